@@ -36,6 +36,8 @@
 # include <roboptim/core/differentiable-function.hh>
 # include <roboptim/core/derivable-parametrized-function.hh>
 # include <roboptim/core/linear-function.hh>
+# include <roboptim/core/low-rank-quadratic-function.hh>
+# include <roboptim/core/matrix-free-linear-function.hh>
 # include <roboptim/core/n-times-derivable-function.hh>
 # include <roboptim/core/numeric-linear-function.hh>
 # include <roboptim/core/numeric-quadratic-function.hh>
@@ -44,6 +46,7 @@
 # include <roboptim/core/sum-of-c1-squares.hh>
 # include <roboptim/core/twice-differentiable-function.hh>
 
+# include <roboptim/core/jacobian-structure.hh>
 # include <roboptim/core/problem.hh>
 # include <roboptim/core/generic-solver.hh>
 # include <roboptim/core/solver.hh>
@@ -58,6 +61,10 @@
 
 # include <roboptim/core/optimization-logger.hh>
 # include <roboptim/core/scaling-helper.hh>
+# include <roboptim/core/snapshot.hh>
+# include <roboptim/core/mps.hh>
+# include <roboptim/core/presolver.hh>
+# include <roboptim/core/scaled-problem.hh>
 # include <roboptim/core/derivative-size.hh>
 
 
@@ -82,6 +89,7 @@
 # include <roboptim/core/operator/selection.hh>
 # include <roboptim/core/operator/selection-by-id.hh>
 # include <roboptim/core/operator/split.hh>
+# include <roboptim/core/operator/stack.hh>
 
 
 // Functions.
@@ -90,6 +98,7 @@
 # include <roboptim/core/function/identity.hh>
 # include <roboptim/core/function/polynomial.hh>
 # include <roboptim/core/function/sin.hh>
+# include <roboptim/core/function/spline.hh>
 
 
 // Visualization.
@@ -86,6 +86,9 @@ namespace roboptim
                              size_t size = 10);
     ~CachedFunction ();
 
+    virtual void evaluationState (std::vector<const void*>& objects)
+      const;
+
     /// \brief Reset the caches.
     void reset ();
 
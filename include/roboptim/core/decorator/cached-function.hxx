@@ -94,6 +94,15 @@ namespace roboptim
   {
   }
 
+  template <typename T>
+  void
+  CachedFunction<T>::evaluationState (std::vector<const void*>& objects)
+    const
+  {
+    objects.push_back (this);
+    function_->evaluationState (objects);
+  }
+
   template <typename T>
   void
   CachedFunction<T>::reset ()
@@ -21,6 +21,7 @@
 # include <stdexcept>
 # include <string>
 # include <ostream>
+# include <vector>
 
 # include <boost/shared_ptr.hpp>
 
@@ -139,6 +140,63 @@ namespace roboptim
   std::ostream& operator<< (std::ostream& o,
 			    const BadJacobian<T>& f);
 
+  /// \brief Exception thrown when a directional derivative check fails.
+  ///
+  /// The analytical directional derivative \f$J(x)v\f$ is compared with
+  /// the finite-difference approximation \f$(f(x+\epsilon v)-f(x))/\epsilon\f$.
+  template <typename T>
+  class BadDirectionalDerivative : public std::runtime_error
+  {
+  public:
+    ROBOPTIM_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_
+    (GenericDifferentiableFunction<T>);
+
+    /// \brief Default constructor.
+    BadDirectionalDerivative (const_argument_ref x,
+			      const_vector_ref direction,
+			      const_vector_ref analyticalDerivative,
+			      const_vector_ref finiteDifferenceDerivative,
+			      const value_type& threshold);
+
+    virtual ~BadDirectionalDerivative () throw ();
+
+    /// \brief Display the exception on the specified output stream.
+    ///
+    /// \param o output stream used for display
+    /// \return output stream
+    virtual std::ostream& print (std::ostream& o) const;
+
+    /// \brief Directional derivative has been computed for this point.
+    argument_t x_;
+
+    /// \brief Direction along which the derivative has been computed.
+    vector_t direction_;
+
+    /// \brief Analytical directional derivative (Jacobian-vector product).
+    vector_t analyticalDerivative_;
+
+    /// \brief Directional derivative computed through finite differences.
+    vector_t finiteDifferenceDerivative_;
+
+    /// \brief Maximum error.
+    value_type maxDelta_;
+
+    /// \brief Row containing the maximum error.
+    size_type maxDeltaRow_;
+
+    /// \brief Allowed threshold.
+    value_type threshold_;
+  };
+
+  /// \brief Override operator<< to handle exception display.
+  ///
+  /// \param o output stream used for display
+  /// \param f function to be displayed
+  /// \return output stream
+  template <typename T>
+  std::ostream& operator<< (std::ostream& o,
+			    const BadDirectionalDerivative<T>& f);
+
   /// \brief Contains finite difference gradients policies.
   ///
   /// Each class of this algorithm implements a finite difference
@@ -194,6 +252,17 @@ namespace roboptim
        const_argument_ref argument,
        argument_ref xEps) const;
 
+      /// \brief Compute the Jacobian columns of a subset of the variables.
+      ///
+      /// Only the given variables are perturbed.
+      /// \return whether the policy supports column-wise evaluation.
+      virtual bool computeJacobianColumns
+      (value_type epsilon,
+       jacobian_ref jacobian,
+       const_argument_ref argument,
+       const indices_t& columns,
+       argument_ref xEps) const;
+
     protected:
       /// \brief Wrapped function.
       const GenericFunction<T>& adaptee_;
@@ -246,6 +315,13 @@ namespace roboptim
        const_argument_ref argument,
        argument_ref xEps) const;
 
+      bool computeJacobianColumns
+      (value_type epsilon,
+       jacobian_ref jacobian,
+       const_argument_ref argument,
+       const indices_t& columns,
+       argument_ref xEps) const;
+
     private:
       mutable result_t result_;
       mutable result_t resultEps_;
@@ -287,6 +363,14 @@ namespace roboptim
        const_argument_ref argument,
        argument_ref xEps) const;
 
+      /// \brief Column-wise evaluation is not supported by this policy.
+      bool computeJacobianColumns
+      (value_type epsilon,
+       jacobian_ref jacobian,
+       const_argument_ref argument,
+       const indices_t& columns,
+       argument_ref xEps) const;
+
       void
       compute_deriv (typename GenericFunction<T>::size_type j,
 		     double h,
@@ -357,6 +441,9 @@ namespace roboptim
 
     ~GenericFiniteDifferenceGradient ();
 
+    virtual void evaluationState (std::vector<const void*>& objects)
+      const;
+
     /// \brief Display the function on the specified output stream.
     ///
     /// \param o output stream used for display
@@ -370,6 +457,9 @@ namespace roboptim
                                 size_type = 0) const;
     virtual void impl_jacobian (jacobian_ref jacobian,
                                 const_argument_ref argument) const;
+    virtual bool impl_jacobian_columns (jacobian_ref jacobian,
+                                        const_argument_ref argument,
+                                        const indices_t& columns) const;
 
     std::string generateName (const GenericFunction<T>& adaptee) const;
 
@@ -441,6 +531,84 @@ namespace roboptim
    typename GenericDifferentiableFunction<T>::value_type fd_eps =
    finiteDifferenceEpsilon);
 
+  /// \brief Check a directional derivative.
+  ///
+  /// Compare the Jacobian-vector product \f$J(x)v\f$ with a forward
+  /// finite-difference approximation along \f$v\f$. This only requires
+  /// one extra evaluation of the function, whatever its input size.
+  /// \param function function that will be checked
+  /// \param x point where the Jacobian will be evaluated
+  /// \param direction direction of the derivative
+  /// \param threshold maximum tolerated error
+  /// \param fd_eps step used for the finite differences
+  /// \return true if valid, false if not
+  template <typename T>
+  bool
+  checkDirectionalDerivative
+  (const GenericDifferentiableFunction<T>& function,
+   typename GenericDifferentiableFunction<T>::const_argument_ref x,
+   typename GenericDifferentiableFunction<T>::const_vector_ref direction,
+   typename GenericDifferentiableFunction<T>::value_type threshold =
+   finiteDifferenceThreshold,
+   typename GenericDifferentiableFunction<T>::value_type fd_eps =
+   finiteDifferenceEpsilon);
+
+  template <typename T>
+  void
+  checkDirectionalDerivativeAndThrow
+  (const GenericDifferentiableFunction<T>& function,
+   typename GenericDifferentiableFunction<T>::const_argument_ref x,
+   typename GenericDifferentiableFunction<T>::const_vector_ref direction,
+   typename GenericDifferentiableFunction<T>::value_type threshold =
+   finiteDifferenceThreshold,
+   typename GenericDifferentiableFunction<T>::value_type fd_eps =
+   finiteDifferenceEpsilon);
+
+  /// \brief Probabilistic Jacobian check.
+  ///
+  /// For each sample point, the Jacobian is evaluated once and compared
+  /// with finite differences along nDirections random unit directions.
+  /// Each point then costs nDirections + 1 function evaluations instead of
+  /// the n + 1 evaluations required by checkJacobian.
+  ///
+  /// Directions are drawn from a pseudo-random generator initialized with
+  /// seed, so that a failing check can be reproduced.
+  /// \param function function that will be checked
+  /// \param x sample points where the Jacobian will be evaluated
+  /// \param nDirections number of random directions per sample point
+  /// \param threshold maximum tolerated error
+  /// \param fd_eps step used for the finite differences
+  /// \param seed seed of the pseudo-random generator
+  /// \return true if valid, false if not
+  template <typename T>
+  bool
+  checkJacobianRandomized
+  (const GenericDifferentiableFunction<T>& function,
+   const std::vector<typename GenericDifferentiableFunction<T>::argument_t>& x,
+   typename GenericDifferentiableFunction<T>::size_type nDirections = 3,
+   typename GenericDifferentiableFunction<T>::value_type threshold =
+   finiteDifferenceThreshold,
+   typename GenericDifferentiableFunction<T>::value_type fd_eps =
+   finiteDifferenceEpsilon,
+   unsigned int seed = 0);
+
+  /// \brief Probabilistic Jacobian check.
+  ///
+  /// Same as checkJacobianRandomized, but throw a BadDirectionalDerivative
+  /// exception describing the worst discrepancy over all the sample points
+  /// and directions if the check fails.
+  template <typename T>
+  void
+  checkJacobianRandomizedAndThrow
+  (const GenericDifferentiableFunction<T>& function,
+   const std::vector<typename GenericDifferentiableFunction<T>::argument_t>& x,
+   typename GenericDifferentiableFunction<T>::size_type nDirections = 3,
+   typename GenericDifferentiableFunction<T>::value_type threshold =
+   finiteDifferenceThreshold,
+   typename GenericDifferentiableFunction<T>::value_type fd_eps =
+   finiteDifferenceEpsilon,
+   unsigned int seed = 0);
+
   /// Example shows finite differences gradient use.
   /// \example finite-difference-gradient.cc
 
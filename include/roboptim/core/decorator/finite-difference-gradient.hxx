@@ -23,6 +23,9 @@
 # include <boost/type_traits/is_same.hpp>
 # include <boost/mpl/same_as.hpp>
 # include <boost/format.hpp>
+# include <boost/make_shared.hpp>
+# include <boost/random/mersenne_twister.hpp>
+# include <boost/random/normal_distribution.hpp>
 
 # include <roboptim/core/util.hh>
 # include <roboptim/core/portability.hh>
@@ -245,11 +248,81 @@ namespace roboptim
     return bj.print (o);
   }
 
+  template <typename T>
+  BadDirectionalDerivative<T>::BadDirectionalDerivative
+  (const_argument_ref x,
+   const_vector_ref direction,
+   const_vector_ref analyticalDerivative,
+   const_vector_ref finiteDifferenceDerivative,
+   const value_type& threshold)
+    : std::runtime_error ("bad directional derivative"),
+      x_ (x),
+      direction_ (direction),
+      analyticalDerivative_ (analyticalDerivative),
+      finiteDifferenceDerivative_ (finiteDifferenceDerivative),
+      maxDelta_ (),
+      maxDeltaRow_ (),
+      threshold_ (threshold)
+  {
+    assert (analyticalDerivative.size ()
+	    == finiteDifferenceDerivative.size ());
+
+    maxDelta_ = -std::numeric_limits<Function::value_type>::infinity ();
+    for (size_type i = 0; i < analyticalDerivative.size (); ++i)
+      {
+	value_type delta =
+	  std::fabs (analyticalDerivative[i] - finiteDifferenceDerivative[i]);
+
+	if (delta > maxDelta_)
+	  {
+	    maxDelta_ = delta;
+	    maxDeltaRow_ = i;
+	  }
+      }
+  }
+
+  template <typename T>
+  BadDirectionalDerivative<T>::~BadDirectionalDerivative () throw ()
+  {}
+
+  template <typename T>
+  std::ostream&
+  BadDirectionalDerivative<T>::print (std::ostream& o) const
+  {
+    o << this->what () << incindent << iendl
+      << "X: " << x_ << iendl
+      << "Direction: " << direction_ << iendl
+      << "Analytical directional derivative: " << analyticalDerivative_
+      << iendl
+      << "Finite difference directional derivative: "
+      << finiteDifferenceDerivative_ << iendl
+      << "Max. delta: " << maxDelta_ << iendl
+      << "Max. delta in row: " << maxDeltaRow_ << iendl
+      << "Max. allowed delta: " << threshold_ << decindent;
+    return o;
+  }
+
+  template <typename T>
+  std::ostream&
+  operator<< (std::ostream& o, const BadDirectionalDerivative<T>& bd)
+  {
+    return bd.print (o);
+  }
+
   template <typename T, typename FdgPolicy>
   GenericFiniteDifferenceGradient<T, FdgPolicy>::~GenericFiniteDifferenceGradient ()
   {
   }
 
+  template <typename T, typename FdgPolicy>
+  void
+  GenericFiniteDifferenceGradient<T, FdgPolicy>::evaluationState
+  (std::vector<const void*>& objects) const
+  {
+    objects.push_back (this);
+    adaptee_->evaluationState (objects);
+  }
+
   template <typename T, typename FdgPolicy>
   void
   GenericFiniteDifferenceGradient<T, FdgPolicy>::impl_compute
@@ -278,6 +351,17 @@ namespace roboptim
     this->computeJacobian(epsilon_, jacobian, argument, xEps_);
   }
 
+  template <typename T, typename FdgPolicy>
+  bool
+  GenericFiniteDifferenceGradient<T, FdgPolicy>::impl_jacobian_columns
+  (jacobian_ref jacobian,
+   const_argument_ref argument,
+   const indices_t& columns) const
+  {
+    return this->computeJacobianColumns (epsilon_, jacobian, argument,
+					 columns, xEps_);
+  }
+
   template <typename T, typename FdgPolicy>
   std::ostream&
   GenericFiniteDifferenceGradient<T, FdgPolicy>::print (std::ostream& o) const
@@ -384,6 +468,185 @@ namespace roboptim
       throw BadJacobian<T> (x, jac, fdjac, threshold);
   }
 
+  namespace detail
+  {
+    /// \internal
+    /// \brief Check the directional derivatives of a function at a given
+    /// point, along each column of directions.
+    ///
+    /// The Jacobian is evaluated once, then each direction only costs one
+    /// extra evaluation of the function.
+    ///
+    /// \return the worst failure, or a null pointer if all the directional
+    /// derivatives are valid.
+    template <typename T, typename D>
+    boost::shared_ptr<BadDirectionalDerivative<T> >
+    checkDirectionalDerivatives
+    (const GenericDifferentiableFunction<T>& function,
+     typename GenericDifferentiableFunction<T>::const_argument_ref x,
+     const D& directions,
+     typename GenericDifferentiableFunction<T>::value_type threshold,
+     typename GenericDifferentiableFunction<T>::value_type fd_eps)
+    {
+      typedef GenericDifferentiableFunction<T> function_t;
+      typedef typename function_t::value_type value_type;
+      typedef typename function_t::vector_t vector_t;
+      typedef typename function_t::jacobian_t jacobian_t;
+
+      assert (directions.rows () == function.inputSize ());
+
+      boost::shared_ptr<BadDirectionalDerivative<T> > worst;
+
+      jacobian_t jac (function.outputSize (), function.inputSize ());
+      jac.setZero ();
+      function.jacobian (jac, x);
+
+      vector_t fx = function (x);
+      vector_t fxEps (function.outputSize ());
+      vector_t jv (function.outputSize ());
+      vector_t fdjv (function.outputSize ());
+      vector_t xEps (function.inputSize ());
+
+      for (typename D::Index k = 0; k < directions.cols (); ++k)
+	{
+	  xEps = x + fd_eps * directions.col (k);
+	  function (fxEps, xEps);
+	  fdjv = (fxEps - fx) / fd_eps;
+	  jv = jac * directions.col (k);
+
+	  if (allclose (jv, fdjv, threshold, threshold))
+	    continue;
+
+	  value_type delta = (jv - fdjv).cwiseAbs ().maxCoeff ();
+	  if (!worst || delta > worst->maxDelta_)
+	    worst = boost::make_shared<BadDirectionalDerivative<T> >
+	      (x, directions.col (k), jv, fdjv, threshold);
+	}
+
+      return worst;
+    }
+
+    /// \internal
+    /// \brief Check the directional derivatives of a function along random
+    /// unit directions, for each sample point.
+    ///
+    /// \return the worst failure, or a null pointer if all the directional
+    /// derivatives are valid.
+    template <typename T>
+    boost::shared_ptr<BadDirectionalDerivative<T> >
+    checkRandomDirectionalDerivatives
+    (const GenericDifferentiableFunction<T>& function,
+     const std::vector<typename GenericDifferentiableFunction<T>::argument_t>& x,
+     typename GenericDifferentiableFunction<T>::size_type nDirections,
+     typename GenericDifferentiableFunction<T>::value_type threshold,
+     typename GenericDifferentiableFunction<T>::value_type fd_eps,
+     unsigned int seed)
+    {
+      typedef GenericDifferentiableFunction<T> function_t;
+      typedef typename function_t::value_type value_type;
+      typedef typename function_t::size_type size_type;
+      typedef Eigen::Matrix<value_type, Eigen::Dynamic, Eigen::Dynamic>
+	directions_t;
+
+      boost::shared_ptr<BadDirectionalDerivative<T> > worst;
+
+      if (function.inputSize () == 0)
+	return worst;
+
+      boost::random::mt19937 generator (seed);
+      boost::random::normal_distribution<value_type> normal;
+      directions_t directions (function.inputSize (), nDirections);
+
+      for (typename std::vector<typename function_t::argument_t>::
+	     const_iterator xi = x.begin (); xi != x.end (); ++xi)
+	{
+	  // Normally-distributed coordinates give directions uniformly
+	  // distributed on the unit sphere.
+	  for (size_type k = 0; k < nDirections; ++k)
+	    {
+	      do
+		{
+		  for (size_type j = 0; j < function.inputSize (); ++j)
+		    directions (j, k) = normal (generator);
+		}
+	      while (directions.col (k).norm () == 0.);
+	      directions.col (k).normalize ();
+	    }
+
+	  boost::shared_ptr<BadDirectionalDerivative<T> > bad =
+	    checkDirectionalDerivatives
+	    (function, *xi, directions, threshold, fd_eps);
+
+	  if (bad && (!worst || bad->maxDelta_ > worst->maxDelta_))
+	    worst = bad;
+	}
+
+      return worst;
+    }
+  } // end of namespace detail.
+
+  template <typename T>
+  bool
+  checkDirectionalDerivative
+  (const GenericDifferentiableFunction<T>& function,
+   typename GenericDifferentiableFunction<T>::const_argument_ref x,
+   typename GenericDifferentiableFunction<T>::const_vector_ref direction,
+   typename GenericDifferentiableFunction<T>::value_type threshold,
+   typename GenericDifferentiableFunction<T>::value_type fd_eps)
+  {
+    return !detail::checkDirectionalDerivatives
+      (function, x, direction, threshold, fd_eps);
+  }
+
+  template <typename T>
+  void
+  checkDirectionalDerivativeAndThrow
+  (const GenericDifferentiableFunction<T>& function,
+   typename GenericDifferentiableFunction<T>::const_argument_ref x,
+   typename GenericDifferentiableFunction<T>::const_vector_ref direction,
+   typename GenericDifferentiableFunction<T>::value_type threshold,
+   typename GenericDifferentiableFunction<T>::value_type fd_eps)
+  {
+    boost::shared_ptr<BadDirectionalDerivative<T> > bad =
+      detail::checkDirectionalDerivatives
+      (function, x, direction, threshold, fd_eps);
+
+    if (bad)
+      throw *bad;
+  }
+
+  template <typename T>
+  bool
+  checkJacobianRandomized
+  (const GenericDifferentiableFunction<T>& function,
+   const std::vector<typename GenericDifferentiableFunction<T>::argument_t>& x,
+   typename GenericDifferentiableFunction<T>::size_type nDirections,
+   typename GenericDifferentiableFunction<T>::value_type threshold,
+   typename GenericDifferentiableFunction<T>::value_type fd_eps,
+   unsigned int seed)
+  {
+    return !detail::checkRandomDirectionalDerivatives
+      (function, x, nDirections, threshold, fd_eps, seed);
+  }
+
+  template <typename T>
+  void
+  checkJacobianRandomizedAndThrow
+  (const GenericDifferentiableFunction<T>& function,
+   const std::vector<typename GenericDifferentiableFunction<T>::argument_t>& x,
+   typename GenericDifferentiableFunction<T>::size_type nDirections,
+   typename GenericDifferentiableFunction<T>::value_type threshold,
+   typename GenericDifferentiableFunction<T>::value_type fd_eps,
+   unsigned int seed)
+  {
+    boost::shared_ptr<BadDirectionalDerivative<T> > bad =
+      detail::checkRandomDirectionalDerivatives
+      (function, x, nDirections, threshold, fd_eps, seed);
+
+    if (bad)
+      throw *bad;
+  }
+
   namespace finiteDifferenceGradientPolicies
   {
     /// Algorithm from the Gnu Scientific Library.
@@ -528,6 +791,68 @@ namespace roboptim
 	}
     }
 
+    template <>
+    inline bool
+    Policy<EigenMatrixSparse>::computeJacobianColumns
+    (value_type epsilon,
+     jacobian_ref jacobian,
+     const_argument_ref argument,
+     const indices_t& columns,
+     argument_ref xEps) const
+    {
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+      bool cur_malloc_allowed = is_malloc_allowed ();
+      set_is_malloc_allowed (true);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+      typedef Eigen::Triplet<double> triplet_t;
+#if EIGEN_VERSION_AT_LEAST(3, 2, 90)
+      typedef matrix_t::StorageIndex index_t;
+#else
+      typedef matrix_t::Index index_t;
+#endif
+
+      std::vector<triplet_t> coefficients;
+
+      gradient_t col (this->adaptee_.outputSize ());
+      for (std::size_t k = 0; k < columns.size (); ++k)
+        {
+          col.setZero ();
+          computeColumn (epsilon, col, argument, columns[k], xEps);
+
+          for (gradient_t::InnerIterator it (col); it; ++it)
+            coefficients.push_back
+              (triplet_t (static_cast<index_t> (it.index ()),
+                          static_cast<index_t> (k), it.value ()));
+        }
+      jacobian.setFromTriplets (coefficients.begin (), coefficients.end ());
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+      set_is_malloc_allowed (cur_malloc_allowed);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+      return true;
+    }
+
+    template <typename T>
+    bool
+    Policy<T>::computeJacobianColumns
+    (value_type epsilon,
+     jacobian_ref jacobian,
+     const_argument_ref argument,
+     const indices_t& columns,
+     argument_ref xEps) const
+    {
+      // For each requested Jacobian column
+      for (std::size_t k = 0; k < columns.size (); ++k)
+	{
+          column_.setZero();
+          computeColumn (epsilon, column_, argument, columns[k], xEps);
+          jacobian.col (static_cast<size_type> (k)) = column_;
+	}
+      return true;
+    }
+
     template <>
     inline void
     Simple<EigenMatrixSparse>::computeGradient
@@ -629,6 +954,22 @@ namespace roboptim
       policy_t::computeJacobian (epsilon, jacobian, argument, xEps);
     }
 
+    template <typename T>
+    bool
+    Simple<T>::computeJacobianColumns
+    (value_type epsilon,
+     jacobian_ref jacobian,
+     const_argument_ref argument,
+     const indices_t& columns,
+     argument_ref xEps) const
+    {
+      // Data used by each computeColumn
+      this->adaptee_ (result_, argument);
+
+      return policy_t::computeJacobianColumns (epsilon, jacobian, argument,
+					       columns, xEps);
+    }
+
     template <>
     inline void
     FivePointsRule<EigenMatrixSparse>::computeGradient
@@ -816,6 +1157,20 @@ namespace roboptim
     }
 
 
+    template <typename T>
+    bool
+    FivePointsRule<T>::computeJacobianColumns
+    (value_type /*epsilon*/,
+     jacobian_ref /*jacobian*/,
+     const_argument_ref /*argument*/,
+     const indices_t& /*columns*/,
+     argument_ref /*xEps*/) const
+    {
+      // The column-wise Jacobian computation is not implemented: the
+      // caller falls back to the full Jacobian.
+      return false;
+    }
+
     template <>
     inline void
     FivePointsRule<EigenMatrixSparse>::computeColumn
@@ -0,0 +1,65 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_DETAIL_INDICES_HH
+# define ROBOPTIM_CORE_DETAIL_INDICES_HH
+
+# include <cstddef>
+# include <vector>
+
+# include <roboptim/core/alloc.hh>
+
+namespace roboptim
+{
+  namespace detail
+  {
+    /// \brief Map indices of an operator to indices of its input function.
+    ///
+    /// This is used to forward row (or column) subsets to the input
+    /// function of an operator. The output buffer is persistent: it only
+    /// allocates memory when more indices than ever before are mapped.
+    ///
+    /// \param indices indices of the operator.
+    /// \param table index of the input function for each index of the
+    /// operator.
+    /// \param output buffer receiving table[indices[k]].
+    /// \return output.
+    template <typename I>
+    const std::vector<I>&
+    map_indices (const std::vector<I>& indices,
+		 const std::vector<I>& table,
+		 std::vector<I>& output)
+    {
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+      bool cur_malloc_allowed = is_malloc_allowed ();
+      set_is_malloc_allowed (true);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+      output.resize (indices.size ());
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+      set_is_malloc_allowed (cur_malloc_allowed);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+      for (std::size_t k = 0; k < indices.size (); ++k)
+	output[k] = table[static_cast<std::size_t> (indices[k])];
+      return output;
+    }
+  } // end of namespace detail
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_DETAIL_INDICES_HH
@@ -0,0 +1,207 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_DETAIL_PARALLEL_JACOBIAN_HH
+# define ROBOPTIM_CORE_DETAIL_PARALLEL_JACOBIAN_HH
+
+# include <cstddef>
+# include <vector>
+
+# include <roboptim/core/alloc.hh>
+# include <roboptim/core/function.hh>
+# include <roboptim/core/jacobian-structure.hh>
+# include <roboptim/core/detail/parallel.hh>
+
+// Evaluation of Jacobian matrices made of the Jacobians of several
+// functions (Stack, Map, FunctionPool, Problem).
+//
+// Dense Jacobians are written in place: each function writes to its own
+// block of the Jacobian. Sparse Jacobians are evaluated in a persistent
+// buffer per function, and the buffers are then copied to the Jacobian by
+// a JacobianStructure. In both cases, the functions can be evaluated
+// concurrently.
+
+namespace roboptim
+{
+  namespace detail
+  {
+    /// \brief Number of threads used to evaluate several functions.
+    ///
+    /// \param threads maximum number of threads.
+    /// \param independent whether the functions can be evaluated
+    /// concurrently (see distinct_objects).
+    inline int parallel_threads (int threads, bool independent)
+    {
+      if (!independent || threads <= 1 || !has_parallel_support ())
+	return 1;
+      return threads;
+    }
+
+    /// \brief Block of a dense Jacobian written by the function i.
+    ///
+    /// \param jacobian whole Jacobian.
+    /// \param row first row of the block.
+    /// \param col first column of the block.
+    /// \param rows number of rows of the block.
+    /// \param cols number of columns of the block.
+    template <typename B>
+    Eigen::Block<GenericFunctionTraits<EigenMatrixDense>::jacobian_ref>
+    jacobian_block (GenericFunctionTraits<EigenMatrixDense>::jacobian_ref&
+		    jacobian,
+		    std::vector<B>&, std::size_t,
+		    Function::size_type row, Function::size_type col,
+		    Function::size_type rows, Function::size_type cols)
+    {
+      return jacobian.block (row, col, rows, cols);
+    }
+
+    /// \brief Buffer of a sparse Jacobian written by the function i.
+    ///
+    /// \param blocks persistent buffers of the functions.
+    /// \param i index of the function.
+    inline GenericFunctionTraits<EigenMatrixSparse>::jacobian_t&
+    jacobian_block
+    (GenericFunctionTraits<EigenMatrixSparse>::jacobian_ref,
+     std::vector<GenericFunctionTraits<EigenMatrixSparse>::jacobian_t>&
+     blocks,
+     std::size_t i,
+     Function::size_type, Function::size_type,
+     Function::size_type, Function::size_type)
+    {
+      return blocks[i];
+    }
+
+    /// \brief Evaluate the Jacobian of a function in a dense block.
+    template <typename F>
+    void
+    evaluate_block (const F& f,
+		    GenericFunctionTraits<EigenMatrixDense>::jacobian_ref block,
+		    typename F::const_argument_ref x)
+    {
+      block.setZero ();
+      f.jacobian (block, x);
+    }
+
+    /// \brief Evaluate the Jacobian of a function in a sparse buffer,
+    /// resized if needed.
+    template <typename F>
+    void
+    evaluate_block (const F& f,
+		    GenericFunctionTraits<EigenMatrixSparse>::jacobian_t& block,
+		    typename F::const_argument_ref x)
+    {
+      if (block.rows () != f.outputSize ()
+	  || block.cols () != f.inputSize ())
+	block.resize (f.outputSize (), f.inputSize ());
+      block.setZero ();
+      f.jacobian (block, x);
+      block.makeCompressed ();
+    }
+
+    /// \brief Copy a block to its rows of a dense Jacobian.
+    template <typename B>
+    void
+    copy_block (GenericFunctionTraits<EigenMatrixDense>::jacobian_ref jacobian,
+		Function::size_type row, const B& block)
+    {
+      jacobian.middleRows (row, block.rows ()) = block;
+    }
+
+    /// \brief Nothing to do: the buffers of sparse Jacobians are copied by
+    /// assemble_rows.
+    template <typename B>
+    void
+    copy_block (GenericFunctionTraits<EigenMatrixSparse>::jacobian_ref,
+		Function::size_type, const B&)
+    {
+    }
+
+    /// \brief Nothing to do: the blocks are written in place.
+    template <typename B>
+    void
+    assemble_rows (GenericFunctionTraits<EigenMatrixDense>::jacobian_ref,
+		   const std::vector<B>&, JacobianStructure&,
+		   Function::size_type)
+    {
+    }
+
+    /// \brief Stack the buffers of a sparse Jacobian, in place if the
+    /// pattern did not change.
+    inline void
+    assemble_rows
+    (GenericFunctionTraits<EigenMatrixSparse>::jacobian_ref jacobian,
+     const std::vector<GenericFunctionTraits<EigenMatrixSparse>::jacobian_t>&
+     blocks,
+     JacobianStructure& structure,
+     Function::size_type cols)
+    {
+      structure.assemble (jacobian, blocks,
+			  static_cast<JacobianStructure::index_t> (cols));
+    }
+
+    /// \brief Nothing to do: the blocks are written in place.
+    template <typename B>
+    void
+    assemble_block_diagonal
+    (GenericFunctionTraits<EigenMatrixDense>::jacobian_ref,
+     const std::vector<B>&, JacobianStructure&)
+    {
+    }
+
+    /// \brief Put the buffers of a sparse Jacobian on its diagonal, in place
+    /// if the pattern did not change.
+    inline void
+    assemble_block_diagonal
+    (GenericFunctionTraits<EigenMatrixSparse>::jacobian_ref jacobian,
+     const std::vector<GenericFunctionTraits<EigenMatrixSparse>::jacobian_t>&
+     blocks,
+     JacobianStructure& structure)
+    {
+      structure.assembleBlockDiagonal (jacobian, blocks);
+    }
+
+    /// \brief Evaluate the blocks of a Jacobian, then assemble them.
+    ///
+    /// \param n number of blocks.
+    /// \param threads maximum number of threads (see parallel_threads).
+    /// \param f functor evaluating the block i with f (i), and copying
+    /// the buffers to the Jacobian with f.assemble ().
+    /// \param allocate whether the evaluation may allocate memory (sparse
+    /// buffers).
+    template <typename F>
+    void parallel_jacobian (std::size_t n, int threads, F& f, bool allocate)
+    {
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+      // The allocation flag is global: it is set once for all the threads.
+      bool cur_malloc_allowed = is_malloc_allowed ();
+      if (allocate)
+	set_is_malloc_allowed (true);
+#else
+      (void)allocate;
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+      parallel_for (n, threads, f);
+      f.assemble ();
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+      set_is_malloc_allowed (cur_malloc_allowed);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    }
+  } // end of namespace detail
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_DETAIL_PARALLEL_JACOBIAN_HH
@@ -0,0 +1,137 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_DETAIL_PARALLEL_HH
+# define ROBOPTIM_CORE_DETAIL_PARALLEL_HH
+
+# include <algorithm>
+# include <cstddef>
+# include <vector>
+
+# include <boost/exception_ptr.hpp>
+
+# ifdef _OPENMP
+#  include <omp.h>
+# endif // _OPENMP
+
+namespace roboptim
+{
+  namespace detail
+  {
+    /// \brief Whether RobOptim was compiled with OpenMP support.
+    inline bool has_parallel_support ()
+    {
+# ifdef _OPENMP
+      return true;
+# else
+      return false;
+# endif // _OPENMP
+    }
+
+    /// \brief Call f (i) for each i in [0, n).
+    ///
+    /// If OpenMP is enabled and more than one thread is requested, the
+    /// iterations are distributed over the threads. Each iteration has to
+    /// write to its own output, so that the result does not depend on the
+    /// scheduling. Otherwise, this is a simple loop.
+    ///
+    /// If some iterations throw, the exception of the first of them (in
+    /// the iteration order) is rethrown once all the threads are done.
+    ///
+    /// \param n number of iterations.
+    /// \param threads maximum number of threads.
+    /// \param f functor taking the iteration index.
+    template <typename F>
+    void parallel_for (std::size_t n, int threads, F& f)
+    {
+# ifdef _OPENMP
+      if (threads > 1 && n > 1)
+	{
+	  const long n_ = static_cast<long> (n);
+	  long failed = n_;
+	  boost::exception_ptr error;
+
+#  pragma omp parallel for num_threads (threads) schedule (dynamic)
+	  for (long i = 0; i < n_; ++i)
+	    {
+	      try
+		{
+		  f (static_cast<std::size_t> (i));
+		}
+	      catch (...)
+		{
+#  pragma omp critical (roboptim_parallel_for)
+		  if (i < failed)
+		    {
+		      failed = i;
+		      error = boost::current_exception ();
+		    }
+		}
+	    }
+
+	  if (failed < n_)
+	    boost::rethrow_exception (error);
+	  return;
+	}
+# endif // _OPENMP
+
+      // Unused when OpenMP is disabled.
+      (void)threads;
+
+      for (std::size_t i = 0; i < n; ++i)
+	f (i);
+    }
+
+    /// \brief Append the objects modified by a function evaluation.
+    ///
+    /// See GenericFunction::evaluationState. An object reported several
+    /// times by the same function (e.g. a function composed with itself)
+    /// is only appended once.
+    ///
+    /// \param objects vector the objects are appended to.
+    /// \param function evaluated function.
+    template <typename F>
+    void append_evaluation_state (std::vector<const void*>& objects,
+				  const F& function)
+    {
+      typedef std::vector<const void*>::iterator iterator_t;
+
+      const std::size_t first = objects.size ();
+      function.evaluationState (objects);
+
+      iterator_t begin = objects.begin ()
+	+ static_cast<std::ptrdiff_t> (first);
+      std::sort (begin, objects.end ());
+      objects.erase (std::unique (begin, objects.end ()), objects.end ());
+    }
+
+    /// \brief Whether no object appears twice.
+    ///
+    /// Functions whose states (see append_evaluation_state) are distinct
+    /// can be evaluated concurrently.
+    ///
+    /// \param objects objects, sorted by this function.
+    inline bool distinct_objects (std::vector<const void*>& objects)
+    {
+      std::sort (objects.begin (), objects.end ());
+      return std::adjacent_find (objects.begin (), objects.end ())
+	== objects.end ();
+    }
+  } // end of namespace detail
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_DETAIL_PARALLEL_HH
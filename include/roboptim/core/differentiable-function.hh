@@ -160,6 +160,69 @@ namespace roboptim
       assert (isValidJacobian (jacobian));
     }
 
+    /// \brief Computes the rows of the jacobian of a subset of the outputs.
+    ///
+    /// This only succeeds if the function implements
+    /// #impl_jacobian_rows, otherwise nothing is written and the caller
+    /// has to compute the whole jacobian.
+    /// \param jacobian jacobian rows will be stored in this argument
+    /// (size: rows.size () x inputSize ())
+    /// \param argument point at which the jacobian will be computed
+    /// \param rows indices of the outputs
+    /// \return whether the jacobian rows have been computed
+    bool jacobianRows (jacobian_ref jacobian, const_argument_ref argument,
+		       const indices_t& rows) const
+    {
+      assert (argument.size () == this->inputSize ());
+      assert (jacobian.rows () == static_cast<size_type> (rows.size ()));
+      assert (jacobian.cols () == this->inputSize ());
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+      bool cur_malloc_allowed = is_malloc_allowed ();
+      set_is_malloc_allowed (false);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+      bool done = this->impl_jacobian_rows (jacobian, argument, rows);
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+      set_is_malloc_allowed (cur_malloc_allowed);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+      return done;
+    }
+
+    /// \brief Computes the columns of the jacobian for a subset of the
+    /// variables.
+    ///
+    /// This only succeeds if the function implements
+    /// #impl_jacobian_columns, otherwise nothing is written and the caller
+    /// has to compute the whole jacobian.
+    /// \param jacobian jacobian columns will be stored in this argument
+    /// (size: outputSize () x columns.size ())
+    /// \param argument point at which the jacobian will be computed
+    /// \param columns indices of the variables
+    /// \return whether the jacobian columns have been computed
+    bool jacobianColumns (jacobian_ref jacobian, const_argument_ref argument,
+			  const indices_t& columns) const
+    {
+      assert (argument.size () == this->inputSize ());
+      assert (jacobian.rows () == this->outputSize ());
+      assert (jacobian.cols () == static_cast<size_type> (columns.size ()));
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+      bool cur_malloc_allowed = is_malloc_allowed ();
+      set_is_malloc_allowed (false);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+      bool done = this->impl_jacobian_columns (jacobian, argument, columns);
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+      set_is_malloc_allowed (cur_malloc_allowed);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+      return done;
+    }
+
     /// \brief Computes the gradient.
     ///
     /// \param argument point at which the gradient will be computed
@@ -231,6 +294,37 @@ namespace roboptim
     virtual void impl_jacobian (jacobian_ref jacobian, const_argument_ref arg)
       const;
 
+    /// \brief Evaluation of the jacobian rows of a subset of the outputs.
+    ///
+    /// Functions that can differentiate a few outputs more cheaply than
+    /// the whole function can override this method. The default
+    /// implementation does nothing and returns false.
+    /// \warning Do not call this function directly, call #jacobianRows
+    /// instead.
+    /// \param jacobian jacobian rows will be stored in this argument
+    /// \param arg point where the jacobian will be computed
+    /// \param rows indices of the outputs
+    /// \return whether the jacobian rows have been computed
+    virtual bool impl_jacobian_rows (jacobian_ref jacobian,
+				     const_argument_ref arg,
+				     const indices_t& rows) const;
+
+    /// \brief Evaluation of the jacobian columns of a subset of the
+    /// variables.
+    ///
+    /// Functions that can differentiate with respect to a few variables
+    /// more cheaply than with respect to all of them can override this
+    /// method. The default implementation does nothing and returns false.
+    /// \warning Do not call this function directly, call #jacobianColumns
+    /// instead.
+    /// \param jacobian jacobian columns will be stored in this argument
+    /// \param arg point where the jacobian will be computed
+    /// \param columns indices of the variables
+    /// \return whether the jacobian columns have been computed
+    virtual bool impl_jacobian_columns (jacobian_ref jacobian,
+					const_argument_ref arg,
+					const indices_t& columns) const;
+
     /// \brief Gradient evaluation.
     ///
     /// Compute the gradient, has to be implemented in concrete classes.
@@ -81,6 +81,26 @@ namespace roboptim
        gradient (jacobian.row (i), argument, i);
   }
 
+  template <typename T>
+  bool
+  GenericDifferentiableFunction<T>::impl_jacobian_rows (jacobian_ref,
+							const_argument_ref,
+							const indices_t&)
+    const
+  {
+    return false;
+  }
+
+  template <typename T>
+  bool
+  GenericDifferentiableFunction<T>::impl_jacobian_columns (jacobian_ref,
+							   const_argument_ref,
+							   const indices_t&)
+    const
+  {
+    return false;
+  }
+
   template <typename T>
   std::ostream&
   GenericDifferentiableFunction<T>::print (std::ostream& o) const
@@ -28,6 +28,7 @@
 # include <boost/type_traits/is_base_of.hpp>
 
 # include <roboptim/core/differentiable-function.hh>
+# include <roboptim/core/jacobian-structure.hh>
 # include <roboptim/core/detail/utility.hh>
 
 namespace roboptim
@@ -36,12 +37,34 @@ namespace roboptim
   /// \addtogroup roboptim_meta_function
   /// @{
 
+  /// \brief Engine of a function pool computing the data required by both
+  /// the values and the Jacobians of the pool functions in a single pass.
+  ///
+  /// The callback of a FunctionPool can implement this interface in
+  /// addition to its function type. When the pool caches the engine
+  /// results (see FunctionPool::cacheEngine), a single pass is then run for
+  /// each distinct point, whether the value or the Jacobian of the pool is
+  /// requested first.
+  class FunctionPoolEngine
+  {
+  public:
+    virtual ~FunctionPoolEngine ()
+    {
+    }
+
+    /// \brief Run the engine for both the values and the Jacobians.
+    ///
+    /// \param x point at which the engine is run.
+    virtual void computeWithJacobian (Function::const_argument_ref x)
+      const = 0;
+  };
+
   /// \brief A pool of functions that will be processed together.
   ///
   /// This class provides a way to regroup functions that depend on the same
   /// "computation engine", for instance a simulator that generates some data,
   /// then each function of the pool can simply read the computed data (which
-  /// could be done in parallel).
+  /// can be done in parallel, see evaluationThreads).
   ///
   /// TODO: the actual type of the FunctionPool should depend on the list of
   /// constraints that are supported. We could imagine using a metaprogramming
@@ -92,6 +115,9 @@ namespace roboptim
     /// \brief Virtual destructor.
     virtual ~FunctionPool ();
 
+    virtual void evaluationState (std::vector<const void*>& objects)
+      const;
+
 
     virtual void impl_compute (result_ref result, const_argument_ref x) const;
 
@@ -102,6 +128,54 @@ namespace roboptim
     virtual void impl_jacobian (jacobian_ref jacobian,
                                 const_argument_ref arg) const;
 
+    /// \brief Maximum number of threads used to evaluate the functions of
+    /// the pool, once the engine has been run.
+    ///
+    /// Each function of the pool writes to its own row block, and sparse
+    /// functions are evaluated in their own buffer before being copied to
+    /// the preassigned slots of the Jacobian. The output does not depend on
+    /// the number of threads.
+    ///
+    /// This requires RobOptim to be compiled with OpenMP support, and the
+    /// functions of the pool to only read the data of the engine.
+    /// Functions modifying a common object (see
+    /// GenericFunction::evaluationState), e.g. a function added twice to
+    /// the pool, disable the parallel evaluation.
+    ///
+    /// \return reference on the number of threads (default: 1, i.e.
+    /// sequential evaluation).
+    int& evaluationThreads ();
+
+    /// \brief Maximum number of threads used to evaluate the functions of
+    /// the pool.
+    /// \return number of threads.
+    int evaluationThreads () const;
+
+    /// \brief Whether the engine results are reused between evaluations.
+    ///
+    /// If enabled, the pool keeps track of the last point at which the
+    /// engine was run, and of what was computed there (values and/or
+    /// Jacobian data). The engine is then only run when the point changes,
+    /// or when the Jacobian data is missing. If the callback implements
+    /// FunctionPoolEngine, values and Jacobian data are always computed
+    /// together, so that each distinct point costs a single engine pass.
+    ///
+    /// This must only be enabled if the state of the engine is not
+    /// modified by anything else than this pool (e.g. another pool sharing
+    /// the same engine), or if resetEngineCache is called when it is.
+    /// Changing this flag discards the last engine results.
+    ///
+    /// \param cache caching flag (default: false).
+    void cacheEngine (bool cache);
+
+    /// \brief Whether the engine results are reused between evaluations.
+    /// \return caching flag.
+    bool cacheEngine () const;
+
+    /// \brief Forget the last engine results, e.g. after the state of the
+    /// engine was modified externally.
+    void resetEngineCache () const;
+
     /// \brief Overriden print function for pools.
     virtual std::ostream& print (std::ostream&) const;
 
@@ -111,6 +185,17 @@ namespace roboptim
     /// \brief Get the output size from the function list.
     static size_type listOutputSize (const functionList_t& functions);
 
+  private:
+    /// \brief Number of threads that can actually be used.
+    int parallelThreads () const;
+
+    /// \brief Run the engine at a given point, unless its results can be
+    /// reused.
+    ///
+    /// \param x evaluation point.
+    /// \param jacobian whether the Jacobian data is required.
+    void runEngine (const_argument_ref x, bool jacobian) const;
+
   private:
     /// \brief Functions of the pool.
     functionList_t functions_;
@@ -123,6 +208,42 @@ namespace roboptim
 
     /// \brief Dummy matrix to avoid callback allocations.
     mutable typename callback_t::jacobian_t callback_jac_;
+
+    /// \brief First row of each function in the output of the pool.
+    std::vector<size_type> rows_;
+
+    /// \brief Jacobian buffers of the sparse functions.
+    mutable std::vector<GenericFunctionTraits<EigenMatrixSparse>::matrix_t>
+    blocks_;
+
+    /// \brief Structure of the sparse Jacobian of the pool, and position of
+    /// the nonzeros of each block.
+    mutable JacobianStructure structure_;
+
+    /// \brief Maximum number of threads used for the evaluation.
+    int evaluationThreads_;
+
+    /// \brief Whether the functions can be evaluated concurrently.
+    bool distinct_;
+
+    /// \brief Whether some functions are sparse.
+    bool sparse_;
+
+    /// \brief Callback as a single-pass engine, or null if it does not
+    /// implement this interface.
+    const FunctionPoolEngine* combinedEngine_;
+
+    /// \brief Whether the engine results are reused.
+    bool cacheEngine_;
+
+    /// \brief Last point at which the engine was run.
+    mutable argument_t lastX_;
+
+    /// \brief Whether the engine computed the values at lastX_.
+    mutable bool valueReady_;
+
+    /// \brief Whether the engine computed the Jacobian data at lastX_.
+    mutable bool jacobianReady_;
   };
 
   /// @}
@@ -15,11 +15,16 @@
 // You should have received a copy of the GNU Lesser General Public License
 // along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
 
+# include <algorithm>
+# include <vector>
+
 # include <boost/variant/apply_visitor.hpp>
 # include <boost/utility/enable_if.hpp>
 # include <boost/type_traits/is_same.hpp>
 
 # include <roboptim/core/util.hh>
+# include <roboptim/core/detail/parallel.hh>
+# include <roboptim/core/detail/parallel-jacobian.hh>
 
 namespace roboptim
 {
@@ -74,21 +79,51 @@ namespace roboptim
       return outputSize;
     }
 
+    struct PoolStateVisitor : public boost::static_visitor<>
+    {
+      PoolStateVisitor (std::vector<const void*>& objects)
+        : objects_ (objects)
+      {}
+
+      template <typename F>
+      void operator () (const F& f)
+      {
+        detail::append_evaluation_state (objects_, *f);
+      }
+
+      std::vector<const void*>& objects_;
+    };
+
+    struct PoolSparseVisitor : public boost::static_visitor<bool>
+    {
+      PoolSparseVisitor (){}
+
+      template <typename U>
+      bool operator () (const boost::shared_ptr<U>&)
+      {
+        return !boost::is_same<typename U::traits_t, EigenMatrixDense>::value;
+      }
+    };
+
+    /// \brief Sparse Jacobian blocks of the pool functions.
+    typedef std::vector<GenericFunctionTraits<EigenMatrixSparse>::matrix_t>
+    poolBlocks_t;
+
     template <typename F>
     struct PoolComputeVisitor : public boost::static_visitor<void>
     {
       PoolComputeVisitor (typename F::result_ref result,
-                          typename F::const_argument_ref x)
+                          typename F::const_argument_ref x,
+                          typename F::size_type idx)
 	: result_ (result),
 	  x_ (x),
-	  idx_ (0)
+	  idx_ (idx)
       {}
 
       template <typename U>
       void operator () (const boost::shared_ptr<U>& f)
       {
         (*f) (result_.segment (idx_, f->outputSize ()), x_);
-        idx_ += f->outputSize ();
       }
 
     private:
@@ -101,10 +136,13 @@ namespace roboptim
     struct PoolJacobianVisitor : public boost::static_visitor<void>
     {
       PoolJacobianVisitor (typename F::jacobian_ref jacobian,
-                           typename F::const_argument_ref x)
+                           poolBlocks_t::value_type& block,
+                           typename F::const_argument_ref x,
+                           typename F::size_type idx)
 	: jacobian_ (jacobian),
+	  block_ (block),
 	  x_ (x),
-	  idx_ (0),
+	  idx_ (idx),
 	  m_ (jacobian.cols ())
       {}
 
@@ -117,8 +155,8 @@ namespace roboptim
       {
         assert (f->inputSize () == m_);
 
-        f->jacobian (jacobian_.block (idx_, 0, f->outputSize (), m_), x_);
-        idx_ += f->outputSize ();
+        detail::evaluate_block
+          (*f, jacobian_.block (idx_, 0, f->outputSize (), m_), x_);
       }
 
       template <typename U>
@@ -130,28 +168,84 @@ namespace roboptim
       {
         assert (f->inputSize () == m_);
 
-#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
-        bool cur_malloc_allowed = is_malloc_allowed ();
-        set_is_malloc_allowed (true);
-#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
-
-        // TODO: update once sparse submatrix support makes it possible
-        copySparseBlock (jacobian_, f->jacobian (x_), idx_, 0);
-
-#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
-        set_is_malloc_allowed (cur_malloc_allowed);
-#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
-
-        idx_ += f->outputSize ();
+        // Evaluate in the persistent buffer of the function.
+        detail::evaluate_block (*f, block_, x_);
+        detail::copy_block (jacobian_, idx_, block_);
       }
 
     private:
       typename F::jacobian_ref jacobian_;
+      poolBlocks_t::value_type& block_;
       typename F::const_argument_ref x_;
       typename F::size_type idx_;
       typename F::size_type m_;
     };
 
+    /// \brief Evaluate a function of the pool into its row block.
+    template <typename F, typename L>
+    struct PoolCompute
+    {
+      PoolCompute (const L& functions,
+                   const std::vector<typename F::size_type>& rows,
+                   typename F::result_ref result,
+                   typename F::const_argument_ref x)
+	: functions_ (functions),
+	  rows_ (rows),
+	  result_ (result),
+	  x_ (x)
+      {}
+
+      void operator () (std::size_t i)
+      {
+        PoolComputeVisitor<F> visitor (result_, x_, rows_[i]);
+        boost::apply_visitor (visitor, functions_[i]);
+      }
+
+      const L& functions_;
+      const std::vector<typename F::size_type>& rows_;
+      typename F::result_ref result_;
+      typename F::const_argument_ref x_;
+    };
+
+    /// \brief Evaluate the Jacobian of a function of the pool into its row
+    /// block (dense pools) or into its own buffer (sparse functions).
+    template <typename F, typename L>
+    struct PoolJacobian
+    {
+      PoolJacobian (const L& functions,
+                    const std::vector<typename F::size_type>& rows,
+                    poolBlocks_t& blocks,
+                    JacobianStructure& structure,
+                    typename F::jacobian_ref jacobian,
+                    typename F::const_argument_ref x)
+	: functions_ (functions),
+	  rows_ (rows),
+	  blocks_ (blocks),
+	  structure_ (structure),
+	  jacobian_ (jacobian),
+	  x_ (x)
+      {}
+
+      void operator () (std::size_t i)
+      {
+        PoolJacobianVisitor<F> visitor (jacobian_, blocks_[i], x_, rows_[i]);
+        boost::apply_visitor (visitor, functions_[i]);
+      }
+
+      void assemble ()
+      {
+        detail::assemble_rows (jacobian_, blocks_, structure_,
+                               jacobian_.cols ());
+      }
+
+      const L& functions_;
+      const std::vector<typename F::size_type>& rows_;
+      poolBlocks_t& blocks_;
+      JacobianStructure& structure_;
+      typename F::jacobian_ref jacobian_;
+      typename F::const_argument_ref x_;
+    };
+
     template <typename F>
     struct PoolPrintVisitor : public boost::static_visitor<void>
     {
@@ -181,8 +275,41 @@ namespace roboptim
       functions_ (functions),
       callback_ (callback),
       callback_res_ (callback->outputSize ()),
-      callback_jac_ (callback->outputSize (), callback->inputSize ())
+      callback_jac_ (callback->outputSize (), callback->inputSize ()),
+      rows_ (functions.size ()),
+      blocks_ (functions.size ()),
+      structure_ (),
+      evaluationThreads_ (1),
+      distinct_ (true),
+      sparse_ (false),
+      combinedEngine_
+      (dynamic_cast<const FunctionPoolEngine*> (callback.get ())),
+      cacheEngine_ (false),
+      lastX_ (callback->inputSize ()),
+      valueReady_ (false),
+      jacobianReady_ (false)
   {
+    lastX_.setZero ();
+
+    std::vector<const void*> objects;
+    PoolOutputSizeVisitor sizeVisitor;
+    PoolStateVisitor stateVisitor (objects);
+    PoolSparseVisitor sparseVisitor;
+    size_type row = 0;
+
+    for (std::size_t i = 0; i < functions_.size (); ++i)
+      {
+        rows_[i] = row;
+        row += static_cast<size_type>
+          (boost::apply_visitor (sizeVisitor, functions_[i]));
+        boost::apply_visitor (stateVisitor, functions_[i]);
+        sparse_ = sparse_ || boost::apply_visitor (sparseVisitor,
+                                                   functions_[i]);
+      }
+
+    // Functions rely on internal buffers: functions modifying a common
+    // object cannot be evaluated concurrently.
+    distinct_ = detail::distinct_objects (objects);
   }
 
   template <typename F, typename FLIST>
@@ -190,27 +317,35 @@ namespace roboptim
   {
   }
 
+  template <typename F, typename FLIST>
+  void
+  FunctionPool<F,FLIST>::evaluationState (std::vector<const void*>& objects)
+    const
+  {
+    PoolStateVisitor stateVisitor (objects);
+
+    objects.push_back (this);
+    callback_->evaluationState (objects);
+    for (std::size_t i = 0; i < functions_.size (); ++i)
+      boost::apply_visitor (stateVisitor, functions_[i]);
+  }
+
   template <typename F, typename FLIST>
   void FunctionPool<F,FLIST>::impl_compute (result_ref result, const_argument_ref x)
     const
   {
-    // First, run the engine (callback)
-    // Note: callback_res_ should not be modified, since the callback does not
-    // directly fill the result vector. However, RobOptim functions expect
-    // a result vector if we want to avoid any allocation.
-    (*callback_) (callback_res_, x);
+    // First, run the engine (callback) if needed
+    runEngine (x, false);
 
     // Second, process the functions of the pool.
     // Note: here a dummy x would work just as well since the computation
     // should have been done in the engine already.
     // TODO: use a fake argument vector that triggers an error when accessed
     // to detect any misuse of the pool?
-    typedef typename functionList_t::const_iterator citer_t;
-    PoolComputeVisitor<pool_t> visitor (result, x);
-    for (citer_t f = functions_.begin (); f != functions_.end (); ++f)
-      {
-	boost::apply_visitor (visitor, *f);
-      }
+    //
+    // Each function writes to its own row block.
+    PoolCompute<pool_t, functionList_t> f (functions_, rows_, result, x);
+    detail::parallel_for (functions_.size (), parallelThreads (), f);
   }
 
   template <typename F, typename FLIST>
@@ -228,26 +363,104 @@ namespace roboptim
   void FunctionPool<F,FLIST>::impl_jacobian (jacobian_ref jacobian,
                                              const_argument_ref x) const
   {
-    // Initialize the Jacobian
-    jacobian.setZero ();
-
-    // First, run the engine (callback)
-    // Note: callback_jac_ should not be modified, since the callback does not
-    // directly fill the Jacobian matrix. However, RobOptim functions expect
-    // a Jacobian matrix if we want to avoid any allocation.
-    callback_->jacobian (callback_jac_, x);
+    // First, run the engine (callback) if needed
+    runEngine (x, true);
 
     // Second, process the functions of the pool.
     // Note: here a dummy x would work just as well since the computation
     // should have been done in the engine already.
     // TODO: use a fake argument vector that triggers an error when accessed
     // to detect any misuse of the pool?
-    typedef typename functionList_t::const_iterator citer_t;
-    PoolJacobianVisitor<pool_t> visitor (jacobian, x);
-    for (citer_t f = functions_.begin (); f != functions_.end (); ++f)
+    //
+    // Dense functions write to their own row block, sparse functions to
+    // their own buffer, which is then copied to the Jacobian of the pool.
+    PoolJacobian<pool_t, functionList_t>
+      f (functions_, rows_, blocks_, structure_, jacobian, x);
+    detail::parallel_jacobian (functions_.size (), parallelThreads (), f,
+                               sparse_);
+  }
+
+  template <typename F, typename FLIST>
+  void FunctionPool<F,FLIST>::runEngine (const_argument_ref x,
+                                         bool jacobian) const
+  {
+    if (cacheEngine_)
       {
-	boost::apply_visitor (visitor, *f);
+        if (lastX_ != x)
+          resetEngineCache ();
+        else if (jacobian ? jacobianReady_ : valueReady_)
+          return;
+      }
+
+    if (cacheEngine_ && combinedEngine_)
+      {
+        // Single pass for the values and the Jacobians.
+        combinedEngine_->computeWithJacobian (x);
       }
+    else if (jacobian)
+      {
+        // Note: callback_jac_ should not be modified, since the callback
+        // does not directly fill the Jacobian matrix. However, RobOptim
+        // functions expect a Jacobian matrix if we want to avoid any
+        // allocation.
+        callback_->jacobian (callback_jac_, x);
+      }
+    else
+      {
+        // Note: callback_res_ should not be modified, since the callback
+        // does not directly fill the result vector. However, RobOptim
+        // functions expect a result vector if we want to avoid any
+        // allocation.
+        (*callback_) (callback_res_, x);
+      }
+
+    // What was computed is only tracked when caching is enabled.
+    if (cacheEngine_)
+      {
+        lastX_ = x;
+        if (combinedEngine_ || !jacobian)
+          valueReady_ = true;
+        if (combinedEngine_ || jacobian)
+          jacobianReady_ = true;
+      }
+  }
+
+  template <typename F, typename FLIST>
+  void FunctionPool<F,FLIST>::cacheEngine (bool cache)
+  {
+    cacheEngine_ = cache;
+    resetEngineCache ();
+  }
+
+  template <typename F, typename FLIST>
+  bool FunctionPool<F,FLIST>::cacheEngine () const
+  {
+    return cacheEngine_;
+  }
+
+  template <typename F, typename FLIST>
+  void FunctionPool<F,FLIST>::resetEngineCache () const
+  {
+    valueReady_ = false;
+    jacobianReady_ = false;
+  }
+
+  template <typename F, typename FLIST>
+  int& FunctionPool<F,FLIST>::evaluationThreads ()
+  {
+    return evaluationThreads_;
+  }
+
+  template <typename F, typename FLIST>
+  int FunctionPool<F,FLIST>::evaluationThreads () const
+  {
+    return evaluationThreads_;
+  }
+
+  template <typename F, typename FLIST>
+  int FunctionPool<F,FLIST>::parallelThreads () const
+  {
+    return detail::parallel_threads (evaluationThreads_, distinct_);
   }
 
   template <typename F, typename FLIST>
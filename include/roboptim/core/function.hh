@@ -82,6 +82,7 @@
   typedef parent_t::value_type value_type;	\
   typedef parent_t::size_type size_type;	\
   typedef parent_t::names_t names_t;            \
+  typedef parent_t::indices_t indices_t;	\
   ROBOPTIM_GENERATE_FWD_REFS(argument);		\
   ROBOPTIM_GENERATE_FWD_REFS(result);		\
   ROBOPTIM_GENERATE_FWD_REFS(vector);		\
@@ -93,6 +94,7 @@
   typedef typename parent_t::value_type value_type;	\
   typedef typename parent_t::size_type size_type;	\
   typedef typename parent_t::names_t names_t;           \
+  typedef typename parent_t::indices_t indices_t;	\
   ROBOPTIM_GENERATE_FWD_REFS_(argument);		\
   ROBOPTIM_GENERATE_FWD_REFS_(result);			\
   ROBOPTIM_GENERATE_FWD_REFS_(vector);			\
@@ -141,7 +143,8 @@ namespace roboptim
       ROBOPTIM_IS_LINEAR                = 1 << 5,
       ROBOPTIM_IS_NUMERIC_LINEAR        = 1 << 6,
       ROBOPTIM_IS_POLYNOMIAL            = 1 << 7,
-      ROBOPTIM_IS_CONSTANT              = 1 << 8
+      ROBOPTIM_IS_CONSTANT              = 1 << 8,
+      ROBOPTIM_IS_MATRIX_FREE           = 1 << 9
     };
 
   /// \brief GenericFunction traits
@@ -237,6 +240,9 @@ namespace roboptim
     /// \brief Type of a vector of function argument names.
     typedef std::vector<name_t> names_t;
 
+    /// \brief Type of a list of output indices.
+    typedef std::vector<size_type> indices_t;
+
     /// \brief Get the value of the machine epsilon, useful for
     /// floating types comparison.
 
@@ -416,6 +422,19 @@ namespace roboptim
     void operator () (result_ref result, const_argument_ref argument)
       const;
 
+    /// \brief Evaluate a subset of the outputs at a specified point.
+    ///
+    /// This only succeeds if the function implements
+    /// #impl_compute_rows, otherwise nothing is written and the caller
+    /// has to evaluate the whole function.
+    /// \param result result will be stored in this vector
+    /// (size: rows.size ())
+    /// \param argument point at which the function will be evaluated
+    /// \param rows indices of the evaluated outputs
+    /// \return whether the outputs have been evaluated
+    bool computeRows (result_ref result, const_argument_ref argument,
+                      const indices_t& rows) const;
+
     /// \brief Get function name.
     ///
     /// \return Function name.
@@ -427,6 +446,18 @@ namespace roboptim
     /// \return output stream
     virtual std::ostream& print (std::ostream&) const;
 
+    /// \brief Collect the objects modified when evaluating the function.
+    ///
+    /// Two functions can only be evaluated concurrently if they do not
+    /// modify a common object. By default, this is the function itself,
+    /// whose internal buffers are used by the evaluation. Operators and
+    /// decorators also report the functions they evaluate, and the state
+    /// they may share with other functions. A reentrant function, which
+    /// does not modify anything during its evaluation, reports no object.
+    ///
+    /// \param objects vector the objects are appended to
+    virtual void evaluationState (std::vector<const void*>& objects) const;
+
     /// \brief Flag representing the Roboptim Function type
     static const flag_t flags = ROBOPTIM_IS_FUNCTION;
 
@@ -455,6 +486,21 @@ namespace roboptim
     virtual void impl_compute (result_ref result, const_argument_ref argument)
       const = 0;
 
+    /// \brief Evaluation of a subset of the outputs.
+    ///
+    /// Functions that can evaluate a few outputs more cheaply than the
+    /// whole result can override this method. The default implementation
+    /// does nothing and returns false.
+    /// \warning Do not call this function directly, call #computeRows
+    /// instead.
+    /// \param result result will be stored in this vector
+    /// \param argument point at which the function will be evaluated
+    /// \param rows indices of the evaluated outputs
+    /// \return whether the outputs have been evaluated
+    virtual bool impl_compute_rows (result_ref result,
+                                    const_argument_ref argument,
+                                    const indices_t& rows) const;
+
   private:
     /// \brief Problem dimension.
     size_type inputSize_;
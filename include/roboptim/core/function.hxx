@@ -149,6 +149,14 @@ namespace roboptim
   {
   }
 
+  template <typename T>
+  void
+  GenericFunction<T>::evaluationState (std::vector<const void*>& objects)
+    const
+  {
+    objects.push_back (this);
+  }
+
   template <typename T>
   std::ostream&
   GenericFunction<T>::print (std::ostream& o) const
@@ -188,6 +196,36 @@ namespace roboptim
     assert (isValidResult (result));
   }
 
+  template <typename T>
+  bool GenericFunction<T>::computeRows (result_ref result,
+                                        const_argument_ref argument,
+                                        const indices_t& rows) const
+  {
+    assert (argument.size () == inputSize ());
+    assert (result.size () == static_cast<size_type> (rows.size ()));
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    bool cur_malloc_allowed = is_malloc_allowed ();
+    set_is_malloc_allowed (false);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+    bool done = this->impl_compute_rows (result, argument, rows);
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    set_is_malloc_allowed (cur_malloc_allowed);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+    return done;
+  }
+
+  template <typename T>
+  bool GenericFunction<T>::impl_compute_rows (result_ref,
+                                              const_argument_ref,
+                                              const indices_t&) const
+  {
+    return false;
+  }
+
   template <typename T>
   typename GenericFunction<T>::result_t
   GenericFunction<T>::operator () (const_argument_ref argument) const
@@ -51,6 +51,16 @@ namespace roboptim
     virtual ~Polynomial ()
     {}
 
+    /// \brief Evaluate a derivative of the polynomial at several points.
+    ///
+    /// Horner's method is applied to all the points at once.
+    /// \param result derivatives, one per point (size: times.size ())
+    /// \param times points at which the polynomial is evaluated
+    /// \param order derivative order (if 0 then the polynomial is
+    /// evaluated)
+    void derivatives (vector_ref result, const_vector_ref times,
+		      size_type order = 0) const;
+
     /// \brief Display the function on the specified output stream.
     ///
     /// \param o output stream used for display
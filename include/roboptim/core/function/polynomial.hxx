@@ -17,6 +17,7 @@
 
 #ifndef ROBOPTIM_CORE_FUNCTION_POLYNOMIAL_HXX
 # define ROBOPTIM_CORE_FUNCTION_POLYNOMIAL_HXX
+# include <cassert>
 # include <stdexcept>
 
 # include <boost/format.hpp>
@@ -137,6 +138,29 @@ namespace roboptim
     return acc;
   }
 
+  template <typename T>
+  void
+  Polynomial<T>::derivatives (vector_ref result, const_vector_ref times,
+			      size_type order) const
+  {
+    assert (result.size () == times.size ());
+
+    result.setZero ();
+
+    // Horner's method on the coefficients of the derivative:
+    // deg * (deg - 1) * ... * (deg - order + 1) * a_deg.
+    for (typename vector_t::Index deg = coeffs_.size () - 1;
+	 deg >= order; --deg)
+      {
+	value_type factor = 1;
+	for (typename vector_t::Index k = 0; k < order; ++k)
+	  factor *= static_cast<value_type> (deg - k);
+
+	result.array () *= times.array ();
+	result.array () += factor * coeffs_[deg];
+      }
+  }
+
   template <typename T>
   void
   Polynomial<T>::impl_gradient (gradient_ref gradient,
@@ -0,0 +1,195 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_FUNCTION_SPLINE_HH
+# define ROBOPTIM_CORE_FUNCTION_SPLINE_HH
+
+# include <roboptim/core/fwd.hh>
+# include <roboptim/core/linear-function.hh>
+# include <roboptim/core/portability.hh>
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_function
+  /// @{
+
+  /// \brief B-spline sampled at fixed times.
+  ///
+  /// The spline of degree p is defined by a non-decreasing knot vector
+  /// \f$(u_0, ..., u_{n+p})\f$ and n control coefficients \f$c_j\f$:
+  /// \f[s(t) = \sum_{j=0}^{n-1} c_j N_{j,p} (t)\f]
+  /// where \f$N_{j,p}\f$ are the B-spline basis functions.
+  ///
+  /// The inputs of the function are the control coefficients, and the
+  /// outputs are the derivatives of a given order of the spline at fixed
+  /// sampling times:
+  /// \f[f(c) = (s^{(k)} (t_0), ..., s^{(k)} (t_{m-1}))\f]
+  ///
+  /// This function is linear in the coefficients. At a given time, only
+  /// the p + 1 basis functions of the active segment are nonzero: their
+  /// values are computed once for all the sampling times and stored
+  /// contiguously, so that the evaluation of each output is a dot
+  /// product of size p + 1, and each row of the Jacobian only has p + 1
+  /// nonzero elements.
+  template <typename T>
+  class Spline : public GenericLinearFunction<T>
+  {
+  public:
+    ROBOPTIM_TWICE_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_
+    (GenericLinearFunction<T>);
+
+    /// \brief Dense matrix storing the values of the basis functions.
+    typedef Eigen::Matrix<value_type, Eigen::Dynamic, Eigen::Dynamic>
+    basis_t;
+
+    /// \brief Build a spline sampled at fixed times.
+    ///
+    /// \param knots non-decreasing knot vector (size: n + degree + 1,
+    /// where n is the number of control coefficients)
+    /// \param degree degree of the spline
+    /// \param times sampling times
+    /// \param order derivative order of the samples (if 0 then the
+    /// spline is evaluated)
+    /// \throw std::runtime_error
+    Spline (const_vector_ref knots,
+	    size_type degree,
+	    const_vector_ref times,
+	    size_type order = 0);
+
+    virtual ~Spline ()
+    {}
+
+    /// \brief Knot vector.
+    const vector_t& knots () const
+    {
+      return knots_;
+    }
+
+    /// \brief Degree of the spline.
+    size_type degree () const
+    {
+      return degree_;
+    }
+
+    /// \brief Sampling times.
+    const vector_t& times () const
+    {
+      return times_;
+    }
+
+    /// \brief Derivative order of the samples.
+    size_type order () const
+    {
+      return order_;
+    }
+
+    /// \brief Find the segment containing a given time.
+    ///
+    /// The segment is found by a binary search on the knots. Times
+    /// outside of the definition interval belong to the first or the
+    /// last segment.
+    /// \param t time
+    /// \return index s of the segment \f$[u_s, u_{s+1}[\f$. The active
+    /// coefficients are \f$c_{s-p}, ..., c_s\f$.
+    size_type segment (value_type t) const;
+
+    /// \brief Evaluate the spline at several times.
+    ///
+    /// \param result derivatives, one per time (size: times.size ())
+    /// \param times times at which the spline is evaluated
+    /// \param coefficients control coefficients (size: inputSize ())
+    /// \param order derivative order (if 0 then the spline is evaluated)
+    void derivatives (vector_ref result,
+		      const_vector_ref times,
+		      const_argument_ref coefficients,
+		      size_type order = 0) const;
+
+    /// \brief Display the function on the specified output stream.
+    ///
+    /// \param o output stream used for display
+    /// \return output stream
+    virtual std::ostream& print (std::ostream& o) const;
+
+  protected:
+    void impl_compute (result_ref result, const_argument_ref x) const;
+
+    void impl_gradient (gradient_ref gradient, const_argument_ref x,
+			size_type functionId) const;
+
+    void impl_jacobian (jacobian_ref jacobian, const_argument_ref x)
+      const;
+
+    bool impl_compute_rows (result_ref result, const_argument_ref x,
+			    const indices_t& rows) const;
+
+    bool impl_jacobian_rows (jacobian_ref jacobian, const_argument_ref x,
+			     const indices_t& rows) const;
+
+    /// \brief Compute the derivatives of the nonzero basis functions.
+    ///
+    /// \param basis derivatives of \f$N_{s-p,p}, ..., N_{s,p}\f$
+    /// (size: degree + 1)
+    /// \param t time
+    /// \param s segment containing t
+    /// \param order derivative order
+    void basis (vector_ref basis, value_type t, size_type s,
+		size_type order) const;
+
+  private:
+    /// \brief Number of control coefficients.
+    /// \throw std::runtime_error if there are not enough knots.
+    static size_type coefficientsSize (const_vector_ref knots,
+				       size_type degree);
+
+    /// \brief Build the sparse Jacobian (sparse matrices only).
+    void initializeJacobian ();
+
+    /// \brief Knot vector.
+    vector_t knots_;
+    /// \brief Degree of the spline.
+    size_type degree_;
+    /// \brief Sampling times.
+    vector_t times_;
+    /// \brief Derivative order of the samples.
+    size_type order_;
+
+    /// \brief Values of the nonzero basis functions, one column per
+    /// sampling time (size: (degree + 1) x times.size ()).
+    basis_t basis_;
+    /// \brief First active coefficient for each sampling time.
+    indices_t first_;
+    /// \brief Constant Jacobian (sparse matrices only).
+    jacobian_t jacobian_;
+
+    /// \brief Buffers used to compute the basis functions.
+    mutable vector_t left_;
+    mutable vector_t right_;
+    mutable basis_t ndu_;
+    mutable basis_t a_;
+    mutable vector_t buffer_;
+  };
+
+  /// Example shows spline function use.
+  /// \example function-spline.cc
+
+  /// @}
+
+} // end of namespace roboptim
+
+# include <roboptim/core/function/spline.hxx>
+
+#endif //! ROBOPTIM_CORE_FUNCTION_SPLINE_HH
@@ -0,0 +1,330 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_FUNCTION_SPLINE_HXX
+# define ROBOPTIM_CORE_FUNCTION_SPLINE_HXX
+# include <algorithm>
+# include <cassert>
+# include <stdexcept>
+# include <utility>
+# include <vector>
+
+# include <boost/format.hpp>
+
+# include <roboptim/core/alloc.hh>
+# include <roboptim/core/indent.hh>
+# include <roboptim/core/util.hh>
+
+namespace roboptim
+{
+  template <typename T>
+  Spline<T>::Spline (const_vector_ref knots,
+		     size_type degree,
+		     const_vector_ref times,
+		     size_type order)
+    : GenericLinearFunction<T>
+      (coefficientsSize (knots, degree), times.size (), "spline"),
+      knots_ (knots),
+      degree_ (degree),
+      times_ (times),
+      order_ (order),
+      basis_ (degree + 1, times.size ()),
+      first_ (static_cast<std::size_t> (times.size ())),
+      jacobian_ (),
+      left_ (degree + 1),
+      right_ (degree + 1),
+      ndu_ (degree + 1, degree + 1),
+      a_ (2, degree + 1),
+      buffer_ (degree + 1)
+  {
+    const size_type n = this->inputSize ();
+
+    for (size_type i = 1; i < knots_.size (); ++i)
+      if (knots_[i] < knots_[i - 1])
+	throw std::runtime_error ("knots must be non-decreasing");
+
+    if (!(knots_[degree_] < knots_[n]))
+      throw std::runtime_error ("empty definition interval");
+
+    // Values of the basis functions at the sampling times.
+    for (size_type i = 0; i < times_.size (); ++i)
+      {
+	const size_type s = segment (times_[i]);
+	first_[static_cast<std::size_t> (i)] = s - degree_;
+	basis (basis_.col (i), times_[i], s, order_);
+      }
+
+    initializeJacobian ();
+  }
+
+  template <typename T>
+  typename Spline<T>::size_type
+  Spline<T>::coefficientsSize (const_vector_ref knots, size_type degree)
+  {
+    if (degree < 0)
+      throw std::runtime_error ("the degree must be nonnegative");
+
+    if (knots.size () < 2 * (degree + 1))
+      throw std::runtime_error
+	((boost::format ("not enough knots: expected at least %1%, got %2%")
+	  % (2 * (degree + 1)) % knots.size ()).str ());
+
+    return knots.size () - degree - 1;
+  }
+
+  template <>
+  inline void
+  Spline<EigenMatrixSparse>::initializeJacobian ()
+  {
+    typedef Eigen::Triplet<value_type> triplet_t;
+#if EIGEN_VERSION_AT_LEAST(3, 2, 90)
+    typedef jacobian_t::StorageIndex index_t;
+#else
+    typedef jacobian_t::Index index_t;
+#endif
+
+    std::vector<triplet_t> coefficients;
+    coefficients.reserve (static_cast<std::size_t> (basis_.size ()));
+    for (size_type i = 0; i < times_.size (); ++i)
+      for (size_type k = 0; k <= degree_; ++k)
+	if (basis_ (k, i) != 0.)
+	  coefficients.push_back
+	    (triplet_t (static_cast<index_t> (i),
+			static_cast<index_t>
+			(first_[static_cast<std::size_t> (i)] + k),
+			basis_ (k, i)));
+
+    jacobian_.resize (this->outputSize (), this->inputSize ());
+    jacobian_.setFromTriplets (coefficients.begin (), coefficients.end ());
+    jacobian_.makeCompressed ();
+  }
+
+  template <typename T>
+  void
+  Spline<T>::initializeJacobian ()
+  {
+  }
+
+  template <typename T>
+  typename Spline<T>::size_type
+  Spline<T>::segment (value_type t) const
+  {
+    const size_type n = this->inputSize ();
+    const value_type* u = knots_.data ();
+
+    // Last knot u_s <= t, with s in [p, n - 1].
+    return static_cast<size_type>
+      (std::upper_bound (u + degree_ + 1, u + n, t) - u) - 1;
+  }
+
+  // Derivatives of the nonzero basis functions, from "The NURBS Book"
+  // (Piegl and Tiller), algorithm A2.3.
+  template <typename T>
+  void
+  Spline<T>::basis (vector_ref basis, value_type t, size_type s,
+		    size_type order) const
+  {
+    const size_type p = degree_;
+
+    if (order > p)
+      {
+	basis.setZero ();
+	return;
+      }
+
+    // Basis functions and knot differences.
+    ndu_ (0, 0) = 1.;
+    for (size_type j = 1; j <= p; ++j)
+      {
+	left_[j] = t - knots_[s + 1 - j];
+	right_[j] = knots_[s + j] - t;
+	value_type saved = 0.;
+	for (size_type r = 0; r < j; ++r)
+	  {
+	    ndu_ (j, r) = right_[r + 1] + left_[j - r];
+	    const value_type tmp = ndu_ (r, j - 1) / ndu_ (j, r);
+	    ndu_ (r, j) = saved + right_[r + 1] * tmp;
+	    saved = left_[j - r] * tmp;
+	  }
+	ndu_ (j, j) = saved;
+      }
+
+    if (order == 0)
+      {
+	basis = ndu_.col (p);
+	return;
+      }
+
+    for (size_type r = 0; r <= p; ++r)
+      {
+	size_type s1 = 0;
+	size_type s2 = 1;
+	a_ (0, 0) = 1.;
+
+	value_type d = 0.;
+	for (size_type k = 1; k <= order; ++k)
+	  {
+	    d = 0.;
+	    const size_type rk = r - k;
+	    const size_type pk = p - k;
+	    if (r >= k)
+	      {
+		a_ (s2, 0) = a_ (s1, 0) / ndu_ (pk + 1, rk);
+		d = a_ (s2, 0) * ndu_ (rk, pk);
+	      }
+	    const size_type j1 = (rk >= -1) ? 1 : -rk;
+	    const size_type j2 = (r - 1 <= pk) ? k - 1 : p - r;
+	    for (size_type j = j1; j <= j2; ++j)
+	      {
+		a_ (s2, j) =
+		  (a_ (s1, j) - a_ (s1, j - 1)) / ndu_ (pk + 1, rk + j);
+		d += a_ (s2, j) * ndu_ (rk + j, pk);
+	      }
+	    if (r <= pk)
+	      {
+		a_ (s2, k) = -a_ (s1, k - 1) / ndu_ (pk + 1, r);
+		d += a_ (s2, k) * ndu_ (r, pk);
+	      }
+	    std::swap (s1, s2);
+	  }
+	basis[r] = d;
+      }
+
+    // Multiply by p! / (p - order)!.
+    value_type factor = 1.;
+    for (size_type k = p; k > p - order; --k)
+      factor *= static_cast<value_type> (k);
+    basis *= factor;
+  }
+
+  template <typename T>
+  void
+  Spline<T>::derivatives (vector_ref result,
+			  const_vector_ref times,
+			  const_argument_ref coefficients,
+			  size_type order) const
+  {
+    assert (result.size () == times.size ());
+    assert (coefficients.size () == this->inputSize ());
+
+    for (size_type i = 0; i < times.size (); ++i)
+      {
+	const size_type s = segment (times[i]);
+	basis (buffer_, times[i], s, order);
+	result[i] = buffer_.dot (coefficients.segment (s - degree_,
+						       degree_ + 1));
+      }
+  }
+
+  template <typename T>
+  void
+  Spline<T>::impl_compute (result_ref result, const_argument_ref x) const
+  {
+    for (size_type i = 0; i < times_.size (); ++i)
+      result[i] = basis_.col (i).dot
+	(x.segment (first_[static_cast<std::size_t> (i)], degree_ + 1));
+  }
+
+  template <typename T>
+  void
+  Spline<T>::impl_gradient (gradient_ref gradient, const_argument_ref,
+			    size_type functionId) const
+  {
+    const size_type first = first_[static_cast<std::size_t> (functionId)];
+    for (size_type k = 0; k <= degree_; ++k)
+      gradient.coeffRef (first + k) = basis_ (k, functionId);
+  }
+
+  template <>
+  inline void
+  Spline<EigenMatrixSparse>::impl_jacobian
+  (jacobian_ref jacobian, const_argument_ref) const
+  {
+    jacobian = jacobian_;
+  }
+
+  template <typename T>
+  void
+  Spline<T>::impl_jacobian (jacobian_ref jacobian, const_argument_ref)
+    const
+  {
+    for (size_type i = 0; i < times_.size (); ++i)
+      jacobian.row (i).segment (first_[static_cast<std::size_t> (i)],
+				degree_ + 1) = basis_.col (i).transpose ();
+  }
+
+  template <typename T>
+  bool
+  Spline<T>::impl_compute_rows (result_ref result, const_argument_ref x,
+				const indices_t& rows) const
+  {
+    for (std::size_t k = 0; k < rows.size (); ++k)
+      result[static_cast<size_type> (k)] = basis_.col (rows[k]).dot
+	(x.segment (first_[static_cast<std::size_t> (rows[k])],
+		    degree_ + 1));
+    return true;
+  }
+
+  template <typename T>
+  bool
+  Spline<T>::impl_jacobian_rows (jacobian_ref jacobian, const_argument_ref,
+				 const indices_t& rows) const
+  {
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    bool cur_malloc_allowed = is_malloc_allowed ();
+    set_is_malloc_allowed (true);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+    for (std::size_t k = 0; k < rows.size (); ++k)
+      {
+	const size_type first = first_[static_cast<std::size_t> (rows[k])];
+	for (size_type j = 0; j <= degree_; ++j)
+	  jacobian.coeffRef (static_cast<size_type> (k), first + j) =
+	    basis_ (j, rows[k]);
+      }
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    set_is_malloc_allowed (cur_malloc_allowed);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+    return true;
+  }
+
+  template <typename T>
+  std::ostream&
+  Spline<T>::print (std::ostream& o) const
+  {
+    o << "Spline function:" << incindent
+      << iendl << "Degree: " << degree_
+      << iendl << "Derivative order: " << order_
+      << iendl << "Knots: " << knots_.transpose ()
+      << iendl << "Times: " << times_.transpose ()
+      << decindent;
+    return o;
+  }
+
+// Explicit template instantiations for dense and sparse matrices.
+# ifdef ROBOPTIM_PRECOMPILED_DENSE_SPARSE
+  ROBOPTIM_ALLOW_ATTRIBUTES_ON
+  extern template class ROBOPTIM_CORE_DLLAPI Spline<EigenMatrixDense>;
+  extern template class ROBOPTIM_CORE_DLLAPI Spline<EigenMatrixSparse>;
+  ROBOPTIM_ALLOW_ATTRIBUTES_OFF
+# endif
+
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_FUNCTION_SPLINE_HXX
@@ -101,6 +101,13 @@ namespace roboptim
   typedef GenericNumericLinearFunction<EigenMatrixSparse>
   NumericLinearSparseFunction;
 
+  template <typename T>
+  class GenericMatrixFreeLinearFunction;
+  typedef GenericMatrixFreeLinearFunction<EigenMatrixDense>
+  MatrixFreeLinearFunction;
+  typedef GenericMatrixFreeLinearFunction<EigenMatrixSparse>
+  MatrixFreeLinearSparseFunction;
+
   template <typename T>
   class GenericNumericQuadraticFunction;
   typedef GenericNumericQuadraticFunction<EigenMatrixDense>
@@ -108,6 +115,13 @@ namespace roboptim
   typedef GenericNumericQuadraticFunction<EigenMatrixSparse>
   NumericQuadraticSparseFunction;
 
+  template <typename T>
+  class GenericLowRankQuadraticFunction;
+  typedef GenericLowRankQuadraticFunction<EigenMatrixDense>
+  LowRankQuadraticFunction;
+  typedef GenericLowRankQuadraticFunction<EigenMatrixSparse>
+  LowRankQuadraticSparseFunction;
+
   template <typename T>
   class GenericConstantFunction;
   typedef GenericConstantFunction<EigenMatrixDense> ConstantFunction;
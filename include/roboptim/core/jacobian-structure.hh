@@ -0,0 +1,203 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_JACOBIAN_STRUCTURE_HH
+# define ROBOPTIM_CORE_JACOBIAN_STRUCTURE_HH
+
+# include <iostream>
+# include <vector>
+
+# include <roboptim/core/fwd.hh>
+# include <roboptim/core/portability.hh>
+# include <roboptim/core/function.hh>
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_problem
+  /// @{
+
+  /// \brief Nonzero structure of a sparse Jacobian matrix.
+  ///
+  /// This class stores the row and column indices of the nonzeros of a
+  /// compressed sparse matrix, both in coordinate (COO) and compressed row
+  /// (CSR) layouts, so that solver plugins relying on index arrays (e.g.
+  /// triplet interfaces) can use them directly.
+  ///
+  /// COO indices follow the order of the values array of the matrix
+  /// (valuePtr ()), i.e. the k-th nonzero is located at
+  /// (cooRows ()[k], cooCols ()[k]). The values can then be used without
+  /// any copy.
+  ///
+  /// CSR index arrays are also provided. Since the values array follows
+  /// the storage order of the matrix (column-major by default), the CSR
+  /// values are obtained with csrPermutation (): the k-th CSR value is
+  /// valuePtr ()[csrPermutation ()[k]]. With a row-major storage order,
+  /// this permutation is the identity.
+  ///
+  /// All indices are 0-based.
+  class ROBOPTIM_CORE_DLLAPI JacobianStructure
+  {
+  public:
+    /// \brief Sparse matrix type.
+    typedef GenericFunctionTraits<EigenMatrixSparse>::matrix_t matrix_t;
+
+    /// \brief Value type.
+    typedef matrix_t::Scalar value_type;
+
+    /// \brief Index type used by the sparse matrix.
+#if EIGEN_VERSION_AT_LEAST(3, 2, 90)
+    typedef matrix_t::StorageIndex index_t;
+#else
+    typedef matrix_t::Index index_t;
+#endif
+
+    /// \brief Vector of indices.
+    typedef std::vector<index_t> indices_t;
+
+    /// \brief Build an empty structure.
+    JacobianStructure ();
+
+    /// \brief Update the index arrays from the pattern of a sparse matrix.
+    ///
+    /// \param m compressed sparse matrix.
+    void update (const matrix_t& m);
+
+    /// \brief Check whether a sparse matrix has exactly this structure.
+    ///
+    /// \param m sparse matrix.
+    /// \return true if m is compressed and has the same pattern.
+    bool matches (const matrix_t& m) const;
+
+    /// \brief Stack sparse row blocks into a sparse matrix, in place.
+    ///
+    /// The first call (or any call after a change of pattern) builds m
+    /// from the blocks, updates this structure and records the position of
+    /// each nonzero of the blocks in the values array of m. As long as the
+    /// same matrix is passed again and the patterns of the blocks do not
+    /// change, later calls copy the values directly into their slots,
+    /// without any allocation.
+    ///
+    /// \param m output matrix.
+    /// \param blocks compressed row blocks, stacked in this order.
+    /// \param cols number of columns of the output matrix.
+    void assemble (matrix_t& m, const std::vector<matrix_t>& blocks,
+		   index_t cols);
+
+    /// \brief Build a block-diagonal sparse matrix, in place.
+    ///
+    /// This is the same as assemble, except that each block also starts
+    /// at the column following the last column of the previous block.
+    ///
+    /// \param m output matrix.
+    /// \param blocks compressed diagonal blocks, in this order.
+    void assembleBlockDiagonal (matrix_t& m,
+				const std::vector<matrix_t>& blocks);
+
+    /// \brief Clear the structure.
+    void clear ();
+
+    /// \brief Whether the structure has been set.
+    bool empty () const;
+
+    /// \brief Number of rows of the matrix.
+    index_t rows () const;
+
+    /// \brief Number of columns of the matrix.
+    index_t cols () const;
+
+    /// \brief Number of nonzeros of the matrix.
+    index_t nonZeros () const;
+
+    /// \brief Row indices of the nonzeros (COO layout).
+    const indices_t& cooRows () const;
+
+    /// \brief Column indices of the nonzeros (COO layout).
+    const indices_t& cooCols () const;
+
+    /// \brief Row pointers (CSR layout, size rows () + 1).
+    const indices_t& csrRowPointers () const;
+
+    /// \brief Column indices of the nonzeros (CSR layout).
+    const indices_t& csrCols () const;
+
+    /// \brief Position in the values array of the matrix of each CSR
+    /// nonzero.
+    const indices_t& csrPermutation () const;
+
+    /// \brief Write the values of a matrix in CSR order.
+    ///
+    /// \param m sparse matrix with this structure.
+    /// \param values output array of size nonZeros ().
+    void csrValues (const matrix_t& m, value_type* values) const;
+
+    /// \brief Display the structure on the specified output stream.
+    ///
+    /// \param o output stream used for display
+    /// \return output stream
+    std::ostream& print (std::ostream& o) const;
+
+  private:
+    /// \brief Implementation of assemble and assembleBlockDiagonal.
+    ///
+    /// \param m output matrix.
+    /// \param blocks blocks, in this order.
+    /// \param cols number of columns of the output matrix.
+    /// \param diagonal whether the blocks are shifted along the columns.
+    void assembleBlocks (matrix_t& m, const std::vector<matrix_t>& blocks,
+			 index_t cols, bool diagonal);
+
+    /// \brief Number of rows.
+    index_t rows_;
+
+    /// \brief Number of columns.
+    index_t cols_;
+
+    /// \brief Outer index array, as stored in the matrix.
+    indices_t outer_;
+
+    /// \brief COO row indices.
+    indices_t cooRows_;
+
+    /// \brief COO column indices.
+    indices_t cooCols_;
+
+    /// \brief CSR row pointers.
+    indices_t csrRowPointers_;
+
+    /// \brief CSR column indices.
+    indices_t csrCols_;
+
+    /// \brief CSR to storage order permutation.
+    indices_t csrPermutation_;
+
+    /// \brief Position of the nonzeros of each block in the values array
+    /// (see assemble).
+    std::vector<indices_t> slots_;
+  };
+
+  /// @}
+
+  /// \brief Override operator<< to handle Jacobian structure display.
+  ///
+  /// \param o output stream used for display
+  /// \param s structure to be displayed
+  /// \return output stream
+  ROBOPTIM_CORE_DLLAPI std::ostream&
+  operator<< (std::ostream& o, const JacobianStructure& s);
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_JACOBIAN_STRUCTURE_HH
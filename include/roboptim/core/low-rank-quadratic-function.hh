@@ -0,0 +1,176 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_LOW_RANK_QUADRATIC_FUNCTION_HH
+# define ROBOPTIM_CORE_LOW_RANK_QUADRATIC_FUNCTION_HH
+
+# include <roboptim/core/sys.hh>
+# include <roboptim/core/debug.hh>
+# include <roboptim/core/portability.hh>
+
+# include <roboptim/core/quadratic-function.hh>
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_function
+  /// @{
+
+  /// \brief Quadratic function with a diagonal plus low-rank matrix.
+  ///
+  /// Implement a quadratic function using the formula:
+  /// \f[f(x) = x^t (D + U U^t) x + b^t x + c\f]
+  /// where \f$D\f$ is a diagonal matrix of size n and \f$U\f$ is a dense
+  /// n x k matrix, with k small compared to n.
+  ///
+  /// Only the diagonal of D and the matrix U are stored. The value, the
+  /// gradient and the products with the Hessian cost O(nk) operations,
+  /// by computing \f$U^t x\f$ first. The n x n Hessian is only built when
+  /// it is explicitly requested.
+  template <typename T>
+  class ROBOPTIM_GCC_ETI_WORKAROUND GenericLowRankQuadraticFunction
+  : public GenericQuadraticFunction<T>
+  {
+  public:
+    ROBOPTIM_TWICE_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_
+    (GenericQuadraticFunction<T>);
+
+    /// \brief Dense matrix type of the low-rank factor.
+    ROBOPTIM_GENERATE_TYPEDEFS_EIGEN_REF
+    (lowRank,
+     Eigen::Matrix<value_type BOOST_PP_COMMA()
+     Eigen::Dynamic BOOST_PP_COMMA()
+     Eigen::Dynamic>);
+
+    /// \brief Build a quadratic function from D, U and b.
+    ///
+    /// c here is omitted and set to zero.
+    ///
+    /// See class documentation for D, U and b definition.
+    /// \param d diagonal of D (size inputSize)
+    /// \param u low-rank factor U (inputSize * rank)
+    /// \param b b vector (size inputSize)
+    /// \param name function's name
+    GenericLowRankQuadraticFunction (const_vector_ref d,
+				     const_lowRank_ref u,
+				     const_vector_ref b,
+				     std::string name = std::string ());
+
+    /// \brief Build a quadratic function from D, U, b and c.
+    ///
+    /// See class documentation for D, U, b and c definition.
+    /// \param d diagonal of D (size inputSize)
+    /// \param u low-rank factor U (inputSize * rank)
+    /// \param b b vector (size inputSize)
+    /// \param c c vector (size one)
+    /// \param name function's name
+    GenericLowRankQuadraticFunction (const_vector_ref d,
+				     const_lowRank_ref u,
+				     const_vector_ref b,
+				     const_vector_ref c,
+				     std::string name = std::string ());
+
+    ~GenericLowRankQuadraticFunction ();
+
+    /// \brief Display the function on the specified output stream.
+    ///
+    /// \param o output stream used for display
+    /// \return output stream
+    virtual std::ostream& print (std::ostream&) const;
+
+    const vector_t& D () const
+    {
+      return d_;
+    }
+
+    const lowRank_t& U () const
+    {
+      return u_;
+    }
+
+    const vector_t& b () const
+    {
+      return b_;
+    }
+
+    const vector_t& c () const
+    {
+      return c_;
+    }
+
+    /// \brief Rank of the low-rank term, i.e. number of columns of U.
+    size_type rank () const
+    {
+      return u_.cols ();
+    }
+
+    /// \brief Compute the value and the gradient of the function.
+    ///
+    /// The product \f$(D + U U^t) x\f$ is only computed once for both
+    /// outputs.
+    /// \param result value of the function (size: 1)
+    /// \param gradient gradient of the function (size: inputSize ())
+    /// \param argument point at which the function is evaluated
+    void computeWithGradient (result_ref result, gradient_ref gradient,
+			      const_argument_ref argument) const;
+
+    /// \brief Compute the product of the Hessian with a vector.
+    ///
+    /// The Hessian \f$2 (D + U U^t)\f$ is not built: the product costs
+    /// O(nk) operations.
+    /// \param result Hessian-vector product (size: inputSize ())
+    /// \param v vector (size: inputSize ())
+    void hessianProduct (vector_ref result, const_vector_ref v) const;
+
+  protected:
+    void impl_compute (result_ref, const_argument_ref) const;
+    void impl_gradient (gradient_ref, const_argument_ref, size_type = 0)
+      const;
+    void impl_jacobian (jacobian_ref, const_argument_ref) const;
+    void impl_hessian (hessian_ref hessian,
+		       const_argument_ref argument,
+		       size_type functionId = 0) const;
+  private:
+    /// \brief Check the sizes of D, U, b and c.
+    void checkSizes () const;
+
+    /// \brief Compute U^t * x in lowRankBuffer_ and (D + U U^t) * x in
+    /// buffer_.
+    void product (const_vector_ref x) const;
+
+    /// \brief Write 2 * buffer_ + b in the gradient.
+    void gradientFromProduct (gradient_ref gradient) const;
+
+    /// \brief Diagonal of D.
+    vector_t d_;
+    /// \brief Low-rank factor U.
+    lowRank_t u_;
+    /// \brief B vector.
+    vector_t b_;
+    /// \brief C vector.
+    vector_t c_;
+    /// \brief buffer storing (D + U U^t) * x.
+    mutable vector_t buffer_;
+    /// \brief buffer storing U^t * x.
+    mutable vector_t lowRankBuffer_;
+  };
+
+  /// @}
+
+} // end of namespace roboptim
+
+# include <roboptim/core/low-rank-quadratic-function.hxx>
+#endif //! ROBOPTIM_CORE_LOW_RANK_QUADRATIC_FUNCTION_HH
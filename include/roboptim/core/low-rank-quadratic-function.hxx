@@ -0,0 +1,273 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_LOW_RANK_QUADRATIC_FUNCTION_HXX
+# define ROBOPTIM_CORE_LOW_RANK_QUADRATIC_FUNCTION_HXX
+
+# include <cassert>
+# include <vector>
+
+# include <roboptim/core/alloc.hh>
+# include <roboptim/core/debug.hh>
+# include <roboptim/core/indent.hh>
+# include <roboptim/core/util.hh>
+# include <roboptim/core/portability.hh>
+
+namespace roboptim
+{
+  template <typename T>
+  GenericLowRankQuadraticFunction<T>::GenericLowRankQuadraticFunction
+  (const_vector_ref d, const_lowRank_ref u, const_vector_ref b,
+   std::string name)
+    : GenericQuadraticFunction<T> (d.size (), 1, name),
+    d_ (d),
+    u_ (u),
+    b_ (b),
+    c_ (1),
+    buffer_ (d.size ()),
+    lowRankBuffer_ (u.cols ())
+  {
+    c_.setZero ();
+    checkSizes ();
+  }
+
+  template <typename T>
+  GenericLowRankQuadraticFunction<T>::GenericLowRankQuadraticFunction
+  (const_vector_ref d, const_lowRank_ref u, const_vector_ref b,
+   const_vector_ref c, std::string name)
+    : GenericQuadraticFunction<T> (d.size (), 1, name),
+    d_ (d),
+    u_ (u),
+    b_ (b),
+    c_ (c),
+    buffer_ (d.size ()),
+    lowRankBuffer_ (u.cols ())
+  {
+    checkSizes ();
+  }
+
+  template <typename T>
+  GenericLowRankQuadraticFunction<T>::~GenericLowRankQuadraticFunction ()
+  {
+  }
+
+  template <typename T>
+  void
+  GenericLowRankQuadraticFunction<T>::checkSizes () const
+  {
+    ROBOPTIM_ASSERT_MSG (u_.rows () == this->inputSize (),
+                         "invalid number of rows for U: " << u_.rows ()
+                         << " != " << this->inputSize ());
+    ROBOPTIM_ASSERT_MSG (b_.size () == this->inputSize (),
+                         "invalid size for b: " << b_.size ()
+                         << " != " << this->inputSize ());
+    ROBOPTIM_ASSERT_MSG (c_.size () == 1,
+                         "invalid size for c: " << c_.size () << " != 1");
+  }
+
+  // U^T * x and D * x + U * U^T * x
+  template <typename T>
+  void
+  GenericLowRankQuadraticFunction<T>::product (const_vector_ref x) const
+  {
+    lowRankBuffer_.noalias () = u_.transpose () * x;
+    buffer_ = d_.cwiseProduct (x);
+    buffer_.noalias () += u_ * lowRankBuffer_;
+  }
+
+  // 2 * (D + U * U^T) * x + b - sparse specialization
+  template <>
+  inline void
+  GenericLowRankQuadraticFunction<EigenMatrixSparse>::gradientFromProduct
+  (gradient_ref gradient) const
+  {
+    for (size_type j = 0; j < this->inputSize (); ++j)
+      gradient.coeffRef (j) = 2. * buffer_[j] + b_[j];
+  }
+
+  // 2 * (D + U * U^T) * x + b
+  template <typename T>
+  void
+  GenericLowRankQuadraticFunction<T>::gradientFromProduct
+  (gradient_ref gradient) const
+  {
+    gradient = 2. * buffer_.transpose () + b_.transpose ();
+  }
+
+  // x^T * D * x + |U^T * x|^2 + b^T * x + c
+  template <typename T>
+  void
+  GenericLowRankQuadraticFunction<T>::impl_compute
+  (result_ref result, const_argument_ref argument) const
+  {
+    lowRankBuffer_.noalias () = u_.transpose () * argument;
+    result[0] = (d_.array () * argument.array ().square ()).sum ()
+      + lowRankBuffer_.squaredNorm () + b_.dot (argument) + c_[0];
+  }
+
+  // 2 * x^T * (D + U * U^T) + b^T - sparse specialization
+  template <>
+  inline void
+  GenericLowRankQuadraticFunction<EigenMatrixSparse>::impl_jacobian
+  (jacobian_ref jacobian, const_argument_ref x) const
+  {
+    product (x);
+    for (size_type i = 0; i < this->inputSize (); ++i)
+      jacobian.coeffRef (0, i) = 2. * buffer_[i] + b_[i];
+  }
+
+  // 2 * x^T * (D + U * U^T) + b^T
+  template <typename T>
+  void
+  GenericLowRankQuadraticFunction<T>::impl_jacobian
+  (jacobian_ref jacobian, const_argument_ref x) const
+  {
+    product (x);
+    jacobian.row (0) = 2. * buffer_.transpose () + b_.transpose ();
+  }
+
+  // 2 * (D + U * U^T) * x + b
+  template <typename T>
+  void
+  GenericLowRankQuadraticFunction<T>::impl_gradient
+  (gradient_ref gradient, const_argument_ref x, size_type) const
+  {
+    product (x);
+    gradientFromProduct (gradient);
+  }
+
+  template <typename T>
+  void
+  GenericLowRankQuadraticFunction<T>::computeWithGradient
+  (result_ref result, gradient_ref gradient, const_argument_ref argument)
+    const
+  {
+    assert (result.size () == 1);
+    assert (gradient.size () == this->inputSize ());
+
+    product (argument);
+    result[0] = argument.dot (buffer_) + b_.dot (argument) + c_[0];
+    gradientFromProduct (gradient);
+  }
+
+  // 2 * (D + U * U^T) * v
+  template <typename T>
+  void
+  GenericLowRankQuadraticFunction<T>::hessianProduct
+  (vector_ref result, const_vector_ref v) const
+  {
+    assert (result.size () == this->inputSize ());
+    assert (v.size () == this->inputSize ());
+
+    product (v);
+    result = 2. * buffer_;
+  }
+
+  // 2 * (D + U * U^T) - sparse specialization
+  template <>
+  inline void
+  GenericLowRankQuadraticFunction<EigenMatrixSparse>::impl_hessian
+  (hessian_ref hessian, const_argument_ref, size_type) const
+  {
+    typedef Eigen::Triplet<value_type> triplet_t;
+#if EIGEN_VERSION_AT_LEAST(3, 2, 90)
+    typedef matrix_t::StorageIndex index_t;
+#else
+    typedef matrix_t::Index index_t;
+#endif
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    bool cur_malloc_allowed = is_malloc_allowed ();
+    set_is_malloc_allowed (true);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+    // U * U^T only couples the nonzero rows of U: the Hessian is built
+    // from these rows and D, without any n x n temporary.
+    std::vector<size_type> rows;
+    for (size_type i = 0; i < u_.rows (); ++i)
+      if (!u_.row (i).isZero (0.))
+	rows.push_back (i);
+
+    std::vector<triplet_t> coefficients;
+    coefficients.reserve (rows.size () * rows.size ()
+			  + static_cast<std::size_t> (d_.size ()));
+    for (size_type i = 0; i < d_.size (); ++i)
+      if (d_[i] != 0.)
+	coefficients.push_back
+	  (triplet_t (static_cast<index_t> (i), static_cast<index_t> (i),
+		      2. * d_[i]));
+    for (std::size_t k = 0; k < rows.size (); ++k)
+      for (std::size_t l = k; l < rows.size (); ++l)
+	{
+	  const value_type v = 2. * u_.row (rows[k]).dot (u_.row (rows[l]));
+	  const index_t i = static_cast<index_t> (rows[k]);
+	  const index_t j = static_cast<index_t> (rows[l]);
+	  coefficients.push_back (triplet_t (i, j, v));
+	  if (i != j)
+	    coefficients.push_back (triplet_t (j, i, v));
+	}
+
+    hessian.resize (this->inputSize (), this->inputSize ());
+    hessian.setFromTriplets (coefficients.begin (), coefficients.end ());
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    set_is_malloc_allowed (cur_malloc_allowed);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+  }
+
+  // 2 * (D + U * U^T)
+  template <typename T>
+  void
+  GenericLowRankQuadraticFunction<T>::impl_hessian
+  (hessian_ref hessian, const_argument_ref, size_type) const
+  {
+    hessian.noalias () = 2. * u_ * u_.transpose ();
+    hessian.diagonal () += 2. * d_;
+  }
+
+  template <typename T>
+  std::ostream&
+  GenericLowRankQuadraticFunction<T>::print (std::ostream& o) const
+  {
+    if (this->getName ().empty ())
+      o << "Low-rank quadratic function";
+    else
+      o << this->getName () << " (low-rank quadratic function)";
+
+    o  << ":" << incindent << iendl
+       << "D = " << this->d_.transpose () << iendl
+       << "U = " << this->u_ << iendl
+       << "B = " << this->b_.transpose () << iendl
+       << "c = " << this->c_
+       << decindent;
+
+    return o;
+  }
+
+// Explicit template instantiations for dense and sparse matrices.
+# ifdef ROBOPTIM_PRECOMPILED_DENSE_SPARSE
+  ROBOPTIM_ALLOW_ATTRIBUTES_ON
+  extern template class ROBOPTIM_CORE_DLLAPI
+    GenericLowRankQuadraticFunction<EigenMatrixDense>;
+  extern template class ROBOPTIM_CORE_DLLAPI
+    GenericLowRankQuadraticFunction<EigenMatrixSparse>;
+  ROBOPTIM_ALLOW_ATTRIBUTES_OFF
+# endif //! ROBOPTIM_PRECOMPILED_DENSE_SPARSE
+
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_LOW_RANK_QUADRATIC_FUNCTION_HXX
@@ -0,0 +1,178 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_MATRIX_FREE_LINEAR_FUNCTION_HH
+# define ROBOPTIM_CORE_MATRIX_FREE_LINEAR_FUNCTION_HH
+
+# include <boost/function.hpp>
+
+# include <roboptim/core/sys.hh>
+# include <roboptim/core/debug.hh>
+# include <roboptim/core/portability.hh>
+
+# include <roboptim/core/linear-function.hh>
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_function
+  /// @{
+
+  /// \brief Linear function defined by products with a matrix.
+  ///
+  /// Implement a linear function using the general formula:
+  /// \f[f(x) = A x + b\f]
+  /// where \f$A\f$ is never stored: it is only known through two
+  /// callbacks computing \f$A v\f$ and \f$A^t w\f$. This suits structured
+  /// operators (stencils, convolutions, Kronecker products) whose matrix
+  /// is large or dense while the products are cheap.
+  ///
+  /// Jacobian-vector and vector-Jacobian products directly call the
+  /// callbacks. Gradients and Jacobian rows use \f$A^t e_i\f$, and
+  /// Jacobian columns use \f$A e_j\f$. The full Jacobian is built on
+  /// request with min(m, n) products, and can be kept for later calls.
+  /// In particular, Problem::finalize does not precompute the Jacobian of
+  /// matrix-free constraints.
+  template <typename T>
+  class ROBOPTIM_GCC_ETI_WORKAROUND GenericMatrixFreeLinearFunction
+  : public GenericLinearFunction<T>
+  {
+  public:
+    ROBOPTIM_TWICE_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_
+    (GenericLinearFunction<T>);
+    ROBOPTIM_ADD_FLAG(ROBOPTIM_IS_MATRIX_FREE);
+
+    /// \brief Matrix-vector product callback.
+    ///
+    /// The first argument is the result of the product, and the second
+    /// argument is the vector multiplied by the matrix.
+    typedef boost::function<void (vector_ref, const_vector_ref)> product_t;
+
+    /// \brief Build a linear function from matrix-vector products.
+    ///
+    /// See class documentation for A and b definition.
+    /// \param inputSize number of columns of A
+    /// \param apply callback computing A v (size: b.size ())
+    /// \param applyTranspose callback computing A^T w (size: inputSize)
+    /// \param b b vector
+    /// \param name function's name
+    /// \throw std::runtime_error if a callback is empty
+    GenericMatrixFreeLinearFunction (size_type inputSize,
+				     const product_t& apply,
+				     const product_t& applyTranspose,
+				     const_vector_ref b,
+				     std::string name = std::string ());
+
+    ~GenericMatrixFreeLinearFunction ();
+
+    /// \brief Display the function on the specified output stream.
+    ///
+    /// \param o output stream used for display
+    /// \return output stream
+    virtual std::ostream& print (std::ostream&) const;
+
+    const vector_t& b () const
+    {
+      return b_;
+    }
+
+    vector_t& b ()
+    {
+      return b_;
+    }
+
+    /// \brief Whether the Jacobian is kept after it has been built.
+    ///
+    /// Disabled by default.
+    bool& cacheJacobian ()
+    {
+      return cacheJacobian_;
+    }
+
+    /// \brief Discard the cached Jacobian.
+    ///
+    /// This has to be called if the operator changes.
+    void resetJacobian () const
+    {
+      jacobianCached_ = false;
+    }
+
+    /// \brief Compute the product of the Jacobian with a vector.
+    ///
+    /// \param result A v (size: outputSize ())
+    /// \param v vector (size: inputSize ())
+    void jacobianProduct (vector_ref result, const_vector_ref v) const;
+
+    /// \brief Compute the product of the transposed Jacobian with a
+    /// vector.
+    ///
+    /// \param result A^T w (size: inputSize ())
+    /// \param w vector (size: outputSize ())
+    void jacobianTransposeProduct (vector_ref result, const_vector_ref w)
+      const;
+
+  protected:
+    void impl_compute (result_ref, const_argument_ref) const;
+    void impl_gradient (gradient_ref, const_argument_ref, size_type = 0)
+      const;
+    void impl_jacobian (jacobian_ref, const_argument_ref) const;
+
+    bool impl_jacobian_rows (jacobian_ref, const_argument_ref,
+			     const indices_t&) const;
+    bool impl_jacobian_columns (jacobian_ref, const_argument_ref,
+				const indices_t&) const;
+
+  private:
+    /// \brief Compute the column j of A in outputBuffer_.
+    void column (size_type j) const;
+
+    /// \brief Compute the row i of A in inputBuffer_.
+    void row (size_type i) const;
+
+    /// \brief Build the whole Jacobian, row by row if there are fewer
+    /// outputs than inputs, column by column otherwise.
+    void materialize (jacobian_ref jacobian) const;
+
+    /// \brief Callback computing A v.
+    product_t apply_;
+    /// \brief Callback computing A^T w.
+    product_t applyTranspose_;
+    /// \brief B vector.
+    vector_t b_;
+
+    /// \brief Whether the Jacobian is kept after it has been built.
+    bool cacheJacobian_;
+    /// \brief Whether jacobian_ holds the Jacobian.
+    mutable bool jacobianCached_;
+    /// \brief Cached Jacobian.
+    mutable jacobian_t jacobian_;
+
+    /// \brief Unit vector of the input space.
+    mutable vector_t inputUnit_;
+    /// \brief Unit vector of the output space.
+    mutable vector_t outputUnit_;
+    /// \brief buffer storing a row of A.
+    mutable vector_t inputBuffer_;
+    /// \brief buffer storing a column of A.
+    mutable vector_t outputBuffer_;
+  };
+
+  /// @}
+
+} // end of namespace roboptim
+
+# include <roboptim/core/matrix-free-linear-function.hxx>
+#endif //! ROBOPTIM_CORE_MATRIX_FREE_LINEAR_FUNCTION_HH
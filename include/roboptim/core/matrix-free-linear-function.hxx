@@ -0,0 +1,372 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_MATRIX_FREE_LINEAR_FUNCTION_HXX
+# define ROBOPTIM_CORE_MATRIX_FREE_LINEAR_FUNCTION_HXX
+
+# include <cassert>
+# include <stdexcept>
+# include <vector>
+
+# include <roboptim/core/alloc.hh>
+# include <roboptim/core/debug.hh>
+# include <roboptim/core/indent.hh>
+# include <roboptim/core/util.hh>
+# include <roboptim/core/portability.hh>
+
+namespace roboptim
+{
+  template <typename T>
+  GenericMatrixFreeLinearFunction<T>::GenericMatrixFreeLinearFunction
+  (size_type inputSize, const product_t& apply,
+   const product_t& applyTranspose, const_vector_ref b, std::string name)
+    : GenericLinearFunction<T> (inputSize, b.size (), name),
+    apply_ (apply),
+    applyTranspose_ (applyTranspose),
+    b_ (b),
+    cacheJacobian_ (false),
+    jacobianCached_ (false),
+    jacobian_ (),
+    inputUnit_ (inputSize),
+    outputUnit_ (b.size ()),
+    inputBuffer_ (inputSize),
+    outputBuffer_ (b.size ())
+  {
+    if (apply_.empty () || applyTranspose_.empty ())
+      throw std::runtime_error ("matrix-free linear function requires both"
+				" A v and A^T w products");
+
+    inputUnit_.setZero ();
+    outputUnit_.setZero ();
+  }
+
+  template <typename T>
+  GenericMatrixFreeLinearFunction<T>::~GenericMatrixFreeLinearFunction ()
+  {
+  }
+
+  // A * v
+  template <typename T>
+  void
+  GenericMatrixFreeLinearFunction<T>::jacobianProduct
+  (vector_ref result, const_vector_ref v) const
+  {
+    assert (result.size () == this->outputSize ());
+    assert (v.size () == this->inputSize ());
+
+    apply_ (result, v);
+  }
+
+  // A^T * w
+  template <typename T>
+  void
+  GenericMatrixFreeLinearFunction<T>::jacobianTransposeProduct
+  (vector_ref result, const_vector_ref w) const
+  {
+    assert (result.size () == this->inputSize ());
+    assert (w.size () == this->outputSize ());
+
+    applyTranspose_ (result, w);
+  }
+
+  // A * e_j
+  template <typename T>
+  void
+  GenericMatrixFreeLinearFunction<T>::column (size_type j) const
+  {
+    inputUnit_[j] = 1.;
+    apply_ (outputBuffer_, inputUnit_);
+    inputUnit_[j] = 0.;
+  }
+
+  // A^T * e_i
+  template <typename T>
+  void
+  GenericMatrixFreeLinearFunction<T>::row (size_type i) const
+  {
+    outputUnit_[i] = 1.;
+    applyTranspose_ (inputBuffer_, outputUnit_);
+    outputUnit_[i] = 0.;
+  }
+
+  // A * x + b
+  template <typename T>
+  void
+  GenericMatrixFreeLinearFunction<T>::impl_compute
+  (result_ref result, const_argument_ref argument) const
+  {
+    apply_ (result, argument);
+    result += b_;
+  }
+
+  // A - sparse specialization
+  template <>
+  inline void
+  GenericMatrixFreeLinearFunction<EigenMatrixSparse>::materialize
+  (jacobian_ref jacobian) const
+  {
+    typedef Eigen::Triplet<value_type> triplet_t;
+#if EIGEN_VERSION_AT_LEAST(3, 2, 90)
+    typedef jacobian_t::StorageIndex index_t;
+#else
+    typedef jacobian_t::Index index_t;
+#endif
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    bool cur_malloc_allowed = is_malloc_allowed ();
+    set_is_malloc_allowed (true);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+    std::vector<triplet_t> coefficients;
+    if (this->outputSize () < this->inputSize ())
+      for (size_type i = 0; i < this->outputSize (); ++i)
+	{
+	  row (i);
+	  for (size_type j = 0; j < this->inputSize (); ++j)
+	    if (inputBuffer_[j] != 0.)
+	      coefficients.push_back
+		(triplet_t (static_cast<index_t> (i),
+			    static_cast<index_t> (j), inputBuffer_[j]));
+	}
+    else
+      for (size_type j = 0; j < this->inputSize (); ++j)
+	{
+	  column (j);
+	  for (size_type i = 0; i < this->outputSize (); ++i)
+	    if (outputBuffer_[i] != 0.)
+	      coefficients.push_back
+		(triplet_t (static_cast<index_t> (i),
+			    static_cast<index_t> (j), outputBuffer_[i]));
+	}
+    jacobian.setFromTriplets (coefficients.begin (), coefficients.end ());
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    set_is_malloc_allowed (cur_malloc_allowed);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+  }
+
+  // A
+  template <typename T>
+  void
+  GenericMatrixFreeLinearFunction<T>::materialize (jacobian_ref jacobian)
+    const
+  {
+    if (this->outputSize () < this->inputSize ())
+      for (size_type i = 0; i < this->outputSize (); ++i)
+	{
+	  row (i);
+	  jacobian.row (i) = inputBuffer_.transpose ();
+	}
+    else
+      for (size_type j = 0; j < this->inputSize (); ++j)
+	{
+	  column (j);
+	  jacobian.col (j) = outputBuffer_;
+	}
+  }
+
+  // A
+  template <typename T>
+  void
+  GenericMatrixFreeLinearFunction<T>::impl_jacobian
+  (jacobian_ref jacobian, const_argument_ref) const
+  {
+    if (!cacheJacobian_)
+      {
+	materialize (jacobian);
+	return;
+      }
+
+    if (!jacobianCached_)
+      {
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+	bool cur_malloc_allowed = is_malloc_allowed ();
+	set_is_malloc_allowed (true);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+	jacobian_.resize (this->outputSize (), this->inputSize ());
+	jacobian_.setZero ();
+	materialize (jacobian_);
+	jacobianCached_ = true;
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+	set_is_malloc_allowed (cur_malloc_allowed);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+      }
+
+    jacobian = jacobian_;
+  }
+
+  // A(i) - sparse specialization
+  template <>
+  inline void
+  GenericMatrixFreeLinearFunction<EigenMatrixSparse>::impl_gradient
+  (gradient_ref gradient, const_argument_ref, size_type idFunction)
+    const
+  {
+    row (idFunction);
+    for (size_type j = 0; j < this->inputSize (); ++j)
+      if (inputBuffer_[j] != 0.)
+	gradient.coeffRef (j) = inputBuffer_[j];
+  }
+
+  // A(i)
+  template <typename T>
+  void
+  GenericMatrixFreeLinearFunction<T>::impl_gradient
+  (gradient_ref gradient, const_argument_ref, size_type idFunction) const
+  {
+    row (idFunction);
+    gradient = inputBuffer_.transpose ();
+  }
+
+  // A(rows) - sparse specialization
+  template <>
+  inline bool
+  GenericMatrixFreeLinearFunction<EigenMatrixSparse>::impl_jacobian_rows
+  (jacobian_ref jacobian, const_argument_ref, const indices_t& rows)
+    const
+  {
+    typedef Eigen::Triplet<value_type> triplet_t;
+#if EIGEN_VERSION_AT_LEAST(3, 2, 90)
+    typedef jacobian_t::StorageIndex index_t;
+#else
+    typedef jacobian_t::Index index_t;
+#endif
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    bool cur_malloc_allowed = is_malloc_allowed ();
+    set_is_malloc_allowed (true);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+    std::vector<triplet_t> coefficients;
+    for (std::size_t k = 0; k < rows.size (); ++k)
+      {
+	row (rows[k]);
+	for (size_type j = 0; j < this->inputSize (); ++j)
+	  if (inputBuffer_[j] != 0.)
+	    coefficients.push_back
+	      (triplet_t (static_cast<index_t> (k),
+			  static_cast<index_t> (j), inputBuffer_[j]));
+      }
+    jacobian.setFromTriplets (coefficients.begin (), coefficients.end ());
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    set_is_malloc_allowed (cur_malloc_allowed);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+    return true;
+  }
+
+  // A(rows)
+  template <typename T>
+  bool
+  GenericMatrixFreeLinearFunction<T>::impl_jacobian_rows
+  (jacobian_ref jacobian, const_argument_ref, const indices_t& rows)
+    const
+  {
+    for (std::size_t k = 0; k < rows.size (); ++k)
+      {
+	row (rows[k]);
+	jacobian.row (static_cast<size_type> (k)) = inputBuffer_.transpose ();
+      }
+    return true;
+  }
+
+  // A(:, columns) - sparse specialization
+  template <>
+  inline bool
+  GenericMatrixFreeLinearFunction<EigenMatrixSparse>::impl_jacobian_columns
+  (jacobian_ref jacobian, const_argument_ref, const indices_t& columns)
+    const
+  {
+    typedef Eigen::Triplet<value_type> triplet_t;
+#if EIGEN_VERSION_AT_LEAST(3, 2, 90)
+    typedef jacobian_t::StorageIndex index_t;
+#else
+    typedef jacobian_t::Index index_t;
+#endif
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    bool cur_malloc_allowed = is_malloc_allowed ();
+    set_is_malloc_allowed (true);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+    std::vector<triplet_t> coefficients;
+    for (std::size_t k = 0; k < columns.size (); ++k)
+      {
+	column (columns[k]);
+	for (size_type i = 0; i < this->outputSize (); ++i)
+	  if (outputBuffer_[i] != 0.)
+	    coefficients.push_back
+	      (triplet_t (static_cast<index_t> (i),
+			  static_cast<index_t> (k), outputBuffer_[i]));
+      }
+    jacobian.setFromTriplets (coefficients.begin (), coefficients.end ());
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    set_is_malloc_allowed (cur_malloc_allowed);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+    return true;
+  }
+
+  // A(:, columns)
+  template <typename T>
+  bool
+  GenericMatrixFreeLinearFunction<T>::impl_jacobian_columns
+  (jacobian_ref jacobian, const_argument_ref, const indices_t& columns)
+    const
+  {
+    for (std::size_t k = 0; k < columns.size (); ++k)
+      {
+	column (columns[k]);
+	jacobian.col (static_cast<size_type> (k)) = outputBuffer_;
+      }
+    return true;
+  }
+
+  template <typename T>
+  std::ostream&
+  GenericMatrixFreeLinearFunction<T>::print (std::ostream& o) const
+  {
+    if (this->getName ().empty ())
+      o << "Matrix-free linear function";
+    else
+      o << this->getName () << " (matrix-free linear function)";
+
+    o  << ":" << incindent << iendl
+       << "B = " << toDense (this->b_) << iendl
+       << "Cached Jacobian: " << (jacobianCached_ ? "yes" : "no")
+       << decindent;
+
+    return o;
+  }
+
+// Explicit template instantiations for dense and sparse matrices.
+# ifdef ROBOPTIM_PRECOMPILED_DENSE_SPARSE
+  ROBOPTIM_ALLOW_ATTRIBUTES_ON
+  extern template class ROBOPTIM_CORE_DLLAPI
+    GenericMatrixFreeLinearFunction<EigenMatrixDense>;
+  extern template class ROBOPTIM_CORE_DLLAPI
+    GenericMatrixFreeLinearFunction<EigenMatrixSparse>;
+  ROBOPTIM_ALLOW_ATTRIBUTES_OFF
+# endif //! ROBOPTIM_PRECOMPILED_DENSE_SPARSE
+
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_MATRIX_FREE_LINEAR_FUNCTION_HXX
@@ -0,0 +1,75 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_MPS_HH
+# define ROBOPTIM_CORE_MPS_HH
+
+# include <iosfwd>
+# include <string>
+
+# include <boost/shared_ptr.hpp>
+
+# include <roboptim/core/fwd.hh>
+# include <roboptim/core/portability.hh>
+# include <roboptim/core/function.hh>
+# include <roboptim/core/problem.hh>
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_problem
+  /// @{
+
+  /// \brief Sparse problem type read from MPS/QPS files.
+  typedef Problem<EigenMatrixSparse> mpsProblem_t;
+
+  /// \brief Read a linear or quadratic program in MPS/QPS format.
+  ///
+  /// Both fixed and free MPS are supported, as long as names do not
+  /// contain spaces. The following sections are read: NAME, OBJSENSE,
+  /// ROWS, COLUMNS, RHS, RANGES, BOUNDS, QUADOBJ (lower triangle of the
+  /// Hessian) and QMATRIX (full Hessian). Integrality markers are ignored.
+  ///
+  /// The input is read line by line, and matrices are assembled once from
+  /// their triplets. The resulting problem has:
+  ///   - a numeric linear cost (LP) or a numeric quadratic cost (QP),
+  ///     \f$\frac{1}{2} x^T Q x + c^T x + c_0\f$, negated for
+  ///     maximization problems,
+  ///   - a single numeric linear constraint \f$A x\f$ gathering all the
+  ///     rows, with their bounds (if there is at least one row),
+  ///   - the column bounds as argument bounds, and the column names as
+  ///     argument names.
+  ///
+  /// \param in input stream.
+  /// \param name name of the problem if the input does not provide one.
+  /// \return problem.
+  /// \throw std::runtime_error if the input is invalid or unsupported.
+  ROBOPTIM_CORE_DLLAPI boost::shared_ptr<mpsProblem_t>
+  readMps (std::istream& in, const std::string& name = std::string ());
+
+  /// \brief Read a linear or quadratic program from an MPS/QPS file.
+  ///
+  /// \param filename path of the file.
+  /// \return problem.
+  /// \throw std::runtime_error if the file cannot be read or is invalid.
+  /// \see readMps (std::istream&, const std::string&)
+  ROBOPTIM_CORE_DLLAPI boost::shared_ptr<mpsProblem_t>
+  readMps (const std::string& filename);
+
+  /// @}
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_MPS_HH
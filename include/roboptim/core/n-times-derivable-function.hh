@@ -151,6 +151,25 @@ namespace roboptim
     }
 
 
+    /// \brief Compute the derivatives of the function at several points.
+    ///
+    /// Column i of the result is the derivative of the given order at
+    /// times[i]. This is equivalent to calling #derivative for each
+    /// point, but concrete classes can evaluate all the points at once.
+    /// \param result derivatives will be stored in this matrix
+    /// (size: derivativeSize () x times.size ())
+    /// \param times points at which the derivatives will be computed
+    /// \param order derivative order (if 0 then function is evaluated)
+    void derivatives (matrix_ref result,
+		      const_vector_ref times,
+		      size_type order = 0) const
+    {
+      assert (order <= derivabilityOrderMax ());
+      assert (result.rows () == derivativeSize ());
+      assert (result.cols () == times.size ());
+      this->impl_derivatives (result, times, order);
+    }
+
     /// \brief Display the function on the specified output stream.
     ///
     /// \param o output stream used for display
@@ -168,8 +187,11 @@ namespace roboptim
     /// \param name function's name
     NTimesDerivableFunction (size_type outputSize = 1,
 			     std::string name = std::string ())
-      : TwiceDifferentiableFunction (1, outputSize, name)
-    {}
+      : TwiceDifferentiableFunction (1, outputSize, name),
+	derivative_ (outputSize)
+    {
+      derivative_.setZero ();
+    }
 
     /// \brief Function evaluation.
     ///
@@ -212,21 +234,9 @@ namespace roboptim
 			const_argument_ref argument,
 			size_type functionId = 0) const
     {
-#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
-      bool cur_malloc_allowed = is_malloc_allowed ();
-      set_is_malloc_allowed (true);
-#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
-
-      derivative_t derivative (derivativeSize ());
-
-#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
-      set_is_malloc_allowed (cur_malloc_allowed);
-#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
-
-      derivative.setZero ();
-
-      this->derivative (derivative, argument[0], 1);
-      gradient[0] = derivative[functionId];
+      derivative_.setZero ();
+      this->derivative (derivative_, argument[0], 1);
+      gradient[0] = derivative_[functionId];
     }
 
 
@@ -257,22 +267,32 @@ namespace roboptim
     {
       assert (functionId == 0);
 
-# ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
-      bool cur_malloc_allowed = is_malloc_allowed ();
-      set_is_malloc_allowed (true);
-# endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
-
-      derivative_t derivative (derivativeSize ());
-
-#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
-      set_is_malloc_allowed (cur_malloc_allowed);
-#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
-
-      derivative.setZero ();
+      derivative_.setZero ();
+      this->derivative (derivative_, argument[0], 2);
+      hessian (0, 0) = derivative_[functionId];
+    }
 
-      this->derivative (derivative, argument[0], 2);
-      hessian (0, 0) = derivative[functionId];
+    /// \brief Evaluation of the derivatives at several points.
+    ///
+    /// The default implementation calls #impl_derivative for each point.
+    /// Concrete classes can override it to evaluate all the points at
+    /// once.
+    /// \warning Do not call this function directly, call #derivatives
+    /// instead.
+    /// \param result derivatives will be stored in this matrix
+    /// \param times points at which the derivatives will be computed
+    /// \param order derivative order (if 0 evaluates the function)
+    virtual void impl_derivatives (matrix_ref result,
+				   const_vector_ref times,
+				   size_type order) const
+    {
+      for (size_type i = 0; i < times.size (); ++i)
+	this->impl_derivative (result.col (i), times[i], order);
     }
+
+  private:
+    /// \brief Derivative buffer used by the gradient and the hessian.
+    mutable derivative_t derivative_;
   };
 
   /// \brief Define a \f$\mathbb{R} \rightarrow \mathbb{R}^m\f$ function,
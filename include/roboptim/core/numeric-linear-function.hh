@@ -89,6 +89,13 @@ namespace roboptim
       const;
     void impl_jacobian (jacobian_ref, const_argument_ref) const;
 
+    bool impl_compute_rows (result_ref, const_argument_ref,
+			    const indices_t&) const;
+    bool impl_jacobian_rows (jacobian_ref, const_argument_ref,
+			     const indices_t&) const;
+    bool impl_jacobian_columns (jacobian_ref, const_argument_ref,
+				const indices_t&) const;
+
   private:
     /// \brief A matrix.
     matrix_t a_;
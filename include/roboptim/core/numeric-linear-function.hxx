@@ -18,6 +18,10 @@
 #ifndef ROBOPTIM_CORE_NUMERIC_LINEAR_FUNCTION_HXX
 # define ROBOPTIM_CORE_NUMERIC_LINEAR_FUNCTION_HXX
 
+# include <algorithm>
+# include <utility>
+# include <vector>
+
 # include <roboptim/core/debug.hh>
 # include <roboptim/core/indent.hh>
 # include <roboptim/core/util.hh>
@@ -25,6 +29,70 @@
 
 namespace roboptim
 {
+  namespace detail
+  {
+    /// \internal
+    /// \brief Select rows (or columns) of a sparse matrix as triplets.
+    ///
+    /// Selected outer vectors (rows of a row-major matrix, columns of a
+    /// column-major matrix) are read directly. Selected inner vectors are
+    /// found in a single pass over the nonzeros of the matrix.
+    ///
+    /// \param m sparse matrix.
+    /// \param indices selected rows (or columns), possibly repeated.
+    /// \param rows whether rows (or columns) are selected.
+    /// \param triplets output coefficients: the selected row (or column)
+    /// k of m becomes the row (or column) k.
+    template <typename M, typename I, typename Tr>
+    void select_sparse (const M& m, const std::vector<I>& indices,
+			bool rows, std::vector<Tr>& triplets)
+    {
+#if EIGEN_VERSION_AT_LEAST(3, 2, 90)
+      typedef typename M::StorageIndex index_t;
+#else
+      typedef typename M::Index index_t;
+#endif
+      typedef std::pair<I, index_t> selected_t;
+      typedef typename std::vector<selected_t>::const_iterator iterator_t;
+
+      if (rows == (M::IsRowMajor != 0))
+	{
+	  for (std::size_t k = 0; k < indices.size (); ++k)
+	    {
+	      const index_t s = static_cast<index_t> (k);
+	      for (typename M::InnerIterator it (m, indices[k]); it; ++it)
+		{
+		  const index_t inner = static_cast<index_t> (it.index ());
+		  triplets.push_back (M::IsRowMajor
+				      ? Tr (s, inner, it.value ())
+				      : Tr (inner, s, it.value ()));
+		}
+	    }
+	  return;
+	}
+
+      // Sorted (index, position) pairs, looked up for each nonzero.
+      std::vector<selected_t> selected (indices.size ());
+      for (std::size_t k = 0; k < indices.size (); ++k)
+	selected[k] = selected_t (indices[k], static_cast<index_t> (k));
+      std::sort (selected.begin (), selected.end ());
+
+      const index_t outerSize = static_cast<index_t> (m.outerSize ());
+      for (index_t outer = 0; outer < outerSize; ++outer)
+	for (typename M::InnerIterator it (m, outer); it; ++it)
+	  {
+	    const I inner = static_cast<I> (it.index ());
+	    for (iterator_t s = std::lower_bound (selected.begin (),
+						  selected.end (),
+						  selected_t (inner, 0));
+		 s != selected.end () && s->first == inner; ++s)
+	      triplets.push_back (M::IsRowMajor
+				  ? Tr (outer, s->second, it.value ())
+				  : Tr (s->second, outer, it.value ()));
+	  }
+    }
+  } // end of namespace detail
+
   template <typename T>
   GenericNumericLinearFunction<T>::GenericNumericLinearFunction
   (const_matrix_ref a, const_vector_ref b, std::string name)
@@ -80,6 +148,93 @@ namespace roboptim
     jacobian = this->a_;
   }
 
+  // A(rows) * x + b(rows)
+  template <typename T>
+  bool
+  GenericNumericLinearFunction<T>::impl_compute_rows
+  (result_ref result, const_argument_ref argument, const indices_t& rows)
+    const
+  {
+    for (std::size_t k = 0; k < rows.size (); ++k)
+      result[static_cast<size_type> (k)] =
+	a_.row (rows[k]).dot (argument) + b_[rows[k]];
+    return true;
+  }
+
+  // A(rows) - sparse specialization
+  template <>
+  inline bool
+  GenericNumericLinearFunction<EigenMatrixSparse>::impl_jacobian_rows
+  (jacobian_ref jacobian, const_argument_ref, const indices_t& rows)
+    const
+  {
+    typedef Eigen::Triplet<value_type> triplet_t;
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    bool cur_malloc_allowed = is_malloc_allowed ();
+    set_is_malloc_allowed (true);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+    std::vector<triplet_t> coefficients;
+    detail::select_sparse (a_, rows, true, coefficients);
+    jacobian.setFromTriplets (coefficients.begin (), coefficients.end ());
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    set_is_malloc_allowed (cur_malloc_allowed);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+    return true;
+  }
+
+  // A(rows)
+  template <typename T>
+  bool
+  GenericNumericLinearFunction<T>::impl_jacobian_rows
+  (jacobian_ref jacobian, const_argument_ref, const indices_t& rows)
+    const
+  {
+    for (std::size_t k = 0; k < rows.size (); ++k)
+      jacobian.row (static_cast<size_type> (k)) = a_.row (rows[k]);
+    return true;
+  }
+
+  // A(:, columns) - sparse specialization
+  template <>
+  inline bool
+  GenericNumericLinearFunction<EigenMatrixSparse>::impl_jacobian_columns
+  (jacobian_ref jacobian, const_argument_ref, const indices_t& columns)
+    const
+  {
+    typedef Eigen::Triplet<value_type> triplet_t;
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    bool cur_malloc_allowed = is_malloc_allowed ();
+    set_is_malloc_allowed (true);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+    std::vector<triplet_t> coefficients;
+    detail::select_sparse (a_, columns, false, coefficients);
+    jacobian.setFromTriplets (coefficients.begin (), coefficients.end ());
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    set_is_malloc_allowed (cur_malloc_allowed);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+    return true;
+  }
+
+  // A(:, columns)
+  template <typename T>
+  bool
+  GenericNumericLinearFunction<T>::impl_jacobian_columns
+  (jacobian_ref jacobian, const_argument_ref, const indices_t& columns)
+    const
+  {
+    for (std::size_t k = 0; k < columns.size (); ++k)
+      jacobian.col (static_cast<size_type> (k)) = a_.col (columns[k]);
+    return true;
+  }
+
   // A(i) - sparse specialization
   template <>
   inline void
@@ -35,7 +35,10 @@ namespace roboptim
   /// \f[f(x) = x^t A x + b^t x + c\f]
   /// where \f$A\f$ and \f$B\f$ are set when the class is instantiated.
   ///
-  /// \note A is a symmetric matrix.
+  /// \note A is a symmetric matrix. The value, the gradient and the
+  /// Jacobian only read its upper triangular part: the product Ax relies
+  /// on a symmetric matrix-vector product (a symmetric SpMV for sparse
+  /// matrices).
   template <typename T>
   class ROBOPTIM_GCC_ETI_WORKAROUND GenericNumericQuadraticFunction
   : public GenericQuadraticFunction<T>
@@ -112,6 +115,15 @@ namespace roboptim
       return c_;
     }
 
+    /// \brief Compute the value and the gradient of the function.
+    ///
+    /// The product Ax is only computed once for both outputs.
+    /// \param result value of the function (size: 1)
+    /// \param gradient gradient of the function (size: inputSize ())
+    /// \param argument point at which the function is evaluated
+    void computeWithGradient (result_ref result, gradient_ref gradient,
+			      const_argument_ref argument) const;
+
   protected:
     void impl_compute (result_ref, const_argument_ref) const;
     void impl_gradient (gradient_ref, const_argument_ref, size_type = 0)
@@ -121,6 +133,13 @@ namespace roboptim
 		       const_argument_ref argument,
 		       size_type functionId = 0) const;
   private:
+    /// \brief Compute A * x in buffer_, from the upper triangular part of
+    /// A.
+    void symmetricProduct (const_argument_ref x) const;
+
+    /// \brief Write 2 * buffer_ + b in the gradient.
+    void gradientFromProduct (gradient_ref gradient) const;
+
     /// \brief A matrix.
     symmetric_t a_;
     /// \brief B vector.
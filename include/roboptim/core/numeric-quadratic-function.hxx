@@ -18,6 +18,8 @@
 #ifndef ROBOPTIM_CORE_NUMERIC_QUADRATIC_FUNCTION_HXX
 # define ROBOPTIM_CORE_NUMERIC_QUADRATIC_FUNCTION_HXX
 
+# include <cassert>
+
 # include <roboptim/core/debug.hh>
 # include <roboptim/core/indent.hh>
 # include <roboptim/core/numeric-linear-function.hh>
@@ -26,6 +28,21 @@
 
 namespace roboptim
 {
+  namespace detail
+  {
+    /// \brief Add the contribution of the coefficient (i, j), i <= j, of
+    /// the upper triangle of a symmetric matrix to y = A x.
+    template <typename V, typename X>
+    void add_symmetric_coefficient (V& y, const X& x,
+				    typename V::Index i, typename V::Index j,
+				    typename V::Scalar v)
+    {
+      y[i] += v * x[j];
+      if (i != j)
+	y[j] += v * x[i];
+    }
+  } // end of namespace detail
+
   template <typename T>
   GenericNumericQuadraticFunction<T>::GenericNumericQuadraticFunction
   (const_matrix_ref a, const_vector_ref b, std::string name)
@@ -62,6 +79,59 @@ namespace roboptim
   {
   }
 
+  // A * x - sparse specialization: symmetric SpMV on the upper triangle
+  template <>
+  inline void
+  GenericNumericQuadraticFunction<EigenMatrixSparse>::symmetricProduct
+  (const_argument_ref x) const
+  {
+    // Each off-diagonal coefficient (i, j), i < j, of the upper
+    // triangle contributes to both rows i and j. Inner indices are
+    // sorted, so the lower triangle is never visited: columns (column
+    // major) are read down to the diagonal, and rows (row major) are read
+    // backwards down to the diagonal.
+    buffer_.setZero ();
+    for (size_type k = 0; k < a_.outerSize (); ++k)
+      if (symmetric_t::IsRowMajor)
+	for (symmetric_t::ReverseInnerIterator it (a_, k);
+	     it && it.col () >= k; --it)
+	  detail::add_symmetric_coefficient
+	    (buffer_, x, it.row (), it.col (), it.value ());
+      else
+	for (symmetric_t::InnerIterator it (a_, k);
+	     it && it.row () <= k; ++it)
+	  detail::add_symmetric_coefficient
+	    (buffer_, x, it.row (), it.col (), it.value ());
+  }
+
+  // A * x
+  template <typename T>
+  void
+  GenericNumericQuadraticFunction<T>::symmetricProduct
+  (const_argument_ref x) const
+  {
+    buffer_.noalias () = a_.template selfadjointView<Eigen::Upper> () * x;
+  }
+
+  // 2 * A * x + b - sparse specialization
+  template <>
+  inline void
+  GenericNumericQuadraticFunction<EigenMatrixSparse>::gradientFromProduct
+  (gradient_ref gradient) const
+  {
+    for (size_type j = 0; j < this->inputSize (); ++j)
+      gradient.coeffRef (j) = 2. * buffer_[j] + b_[j];
+  }
+
+  // 2 * A * x + b
+  template <typename T>
+  void
+  GenericNumericQuadraticFunction<T>::gradientFromProduct
+  (gradient_ref gradient) const
+  {
+    gradient = 2. * buffer_.transpose () + b_.transpose ();
+  }
+
   // x^T * A * x + b^T * x + c
   template <typename T>
   void
@@ -69,79 +139,64 @@ namespace roboptim
 						    const_argument_ref argument)
     const
   {
-    buffer_.noalias () = a_ * argument;
-    result = argument.adjoint ()  * buffer_;
-    result += b_.adjoint () * argument;
-    result += c_;
+    symmetricProduct (argument);
+    result[0] = argument.dot (buffer_) + b_.dot (argument) + c_[0];
   }
 
-  // 2 * x * A + b
+  // 2 * x * A + b - sparse specialization
   template <>
   inline void
   GenericNumericQuadraticFunction<EigenMatrixSparse>::impl_jacobian
   (jacobian_ref jacobian, const_argument_ref x) const
   {
-#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
-    bool cur_malloc_allowed = is_malloc_allowed ();
-    set_is_malloc_allowed (true);
-#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
-
-    Eigen::MatrixXd j = 2 * x.transpose () * a_;
-
-#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
-    set_is_malloc_allowed (cur_malloc_allowed);
-#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
-
+    symmetricProduct (x);
     for (size_type i = 0; i < this->inputSize (); ++i)
-      j.coeffRef (0, i) += b_[i];
-
-    for (size_type i = 0; i < this->inputSize (); ++i)
-      jacobian.coeffRef (0, i) = j.coeffRef (0, i);
+      jacobian.coeffRef (0, i) = 2. * buffer_[i] + b_[i];
   }
 
-
+  // 2 * x * A + b
   template <typename T>
   void
   GenericNumericQuadraticFunction<T>::impl_jacobian
   (jacobian_ref jacobian, const_argument_ref x) const
   {
-    // Warning: noalias() led to a possible Eigen bug here
-    // See: http://eigen.tuxfamily.org/bz/show_bug.cgi?id=1166
-    jacobian = 2 * x.transpose () * a_;
-    jacobian += b_.transpose ();
+    symmetricProduct (x);
+    jacobian.row (0) = 2. * buffer_.transpose () + b_.transpose ();
   }
 
-  // A(i) - sparse specialization
-  template <>
-  inline void
-  GenericNumericQuadraticFunction<EigenMatrixSparse>::impl_gradient
-  (gradient_ref gradient, const_argument_ref x, size_type)
-    const
+  // 2 * A * x + b
+  template <typename T>
+  void
+  GenericNumericQuadraticFunction<T>::impl_gradient
+  (gradient_ref gradient, const_argument_ref x, size_type) const
   {
-    buffer_.noalias () = 2 * a_ * x;
-    buffer_ += b_;
-    for (size_type j = 0; j < this->inputSize (); ++j)
-      gradient.coeffRef (j) = buffer_.coeffRef (j);
+    symmetricProduct (x);
+    gradientFromProduct (gradient);
   }
 
-  // A(i)
+  // x^T * A * x + b^T * x + c and 2 * A * x + b
   template <typename T>
   void
-  GenericNumericQuadraticFunction<T>::impl_gradient
-  (gradient_ref gradient, const_argument_ref x, size_type) const
+  GenericNumericQuadraticFunction<T>::computeWithGradient
+  (result_ref result, gradient_ref gradient, const_argument_ref argument)
+    const
   {
-    buffer_.noalias () = 2 * a_ * x;
-    buffer_ += b_;
-    gradient = buffer_;
+    assert (result.size () == 1);
+    assert (gradient.size () == this->inputSize ());
+
+    symmetricProduct (argument);
+    result[0] = argument.dot (buffer_) + b_.dot (argument) + c_[0];
+    gradientFromProduct (gradient);
   }
 
-  // A
+  // 2 * A, mirrored from the upper triangle
   template <typename T>
   void
   GenericNumericQuadraticFunction<T>::impl_hessian
   (hessian_ref hessian, const_argument_ref, size_type) const
   {
-    hessian = 2 * a_;
+    hessian = a_.template selfadjointView<Eigen::Upper> ();
+    hessian *= 2;
   }
 
   template <typename T>
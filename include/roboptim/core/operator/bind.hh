@@ -37,6 +37,11 @@ namespace roboptim
   /// This allows to reduce any function input space by setting some
   /// inputs to particular values.
   ///
+  /// If the input function can differentiate with respect to a subset of
+  /// its variables (see GenericDifferentiableFunction::jacobianColumns),
+  /// only the columns of the free variables are computed. Otherwise, the
+  /// whole Jacobian is computed and the relevant columns are extracted.
+  ///
   /// \tparam U input function type.
   template <typename U>
   class Bind : public detail::AutopromoteTrait<U>::T_type
@@ -52,6 +57,9 @@ namespace roboptim
 		   const boundValues_t& selector);
     ~Bind ();
 
+    virtual void evaluationState (std::vector<const void*>& objects)
+      const;
+
     const boost::shared_ptr<U>& origin () const
     {
       return origin_;
@@ -73,6 +81,11 @@ namespace roboptim
 			const_argument_ref arg)
       const;
 
+    bool impl_jacobian_columns (jacobian_ref jacobian,
+				const_argument_ref arg,
+				const indices_t& columns)
+      const;
+
     /// \brief Display the function on the specified output stream.
     ///
     /// \param o output stream used for display
@@ -80,8 +93,16 @@ namespace roboptim
     virtual std::ostream& print (std::ostream& o) const;
 
   private:
+    /// \brief Fill the argument of the input function.
+    void updateArgument (const_argument_ref x) const;
+
     boost::shared_ptr<U> origin_;
     boundValues_t boundValues_;
+
+    /// \brief Free variables of the input function.
+    indices_t columns_;
+    /// \brief Buffer used to forward column subsets to the input function.
+    mutable indices_t originColumns_;
     mutable vector_t x_;
     mutable gradient_t gradient_;
     mutable jacobian_t jacobian_;
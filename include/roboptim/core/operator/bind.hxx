@@ -21,6 +21,7 @@
 # include <stdexcept>
 # include <boost/format.hpp>
 
+# include <roboptim/core/detail/indices.hh>
 # include <roboptim/core/indent.hh>
 
 namespace roboptim
@@ -38,6 +39,8 @@ namespace roboptim
 	% origin->getName ()).str ()),
       origin_ (origin),
       boundValues_ (boundValues),
+      columns_ (),
+      originColumns_ (),
       x_ (origin->inputSize ()),
       gradient_ (origin->inputSize ()),
       jacobian_ (origin->outputSize (),
@@ -57,24 +60,33 @@ namespace roboptim
 	  % origin->inputSize () % boundValues.size ();
 	throw std::runtime_error (fmt.str ().c_str ());
       }
+
+    for (std::size_t idx = 0; idx < boundValues_.size (); ++idx)
+      if (!boundValues_[idx])
+	columns_.push_back (static_cast<size_type> (idx));
+    originColumns_.reserve (columns_.size ());
   }
 
   template <typename U>
   Bind<U>::~Bind ()
   {}
 
+  template <typename U>
+  void
+  Bind<U>::evaluationState (std::vector<const void*>& objects)
+    const
+  {
+    objects.push_back (this);
+    origin_->evaluationState (objects);
+  }
+
   template <typename U>
   void
   Bind<U>::impl_compute
   (result_ref result, const_argument_ref x)
     const
   {
-    size_type id = 0;
-    for (std::size_t idx = 0; idx < boundValues_.size (); ++idx)
-      if (boundValues_[idx])
-	x_[static_cast<size_type> (idx)] = *(boundValues_[idx]);
-      else
-	x_[static_cast<size_type> (idx)] = x[id++];
+    updateArgument (x);
     origin_->operator () (result, x_);
   }
 
@@ -85,15 +97,10 @@ namespace roboptim
 			  size_type functionId)
     const
   {
-    size_type id = 0;
-    for (std::size_t idx = 0; idx < boundValues_.size (); ++idx)
-      if (boundValues_[idx])
-	x_[static_cast<size_type> (idx)] = *(boundValues_[idx]);
-      else
-	x_[static_cast<size_type> (idx)] = argument[id++];
+    updateArgument (argument);
     origin_->gradient (gradient_, x_, functionId);
 
-    id = 0;
+    size_type id = 0;
     for (std::size_t idx = 0; idx < boundValues_.size (); ++idx)
       if (!boundValues_[idx])
 	gradient.coeffRef (id++) =
@@ -106,18 +113,16 @@ namespace roboptim
 			  const_argument_ref argument)
     const
   {
-    size_type id = 0;
-    for (std::size_t idx = 0; idx < boundValues_.size (); ++idx)
-      if (boundValues_[idx])
-	x_[static_cast<size_type> (idx)] = *(boundValues_[idx]);
-      else
-	x_[static_cast<size_type> (idx)] = argument[id++];
+    updateArgument (argument);
+
+    if (origin_->jacobianColumns (jacobian, x_, columns_))
+      return;
 
     origin_->jacobian (jacobian_, x_);
 
     assert (jacobian_.rows () == jacobian.rows ());
 
-    id = 0;
+    size_type id = 0;
     for (size_type col = 0; col < jacobian_.cols (); ++col)
       if (!boundValues_[static_cast<std::size_t> (col)])
 	{
@@ -127,6 +132,30 @@ namespace roboptim
 	}
   }
 
+  template <typename U>
+  bool
+  Bind<U>::impl_jacobian_columns (jacobian_ref jacobian,
+				  const_argument_ref argument,
+				  const indices_t& columns)
+    const
+  {
+    updateArgument (argument);
+    return origin_->jacobianColumns
+      (jacobian, x_, detail::map_indices (columns, columns_, originColumns_));
+  }
+
+  template <typename U>
+  void
+  Bind<U>::updateArgument (const_argument_ref x) const
+  {
+    size_type id = 0;
+    for (std::size_t idx = 0; idx < boundValues_.size (); ++idx)
+      if (boundValues_[idx])
+	x_[static_cast<size_type> (idx)] = *(boundValues_[idx]);
+      else
+	x_[static_cast<size_type> (idx)] = x[id++];
+  }
+
 
   template <typename U>
   std::ostream&
@@ -42,6 +42,12 @@ namespace roboptim
   ///
   /// (left (right (x)))' = left'(right(x)) * right'(x)
   ///
+  /// Optionally (see cacheRight), the result and the Jacobian of the right
+  /// function are kept along with the point where they were computed, so
+  /// that successive evaluations at the same point (e.g. value, then
+  /// Jacobian, or the gradients of all the outputs) evaluate the right
+  /// function only once.
+  ///
   /// \tparam U left input function type.
   /// \tparam V right input function type.
   template <typename U, typename V>
@@ -60,6 +66,9 @@ namespace roboptim
     explicit Chain (boost::shared_ptr<U> left, boost::shared_ptr<V> right);
     ~Chain ();
 
+    virtual void evaluationState (std::vector<const void*>& objects)
+      const;
+
     const boost::shared_ptr<U>& left () const
     {
       return left_;
@@ -80,6 +89,28 @@ namespace roboptim
       return right_;
     }
 
+    /// \brief Whether the results of the right function are reused
+    /// between evaluations at the same point.
+    ///
+    /// This must only be enabled if the right function only depends on
+    /// its argument, or if resetCache is called when its state is
+    /// modified. Changing this flag discards the last results.
+    ///
+    /// \param cache caching flag (default: false).
+    void cacheRight (bool cache);
+
+    /// \brief Whether the results of the right function are reused
+    /// between evaluations at the same point.
+    /// \return caching flag.
+    bool cacheRight () const
+    {
+      return cacheRight_;
+    }
+
+    /// \brief Forget the last results of the right function, e.g. after
+    /// its state was modified.
+    void resetCache () const;
+
     void impl_compute (result_ref result, const_argument_ref x)
       const;
 
@@ -91,6 +122,14 @@ namespace roboptim
 			const_argument_ref arg)
       const;
   private:
+    /// \brief Evaluate the right function at x, unless its results can
+    /// be reused.
+    ///
+    /// \param x evaluation point.
+    /// \param jacobian whether the Jacobian of the right function is
+    /// required.
+    void updateRight (const_argument_ref x, bool jacobian) const;
+
     /// \brief Shared pointer to the left function.
     boost::shared_ptr<U> left_;
     /// \brief Shared pointer to the right function.
@@ -114,6 +153,26 @@ namespace roboptim
     /// \brief Temporary buffer to store right function jacobian.
     mutable jacobian_t jacobianRight_;
 
+    /// \brief Work buffer of the in-place sparse product.
+    mutable std::vector<typename jacobian_t::Index> productWork_;
+
+    /// \}
+
+    /// \name Cache of the right function
+    /// \{
+
+    /// \brief Whether the results of the right function are reused.
+    bool cacheRight_;
+
+    /// \brief Point where the right function was last evaluated.
+    mutable argument_t lastX_;
+
+    /// \brief Whether rightResult_ is valid at lastX_.
+    mutable bool rightResultReady_;
+
+    /// \brief Whether jacobianRight_ is valid at lastX_.
+    mutable bool rightJacobianReady_;
+
     /// \}
   };
 
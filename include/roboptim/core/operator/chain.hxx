@@ -17,10 +17,61 @@
 
 #ifndef ROBOPTIM_CORE_OPERATOR_CHAIN_HXX
 # define ROBOPTIM_CORE_OPERATOR_CHAIN_HXX
+# include <vector>
+
 # include <boost/format.hpp>
 
+# include <roboptim/core/util.hh>
+
 namespace roboptim
 {
+  namespace detail
+  {
+    /// \brief Product of the Jacobians of a Chain operator (dense
+    /// matrices).
+    template <typename I>
+    void chain_product
+    (GenericFunctionTraits<EigenMatrixDense>::jacobian_ref jacobian,
+     const GenericFunctionTraits<EigenMatrixDense>::jacobian_t& left,
+     const GenericFunctionTraits<EigenMatrixDense>::jacobian_t& right,
+     std::vector<I>&)
+    {
+      jacobian.noalias () = left * right;
+    }
+
+    /// \brief Product of the Jacobians of a Chain operator (sparse
+    /// matrices): computed in the pattern of the output if possible.
+    template <typename I>
+    void chain_product
+    (GenericFunctionTraits<EigenMatrixSparse>::jacobian_ref jacobian,
+     const GenericFunctionTraits<EigenMatrixSparse>::jacobian_t& left,
+     const GenericFunctionTraits<EigenMatrixSparse>::jacobian_t& right,
+     std::vector<I>& work)
+    {
+      sparseProductInPlace (jacobian, left, right, work);
+    }
+
+    /// \brief Gradient of an output of a Chain operator (dense
+    /// matrices).
+    inline void chain_gradient
+    (GenericFunctionTraits<EigenMatrixDense>::gradient_ref gradient,
+     const GenericFunctionTraits<EigenMatrixDense>::gradient_t& left,
+     const GenericFunctionTraits<EigenMatrixDense>::jacobian_t& right)
+    {
+      gradient.noalias () = left * right;
+    }
+
+    /// \brief Gradient of an output of a Chain operator (sparse
+    /// matrices).
+    inline void chain_gradient
+    (GenericFunctionTraits<EigenMatrixSparse>::gradient_ref gradient,
+     const GenericFunctionTraits<EigenMatrixSparse>::gradient_t& left,
+     const GenericFunctionTraits<EigenMatrixSparse>::jacobian_t& right)
+    {
+      gradient = left * right;
+    }
+  } // end of namespace detail.
+
   template <typename U, typename V>
   Chain<U, V>::Chain
   (boost::shared_ptr<U> left, boost::shared_ptr<V> right)
@@ -38,7 +89,12 @@ namespace roboptim
       jacobianLeft_ (left->outputSize (),
 		     left->inputSize ()),
       jacobianRight_ (right->outputSize (),
-		      right->inputSize ())
+		      right->inputSize ()),
+      productWork_ (),
+      cacheRight_ (false),
+      lastX_ (right->inputSize ()),
+      rightResultReady_ (false),
+      rightJacobianReady_ (false)
   {
     if (left->inputSize () != right->outputSize ())
       throw std::runtime_error
@@ -49,19 +105,76 @@ namespace roboptim
     gradientRight_.setZero ();
     jacobianLeft_.setZero ();
     jacobianRight_.setZero ();
+    lastX_.setZero ();
   }
 
   template <typename U, typename V>
   Chain<U, V>::~Chain ()
   {}
 
+  template <typename U, typename V>
+  void
+  Chain<U, V>::evaluationState (std::vector<const void*>& objects)
+    const
+  {
+    objects.push_back (this);
+    left_->evaluationState (objects);
+    right_->evaluationState (objects);
+  }
+
+  template <typename U, typename V>
+  void
+  Chain<U, V>::cacheRight (bool cache)
+  {
+    cacheRight_ = cache;
+    resetCache ();
+  }
+
+  template <typename U, typename V>
+  void
+  Chain<U, V>::resetCache () const
+  {
+    rightResultReady_ = false;
+    rightJacobianReady_ = false;
+  }
+
+  template <typename U, typename V>
+  void
+  Chain<U, V>::updateRight (const_argument_ref x, bool jacobian) const
+  {
+    if (!cacheRight_)
+      {
+	(*right_) (rightResult_, x);
+	if (jacobian)
+	  right_->jacobian (jacobianRight_, x);
+	return;
+      }
+
+    if ((rightResultReady_ || rightJacobianReady_) && lastX_ != x)
+      resetCache ();
+
+    if (!rightResultReady_)
+      {
+	(*right_) (rightResult_, x);
+	rightResultReady_ = true;
+      }
+
+    if (jacobian && !rightJacobianReady_)
+      {
+	right_->jacobian (jacobianRight_, x);
+	rightJacobianReady_ = true;
+      }
+
+    lastX_ = x;
+  }
+
   template <typename U, typename V>
   void
   Chain<U, V>::impl_compute
   (result_ref result, const_argument_ref x)
     const
   {
-    (*right_) (rightResult_, x);
+    updateRight (x, false);
     (*left_) (result, rightResult_);
   }
 
@@ -72,10 +185,9 @@ namespace roboptim
 			 size_type functionId)
     const
   {
-    (*right_) (rightResult_, x);
+    updateRight (x, true);
     left_->gradient (gradientLeft_, rightResult_, functionId);
-    right_->jacobian (jacobianRight_, x);
-    gradient.noalias () = gradientLeft_.adjoint () * jacobianRight_;
+    detail::chain_gradient (gradient, gradientLeft_, jacobianRight_);
   }
 
   template <typename U, typename V>
@@ -84,11 +196,11 @@ namespace roboptim
 			      const_argument_ref x)
     const
   {
-    (*right_) (rightResult_, x);
+    updateRight (x, true);
     left_->jacobian (jacobianLeft_, rightResult_);
-    right_->jacobian (jacobianRight_, x);
 
-    jacobian.noalias () = jacobianLeft_ * jacobianRight_;
+    detail::chain_product (jacobian, jacobianLeft_, jacobianRight_,
+			   productWork_);
   }
 
 } // end of namespace roboptim.
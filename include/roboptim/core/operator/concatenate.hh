@@ -57,6 +57,9 @@ namespace roboptim
 			  boost::shared_ptr<U> right);
     ~Concatenate ();
 
+    virtual void evaluationState (std::vector<const void*>& objects)
+      const;
+
     const boost::shared_ptr<U>& left () const
     {
       return left_;
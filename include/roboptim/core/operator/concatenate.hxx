@@ -75,6 +75,16 @@ namespace roboptim
   Concatenate<U>::~Concatenate ()
   {}
 
+  template <typename U>
+  void
+  Concatenate<U>::evaluationState (std::vector<const void*>& objects)
+    const
+  {
+    objects.push_back (this);
+    left_->evaluationState (objects);
+    right_->evaluationState (objects);
+  }
+
   template <typename U>
   void
   Concatenate<U>::impl_compute
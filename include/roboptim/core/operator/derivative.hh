@@ -80,6 +80,8 @@ namespace roboptim
 	 "derivative of " + origin->getName ()),
 	origin_ (origin),
 	variableId_ (variableId),
+	variables_ (1, variableId),
+	column_ (origin->outputSize (), 1),
 	jacobian_ (origin->outputSize (),
 		   origin->inputSize ()),
 	hessian_ (origin->inputSize (),
@@ -91,6 +93,13 @@ namespace roboptim
     ~Derivative ()
     {}
 
+    virtual void evaluationState (std::vector<const void*>& objects)
+      const
+    {
+      objects.push_back (this);
+      origin_->evaluationState (objects);
+    }
+
     const boost::shared_ptr<U>& origin () const
     {
       return origin_;
@@ -101,11 +110,37 @@ namespace roboptim
       return origin_;
     }
 
+    /// \brief Evaluate the derivative at several points.
+    ///
+    /// This is only available if the input function is a
+    /// NTimesDerivableFunction: the derivative of order k of this
+    /// function is the derivative of order k + 1 of the input function,
+    /// so all the points are forwarded at once.
+    /// \param result derivatives will be stored in this matrix
+    /// (size: outputSize () x times.size ())
+    /// \param times points at which the derivatives will be computed
+    /// \param order derivative order (if 0 then function is evaluated)
+    void derivatives (matrix_ref result,
+		      const_vector_ref times,
+		      size_type order = 0) const
+    {
+      origin_->derivatives (result, times, order + 1);
+    }
+
   protected:
-    // FIXME: this is inefficient.
     void impl_compute (result_ref result, const_argument_ref x)
       const
     {
+      // Only compute the column of the Jacobian if the input function
+      // supports it.
+      column_.setZero ();
+      if (origin_->jacobianColumns (column_, x, variables_))
+	{
+	  result = column_.block (0, 0, this->outputSize (), 1);
+	  return;
+	}
+
+      jacobian_.setZero ();
       origin_->jacobian (jacobian_, x);
       result = jacobian_.block (0, variableId_, this->outputSize (), 1);
     }
@@ -123,6 +158,10 @@ namespace roboptim
   private:
     boost::shared_ptr<U> origin_;
     size_type variableId_;
+    /// \brief Column selected in the Jacobian of the input function.
+    indices_t variables_;
+    /// \brief Buffer for the selected column of the Jacobian.
+    mutable matrix_t column_;
     mutable matrix_t jacobian_;
     mutable matrix_t hessian_;
   };
@@ -18,10 +18,12 @@
 #ifndef ROBOPTIM_CORE_OPERATOR_MAP_HH
 # define ROBOPTIM_CORE_OPERATOR_MAP_HH
 # include <vector>
+# include <boost/make_shared.hpp>
 # include <boost/shared_ptr.hpp>
 
 # include <roboptim/core/detail/autopromote.hh>
 # include <roboptim/core/differentiable-function.hh>
+# include <roboptim/core/jacobian-structure.hh>
 
 
 namespace roboptim
@@ -37,6 +39,13 @@ namespace roboptim
   /// Output:
   /// [f(x_0^0 x_1^0 ... x_N^0) ... f(x_0^M x_1^M ... x_N^M)]
   ///
+  /// The Jacobian is block-diagonal. Each repeat is evaluated directly in
+  /// its segment of the result (resp. its diagonal block of a dense
+  /// Jacobian), without any intermediate copy. With sparse matrices, each
+  /// repeat is evaluated in its own buffer, and the blocks are copied to
+  /// their preassigned slots in the Jacobian, so that the block-diagonal
+  /// pattern is only built once.
+  ///
   /// \tparam U input function type.
   template <typename U>
   class Map : public detail::AutopromoteTrait<U>::T_type
@@ -44,6 +53,7 @@ namespace roboptim
   public:
     typedef typename detail::AutopromoteTrait<U>::T_type parentType_t;
     ROBOPTIM_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_ (parentType_t);
+    typedef typename parentType_t::traits_t traits_t;
 
     typedef boost::shared_ptr<Map> MapShPtr_t;
 
@@ -53,6 +63,9 @@ namespace roboptim
     explicit Map (boost::shared_ptr<U> origin, size_type repeat);
     ~Map ();
 
+    virtual void evaluationState (std::vector<const void*>& objects)
+      const;
+
     const boost::shared_ptr<U>& origin () const
     {
       return origin_;
@@ -63,6 +76,29 @@ namespace roboptim
       return origin_;
     }
 
+    /// \brief Maximum number of threads used to evaluate the repeats.
+    ///
+    /// The repeats are independent, and each of them writes to its own
+    /// output. However, they are all evaluated by the same origin
+    /// function, so they are only evaluated concurrently if the origin
+    /// function is reentrant, i.e. its evaluationState reports no
+    /// object. Otherwise, the repeats are evaluated sequentially. This
+    /// also requires RobOptim to be compiled with OpenMP support.
+    ///
+    /// \return reference on the number of threads (default: 1, i.e.
+    /// sequential evaluation).
+    int& evaluationThreads ()
+    {
+      return evaluationThreads_;
+    }
+
+    /// \brief Maximum number of threads used to evaluate the repeats.
+    /// \return number of threads.
+    int evaluationThreads () const
+    {
+      return evaluationThreads_;
+    }
+
     void impl_compute (result_ref result, const_argument_ref x)
       const ;
 
@@ -74,13 +110,27 @@ namespace roboptim
 			const_argument_ref arg)
       const ;
   private:
+    /// \brief Number of threads that can actually be used.
+    int parallelThreads () const;
+
     boost::shared_ptr<U> origin_;
     size_type repeat_;
 
-    mutable argument_t x_;
-    mutable result_t result_;
+    /// \brief Maximum number of threads used to evaluate the repeats.
+    int evaluationThreads_;
+
     mutable gradient_t gradient_;
-    mutable jacobian_t jacobian_;
+
+    /// \brief Jacobian buffers of the repeats (sparse matrices only).
+    mutable std::vector<jacobian_t> blocks_;
+
+    /// \brief Structure of the block-diagonal Jacobian (sparse matrices
+    /// only).
+    mutable JacobianStructure structure_;
+
+    /// \brief Objects modified by the evaluation of the origin function
+    /// (see parallelThreads).
+    mutable std::vector<const void*> originState_;
   };
 
   template <typename U>
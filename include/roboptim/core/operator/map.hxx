@@ -17,10 +17,119 @@
 
 #ifndef ROBOPTIM_CORE_OPERATOR_MAP_HXX
 # define ROBOPTIM_CORE_OPERATOR_MAP_HXX
+# include <vector>
+
 # include <boost/format.hpp>
+# include <boost/type_traits/is_same.hpp>
+
+# include <roboptim/core/detail/parallel.hh>
+# include <roboptim/core/detail/parallel-jacobian.hh>
 
 namespace roboptim
 {
+  namespace detail
+  {
+    /// \brief Evaluate a repeat of a Map operator into its segment of the
+    /// result.
+    template <typename U>
+    struct MapCompute
+    {
+      MapCompute (const U& f,
+		  typename U::result_ref result,
+		  typename U::const_argument_ref x)
+	: f_ (f),
+	  result_ (result),
+	  x_ (x)
+      {}
+
+      void operator () (std::size_t i)
+      {
+	const typename U::size_type n = f_.inputSize ();
+	const typename U::size_type m = f_.outputSize ();
+	const typename U::size_type k =
+	  static_cast<typename U::size_type> (i);
+
+	f_ (result_.segment (k * m, m), x_.segment (k * n, n));
+      }
+
+      const U& f_;
+      typename U::result_ref result_;
+      typename U::const_argument_ref x_;
+    };
+
+    /// \brief Evaluate the Jacobian of a repeat of a Map operator into its
+    /// diagonal block (dense matrices) or into its buffer (sparse
+    /// matrices).
+    template <typename U>
+    struct MapJacobian
+    {
+      typedef typename U::jacobian_t jacobian_t;
+
+      MapJacobian (const U& f,
+		   std::vector<jacobian_t>& blocks,
+		   JacobianStructure& structure,
+		   typename U::jacobian_ref jacobian,
+		   typename U::const_argument_ref x)
+	: f_ (f),
+	  blocks_ (blocks),
+	  structure_ (structure),
+	  jacobian_ (jacobian),
+	  x_ (x)
+      {}
+
+      void operator () (std::size_t i)
+      {
+	const typename U::size_type n = f_.inputSize ();
+	const typename U::size_type m = f_.outputSize ();
+	const typename U::size_type k =
+	  static_cast<typename U::size_type> (i);
+
+	evaluate_block (f_, jacobian_block (jacobian_, blocks_, i,
+					    k * m, k * n, m, n),
+			x_.segment (k * n, n));
+      }
+
+      void assemble ()
+      {
+	assemble_block_diagonal (jacobian_, blocks_, structure_);
+      }
+
+      const U& f_;
+      std::vector<jacobian_t>& blocks_;
+      JacobianStructure& structure_;
+      typename U::jacobian_ref jacobian_;
+      typename U::const_argument_ref x_;
+    };
+
+    /// \brief Copy the gradient of a repeat to its segment.
+    inline void
+    map_copy_gradient
+    (GenericFunctionTraits<EigenMatrixDense>::gradient_ref gradient,
+     Function::size_type offset,
+     const GenericFunctionTraits<EigenMatrixDense>::gradient_t& g)
+    {
+      gradient.setZero ();
+      gradient.segment (offset, g.size ()) = g;
+    }
+
+    /// \brief Copy the gradient of a repeat to its segment (sparse
+    /// gradients: only the nonzeros are inserted).
+    inline void
+    map_copy_gradient
+    (GenericFunctionTraits<EigenMatrixSparse>::gradient_ref gradient,
+     Function::size_type offset,
+     const GenericFunctionTraits<EigenMatrixSparse>::gradient_t& g)
+    {
+      typedef GenericFunctionTraits<EigenMatrixSparse>::gradient_t
+	gradient_t;
+
+      gradient.setZero ();
+      gradient.reserve (g.nonZeros ());
+      for (gradient_t::InnerIterator it (g); it; ++it)
+	gradient.insert (offset + it.index ()) = it.value ();
+    }
+  } // end of namespace detail.
+
   template <typename U>
   Map<U>::Map
   (boost::shared_ptr<U> origin,
@@ -33,35 +142,42 @@ namespace roboptim
 	% repeat).str ()),
       origin_ (origin),
       repeat_ (repeat),
-      x_ (origin->inputSize ()),
-      result_ (origin->outputSize ()),
+      evaluationThreads_ (1),
       gradient_ (origin->inputSize ()),
-      jacobian_ (origin->outputSize (),
-		 origin->inputSize ())
+      blocks_ (),
+      structure_ (),
+      originState_ ()
   {
-    x_.setZero ();
-    result_.setZero ();
     gradient_.setZero ();
-    jacobian_.setZero ();
+
+    if (!boost::is_same<traits_t, EigenMatrixDense>::value)
+      blocks_.resize (static_cast<std::size_t> (repeat),
+		      jacobian_t (origin->outputSize (),
+				  origin->inputSize ()));
   }
 
   template <typename U>
   Map<U>::~Map ()
   {}
 
+  template <typename U>
+  void
+  Map<U>::evaluationState (std::vector<const void*>& objects)
+    const
+  {
+    objects.push_back (this);
+    origin_->evaluationState (objects);
+  }
+
   template <typename U>
   void
   Map<U>::impl_compute
   (result_ref result, const_argument_ref x)
     const
   {
-    for (size_type i = 0; i < repeat_; ++i)
-      {
-	x_ = x.segment (i * origin_->inputSize (), origin_->inputSize ());
-	origin_->operator () (result_, x_);
-	result.segment (i * origin_->outputSize (), origin_->outputSize ()) =
-	  result_;
-      }
+    detail::MapCompute<U> f (*origin_, result, x);
+    detail::parallel_for (static_cast<std::size_t> (repeat_),
+			  parallelThreads (), f);
   }
 
   template <typename U>
@@ -71,16 +187,14 @@ namespace roboptim
 			 size_type functionId)
     const
   {
-    for (size_type i = 0; i < repeat_; ++i)
-      {
-	x_ = x.segment (i * origin_->inputSize (), origin_->inputSize ());
-	origin_->gradient (gradient_, x_, functionId);
+    // Only the repeat computing this output depends on the input.
+    const size_type n = origin_->inputSize ();
+    const size_type m = origin_->outputSize ();
+    const size_type i = functionId / m;
 
-	//FIXME: should be a segment but Eigen support is still preliminary.
-	for (size_type idx = 0; idx < origin_->inputSize (); ++idx)
-	  gradient.coeffRef (i * origin_->inputSize () + idx) =
-	    gradient_.coeffRef (idx);
-      }
+    gradient_.setZero ();
+    origin_->gradient (gradient_, x.segment (i * n, n), functionId % m);
+    detail::map_copy_gradient (gradient, i * n, gradient_);
   }
 
   template <typename U>
@@ -89,19 +203,24 @@ namespace roboptim
 			 const_argument_ref x)
     const
   {
-    for (size_type i = 0; i < repeat_; ++i)
-      {
-	x_ = x.segment (i * origin_->inputSize (), origin_->inputSize ());
-	origin_->jacobian (jacobian_, x_);
-
-	//FIXME: should be a block but Eigen support is still preliminary.
-	for (size_type idx_i = 0; idx_i < origin_->outputSize (); ++idx_i)
-	  for (size_type idx_j = 0; idx_j < origin_->inputSize (); ++idx_j)
-	    jacobian.coeffRef
-	      (i * origin_->outputSize () + idx_i,
-	       i * origin_->inputSize () + idx_j) =
-	      jacobian_.coeffRef (idx_i, idx_j);
-      }
+    detail::MapJacobian<U> f (*origin_, blocks_, structure_, jacobian, x);
+    detail::parallel_jacobian (static_cast<std::size_t> (repeat_),
+			       parallelThreads (), f, !blocks_.empty ());
+  }
+
+  template <typename U>
+  int
+  Map<U>::parallelThreads () const
+  {
+    if (evaluationThreads_ <= 1 || !detail::has_parallel_support ())
+      return 1;
+
+    // All the repeats are evaluated by the origin function: they can only
+    // be evaluated concurrently if it does not modify any object.
+    originState_.clear ();
+    origin_->evaluationState (originState_);
+    return detail::parallel_threads (evaluationThreads_,
+				     originState_.empty ());
   }
 
 } // end of namespace roboptim.
@@ -44,6 +44,9 @@ namespace roboptim
     explicit Minus (boost::shared_ptr<U> left, boost::shared_ptr<V> right);
     ~Minus ();
 
+    virtual void evaluationState (std::vector<const void*>& objects)
+      const;
+
     const boost::shared_ptr<U>& left () const
     {
       return left_;
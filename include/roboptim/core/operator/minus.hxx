@@ -49,6 +49,16 @@ namespace roboptim
   Minus<U, V>::~Minus ()
   {}
 
+  template <typename U, typename V>
+  void
+  Minus<U, V>::evaluationState (std::vector<const void*>& objects)
+    const
+  {
+    objects.push_back (this);
+    left_->evaluationState (objects);
+    right_->evaluationState (objects);
+  }
+
   template <typename U, typename V>
   void
   Minus<U, V>::impl_compute
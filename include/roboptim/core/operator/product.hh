@@ -23,6 +23,7 @@
 
 # include <roboptim/core/detail/autopromote.hh>
 # include <roboptim/core/differentiable-function.hh>
+# include <roboptim/core/twice-differentiable-function.hh>
 
 namespace roboptim
 {
@@ -30,6 +31,10 @@ namespace roboptim
   /// @{
 
   /// \brief Product of two RobOptim functions.
+  ///
+  /// The Hessian \f$(uv)'' = u v'' + v u'' + u'^T v' + v'^T u'\f$ is
+  /// available when both functions are twice differentiable.
+  ///
   /// \tparam U first input function type.
   /// \tparam V second input function type.
   template <typename U, typename V>
@@ -39,11 +44,24 @@ namespace roboptim
     typedef typename detail::PromoteTrait<U, V>::T_promote parentType_t;
     ROBOPTIM_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_ (parentType_t);
 
+    /// \brief Traits type.
+    typedef typename parentType_t::traits_t traits_t;
+
+    /// \brief Hessian types, only used if both functions are twice
+    /// differentiable.
+    typedef GenericTwiceDifferentiableFunction<traits_t>
+    twiceDifferentiable_t;
+    typedef typename twiceDifferentiable_t::hessian_t hessian_t;
+    typedef typename twiceDifferentiable_t::hessian_ref hessian_ref;
+
     typedef boost::shared_ptr<Product> ProductShPtr_t;
 
     explicit Product (boost::shared_ptr<U> left, boost::shared_ptr<V> right);
     ~Product ();
 
+    virtual void evaluationState (std::vector<const void*>& objects)
+      const;
+
     const boost::shared_ptr<U>& left () const
     {
       return left_;
@@ -74,7 +92,14 @@ namespace roboptim
     void impl_jacobian (jacobian_ref jacobian,
 			const_argument_ref arg)
       const;
+
+    void impl_hessian (hessian_ref hessian,
+		       const_argument_ref x,
+		       size_type functionId = 0) const;
   private:
+    /// \brief Size of the Hessian buffers.
+    static size_type hessianBufferSize (size_type n);
+
     boost::shared_ptr<U> left_;
     boost::shared_ptr<V> right_;
 
@@ -86,6 +111,8 @@ namespace roboptim
 
     mutable jacobian_t jacobianLeft_;
     mutable jacobian_t jacobianRight_;
+    mutable hessian_t hessianLeft_;
+    mutable hessian_t hessianRight_;
   };
 
   template <typename U, typename V>
@@ -19,10 +19,13 @@
 # define ROBOPTIM_CORE_OPERATOR_PRODUCT_HXX
 # include <boost/format.hpp>
 # include <boost/utility/enable_if.hpp>
+# include <boost/type_traits/is_base_of.hpp>
 # include <boost/type_traits/is_same.hpp>
 # include <boost/mpl/and.hpp>
 # include <Eigen/Core>
 
+# include <roboptim/core/alloc.hh>
+
 namespace roboptim
 {
   namespace detail
@@ -74,49 +77,39 @@ namespace roboptim
       template <typename U, typename V>
       static void gradient
       (typename Types<U,V>::gradient_ref grad_uv,
-       const typename Types<U,V>::rowVectorU_ref u,
-       const typename Types<U,V>::rowVectorV_ref v,
+       typename Types<U,V>::value_type u,
+       typename Types<U,V>::value_type v,
        const typename Types<U,V>::gradientU_ref grad_u,
        const typename Types<U,V>::gradientV_ref grad_v,
        typename boost::enable_if<typename Types<U,V>::fullDense_t>::type* = 0)
       {
-        grad_uv.noalias () = u.cwiseProduct (grad_v);
-        grad_uv.noalias () += v.cwiseProduct (grad_u);
+        grad_uv.noalias () = u * grad_v;
+        grad_uv.noalias () += v * grad_u;
       }
 
       /// \brief Dense/sparse version of gradient computation.
-      /// dense.cwiseProduct (sparse) or sparse.cwiseProduct (dense) are
-      /// apparently not available in Eigen.
       template <typename U, typename V>
       static void gradient
       (typename Types<U,V>::gradient_ref grad_uv,
-       const typename Types<U,V>::rowVectorU_ref u,
-       const typename Types<U,V>::rowVectorV_ref v,
+       typename Types<U,V>::value_type u,
+       typename Types<U,V>::value_type v,
        const typename Types<U,V>::gradientU_ref grad_u,
        const typename Types<U,V>::gradientV_ref grad_v,
        typename boost::disable_if<typename Types<U,V>::fullDense_t>::type* = 0)
       {
-        // Here, u and v are dense vectors, while grad_u and grad_v are sparse
-        // vectors. Since cwiseProduct is not available for dense-sparse
-        // computation, we compute it manually. All we need to do is loop over
-        // the nonzeros of grad_u or grad_v and multiply by v or u.
+        // All we need to do is loop over the nonzeros of grad_u and
+        // grad_v and multiply by v or u.
         grad_uv.setZero ();
 
         // grad_uv = u * grad_v;
         for (typename Types<U,V>::gradientV_t::InnerIterator it (grad_v);
              it; ++it)
-	  {
-	    typename Types<U,V>::gradientV_t::Index id = it.index ();
-	    grad_uv.coeffRef (id) = u (id) * it.value ();
-	  }
+	  grad_uv.coeffRef (it.index ()) = u * it.value ();
 
         // grad_uv += v * grad_u;
         for (typename Types<U,V>::gradientU_t::InnerIterator it (grad_u);
              it; ++it)
-	  {
-	    typename Types<U,V>::gradientU_t::Index id = it.index ();
-	    grad_uv.coeffRef (id) += v (id) * it.value ();
-	  }
+	  grad_uv.coeffRef (it.index ()) += v * it.value ();
       }
 
       /// \brief Full dense version of Jacobian computation.
@@ -129,19 +122,16 @@ namespace roboptim
        const typename Types<U,V>::jacobianV_ref jac_v,
        typename boost::enable_if<typename Types<U,V>::fullDense_t>::type* = 0)
       {
-        // For each column of the Jacobian
-        // FIXME: do it Eigen-style
-        for (typename Types<U,V>::jacobian_t::Index i = 0;
-             i < jac_uv.cols (); ++i)
-	  {
-	    jac_uv.col (i).noalias () = u.cwiseProduct (jac_v.col (i));
-	    jac_uv.col (i).noalias () += v.cwiseProduct (jac_u.col (i));
-	  }
+        // Row i of the Jacobian is u_i ∂v_i + v_i ∂u_i.
+        jac_uv.noalias () = u.asDiagonal () * jac_v;
+        jac_uv.noalias () += v.asDiagonal () * jac_u;
       }
 
       /// \brief Dense/sparse version of Jacobian computation.
-      /// dense.cwiseProduct (sparse) or sparse.cwiseProduct (dense) are
-      /// apparently not available in Eigen.
+      ///
+      /// The nonzeros of jac_u and jac_v are merged outer vector by outer
+      /// vector. If jac_uv already has the merged pattern, its values are
+      /// overwritten in place, otherwise the matrix is rebuilt.
       template <typename U, typename V>
       static void jacobian
       (typename Types<U,V>::jacobian_ref jac_uv,
@@ -151,63 +141,117 @@ namespace roboptim
        const typename Types<U,V>::jacobianV_ref jac_v,
        typename boost::disable_if<typename Types<U,V>::fullDense_t>::type* = 0)
       {
-        jac_uv.setZero ();
-
-        typedef Eigen::Triplet<typename Types<U,V>::value_type> triplet_t;
-        std::vector<triplet_t> tripletList;
-        tripletList.reserve
-          (static_cast<std::size_t>
-           (std::max<typename Types<U,V>::size_type>
-            (jac_u.nonZeros (), jac_v.nonZeros ())));
-
-        // tripletList will contain duplicated elements that will be summed up
-        // by setFromTriplets()
-
-        // For each column of the Jacobian
-        // FIXME: do it Eigen-style
-#if EIGEN_VERSION_AT_LEAST(3, 2, 90)
-        for (typename Types<U,V>::jacobian_t::StorageIndex i = 0;
-#else
-        for (typename Types<U,V>::jacobian_t::Index i = 0;
-#endif
-             i < jac_uv.cols (); ++i)
-	  {
-	    // grad_uv = u * grad_v;
-	    for (typename Types<U,V>::jacobianV_t::InnerIterator
-		   it (jac_v, i); it; ++it)
-	      {
-#if EIGEN_VERSION_AT_LEAST(3, 2, 90)
-		typename Types<U,V>::gradientV_t::StorageIndex id = it.index ();
-#else
-		typename Types<U,V>::gradientV_t::Index id = it.index ();
-#endif
-		tripletList.push_back (triplet_t (id, i, u (id) * it.value ()));
-	      }
+        typedef typename Types<U,V>::jacobian_t jacobian_t;
 
-	    // grad_uv += v * grad_u;
-	    for (typename Types<U,V>::jacobianU_t::InnerIterator
-		   it (jac_u, i); it; ++it)
-	      {
-#if EIGEN_VERSION_AT_LEAST(3, 2, 90)
-		typename Types<U,V>::gradientU_t::StorageIndex id = it.index ();
-#else
-		typename Types<U,V>::gradientU_t::Index id = it.index ();
-#endif
-		tripletList.push_back (triplet_t (id, i, v (id) * it.value ()));
-	      }
-	  }
+        if (jac_uv.isCompressed ()
+            && mergeJacobians<U,V> (jac_uv, u, v, jac_u, jac_v, true))
+          return;
 
 #ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
         bool cur_malloc_allowed = is_malloc_allowed ();
         set_is_malloc_allowed (true);
 #endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
 
-        jac_uv.setFromTriplets (tripletList.begin (), tripletList.end ());
+        // The merged outer vectors have at most nnz(u) + nnz(v) elements.
+        Eigen::VectorXi sizes (jac_uv.outerSize ());
+        for (typename jacobian_t::Index j = 0; j < jac_uv.outerSize (); ++j)
+	  {
+	    int size = 0;
+	    for (typename Types<U,V>::jacobianU_t::InnerIterator
+		   it (jac_u, j); it; ++it)
+	      ++size;
+	    for (typename Types<U,V>::jacobianV_t::InnerIterator
+		   it (jac_v, j); it; ++it)
+	      ++size;
+	    sizes[j] = size;
+	  }
+
+        jac_uv.setZero ();
+        jac_uv.reserve (sizes);
+        mergeJacobians<U,V> (jac_uv, u, v, jac_u, jac_v, false);
+        jac_uv.makeCompressed ();
 
 #ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
         set_is_malloc_allowed (cur_malloc_allowed);
 #endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
       }
+
+      /// \brief Merge the sparse Jacobians of u and v into jac_uv.
+      ///
+      /// \param inPlace if true, overwrite the values of the compressed
+      /// matrix jac_uv, otherwise insert the coefficients in jac_uv (with
+      /// enough reserved space).
+      /// \return false if jac_uv does not have the merged pattern (in place
+      /// only).
+      template <typename U, typename V>
+      static bool mergeJacobians
+      (typename Types<U,V>::jacobian_ref jac_uv,
+       const typename Types<U,V>::vectorU_ref u,
+       const typename Types<U,V>::vectorV_ref v,
+       const typename Types<U,V>::jacobianU_ref jac_u,
+       const typename Types<U,V>::jacobianV_ref jac_v,
+       bool inPlace)
+      {
+        typedef typename Types<U,V>::jacobian_t jacobian_t;
+        typedef typename Types<U,V>::value_type value_type;
+        typedef typename jacobian_t::Index index_t;
+        typedef typename Types<U,V>::jacobianU_t::InnerIterator iteratorU_t;
+        typedef typename Types<U,V>::jacobianV_t::InnerIterator iteratorV_t;
+
+        for (index_t j = 0; j < jac_uv.outerSize (); ++j)
+	  {
+	    index_t p = inPlace ? jac_uv.outerIndexPtr ()[j] : 0;
+	    const index_t end = inPlace ? jac_uv.outerIndexPtr ()[j + 1] : 0;
+
+	    iteratorU_t itU (jac_u, j);
+	    iteratorV_t itV (jac_v, j);
+	    while (itU || itV)
+	      {
+		index_t row;
+		index_t col;
+		value_type value;
+
+		if (itV && (!itU || itV.index () < itU.index ()))
+		  {
+		    row = itV.row ();
+		    col = itV.col ();
+		    value = u[row] * itV.value ();
+		    ++itV;
+		  }
+		else if (!itV || itU.index () < itV.index ())
+		  {
+		    row = itU.row ();
+		    col = itU.col ();
+		    value = v[row] * itU.value ();
+		    ++itU;
+		  }
+		else
+		  {
+		    row = itU.row ();
+		    col = itU.col ();
+		    value = u[row] * itV.value () + v[row] * itU.value ();
+		    ++itU;
+		    ++itV;
+		  }
+
+		if (!inPlace)
+		  {
+		    jac_uv.insert (row, col) = value;
+		    continue;
+		  }
+
+		if (p == end
+		    || jac_uv.innerIndexPtr ()[p]
+		    != (jacobian_t::IsRowMajor ? col : row))
+		  return false;
+		jac_uv.valuePtr ()[p++] = value;
+	      }
+
+	    if (p != end)
+	      return false;
+	  }
+        return true;
+      }
     };
   } // end of namespace detail.
 
@@ -229,7 +273,11 @@ namespace roboptim
       jacobianLeft_ (left->outputSize (),
 		     left->inputSize ()),
       jacobianRight_ (left->outputSize (),
-		      left->inputSize ())
+		      left->inputSize ()),
+      hessianLeft_ (hessianBufferSize (left->inputSize ()),
+		    hessianBufferSize (left->inputSize ())),
+      hessianRight_ (hessianBufferSize (left->inputSize ()),
+		     hessianBufferSize (left->inputSize ()))
   {
     if (left->inputSize () != right->inputSize ()
 	|| left->outputSize () != right->outputSize ())
@@ -240,12 +288,33 @@ namespace roboptim
     gradientRight_.setZero ();
     jacobianLeft_.setZero ();
     jacobianRight_.setZero ();
+    hessianLeft_.setZero ();
+    hessianRight_.setZero ();
   }
 
   template <typename U, typename V>
   Product<U, V>::~Product ()
   {}
 
+  template <typename U, typename V>
+  void
+  Product<U, V>::evaluationState (std::vector<const void*>& objects)
+    const
+  {
+    objects.push_back (this);
+    left_->evaluationState (objects);
+    right_->evaluationState (objects);
+  }
+
+  template <typename U, typename V>
+  typename Product<U, V>::size_type
+  Product<U, V>::hessianBufferSize (size_type n)
+  {
+    // Hessian buffers are only needed by twice differentiable products.
+    return boost::is_base_of<twiceDifferentiable_t, parentType_t>::value
+      ? n : 0;
+  }
+
   template <typename U, typename V>
   void
   Product<U, V>::impl_compute
@@ -275,7 +344,7 @@ namespace roboptim
 
     // Compute gradient = ∂U V + ∂V U
     detail::ProductDifferentiation::gradient<U,V>
-      (gradient, resultLeft_, resultRight_,
+      (gradient, resultLeft_[functionId], resultRight_[functionId],
        gradientLeft_, gradientRight_);
   }
 
@@ -299,6 +368,43 @@ namespace roboptim
       (jacobian, resultLeft_, resultRight_,
        jacobianLeft_, jacobianRight_);
   }
+
+  template <typename U, typename V>
+  void
+  Product<U, V>::impl_hessian (hessian_ref hessian,
+			       const_argument_ref x,
+			       size_type functionId)
+    const
+  {
+    // Compute U, V and their derivatives
+    (*left_) (resultLeft_, x);
+    (*right_) (resultRight_, x);
+    gradientLeft_.setZero ();
+    gradientRight_.setZero ();
+    hessianLeft_.setZero ();
+    hessianRight_.setZero ();
+    left_->gradient (gradientLeft_, x, functionId);
+    right_->gradient (gradientRight_, x, functionId);
+    left_->hessian (hessianLeft_, x, functionId);
+    right_->hessian (hessianRight_, x, functionId);
+
+    const value_type u = resultLeft_[functionId];
+    const value_type v = resultRight_[functionId];
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    bool cur_malloc_allowed = is_malloc_allowed ();
+    set_is_malloc_allowed (true);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+    // Compute hessian = U ∂²V + V ∂²U + ∂U^T ∂V + ∂V^T ∂U
+    hessian = u * hessianRight_ + v * hessianLeft_
+      + gradientLeft_.transpose () * gradientRight_
+      + gradientRight_.transpose () * gradientLeft_;
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    set_is_malloc_allowed (cur_malloc_allowed);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+  }
 } // end of namespace roboptim.
 
 #endif //! ROBOPTIM_CORE_OPERATOR_PRODUCT_HXX
@@ -49,6 +49,9 @@ namespace roboptim
 		     value_type scalar);
     ~Scalar ();
 
+    virtual void evaluationState (std::vector<const void*>& objects)
+      const;
+
     const boost::shared_ptr<U>& origin () const
     {
       return origin_;
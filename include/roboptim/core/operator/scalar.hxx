@@ -39,6 +39,15 @@ namespace roboptim
   Scalar<U>::~Scalar ()
   {}
 
+  template <typename U>
+  void
+  Scalar<U>::evaluationState (std::vector<const void*>& objects)
+    const
+  {
+    objects.push_back (this);
+    origin_->evaluationState (objects);
+  }
+
   template <typename U>
   void
   Scalar<U>::impl_compute
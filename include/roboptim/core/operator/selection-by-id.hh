@@ -31,6 +31,13 @@ namespace roboptim
   /// @{
 
   /// \brief Select part of a function.
+  ///
+  /// If the input function can evaluate a subset of its outputs (see
+  /// GenericFunction::computeRows and
+  /// GenericDifferentiableFunction::jacobianRows), only the selected rows
+  /// are evaluated. Otherwise, the whole function is evaluated and the
+  /// selected outputs are extracted.
+  ///
   /// \tparam U input function type.
   template <typename U>
   class SelectionById : public detail::AutopromoteTrait<U>::T_type
@@ -45,6 +52,9 @@ namespace roboptim
 			    std::vector<bool> selector);
     ~SelectionById ();
 
+    virtual void evaluationState (std::vector<const void*>& objects)
+      const;
+
     const boost::shared_ptr<U>& origin () const
     {
       return origin_;
@@ -65,10 +75,24 @@ namespace roboptim
     void impl_jacobian (jacobian_ref jacobian,
 			const_argument_ref arg)
       const;
+
+    bool impl_compute_rows (result_ref result, const_argument_ref x,
+			    const indices_t& rows)
+      const;
+    bool impl_jacobian_rows (jacobian_ref jacobian,
+			     const_argument_ref arg,
+			     const indices_t& rows)
+      const;
+
   private:
     boost::shared_ptr<U> origin_;
     std::vector<bool> selector_;
 
+    /// \brief Selected rows of the input function.
+    indices_t rows_;
+    /// \brief Buffer used to forward row subsets to the input function.
+    mutable indices_t originRows_;
+
     mutable result_t result_;
     mutable gradient_t gradient_;
   };
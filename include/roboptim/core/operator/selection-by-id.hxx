@@ -19,6 +19,8 @@
 # define ROBOPTIM_CORE_OPERATOR_SELECTION_BY_ID_HXX
 # include <boost/format.hpp>
 
+# include <roboptim/core/detail/indices.hh>
+
 namespace roboptim
 {
   template <typename U>
@@ -33,6 +35,8 @@ namespace roboptim
 	% origin->getName ()).str ()),
       origin_ (origin),
       selector_ (selector),
+      rows_ (),
+      originRows_ (),
       result_ (origin->outputSize ()),
       gradient_ (origin->inputSize ())
   {
@@ -50,18 +54,35 @@ namespace roboptim
 	fmt % selector.size () % origin->outputSize ();
 	throw std::runtime_error (fmt.str ());
       }
+
+    for (std::size_t i = 0; i < selector_.size (); ++i)
+      if (selector_[i])
+	rows_.push_back (static_cast<size_type> (i));
+    originRows_.reserve (rows_.size ());
   }
 
   template <typename U>
   SelectionById<U>::~SelectionById ()
   {}
 
+  template <typename U>
+  void
+  SelectionById<U>::evaluationState (std::vector<const void*>& objects)
+    const
+  {
+    objects.push_back (this);
+    origin_->evaluationState (objects);
+  }
+
   template <typename U>
   void
   SelectionById<U>::impl_compute
   (result_ref result, const_argument_ref x)
     const
   {
+    if (origin_->computeRows (result, x, rows_))
+      return;
+
     origin_->operator () (result_, x);
 
     size_type id = 0;
@@ -73,8 +94,8 @@ namespace roboptim
   // The gradient size depends on the input size which is not varying
   // as we are filtering output but not input here.
   //
-  // The only different value is the functionId value which may be lower
-  // if some outputs have been filtered out.
+  // The only different value is the functionId value which maps to the
+  // functionId-th selected output.
   template <typename U>
   void
   SelectionById<U>::impl_gradient (gradient_ref gradient,
@@ -82,12 +103,8 @@ namespace roboptim
 				   size_type functionId)
     const
   {
-    size_type functionIdUpdated = functionId;
-    for (size_type element = 0; element < functionId; ++element)
-      if (selector_[static_cast<std::size_t> (element)])
-	functionIdUpdated--;
-
-    origin_->gradient (gradient, argument, functionIdUpdated);
+    origin_->gradient (gradient, argument,
+		       rows_[static_cast<std::size_t> (functionId)]);
   }
 
   template <typename U>
@@ -96,6 +113,9 @@ namespace roboptim
 				   const_argument_ref argument)
     const
   {
+    if (origin_->jacobianRows (jacobian, argument, rows_))
+      return;
+
     size_type row = 0;
     for (size_type functionId = 0;
 	 functionId < origin_->outputSize (); ++functionId)
@@ -110,6 +130,28 @@ namespace roboptim
       }
   }
 
+  template <typename U>
+  bool
+  SelectionById<U>::impl_compute_rows (result_ref result,
+				       const_argument_ref x,
+				       const indices_t& rows)
+    const
+  {
+    return origin_->computeRows
+      (result, x, detail::map_indices (rows, rows_, originRows_));
+  }
+
+  template <typename U>
+  bool
+  SelectionById<U>::impl_jacobian_rows (jacobian_ref jacobian,
+					const_argument_ref argument,
+					const indices_t& rows)
+    const
+  {
+    return origin_->jacobianRows
+      (jacobian, argument, detail::map_indices (rows, rows_, originRows_));
+  }
+
 } // end of namespace roboptim.
 
 #endif //! ROBOPTIM_CORE_OPERATOR_SELECTION_BY_ID_HXX
@@ -32,6 +32,13 @@ namespace roboptim
 
   /// \brief Select a block of a function's output.
   /// The selected block is a range given by a start and a size.
+  ///
+  /// If the input function can evaluate a subset of its outputs (see
+  /// GenericFunction::computeRows and
+  /// GenericDifferentiableFunction::jacobianRows), only the selected rows
+  /// are evaluated. Otherwise, the whole function is evaluated and the
+  /// block is extracted.
+  ///
   /// \tparam U input function type.
   template <typename U>
   class Selection : public detail::AutopromoteTrait<U>::T_type
@@ -50,6 +57,9 @@ namespace roboptim
 			size_type start, size_type size);
     ~Selection ();
 
+    virtual void evaluationState (std::vector<const void*>& objects)
+      const;
+
     const boost::shared_ptr<U>& origin () const
     {
       return origin_;
@@ -70,12 +80,26 @@ namespace roboptim
     void impl_jacobian (jacobian_ref jacobian,
 			const_argument_ref arg)
       const;
+
+    bool impl_compute_rows (result_ref result, const_argument_ref x,
+			    const indices_t& rows)
+      const;
+    bool impl_jacobian_rows (jacobian_ref jacobian,
+			     const_argument_ref arg,
+			     const indices_t& rows)
+      const;
+
   private:
     boost::shared_ptr<U> origin_;
 
     size_type start_;
     size_type size_;
 
+    /// \brief Selected rows of the input function.
+    indices_t rows_;
+    /// \brief Buffer used to forward row subsets to the input function.
+    mutable indices_t originRows_;
+
     mutable result_t result_;
     mutable gradient_t gradient_;
     mutable jacobian_t jacobian_;
@@ -19,6 +19,8 @@
 # define ROBOPTIM_CORE_OPERATOR_SELECTION_HXX
 # include <boost/format.hpp>
 
+# include <roboptim/core/detail/indices.hh>
+
 namespace roboptim
 {
   template <typename U>
@@ -34,13 +36,19 @@ namespace roboptim
       origin_ (origin),
       start_ (start),
       size_ (size),
+      rows_ (static_cast<std::size_t> (size)),
+      originRows_ (),
       result_ (origin->outputSize ()),
       jacobian_ (origin->outputSize (),
 		 origin->inputSize ())
   {
-    if (start + size > origin->inputSize ())
+    if (start + size > origin->outputSize ())
       throw std::runtime_error ("invalid start/size");
 
+    for (std::size_t i = 0; i < rows_.size (); ++i)
+      rows_[i] = start + static_cast<size_type> (i);
+    originRows_.reserve (rows_.size ());
+
     result_.setZero ();
     gradient_.setZero ();
     jacobian_.setZero ();
@@ -50,12 +58,24 @@ namespace roboptim
   Selection<U>::~Selection ()
   {}
 
+  template <typename U>
+  void
+  Selection<U>::evaluationState (std::vector<const void*>& objects)
+    const
+  {
+    objects.push_back (this);
+    origin_->evaluationState (objects);
+  }
+
   template <typename U>
   void
   Selection<U>::impl_compute
   (result_ref result, const_argument_ref x)
     const
   {
+    if (origin_->computeRows (result, x, rows_))
+      return;
+
     origin_->operator () (result_, x);
     result = result_.segment (start_, size_);
   }
@@ -67,7 +87,7 @@ namespace roboptim
 			 size_type functionId)
     const
   {
-    origin_->gradient (gradient, argument, functionId);
+    origin_->gradient (gradient, argument, start_ + functionId);
   }
 
   template <typename U>
@@ -76,10 +96,35 @@ namespace roboptim
 			 const_argument_ref argument)
     const
   {
+    if (origin_->jacobianRows (jacobian, argument, rows_))
+      return;
+
     origin_->jacobian (jacobian_, argument);
     jacobian = jacobian_.block (start_, 0, size_, jacobian_.cols ());
   }
 
+  template <typename U>
+  bool
+  Selection<U>::impl_compute_rows (result_ref result,
+				   const_argument_ref x,
+				   const indices_t& rows)
+    const
+  {
+    return origin_->computeRows
+      (result, x, detail::map_indices (rows, rows_, originRows_));
+  }
+
+  template <typename U>
+  bool
+  Selection<U>::impl_jacobian_rows (jacobian_ref jacobian,
+				    const_argument_ref argument,
+				    const indices_t& rows)
+    const
+  {
+    return origin_->jacobianRows
+      (jacobian, argument, detail::map_indices (rows, rows_, originRows_));
+  }
+
 } // end of namespace roboptim.
 
 #endif //! ROBOPTIM_CORE_OPERATOR_SELECTION_HXX
@@ -18,6 +18,8 @@
 #ifndef ROBOPTIM_CORE_OPERATOR_SPLIT_HH
 # define ROBOPTIM_CORE_OPERATOR_SPLIT_HH
 # include <stdexcept>
+# include <vector>
+
 # include <boost/shared_ptr.hpp>
 
 # include <roboptim/core/n-times-derivable-function.hh>
@@ -27,7 +29,98 @@ namespace roboptim
   /// \addtogroup roboptim_operator
   /// @{
 
+  /// \brief Evaluation of a function shared by several Split operators.
+  ///
+  /// The last point at which the value, the Jacobian and each Hessian of
+  /// the function were computed is recorded: asking again for the same
+  /// point (exactly) returns the stored matrices. Split operators
+  /// selecting different outputs of the same function at the same point
+  /// thus only evaluate the function once.
+  ///
+  /// Since the record is shared, Split operators using the same record
+  /// must not be evaluated concurrently. They report the record in their
+  /// evaluation state (see GenericFunction::evaluationState), so that
+  /// Problem, Stack and FunctionPool evaluate them sequentially.
+  ///
+  /// \tparam T input function type.
+  template <typename T>
+  class SplitEvaluation
+  {
+  public:
+    /// \brief Import traits type.
+    typedef typename T::traits_t traits_t;
+
+    ROBOPTIM_TWICE_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_
+    (GenericTwiceDifferentiableFunction<traits_t>);
+
+    /// \brief Create an evaluation record.
+    /// \param fct function shared by the Split operators.
+    explicit SplitEvaluation (boost::shared_ptr<const T> fct);
+
+    /// \brief Shared function.
+    const boost::shared_ptr<const T>& function () const
+    {
+      return function_;
+    }
+
+    /// \brief Evaluate the function, or return the recorded result.
+    /// \param argument point at which the function is evaluated.
+    /// \return result of the function at this point.
+    const result_t& compute (const_argument_ref argument);
+
+    /// \brief Compute the Jacobian, or return the recorded one.
+    /// \param argument point at which the Jacobian is computed.
+    /// \return Jacobian of the function at this point.
+    const jacobian_t& jacobian (const_argument_ref argument);
+
+    /// \brief Compute a Hessian, or return the recorded one.
+    /// \param argument point at which the Hessian is computed.
+    /// \param functionId output of the function.
+    /// \return Hessian of the output at this point.
+    const hessian_t& hessian (const_argument_ref argument,
+			      size_type functionId);
+
+    /// \brief Forget the recorded evaluations.
+    ///
+    /// This must be called if the function changed (e.g. parameters of
+    /// the function were modified).
+    void reset ();
+
+  private:
+    /// \brief Shared function.
+    boost::shared_ptr<const T> function_;
+
+    /// \brief Point of the recorded result.
+    argument_t resultArgument_;
+    /// \brief Whether the result was recorded.
+    bool hasResult_;
+    /// \brief Recorded result.
+    result_t result_;
+
+    /// \brief Point of the recorded Jacobian.
+    argument_t jacobianArgument_;
+    /// \brief Whether the Jacobian was recorded.
+    bool hasJacobian_;
+    /// \brief Recorded Jacobian.
+    jacobian_t jacobian_;
+
+    /// \brief Points of the recorded Hessians.
+    std::vector<argument_t> hessianArguments_;
+    /// \brief Whether each Hessian was recorded.
+    std::vector<bool> hasHessian_;
+    /// \brief Recorded Hessians (allocated on first use).
+    std::vector<hessian_t> hessians_;
+  };
+
   /// \brief Select an element of a function's output.
+  ///
+  /// If the input function can evaluate a subset of its outputs (see
+  /// GenericFunction::computeRows), only the selected output is evaluated.
+  ///
+  /// Several Split operators can share a SplitEvaluation record: the
+  /// function is then evaluated once per point for all of them, and the
+  /// gradients are read from the rows of a single Jacobian.
+  ///
   /// \tparam T input function type.
   template <typename T>
   class Split : public T
@@ -47,8 +140,24 @@ namespace roboptim
     /// \param functionId index of the output to select.
     explicit Split (boost::shared_ptr<const T> fct,
 		    size_type functionId);
+
+    /// \brief Split operator constructor sharing the evaluations of the
+    /// input function.
+    /// \param evaluation evaluation record of the input function.
+    /// \param functionId index of the output to select.
+    Split (boost::shared_ptr<SplitEvaluation<T> > evaluation,
+	   size_type functionId);
     ~Split ();
 
+    virtual void evaluationState (std::vector<const void*>& objects)
+      const;
+
+    /// \brief Shared evaluation record (null if not shared).
+    const boost::shared_ptr<SplitEvaluation<T> >& evaluation () const
+    {
+      return evaluation_;
+    }
+
   protected:
     virtual void impl_compute (result_ref result, const_argument_ref argument)
       const;
@@ -69,17 +178,46 @@ namespace roboptim
 
   private:
     boost::shared_ptr<const T> function_;
+    /// \brief Evaluation record shared with other Split operators.
+    boost::shared_ptr<SplitEvaluation<T> > evaluation_;
     size_type functionId_;
+    /// \brief Evaluated row of the split function.
+    indices_t rows_;
     mutable result_t res_;
   };
 
+  /// \brief Split all the outputs of a function.
+  ///
+  /// \param fct input function.
+  /// \param shareEvaluation whether the Split operators share the
+  /// evaluations of the function (see SplitEvaluation). This is off by
+  /// default: shared evaluations must be reset when the function changes,
+  /// and the Split operators can then not be evaluated concurrently.
+  /// \return one Split operator per output of the function.
+  template <typename T>
+  std::vector<boost::shared_ptr<Split<T> > >
+  split (boost::shared_ptr<const T> fct, bool shareEvaluation = false);
+
+  /// \brief Add each output of a constraint as a scalar constraint.
+  ///
+  /// The scalar constraints are Split operators (see split). If they
+  /// share the evaluations of the constraint, the problem evaluates them
+  /// sequentially, even if Problem::evaluationThreads is set.
+  ///
+  /// \param problem problem the constraints are added to.
+  /// \param constraint constraint to split.
+  /// \param interval bounds of each output.
+  /// \param scale scaling of each output (optional).
+  /// \param shareEvaluation whether the Split operators share the
+  /// evaluations of the constraint.
   template <typename P, typename C>
   void addNonScalarConstraint
   (P& problem,
    boost::shared_ptr<C> constraint,
    std::vector<Function::interval_t> interval,
    std::vector<Function::value_type> scale
-   = std::vector<Function::value_type> ());
+   = std::vector<Function::value_type> (),
+   bool shareEvaluation = false);
 
   /// @}
 
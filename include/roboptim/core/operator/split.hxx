@@ -17,8 +17,11 @@
 
 #ifndef ROBOPTIM_CORE_OPERATOR_SPLIT_HXX
 # define ROBOPTIM_CORE_OPERATOR_SPLIT_HXX
+# include <algorithm>
+
 # include <boost/format.hpp>
 
+# include <roboptim/core/alloc.hh>
 # include <roboptim/core/debug.hh>
 # include <roboptim/core/derivative-size.hh>
 
@@ -39,28 +42,152 @@ namespace roboptim
     }
   } // end of anonymous namespace.
 
+  template <typename T>
+  SplitEvaluation<T>::SplitEvaluation (boost::shared_ptr<const T> fct)
+    : function_ (fct),
+      resultArgument_ (fct->inputSize ()),
+      hasResult_ (false),
+      result_ (fct->outputSize ()),
+      jacobianArgument_ (fct->inputSize ()),
+      hasJacobian_ (false),
+      jacobian_ (fct->outputSize (), fct->inputSize ()),
+      hessianArguments_ (static_cast<std::size_t> (fct->outputSize ()),
+			 argument_t (fct->inputSize ())),
+      hasHessian_ (static_cast<std::size_t> (fct->outputSize ()), false),
+      hessians_ ()
+  {
+    result_.setZero ();
+    jacobian_.setZero ();
+  }
+
+  template <typename T>
+  const typename SplitEvaluation<T>::result_t&
+  SplitEvaluation<T>::compute (const_argument_ref argument)
+  {
+    if (hasResult_ && resultArgument_ == argument)
+      return result_;
+
+    (*function_) (result_, argument);
+    resultArgument_ = argument;
+    hasResult_ = true;
+    return result_;
+  }
+
+  template <typename T>
+  const typename SplitEvaluation<T>::jacobian_t&
+  SplitEvaluation<T>::jacobian (const_argument_ref argument)
+  {
+    if (hasJacobian_ && jacobianArgument_ == argument)
+      return jacobian_;
+
+    jacobian_.setZero ();
+    function_->jacobian (jacobian_, argument);
+    jacobianArgument_ = argument;
+    hasJacobian_ = true;
+    return jacobian_;
+  }
+
+  template <typename T>
+  const typename SplitEvaluation<T>::hessian_t&
+  SplitEvaluation<T>::hessian (const_argument_ref argument,
+			       size_type functionId)
+  {
+    const std::size_t id = static_cast<std::size_t> (functionId);
+
+    if (hessians_.empty ())
+      {
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+	bool cur_malloc_allowed = is_malloc_allowed ();
+	set_is_malloc_allowed (true);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+	hessians_.resize (hasHessian_.size (),
+			  hessian_t (function_->inputSize (),
+				     function_->inputSize ()));
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+	set_is_malloc_allowed (cur_malloc_allowed);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+      }
+
+    if (hasHessian_[id] && hessianArguments_[id] == argument)
+      return hessians_[id];
+
+    hessians_[id].setZero ();
+    function_->hessian (hessians_[id], argument, functionId);
+    hessianArguments_[id] = argument;
+    hasHessian_[id] = true;
+    return hessians_[id];
+  }
+
+  template <typename T>
+  void
+  SplitEvaluation<T>::reset ()
+  {
+    hasResult_ = false;
+    hasJacobian_ = false;
+    std::fill (hasHessian_.begin (), hasHessian_.end (), false);
+  }
+
   template <typename T>
   Split<T>::Split (boost::shared_ptr<const T> fct,
 		   size_type functionId)
     : T (fct->inputSize (), 1, splitName (*fct, functionId)),
       function_ (fct),
+      evaluation_ (),
       functionId_ (functionId),
+      rows_ (1, functionId),
       res_ (function_->outputSize ())
   {
     assert (functionId < fct->outputSize ());
   }
 
+  template <typename T>
+  Split<T>::Split (boost::shared_ptr<SplitEvaluation<T> > evaluation,
+		   size_type functionId)
+    : T (evaluation->function ()->inputSize (), 1,
+	 splitName (*evaluation->function (), functionId)),
+      function_ (evaluation->function ()),
+      evaluation_ (evaluation),
+      functionId_ (functionId),
+      rows_ (1, functionId),
+      res_ ()
+  {
+    assert (functionId < function_->outputSize ());
+  }
+
   template <typename T>
   Split<T>::~Split ()
   {
   }
 
+  template <typename T>
+  void
+  Split<T>::evaluationState (std::vector<const void*>& objects)
+    const
+  {
+    objects.push_back (this);
+    function_->evaluationState (objects);
+    // The record is modified by all the Split operators sharing it.
+    if (evaluation_)
+      objects.push_back (evaluation_.get ());
+  }
+
   template <typename T>
   void
   Split<T>::impl_compute (result_ref result,
 			  const_argument_ref argument)
     const
   {
+    if (evaluation_)
+      {
+	result[0] = evaluation_->compute (argument)[functionId_];
+	return;
+      }
+
+    if (function_->computeRows (result, argument, rows_))
+      return;
+
     (*function_) (this->res_, argument);
     result[0] = this->res_[functionId_];
   }
@@ -82,7 +209,11 @@ namespace roboptim
     const
   {
     assert (functionId == 0);
-    function_->gradient (gradient, argument, functionId_);
+
+    if (evaluation_)
+      gradient = evaluation_->jacobian (argument).row (functionId_);
+    else
+      function_->gradient (gradient, argument, functionId_);
   }
 
 
@@ -114,7 +245,11 @@ namespace roboptim
     const
   {
     assert (functionId == 0);
-    function_->hessian (hessian, argument, functionId_);
+
+    if (evaluation_)
+      hessian = evaluation_->hessian (argument, functionId_);
+    else
+      function_->hessian (hessian, argument, functionId_);
   }
 
 
@@ -152,12 +287,30 @@ namespace roboptim
     function_->derivative (derivative, argument, order);
   }
 
+  template <typename T>
+  std::vector<boost::shared_ptr<Split<T> > >
+  split (boost::shared_ptr<const T> fct, bool shareEvaluation)
+  {
+    boost::shared_ptr<SplitEvaluation<T> > evaluation;
+    if (shareEvaluation)
+      evaluation.reset (new SplitEvaluation<T> (fct));
+
+    std::vector<boost::shared_ptr<Split<T> > > splits;
+    for (typename Split<T>::size_type i = 0; i < fct->outputSize (); ++i)
+      splits.push_back
+	(boost::shared_ptr<Split<T> > (shareEvaluation
+				       ? new Split<T> (evaluation, i)
+				       : new Split<T> (fct, i)));
+    return splits;
+  }
+
   template <typename P, typename C>
   void addNonScalarConstraint
   (P& problem,
    boost::shared_ptr<C> constraint,
    std::vector<Function::interval_t> interval,
-   std::vector<Function::value_type> scaling)
+   std::vector<Function::value_type> scaling,
+   bool shareEvaluation)
   {
     assert (constraint);
     assert (interval.size () == constraint->outputSize ());
@@ -171,13 +324,14 @@ namespace roboptim
 	problem.addConstraint (constraint, interval[0], scaling[0]);
       return;
     }
-    for (unsigned i = 0; i < constraint->outputSize (); ++i)
+    std::vector<boost::shared_ptr<Split<C> > > splits =
+      split<C> (constraint, shareEvaluation);
+    for (std::size_t i = 0; i < splits.size (); ++i)
       {
-	boost::shared_ptr<Split<C> > split (new Split<C> (constraint, i));
 	if (scaling.empty ())
-	  problem.addConstraint (split, interval[i]);
+	  problem.addConstraint (splits[i], interval[i]);
 	else
-	  problem.addConstraint (split, interval[i], scaling[i]);
+	  problem.addConstraint (splits[i], interval[i], scaling[i]);
       }
   }
 } // end of namespace roboptim
@@ -0,0 +1,167 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_OPERATOR_STACK_HH
+# define ROBOPTIM_CORE_OPERATOR_STACK_HH
+# include <string>
+# include <vector>
+
+# include <boost/make_shared.hpp>
+# include <boost/shared_ptr.hpp>
+
+# include <roboptim/core/detail/autopromote.hh>
+# include <roboptim/core/differentiable-function.hh>
+# include <roboptim/core/jacobian-structure.hh>
+
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_operator
+  /// @{
+
+  /// \brief Stack the outputs of several functions.
+  ///
+  /// Input: (size: input size of the functions)
+  ///  x
+  ///
+  /// Output: (size: sum of the output sizes of the functions)
+  ///  [f_0 (x) f_1 (x) ... f_N (x)]
+  ///
+  /// This is the n-ary version of Concatenate. Each function is evaluated
+  /// directly in its segment of the result (resp. its row block of a
+  /// dense Jacobian), without any intermediate copy. With sparse matrices,
+  /// each function is evaluated in its own buffer, and the blocks are
+  /// copied to their preassigned slots in the Jacobian, so that the
+  /// pattern of the Jacobian is only built once.
+  ///
+  /// \tparam U input functions type.
+  template <typename U>
+  class Stack : public detail::AutopromoteTrait<U>::T_type
+  {
+  public:
+    typedef typename detail::AutopromoteTrait<U>::T_type parentType_t;
+    ROBOPTIM_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_ (parentType_t);
+
+    /// \brief Traits type.
+    typedef typename parentType_t::traits_t traits_t;
+
+    typedef boost::shared_ptr<Stack> StackShPtr_t;
+
+    /// \brief Vector of functions.
+    typedef std::vector<boost::shared_ptr<U> > functions_t;
+
+    /// \brief Stack operator constructor.
+    ///
+    /// \param functions functions to stack, in this order.
+    /// \throw std::runtime_error if there is no function, or if the
+    /// functions do not have the same input size.
+    explicit Stack (const functions_t& functions);
+    ~Stack ();
+
+    virtual void evaluationState (std::vector<const void*>& objects)
+      const;
+
+    /// \brief Stacked functions.
+    const functions_t& functions () const
+    {
+      return functions_;
+    }
+
+    /// \brief Maximum number of threads used to evaluate the functions.
+    ///
+    /// Each function writes to its own output, so the result does not
+    /// depend on the number of threads. This requires RobOptim to be
+    /// compiled with OpenMP support. Functions modifying a common object
+    /// (see GenericFunction::evaluationState), e.g. a function stacked
+    /// twice, disable the parallel evaluation.
+    ///
+    /// \return reference on the number of threads (default: 1, i.e.
+    /// sequential evaluation).
+    int& evaluationThreads ()
+    {
+      return evaluationThreads_;
+    }
+
+    /// \brief Maximum number of threads used to evaluate the functions.
+    /// \return number of threads.
+    int evaluationThreads () const
+    {
+      return evaluationThreads_;
+    }
+
+    void impl_compute (result_ref result, const_argument_ref x)
+      const;
+
+    void impl_gradient (gradient_ref gradient,
+			const_argument_ref argument,
+			size_type functionId = 0)
+      const;
+    void impl_jacobian (jacobian_ref jacobian,
+			const_argument_ref arg)
+      const;
+
+  private:
+    /// \brief Input size of the functions.
+    /// \throw std::runtime_error if there is no function, or if the
+    /// functions do not have the same input size.
+    static size_type listInputSize (const functions_t& functions);
+
+    /// \brief Sum of the output sizes of the functions.
+    static size_type listOutputSize (const functions_t& functions);
+
+    /// \brief Name of the operator.
+    static std::string listName (const functions_t& functions);
+
+    /// \brief Number of threads that can actually be used.
+    int parallelThreads () const;
+
+    /// \brief Stacked functions.
+    functions_t functions_;
+
+    /// \brief First row of each function in the output.
+    std::vector<size_type> rows_;
+
+    /// \brief Maximum number of threads used to evaluate the functions.
+    int evaluationThreads_;
+
+    /// \brief Whether the functions can be evaluated concurrently.
+    bool distinct_;
+
+    /// \brief Jacobian buffers of the functions (sparse matrices only).
+    mutable std::vector<jacobian_t> blocks_;
+
+    /// \brief Structure of the stacked Jacobian (sparse matrices only).
+    mutable JacobianStructure structure_;
+  };
+
+  /// \brief Stack the outputs of several functions.
+  ///
+  /// This will instantiate a Stack<U> RobOptim operator that will
+  /// realize the underlying computations.
+  template <typename U>
+  boost::shared_ptr<Stack<U> >
+  stack (const std::vector<boost::shared_ptr<U> >& functions)
+  {
+    return boost::make_shared<Stack<U> > (functions);
+  }
+
+  /// @}
+
+} // end of namespace roboptim.
+
+# include <roboptim/core/operator/stack.hxx>
+#endif //! ROBOPTIM_CORE_OPERATOR_STACK_HH
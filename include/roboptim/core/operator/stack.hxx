@@ -0,0 +1,238 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_OPERATOR_STACK_HXX
+# define ROBOPTIM_CORE_OPERATOR_STACK_HXX
+# include <algorithm>
+# include <stdexcept>
+# include <vector>
+
+# include <boost/format.hpp>
+# include <boost/type_traits/is_same.hpp>
+
+# include <roboptim/core/detail/parallel.hh>
+# include <roboptim/core/detail/parallel-jacobian.hh>
+
+namespace roboptim
+{
+  namespace detail
+  {
+    /// \brief Evaluate a function of a Stack operator into its segment of
+    /// the result.
+    template <typename U>
+    struct StackCompute
+    {
+      typedef std::vector<boost::shared_ptr<U> > functions_t;
+      typedef typename U::size_type size_type;
+
+      StackCompute (const functions_t& functions,
+		    const std::vector<size_type>& rows,
+		    typename U::result_ref result,
+		    typename U::const_argument_ref x)
+	: functions_ (functions),
+	  rows_ (rows),
+	  result_ (result),
+	  x_ (x)
+      {}
+
+      void operator () (std::size_t i)
+      {
+	const U& f = *functions_[i];
+	f (result_.segment (rows_[i], f.outputSize ()), x_);
+      }
+
+      const functions_t& functions_;
+      const std::vector<size_type>& rows_;
+      typename U::result_ref result_;
+      typename U::const_argument_ref x_;
+    };
+
+    /// \brief Evaluate the Jacobian of a function of a Stack operator
+    /// into its row block (dense matrices) or into its buffer (sparse
+    /// matrices).
+    template <typename U>
+    struct StackJacobian
+    {
+      typedef std::vector<boost::shared_ptr<U> > functions_t;
+      typedef typename U::size_type size_type;
+      typedef typename U::jacobian_t jacobian_t;
+
+      StackJacobian (const functions_t& functions,
+		     const std::vector<size_type>& rows,
+		     std::vector<jacobian_t>& blocks,
+		     JacobianStructure& structure,
+		     typename U::jacobian_ref jacobian,
+		     typename U::const_argument_ref x)
+	: functions_ (functions),
+	  rows_ (rows),
+	  blocks_ (blocks),
+	  structure_ (structure),
+	  jacobian_ (jacobian),
+	  x_ (x)
+      {}
+
+      void operator () (std::size_t i)
+      {
+	const U& f = *functions_[i];
+	evaluate_block (f, jacobian_block (jacobian_, blocks_, i, rows_[i], 0,
+					   f.outputSize (), f.inputSize ()),
+			x_);
+      }
+
+      void assemble ()
+      {
+	assemble_rows (jacobian_, blocks_, structure_, jacobian_.cols ());
+      }
+
+      const functions_t& functions_;
+      const std::vector<size_type>& rows_;
+      std::vector<jacobian_t>& blocks_;
+      JacobianStructure& structure_;
+      typename U::jacobian_ref jacobian_;
+      typename U::const_argument_ref x_;
+    };
+  } // end of namespace detail.
+
+  template <typename U>
+  Stack<U>::Stack (const functions_t& functions)
+    : detail::AutopromoteTrait<U>::T_type
+      (listInputSize (functions),
+       listOutputSize (functions),
+       listName (functions)),
+      functions_ (functions),
+      rows_ (functions.size ()),
+      evaluationThreads_ (1),
+      distinct_ (true),
+      blocks_ (),
+      structure_ ()
+  {
+    size_type row = 0;
+    for (std::size_t i = 0; i < functions_.size (); ++i)
+      {
+	rows_[i] = row;
+	row += functions_[i]->outputSize ();
+      }
+
+    std::vector<const void*> objects;
+    for (std::size_t i = 0; i < functions_.size (); ++i)
+      detail::append_evaluation_state (objects, *functions_[i]);
+    distinct_ = detail::distinct_objects (objects);
+
+    if (!boost::is_same<traits_t, EigenMatrixDense>::value)
+      for (std::size_t i = 0; i < functions_.size (); ++i)
+	blocks_.push_back (jacobian_t (functions_[i]->outputSize (),
+				       this->inputSize ()));
+  }
+
+  template <typename U>
+  Stack<U>::~Stack ()
+  {}
+
+  template <typename U>
+  void
+  Stack<U>::evaluationState (std::vector<const void*>& objects) const
+  {
+    objects.push_back (this);
+    for (std::size_t i = 0; i < functions_.size (); ++i)
+      functions_[i]->evaluationState (objects);
+  }
+
+  template <typename U>
+  void
+  Stack<U>::impl_compute
+  (result_ref result, const_argument_ref x)
+    const
+  {
+    detail::StackCompute<U> f (functions_, rows_, result, x);
+    detail::parallel_for (functions_.size (), parallelThreads (), f);
+  }
+
+  template <typename U>
+  void
+  Stack<U>::impl_gradient (gradient_ref gradient,
+			   const_argument_ref x,
+			   size_type functionId)
+    const
+  {
+    // Find the function computing this output.
+    const std::size_t i = static_cast<std::size_t>
+      (std::upper_bound (rows_.begin (), rows_.end (), functionId)
+       - rows_.begin ()) - 1;
+
+    functions_[i]->gradient (gradient, x, functionId - rows_[i]);
+  }
+
+  template <typename U>
+  void
+  Stack<U>::impl_jacobian (jacobian_ref jacobian,
+			   const_argument_ref x)
+    const
+  {
+    detail::StackJacobian<U> f (functions_, rows_, blocks_, structure_,
+				jacobian, x);
+    detail::parallel_jacobian (functions_.size (), parallelThreads (), f,
+			       !blocks_.empty ());
+  }
+
+  template <typename U>
+  typename Stack<U>::size_type
+  Stack<U>::listInputSize (const functions_t& functions)
+  {
+    if (functions.empty ())
+      throw std::runtime_error ("no function to stack");
+
+    const size_type inputSize = functions[0]->inputSize ();
+    for (std::size_t i = 1; i < functions.size (); ++i)
+      if (functions[i]->inputSize () != inputSize)
+	throw std::runtime_error
+	  ((boost::format ("input size of function %1% does not match:"
+			   " expected %2%, got %3%")
+	    % i % inputSize % functions[i]->inputSize ()).str ());
+
+    return inputSize;
+  }
+
+  template <typename U>
+  typename Stack<U>::size_type
+  Stack<U>::listOutputSize (const functions_t& functions)
+  {
+    size_type outputSize = 0;
+    for (std::size_t i = 0; i < functions.size (); ++i)
+      outputSize += functions[i]->outputSize ();
+    return outputSize;
+  }
+
+  template <typename U>
+  std::string
+  Stack<U>::listName (const functions_t& functions)
+  {
+    std::string names;
+    for (std::size_t i = 0; i < functions.size (); ++i)
+      names += (i > 0 ? ", " : "") + functions[i]->getName ();
+    return (boost::format ("stack(%1%)") % names).str ();
+  }
+
+  template <typename U>
+  int
+  Stack<U>::parallelThreads () const
+  {
+    return detail::parallel_threads (evaluationThreads_, distinct_);
+  }
+
+} // end of namespace roboptim.
+
+#endif //! ROBOPTIM_CORE_OPERATOR_STACK_HXX
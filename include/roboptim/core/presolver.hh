@@ -0,0 +1,325 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_PRESOLVER_HH
+# define ROBOPTIM_CORE_PRESOLVER_HH
+
+# include <vector>
+
+# include <boost/shared_ptr.hpp>
+
+# include <roboptim/core/numeric-linear-function.hh>
+# include <roboptim/core/problem.hh>
+# include <roboptim/core/result.hh>
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_problem
+  /// @{
+
+  /// \brief Reduce a problem before solving it, and map the solution back.
+  ///
+  /// The presolver builds a smaller problem equivalent to the input one:
+  ///   - fixed variables (equal lower and upper bounds) are removed,
+  ///   - rows of numeric linear constraints with a single free variable
+  ///     are turned into argument bounds,
+  ///   - rows of numeric linear constraints that are implied by the
+  ///     argument bounds are dropped, and their redundant sides are
+  ///     relaxed,
+  ///   - duplicate rows (with proportional coefficients) are merged, and
+  ///     their bounds are intersected.
+  ///
+  /// Rows with several free variables are not used to tighten the
+  /// argument bounds (activity-based tightening): the multiplier of such a
+  /// bound could not be mapped back to a single row.
+  ///
+  /// These reductions are applied until no more progress is made. Numeric
+  /// linear and quadratic functions are reduced directly, while other
+  /// functions are wrapped in a Bind operator when some variables are
+  /// fixed (they have to be differentiable then).
+  ///
+  /// Once the reduced problem is solved, postsolve expands its result
+  /// back to the input problem, including the Lagrange multipliers: the
+  /// multiplier of a bound that comes from a linear row is transferred to
+  /// that row, and the bound multipliers of fixed variables are recovered
+  /// from the stationarity of the Lagrangian
+  /// \f$f (x) + \lambda_c^T g (x) + \lambda_x^T x\f$.
+  ///
+  /// \tparam T matrix type (dense or sparse).
+  template <typename T>
+  class Presolver
+  {
+  public:
+    typedef Problem<T> problem_t;
+    typedef typename problem_t::function_t function_t;
+    typedef typename problem_t::value_type value_type;
+    typedef typename problem_t::size_type size_type;
+    typedef typename problem_t::vector_t vector_t;
+    typedef typename problem_t::argument_t argument_t;
+    typedef typename problem_t::jacobian_t jacobian_t;
+    typedef typename problem_t::intervals_t intervals_t;
+    typedef typename problem_t::scaling_t scaling_t;
+    typedef typename problem_t::constraint_t constraint_t;
+    typedef GenericDifferentiableFunction<T> differentiableFunction_t;
+
+    /// \brief Presolve a problem.
+    ///
+    /// \param pb input problem.
+    /// \param epsilon tolerance used for feasibility and proportionality
+    /// checks.
+    /// \throw std::runtime_error if the problem is detected as infeasible,
+    /// or if a non-differentiable function depends on a fixed variable.
+    explicit Presolver (const problem_t& pb, value_type epsilon = 1e-9);
+
+    virtual ~Presolver ();
+
+    /// \brief Reduced problem.
+    const boost::shared_ptr<problem_t>& problem () const
+    {
+      return reduced_;
+    }
+
+    /// \brief Number of removed variables.
+    size_type removedVariables () const;
+
+    /// \brief Number of removed constraint rows.
+    size_type removedRows () const;
+
+    /// \brief Expand a result of the reduced problem.
+    ///
+    /// Constraint values are evaluated on the input problem. Multipliers
+    /// are expanded if the reduced result provides at least the argument
+    /// bounds and constraints multipliers.
+    ///
+    /// \param result result of the reduced problem.
+    /// \return result of the input problem.
+    Result postsolve (const Result& result) const;
+
+    /// \brief Print method.
+    /// \param o output stream.
+    /// \return modified output stream.
+    virtual std::ostream& print (std::ostream& o) const;
+
+  private:
+    /// \brief Origin of a bound.
+    ///
+    /// A bound on an argument or on a row either comes from the problem
+    /// itself, or from a linear row \f$g_r\f$ such that
+    /// \f$g_r = factor \times g + constant\f$ where g is the bounded
+    /// quantity. A multiplier \f$\lambda\f$ on the bound is then a
+    /// multiplier \f$\lambda / factor\f$ on the row.
+    struct Source
+    {
+      Source (size_type r = -1, value_type f = 1.)
+	: row (r),
+	  factor (f)
+      {
+      }
+
+      /// \brief Compose with a scaling factor.
+      Source scaled (value_type f) const
+      {
+	return Source (row, factor * f);
+      }
+
+      /// \brief Global row index, or -1 if the bound is not from a row.
+      size_type row;
+
+      /// \brief Scaling factor.
+      value_type factor;
+    };
+
+    /// \brief Row of a numeric linear constraint.
+    struct Row
+    {
+      /// \brief Constraint index.
+      std::size_t constraint;
+
+      /// \brief Global row index.
+      size_type row;
+
+      /// \brief Column indices.
+      std::vector<size_type> columns;
+
+      /// \brief Coefficients.
+      std::vector<value_type> values;
+
+      /// \brief Constant term.
+      value_type offset;
+
+      /// \brief Lower bound.
+      value_type lower;
+
+      /// \brief Upper bound.
+      value_type upper;
+
+      /// \brief Origin of the lower bound.
+      Source lowerSource;
+
+      /// \brief Origin of the upper bound.
+      Source upperSource;
+
+      /// \brief Whether the row was removed.
+      bool removed;
+    };
+
+    /// \brief Activity of a row over the free variables.
+    struct Activity
+    {
+      /// \brief Constant part (offset and fixed variables).
+      value_type constant;
+
+      /// \brief Minimum value of the row.
+      value_type min;
+
+      /// \brief Maximum value of the row.
+      value_type max;
+
+      /// \brief Number of free variables.
+      size_type free;
+
+      /// \brief Index of the last free variable in the row.
+      std::size_t last;
+    };
+
+    /// \brief Copy the rows of the numeric linear constraints to rows_.
+    void extractRows ();
+
+    /// \brief Split a row into its free entries and a constant term.
+    ///
+    /// \param row row of a numeric linear constraint.
+    /// \param columns columns of the free variables (output).
+    /// \param values coefficients of the free variables (output).
+    /// \return offset of the row plus the contribution of the fixed
+    /// variables.
+    value_type freeEntries (const Row& row,
+			    std::vector<size_type>& columns,
+			    std::vector<value_type>& values) const;
+
+    /// \brief Range of a row over the current argument bounds.
+    Activity activity (const Row& row) const;
+
+    /// \brief Remove constant and singleton rows, and relax the sides of
+    /// the rows that are implied by the argument bounds.
+    ///
+    /// \return whether a row or a bound changed.
+    bool simplifyRows ();
+
+    /// \brief Merge the rows whose free entries are proportional into
+    /// the first of them.
+    ///
+    /// \return whether a row was removed.
+    bool mergeDuplicates ();
+
+    /// \brief Intersect the bounds of an argument with new bounds, and
+    /// fix it if they are equal.
+    ///
+    /// \param j argument index.
+    /// \param lower new lower bound.
+    /// \param lowerSource origin of the new lower bound.
+    /// \param upper new upper bound.
+    /// \param upperSource origin of the new upper bound.
+    void tightenVariable (size_type j,
+			  value_type lower, const Source& lowerSource,
+			  value_type upper, const Source& upperSource);
+
+    /// \brief Remove an argument from the reduced problem.
+    ///
+    /// \param j argument index.
+    /// \param v value of the argument.
+    void fixVariable (size_type j, value_type v);
+
+    /// \brief Build the reduced problem from the remaining rows and the
+    /// free arguments.
+    void buildProblem ();
+
+    /// \brief Restrict a function to the free arguments.
+    ///
+    /// \param f function of the input problem.
+    /// \return f itself if no argument is fixed.
+    boost::shared_ptr<function_t>
+    reduceFunction (const boost::shared_ptr<function_t>& f) const;
+
+    /// \brief Restrict some rows of a numeric linear function to the free
+    /// arguments.
+    ///
+    /// \param f numeric linear function of the input problem.
+    /// \param rows kept rows of f.
+    boost::shared_ptr<function_t>
+    reduceLinear (const GenericNumericLinearFunction<T>& f,
+		  const std::vector<size_type>& rows) const;
+
+    /// \brief Report an infeasible problem.
+    ///
+    /// \param what infeasible argument or rows.
+    /// \throw std::runtime_error
+    void infeasible (const std::string& what) const;
+
+    /// \brief Copy of the input problem.
+    boost::shared_ptr<const problem_t> original_;
+
+    /// \brief Reduced problem.
+    boost::shared_ptr<problem_t> reduced_;
+
+    /// \brief Tolerance.
+    value_type epsilon_;
+
+    /// \brief Argument lower bounds.
+    vector_t lower_;
+
+    /// \brief Argument upper bounds.
+    vector_t upper_;
+
+    /// \brief Origins of argument lower bounds.
+    std::vector<Source> lowerSources_;
+
+    /// \brief Origins of argument upper bounds.
+    std::vector<Source> upperSources_;
+
+    /// \brief Whether arguments are fixed.
+    std::vector<bool> fixed_;
+
+    /// \brief Values of fixed arguments.
+    vector_t fixedValues_;
+
+    /// \brief Rows of numeric linear constraints.
+    std::vector<Row> rows_;
+
+    /// \brief Index in rows_ of each global row (-1 if not linear).
+    std::vector<long> rowIndices_;
+
+    /// \brief First global row of each constraint.
+    std::vector<size_type> constraintRows_;
+
+    /// \brief Reduced argument index of each argument (-1 if fixed).
+    std::vector<size_type> variables_;
+
+    /// \brief Number of free arguments.
+    size_type freeVariables_;
+
+    /// \brief Global row of the input problem for each reduced row.
+    std::vector<size_type> reducedRows_;
+  };
+
+  template <typename T>
+  std::ostream& operator<< (std::ostream& o, const Presolver<T>& p);
+
+  /// @}
+} // end of namespace roboptim
+
+# include <roboptim/core/presolver.hxx>
+#endif //! ROBOPTIM_CORE_PRESOLVER_HH
@@ -0,0 +1,827 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_PRESOLVER_HXX
+# define ROBOPTIM_CORE_PRESOLVER_HXX
+
+# include <algorithm>
+# include <cmath>
+# include <stdexcept>
+# include <string>
+
+# include <boost/format.hpp>
+# include <boost/make_shared.hpp>
+# include <boost/unordered_map.hpp>
+
+# include <roboptim/core/indent.hh>
+# include <roboptim/core/numeric-quadratic-function.hh>
+# include <roboptim/core/operator/bind.hh>
+
+namespace roboptim
+{
+  namespace detail
+  {
+    /// \internal
+    /// \brief Row-major sparse matrix used to iterate over rows.
+    typedef Eigen::SparseMatrix<Function::value_type, Eigen::RowMajor>
+    presolveMatrix_t;
+
+    /// \internal
+    /// \brief Index type of presolveMatrix_t.
+#if EIGEN_VERSION_AT_LEAST(3, 2, 90)
+    typedef presolveMatrix_t::StorageIndex presolveIndex_t;
+#else
+    typedef presolveMatrix_t::Index presolveIndex_t;
+#endif
+
+    /// \internal
+    /// \brief Triplet used to assemble reduced matrices.
+    typedef Eigen::Triplet<Function::value_type> presolveTriplet_t;
+
+    /// \internal
+    /// \brief Convert a dense matrix to a row-major sparse matrix.
+    inline presolveMatrix_t
+    presolveRowMajor
+    (const GenericFunctionTraits<EigenMatrixDense>::matrix_t& m)
+    {
+      return presolveMatrix_t (m.sparseView ());
+    }
+
+    /// \internal
+    /// \brief Convert a sparse matrix to a row-major sparse matrix.
+    inline presolveMatrix_t
+    presolveRowMajor
+    (const GenericFunctionTraits<EigenMatrixSparse>::matrix_t& m)
+    {
+      return presolveMatrix_t (m);
+    }
+
+    /// \internal
+    /// \brief Assemble a dense matrix from triplets.
+    inline void
+    presolveAssemble (GenericFunctionTraits<EigenMatrixDense>::matrix_t& m,
+		      Function::size_type rows, Function::size_type cols,
+		      const std::vector<presolveTriplet_t>& triplets)
+    {
+      m.setZero (rows, cols);
+      for (std::size_t k = 0; k < triplets.size (); ++k)
+	m (triplets[k].row (), triplets[k].col ()) += triplets[k].value ();
+    }
+
+    /// \internal
+    /// \brief Assemble a sparse matrix from triplets.
+    inline void
+    presolveAssemble (GenericFunctionTraits<EigenMatrixSparse>::matrix_t& m,
+		      Function::size_type rows, Function::size_type cols,
+		      const std::vector<presolveTriplet_t>& triplets)
+    {
+      m.resize (rows, cols);
+      m.setFromTriplets (triplets.begin (), triplets.end ());
+    }
+  } // end of namespace detail
+
+  template <typename T>
+  Presolver<T>::Presolver (const problem_t& pb, value_type epsilon)
+    : original_ (boost::make_shared<problem_t> (pb)),
+      reduced_ (),
+      epsilon_ (epsilon),
+      lower_ (pb.argumentLowerBounds ()),
+      upper_ (pb.argumentUpperBounds ()),
+      lowerSources_ (static_cast<std::size_t> (pb.function ().inputSize ())),
+      upperSources_ (static_cast<std::size_t> (pb.function ().inputSize ())),
+      fixed_ (static_cast<std::size_t> (pb.function ().inputSize ()), false),
+      fixedValues_ (vector_t::Zero (pb.function ().inputSize ())),
+      rows_ (),
+      rowIndices_ (),
+      constraintRows_ (),
+      variables_ (),
+      freeVariables_ (0),
+      reducedRows_ ()
+  {
+    for (size_type j = 0; j < lower_.size (); ++j)
+      {
+	if (lower_[j] > upper_[j])
+	  infeasible ((boost::format ("argument %d") % j).str ());
+	if (lower_[j] == upper_[j])
+	  fixVariable (j, lower_[j]);
+      }
+
+    extractRows ();
+
+    // Each reduction removes a row, fixes a variable or relaxes a finite
+    // bound, so this terminates.
+    bool changed = true;
+    while (changed)
+      {
+	changed = simplifyRows ();
+	changed = mergeDuplicates () || changed;
+      }
+
+    buildProblem ();
+  }
+
+  template <typename T>
+  Presolver<T>::~Presolver ()
+  {
+  }
+
+  template <typename T>
+  typename Presolver<T>::size_type
+  Presolver<T>::removedVariables () const
+  {
+    return static_cast<size_type>
+      (std::count (fixed_.begin (), fixed_.end (), true));
+  }
+
+  template <typename T>
+  typename Presolver<T>::size_type
+  Presolver<T>::removedRows () const
+  {
+    return original_->constraintsOutputSize ()
+      - static_cast<size_type> (reducedRows_.size ());
+  }
+
+  template <typename T>
+  void Presolver<T>::infeasible (const std::string& what) const
+  {
+    boost::format fmt ("presolve: infeasible problem (%s)");
+    fmt % what;
+    throw std::runtime_error (fmt.str ());
+  }
+
+  template <typename T>
+  void Presolver<T>::extractRows ()
+  {
+    typedef GenericNumericLinearFunction<T> numericLinear_t;
+
+    const typename problem_t::constraints_t& constraints =
+      original_->constraints ();
+    const vector_t& lower = original_->constraintsLowerBounds ();
+    const vector_t& upper = original_->constraintsUpperBounds ();
+
+    rowIndices_.assign
+      (static_cast<std::size_t> (original_->constraintsOutputSize ()), -1);
+
+    size_type global = 0;
+    for (std::size_t i = 0; i < constraints.size (); ++i)
+      {
+	const function_t& f = *constraints[i];
+	constraintRows_.push_back (global);
+
+	if (f.template asType<numericLinear_t> ())
+	  {
+	    const numericLinear_t* l = f.template castInto<numericLinear_t> ();
+	    detail::presolveMatrix_t a = detail::presolveRowMajor (l->A ());
+
+	    for (size_type k = 0; k < a.outerSize (); ++k)
+	      {
+		const size_type r = global + k;
+		rowIndices_[static_cast<std::size_t> (r)] =
+		  static_cast<long> (rows_.size ());
+		rows_.push_back (Row ());
+
+		Row& row = rows_.back ();
+		row.constraint = i;
+		row.row = r;
+		for (detail::presolveMatrix_t::InnerIterator it (a, k);
+		     it; ++it)
+		  {
+		    row.columns.push_back (it.col ());
+		    row.values.push_back (it.value ());
+		  }
+		row.offset = l->b ()[k];
+		row.lower = lower[r];
+		row.upper = upper[r];
+		row.lowerSource = Source (r);
+		row.upperSource = Source (r);
+		row.removed = false;
+	      }
+	  }
+
+	global += f.outputSize ();
+      }
+  }
+
+  template <typename T>
+  typename Presolver<T>::value_type
+  Presolver<T>::freeEntries (const Row& row,
+			     std::vector<size_type>& columns,
+			     std::vector<value_type>& values) const
+  {
+    value_type constant = row.offset;
+    columns.clear ();
+    values.clear ();
+
+    for (std::size_t k = 0; k < row.columns.size (); ++k)
+      {
+	const size_type j = row.columns[k];
+	if (fixed_[static_cast<std::size_t> (j)])
+	  constant += row.values[k] * fixedValues_[j];
+	else
+	  {
+	    columns.push_back (j);
+	    values.push_back (row.values[k]);
+	  }
+      }
+
+    return constant;
+  }
+
+  template <typename T>
+  typename Presolver<T>::Activity
+  Presolver<T>::activity (const Row& row) const
+  {
+    const value_type inf = function_t::infinity ();
+
+    Activity a;
+    a.constant = row.offset;
+    a.free = 0;
+    a.last = 0;
+
+    value_type minimum = 0.;
+    value_type maximum = 0.;
+    bool minimumInfinite = false;
+    bool maximumInfinite = false;
+
+    for (std::size_t k = 0; k < row.columns.size (); ++k)
+      {
+	const size_type j = row.columns[k];
+	const value_type v = row.values[k];
+
+	if (fixed_[static_cast<std::size_t> (j)])
+	  {
+	    a.constant += v * fixedValues_[j];
+	    continue;
+	  }
+
+	++a.free;
+	a.last = k;
+
+	const value_type l = (v > 0.) ? lower_[j] : upper_[j];
+	const value_type u = (v > 0.) ? upper_[j] : lower_[j];
+
+	if (std::fabs (l) < inf)
+	  minimum += v * l;
+	else
+	  minimumInfinite = true;
+
+	if (std::fabs (u) < inf)
+	  maximum += v * u;
+	else
+	  maximumInfinite = true;
+      }
+
+    a.min = minimumInfinite ? -inf : a.constant + minimum;
+    a.max = maximumInfinite ? inf : a.constant + maximum;
+    return a;
+  }
+
+  template <typename T>
+  bool Presolver<T>::simplifyRows ()
+  {
+    const value_type inf = function_t::infinity ();
+    bool changed = false;
+
+    for (std::size_t r = 0; r < rows_.size (); ++r)
+      {
+	Row& row = rows_[r];
+	if (row.removed)
+	  continue;
+
+	const Activity a = activity (row);
+
+	// Constant row: check it, then drop it.
+	if (a.free == 0)
+	  {
+	    if (a.constant < row.lower - epsilon_
+		|| a.constant > row.upper + epsilon_)
+	      infeasible ((boost::format ("row %d") % row.row).str ());
+
+	    row.removed = true;
+	    changed = true;
+	    continue;
+	  }
+
+	// Singleton row: turn it into argument bounds.
+	if (a.free == 1)
+	  {
+	    const size_type j = row.columns[a.last];
+	    const value_type v = row.values[a.last];
+	    const value_type l = (row.lower - a.constant) / v;
+	    const value_type u = (row.upper - a.constant) / v;
+
+	    if (v > 0.)
+	      tightenVariable (j, l, row.lowerSource.scaled (v),
+			       u, row.upperSource.scaled (v));
+	    else
+	      tightenVariable (j, u, row.upperSource.scaled (v),
+			       l, row.lowerSource.scaled (v));
+
+	    row.removed = true;
+	    changed = true;
+	    continue;
+	  }
+
+	if (a.min > row.upper + epsilon_ || a.max < row.lower - epsilon_)
+	  infeasible ((boost::format ("row %d") % row.row).str ());
+
+	// Relax the sides that are implied by the argument bounds.
+	if (row.lower > -inf && a.min >= row.lower)
+	  {
+	    row.lower = -inf;
+	    row.lowerSource = Source ();
+	    changed = true;
+	  }
+	if (row.upper < inf && a.max <= row.upper)
+	  {
+	    row.upper = inf;
+	    row.upperSource = Source ();
+	    changed = true;
+	  }
+
+	if (row.lower == -inf && row.upper == inf)
+	  {
+	    row.removed = true;
+	    changed = true;
+	  }
+      }
+
+    return changed;
+  }
+
+  template <typename T>
+  bool Presolver<T>::mergeDuplicates ()
+  {
+    typedef boost::unordered_map<std::vector<size_type>, std::size_t>
+      supports_t;
+
+    supports_t supports;
+    std::vector<size_type> columns;
+    std::vector<value_type> values;
+    std::vector<size_type> otherColumns;
+    std::vector<value_type> otherValues;
+    bool changed = false;
+
+    for (std::size_t r = 0; r < rows_.size (); ++r)
+      {
+	Row& row = rows_[r];
+	if (row.removed)
+	  continue;
+
+	const value_type c = freeEntries (row, columns, values);
+	if (columns.size () < 2)
+	  continue;
+
+	std::pair<typename supports_t::iterator, bool> it =
+	  supports.insert (std::make_pair (columns, r));
+	if (it.second)
+	  continue;
+
+	// Compare with the first row with the same support.
+	Row& first = rows_[it.first->second];
+	const value_type cFirst = freeEntries (first, otherColumns, otherValues);
+
+	const value_type k = values[0] / otherValues[0];
+	bool proportional = true;
+	for (std::size_t i = 1; i < values.size () && proportional; ++i)
+	  proportional = std::fabs (values[i] - k * otherValues[i])
+	    <= epsilon_ * std::max (1., std::fabs (values[i]));
+	if (!proportional)
+	  continue;
+
+	// row = k first + (c - k cFirst)
+	value_type l = (row.lower - c) / k + cFirst;
+	value_type u = (row.upper - c) / k + cFirst;
+	Source lSource = row.lowerSource.scaled (k);
+	Source uSource = row.upperSource.scaled (k);
+	if (k < 0.)
+	  {
+	    std::swap (l, u);
+	    std::swap (lSource, uSource);
+	  }
+
+	if (l > first.lower)
+	  {
+	    first.lower = l;
+	    first.lowerSource = lSource;
+	  }
+	if (u < first.upper)
+	  {
+	    first.upper = u;
+	    first.upperSource = uSource;
+	  }
+	if (first.lower > first.upper + epsilon_)
+	  infeasible ((boost::format ("rows %d and %d")
+		       % first.row % row.row).str ());
+
+	row.removed = true;
+	changed = true;
+      }
+
+    return changed;
+  }
+
+  template <typename T>
+  void Presolver<T>::tightenVariable (size_type j,
+				      value_type lower,
+				      const Source& lowerSource,
+				      value_type upper,
+				      const Source& upperSource)
+  {
+    const std::size_t j_ = static_cast<std::size_t> (j);
+
+    if (lower > lower_[j])
+      {
+	lower_[j] = lower;
+	lowerSources_[j_] = lowerSource;
+      }
+    if (upper < upper_[j])
+      {
+	upper_[j] = upper;
+	upperSources_[j_] = upperSource;
+      }
+
+    if (lower_[j] > upper_[j] + epsilon_)
+      infeasible ((boost::format ("argument %d") % j).str ());
+
+    if (upper_[j] - lower_[j] <= epsilon_)
+      fixVariable (j, .5 * (lower_[j] + upper_[j]));
+  }
+
+  template <typename T>
+  void Presolver<T>::fixVariable (size_type j, value_type v)
+  {
+    fixed_[static_cast<std::size_t> (j)] = true;
+    fixedValues_[j] = v;
+  }
+
+  template <typename T>
+  boost::shared_ptr<typename Presolver<T>::function_t>
+  Presolver<T>::reduceLinear (const GenericNumericLinearFunction<T>& f,
+			      const std::vector<size_type>& rows) const
+  {
+    typedef GenericNumericLinearFunction<T> numericLinear_t;
+
+    const size_type n = freeVariables_;
+    const size_type m = static_cast<size_type> (rows.size ());
+
+    detail::presolveMatrix_t a = detail::presolveRowMajor (f.A ());
+    std::vector<detail::presolveTriplet_t> triplets;
+    vector_t b (m);
+
+    for (size_type k = 0; k < m; ++k)
+      {
+	const size_type i = rows[static_cast<std::size_t> (k)];
+	b[k] = f.b ()[i];
+
+	// Contributions of fixed variables go to the constant term.
+	for (detail::presolveMatrix_t::InnerIterator it (a, i); it; ++it)
+	  {
+	    const size_type j =
+	      variables_[static_cast<std::size_t> (it.col ())];
+	    if (j >= 0)
+	      triplets.push_back (detail::presolveTriplet_t
+				  (static_cast<detail::presolveIndex_t> (k),
+				   static_cast<detail::presolveIndex_t> (j),
+				   it.value ()));
+	    else
+	      b[k] += it.value () * fixedValues_[it.col ()];
+	  }
+      }
+
+    typename numericLinear_t::matrix_t reduced;
+    detail::presolveAssemble (reduced, m, n, triplets);
+    return boost::make_shared<numericLinear_t> (reduced, b, f.getName ());
+  }
+
+  template <typename T>
+  boost::shared_ptr<typename Presolver<T>::function_t>
+  Presolver<T>::reduceFunction (const boost::shared_ptr<function_t>& f) const
+  {
+    typedef GenericNumericLinearFunction<T> numericLinear_t;
+    typedef GenericNumericQuadraticFunction<T> numericQuadratic_t;
+    typedef Bind<differentiableFunction_t> bind_t;
+
+    const size_type n = f->inputSize ();
+    const size_type nReduced = freeVariables_;
+
+    if (nReduced == n)
+      return f;
+
+    if (f->template asType<numericQuadratic_t> ())
+      {
+	// x^T A x + b^T x + c, with x = (free, fixed). Only the upper
+	// triangle of A is read: an off-diagonal coefficient stands for
+	// both (i, j) and (j, i). Free variables keep their order, so the
+	// reduced matrix is upper triangular as well.
+	const numericQuadratic_t* q = f->template castInto<numericQuadratic_t> ();
+	detail::presolveMatrix_t a = detail::presolveRowMajor (q->A ());
+	std::vector<detail::presolveTriplet_t> triplets;
+	vector_t b = vector_t::Zero (nReduced);
+	vector_t c = q->c ();
+
+	for (size_type i = 0; i < a.outerSize (); ++i)
+	  for (detail::presolveMatrix_t::InnerIterator it (a, i); it; ++it)
+	    {
+	      if (it.col () < i)
+		continue;
+
+	      const size_type ri = variables_[static_cast<std::size_t> (i)];
+	      const size_type rj =
+		variables_[static_cast<std::size_t> (it.col ())];
+	      const value_type v =
+		(it.col () == i) ? it.value () : 2 * it.value ();
+
+	      if (ri >= 0 && rj >= 0)
+		triplets.push_back (detail::presolveTriplet_t
+				    (static_cast<detail::presolveIndex_t> (ri),
+				     static_cast<detail::presolveIndex_t> (rj),
+				     it.value ()));
+	      else if (ri >= 0)
+		b[ri] += v * fixedValues_[it.col ()];
+	      else if (rj >= 0)
+		b[rj] += v * fixedValues_[i];
+	      else
+		c[0] += v * fixedValues_[i] * fixedValues_[it.col ()];
+	    }
+
+	for (size_type j = 0; j < n; ++j)
+	  {
+	    const size_type rj = variables_[static_cast<std::size_t> (j)];
+	    if (rj >= 0)
+	      b[rj] += q->b ()[j];
+	    else
+	      c[0] += q->b ()[j] * fixedValues_[j];
+	  }
+
+	typename numericQuadratic_t::matrix_t reduced;
+	detail::presolveAssemble (reduced, nReduced, nReduced, triplets);
+	return boost::make_shared<numericQuadratic_t>
+	  (reduced, b, c, f->getName ());
+      }
+
+    if (f->template asType<numericLinear_t> ())
+      {
+	std::vector<size_type> rows (static_cast<std::size_t>
+				     (f->outputSize ()));
+	for (std::size_t k = 0; k < rows.size (); ++k)
+	  rows[k] = static_cast<size_type> (k);
+	return reduceLinear (*f->template castInto<numericLinear_t> (), rows);
+      }
+
+    if (!f->template asType<differentiableFunction_t> ())
+      {
+	boost::format fmt
+	  ("presolve: function \"%s\" is not differentiable and cannot be"
+	   " restricted to the free variables");
+	fmt % f->getName ();
+	throw std::runtime_error (fmt.str ());
+      }
+
+    typename bind_t::boundValues_t values (static_cast<std::size_t> (n));
+    for (size_type j = 0; j < n; ++j)
+      if (fixed_[static_cast<std::size_t> (j)])
+	values[static_cast<std::size_t> (j)] = fixedValues_[j];
+
+    return boost::make_shared<bind_t>
+      (boost::static_pointer_cast<differentiableFunction_t> (f), values);
+  }
+
+  template <typename T>
+  void Presolver<T>::buildProblem ()
+  {
+    typedef GenericNumericLinearFunction<T> numericLinear_t;
+
+    const size_type n = original_->function ().inputSize ();
+
+    variables_.assign (static_cast<std::size_t> (n), -1);
+    size_type nReduced = 0;
+    for (std::size_t j = 0; j < fixed_.size (); ++j)
+      if (!fixed_[j])
+	variables_[j] = nReduced++;
+
+    freeVariables_ = nReduced;
+
+    // The cost function is owned by the copy of the input problem.
+    boost::shared_ptr<const function_t> cost (original_,
+					      &original_->function ());
+    reduced_ = boost::make_shared<problem_t>
+      (reduceFunction (boost::const_pointer_cast<function_t> (cost)));
+
+    reduced_->objectiveScaling () = original_->objectiveScaling ();
+
+    const bool names =
+      original_->argumentNames ().size () == static_cast<std::size_t> (n);
+    const typename problem_t::startingPoint_t& x0 =
+      original_->startingPoint ();
+    argument_t x0Reduced (nReduced);
+
+    for (size_type j = 0; j < n; ++j)
+      {
+	const size_type rj = variables_[static_cast<std::size_t> (j)];
+	if (rj < 0)
+	  continue;
+
+	const std::size_t rj_ = static_cast<std::size_t> (rj);
+	reduced_->argumentBounds ()[rj_] =
+	  function_t::makeInterval (lower_[j], upper_[j]);
+	reduced_->argumentScaling ()[rj_] =
+	  original_->argumentScaling ()[static_cast<std::size_t> (j)];
+	if (names)
+	  reduced_->argumentNames ().push_back
+	    (original_->argumentNames ()[static_cast<std::size_t> (j)]);
+	if (x0)
+	  x0Reduced[rj] = (*x0)[j];
+      }
+
+    if (x0)
+      reduced_->startingPoint () = x0Reduced;
+
+    // Constraints.
+    const typename problem_t::constraints_t& constraints =
+      original_->constraints ();
+
+    for (std::size_t i = 0; i < constraints.size (); ++i)
+      {
+	const boost::shared_ptr<function_t>& f = constraints[i];
+	const size_type first = constraintRows_[i];
+	const intervals_t& bounds = original_->boundsVector ()[i];
+	const scaling_t& scaling = original_->scalingVector ()[i];
+
+	if (f->outputSize () > 0
+	    && rowIndices_[static_cast<std::size_t> (first)] >= 0)
+	  {
+	    std::vector<size_type> kept;
+	    intervals_t keptBounds;
+	    scaling_t keptScaling;
+
+	    for (size_type k = 0; k < f->outputSize (); ++k)
+	      {
+		const Row& row = rows_[static_cast<std::size_t>
+				       (rowIndices_[static_cast<std::size_t>
+						    (first + k)])];
+		if (row.removed)
+		  continue;
+
+		kept.push_back (k);
+		keptBounds.push_back (function_t::makeInterval (row.lower,
+								 row.upper));
+		keptScaling.push_back (scaling[static_cast<std::size_t> (k)]);
+		reducedRows_.push_back (first + k);
+	      }
+
+	    if (kept.empty ())
+	      continue;
+
+	    reduced_->addConstraint
+	      (reduceLinear (*f->template castInto<numericLinear_t> (), kept),
+	       keptBounds, keptScaling);
+	  }
+	else
+	  {
+	    reduced_->addConstraint (reduceFunction (f), bounds, scaling);
+	    for (size_type k = 0; k < f->outputSize (); ++k)
+	      reducedRows_.push_back (first + k);
+	  }
+      }
+  }
+
+  template <typename T>
+  Result Presolver<T>::postsolve (const Result& result) const
+  {
+    const size_type n = original_->function ().inputSize ();
+    const size_type m = original_->constraintsOutputSize ();
+    const size_type nReduced = freeVariables_;
+    const size_type mReduced = static_cast<size_type> (reducedRows_.size ());
+
+    if (result.x.size () != nReduced)
+      {
+	boost::format fmt ("presolve: result size (%d) does not match the"
+			   " reduced problem (%d)");
+	fmt % result.x.size () % nReduced;
+	throw std::runtime_error (fmt.str ());
+      }
+
+    Result res (n, result.outputSize);
+    res.x = fixedValues_;
+    for (size_type j = 0; j < n; ++j)
+      {
+	const size_type rj = variables_[static_cast<std::size_t> (j)];
+	if (rj >= 0)
+	  res.x[j] = result.x[rj];
+      }
+    res.value = result.value;
+    res.constraint_violation = result.constraint_violation;
+    res.warnings = result.warnings;
+    res.constraints.resize (m);
+    if (m > 0)
+      original_->evaluateConstraints (res.constraints, res.x);
+
+    if (result.lambda.size () < nReduced + mReduced)
+      return res;
+
+    const size_type extra = result.lambda.size () - nReduced - mReduced;
+    res.lambda = vector_t::Zero (n + m + extra);
+    res.lambda.tail (extra) = result.lambda.tail (extra);
+
+    // Constraint multipliers: a multiplier on a merged row goes to the row
+    // that provides its active bound.
+    for (size_type k = 0; k < mReduced; ++k)
+      {
+	const size_type g = reducedRows_[static_cast<std::size_t> (k)];
+	const value_type lambda = result.lambda[nReduced + k];
+	const long r = rowIndices_[static_cast<std::size_t> (g)];
+
+	if (r < 0)
+	  {
+	    res.lambda[n + g] += lambda;
+	    continue;
+	  }
+
+	const Row& row = rows_[static_cast<std::size_t> (r)];
+	value_type v = row.offset;
+	for (std::size_t i = 0; i < row.columns.size (); ++i)
+	  v += row.values[i] * res.x[row.columns[i]];
+
+	const Source& s =
+	  (std::fabs (v - row.lower) <= std::fabs (v - row.upper))
+	  ? row.lowerSource : row.upperSource;
+	if (s.row >= 0)
+	  res.lambda[n + s.row] += lambda / s.factor;
+      }
+
+    // Argument bound multipliers: bounds that come from a row transfer
+    // their multiplier to that row.
+    for (size_type j = 0; j < n; ++j)
+      {
+	const size_type rj = variables_[static_cast<std::size_t> (j)];
+	if (rj < 0)
+	  continue;
+
+	const std::size_t j_ = static_cast<std::size_t> (j);
+	const value_type lambda = result.lambda[rj];
+	const Source& s =
+	  (std::fabs (res.x[j] - lower_[j]) <= std::fabs (res.x[j] - upper_[j]))
+	  ? lowerSources_[j_] : upperSources_[j_];
+
+	if (s.row >= 0)
+	  res.lambda[n + s.row] += lambda / s.factor;
+	else
+	  res.lambda[j] += lambda;
+      }
+
+    // Fixed arguments: their bound multipliers follow from the
+    // stationarity of the Lagrangian.
+    const function_t& cost = original_->function ();
+    if (nReduced < n
+	&& cost.outputSize () == 1
+	&& cost.template asType<differentiableFunction_t> ()
+	&& original_->differentiableConstraintsOutputSize () == m)
+      {
+	vector_t grad = cost.template castInto<differentiableFunction_t> ()
+	  ->jacobian (res.x).transpose () * vector_t::Ones (1);
+	if (m > 0)
+	  grad += original_->jacobian (res.x).transpose ()
+	    * res.lambda.segment (n, m);
+
+	for (size_type j = 0; j < n; ++j)
+	  if (fixed_[static_cast<std::size_t> (j)])
+	    res.lambda[j] = -grad[j];
+      }
+
+    return res;
+  }
+
+  template <typename T>
+  std::ostream& Presolver<T>::print (std::ostream& o) const
+  {
+    o << "Presolver:" << incindent
+      << iendl << "Removed variables: " << removedVariables ()
+      << iendl << "Removed rows: " << removedRows ()
+      << iendl << "Reduced problem:" << incindent << iendl << *reduced_
+      << decindent << decindent;
+    return o;
+  }
+
+  template <typename T>
+  std::ostream& operator<< (std::ostream& o, const Presolver<T>& p)
+  {
+    return p.print (o);
+  }
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_PRESOLVER_HXX
@@ -29,6 +29,7 @@
 # include <roboptim/core/fwd.hh>
 # include <roboptim/core/portability.hh>
 # include <roboptim/core/function.hh>
+# include <roboptim/core/jacobian-structure.hh>
 # include <roboptim/core/detail/utility.hh>
 
 # include <roboptim/core/deprecated.hh>
@@ -74,6 +75,12 @@ namespace roboptim
   /// For instance, a twice-differentiable function can be inserted in
   /// a problem which expects a differentiable function.
   ///
+  /// Copying a problem is cheap: copies share the constraints, bounds,
+  /// scaling vectors, names and starting point until one of them is
+  /// modified through a non-const method (copy-on-write). References
+  /// returned by non-const accessors should therefore not be kept across
+  /// copies. Shared problems should not be copied or modified concurrently.
+  ///
   /// \tparam T matrix type
   template <typename T>
   class ROBOPTIM_GCC_ETI_WORKAROUND Problem
@@ -103,6 +110,12 @@ namespace roboptim
     /// \brief Result type.
     typedef typename function_t::result_t result_t;
 
+    /// \brief Reference to a result vector.
+    typedef typename function_t::result_ref result_ref;
+
+    /// \brief Reference to an argument vector.
+    typedef typename function_t::argument_ref argument_ref;
+
     /// \brief Size type.
     typedef typename function_t::size_type size_type;
 
@@ -159,6 +172,9 @@ namespace roboptim
     /// \brief Jacobian matrix type.
     typedef typename GenericFunctionTraits<T>::jacobian_t jacobian_t;
 
+    /// \brief Reference to a Jacobian matrix.
+    typedef typename GenericFunctionTraits<T>::jacobian_ref jacobian_ref;
+
     /// \brief Constant reference to an argument vector.
     typedef typename GenericFunctionTraits<T>::const_argument_ref
     const_argument_ref;
@@ -204,6 +220,9 @@ namespace roboptim
 
     /// \brief Retrieve arguments bounds.
     /// Arguments bounds define in which interval each argument is valid.
+    ///
+    /// Note: this invalidates the packed bounds (see argumentLowerBounds),
+    /// so the returned reference should not be kept.
     /// \return arguments bounds
     intervals_t& argumentBounds ();
 
@@ -299,9 +318,45 @@ namespace roboptim
     const intervalsVect_t& boundsVector () const;
 
     /// \brief Retrieve constraints bounds vector.
+    ///
+    /// Note: this invalidates the packed bounds (see
+    /// constraintsLowerBounds), so the returned reference should not be
+    /// kept.
     /// \return constraints bounds vector
     intervalsVect_t& boundsVector ();
 
+    /// \name Packed bounds.
+    /// \{
+
+    /// \brief Lower bounds of the arguments, as a contiguous vector.
+    ///
+    /// Bounds are packed from the intervals when first requested after a
+    /// modification, then reused. Infinite bounds are stored as
+    /// -Function::infinity () and Function::infinity ().
+    ///
+    /// \return vector of size n.
+    const vector_t& argumentLowerBounds () const;
+
+    /// \brief Upper bounds of the arguments, as a contiguous vector.
+    /// \return vector of size n.
+    const vector_t& argumentUpperBounds () const;
+
+    /// \brief Lower bounds of all the constraint rows, as a contiguous
+    /// vector (same order as evaluateConstraints).
+    /// \return vector of size constraintsOutputSize ().
+    const vector_t& constraintsLowerBounds () const;
+
+    /// \brief Upper bounds of all the constraint rows, as a contiguous
+    /// vector (same order as evaluateConstraints).
+    /// \return vector of size constraintsOutputSize ().
+    const vector_t& constraintsUpperBounds () const;
+
+    /// \brief Project a point on the argument bounds.
+    /// \param x point to project (modified in place).
+    void projectOnArgumentBounds (argument_ref x) const;
+
+    /// \}
+
     /// \brief Retrieve constraints scaling vector.
     /// \return constraints scaling vector
     const scalingVect_t& scalingVector () const;
@@ -321,6 +376,64 @@ namespace roboptim
     /// \brief Clear the constraints from the problem.
     void clearConstraints ();
 
+    /// \brief Prepare the problem for repeated evaluations.
+    ///
+    /// Constraints are classified once with their flags: typed pointers to
+    /// the differentiable constraints and their row offsets are cached, and
+    /// the Jacobians of linear (and constant) constraints are computed
+    /// once and for all. Later calls to jacobian only evaluate the
+    /// nonlinear constraints. Matrix-free linear constraints
+    /// (ROBOPTIM_IS_MATRIX_FREE) are not precomputed, since this would
+    /// build their matrix.
+    ///
+    /// Adding or clearing constraints resets this step. Linear
+    /// constraints modified after this call are not taken into account
+    /// until finalize is called again. Copies of the problem, e.g. the one
+    /// stored by a solver, share the finalization.
+    void finalize ();
+
+    /// \brief Whether finalize has been called since the last change of
+    /// constraints.
+    bool isFinalized () const;
+
+    /// \}
+
+
+    /// \name Parallel evaluation.
+    /// \{
+
+    /// \brief Maximum number of threads used to evaluate the constraints.
+    ///
+    /// Constraints are independent functions writing to disjoint row
+    /// blocks, so evaluateConstraints, jacobian and
+    /// constraintsViolationVector can distribute them over several threads.
+    /// The output does not depend on the number of threads.
+    ///
+    /// This requires RobOptim to be compiled with OpenMP support
+    /// (ROBOPTIM_USE_OPENMP), otherwise the evaluation is sequential. Since
+    /// functions rely on internal buffers, constraints modifying a common
+    /// object (see GenericFunction::evaluationState), e.g. a constraint
+    /// added twice or several views of the same function, disable the
+    /// parallel evaluation.
+    ///
+    /// \return reference on the number of threads (default: 1, i.e.
+    /// sequential evaluation).
+    int& evaluationThreads ();
+
+    /// \brief Maximum number of threads used to evaluate the constraints.
+    /// \return number of threads.
+    int evaluationThreads () const;
+
+    /// \brief Number of threads that can actually be used to evaluate the
+    /// constraints.
+    ///
+    /// This is evaluationThreads, or 1 if the constraints cannot be
+    /// evaluated concurrently (no OpenMP support, or constraints modifying
+    /// a common object).
+    ///
+    /// \return number of threads.
+    int parallelThreads () const;
+
     /// \}
 
 
@@ -351,6 +464,30 @@ namespace roboptim
     /// \return Jacobian matrix evaluated at x.
     jacobian_t jacobian (const_argument_ref x) const;
 
+    /// \brief Evaluate the constraints of the problem in place.
+    ///
+    /// Results are stacked in the order of the constraints.
+    ///
+    /// \param res result vector of size constraintsOutputSize ().
+    /// \param x evaluation point.
+    void evaluateConstraints (result_ref res, const_argument_ref x) const;
+
+    /// \brief Evaluate the Jacobian matrix of the problem in place.
+    ///
+    /// Rows are ordered as the differentiable constraints of the problem.
+    ///
+    /// For sparse matrices, the union of the constraints' sparsity patterns
+    /// is computed during the first call (or whenever a constraint's pattern
+    /// changes), and the position of each nonzero in the values array is
+    /// recorded. As long as the same matrix is passed again and the
+    /// patterns do not change, later calls write the values directly into
+    /// their slots, without any allocation. The structure is available
+    /// through jacobianStructure ().
+    ///
+    /// \param jac Jacobian matrix (dense: of the right size, sparse: any).
+    /// \param x evaluation point.
+    void jacobian (jacobian_ref jac, const_argument_ref x) const;
+
     /// \brief Evaluate the scaled Jacobian matrix of the problem for a given x.
     /// Note: this is a helper method, and is not supposed to be used in any
     /// critical loop. Both constraint and argument scaling parameters are
@@ -360,6 +497,23 @@ namespace roboptim
     /// \return scaled Jacobian matrix evaluated at x.
     jacobian_t scaledJacobian (const_argument_ref x) const;
 
+    /// \brief Evaluate the scaled Jacobian matrix of the problem in place.
+    /// Both constraint and argument scaling parameters are applied.
+    ///
+    /// \param jac Jacobian matrix (see jacobian (jacobian_ref,
+    /// const_argument_ref)).
+    /// \param x evaluation point.
+    void scaledJacobian (jacobian_ref jac, const_argument_ref x) const;
+
+    /// \brief Sparsity structure of the last Jacobian assembled in place.
+    ///
+    /// The index arrays stay valid, and at the same address, as long as the
+    /// sparsity pattern of the Jacobian does not change. This is only set
+    /// for sparse problems.
+    ///
+    /// \return Jacobian structure (COO and CSR layouts).
+    const JacobianStructure& jacobianStructure () const;
+
     /// \brief Evaluate the vector of constraints violation for a given x.
     /// This takes into account both argument bounds and constraint bounds.
     /// If the output value is lower than the lower bound, the violation is
@@ -392,9 +546,96 @@ namespace roboptim
     std::ostream& print (std::ostream& o) const;
 
   private:
+    /// \brief Differentiable constraints, used by the Jacobian evaluation.
+    struct DifferentiableConstraints
+    {
+      /// \brief Typed pointers to the differentiable constraints.
+      std::vector<const GenericDifferentiableFunction<T>*> constraints;
+
+      /// \brief First row of each constraint in the Jacobian.
+      std::vector<size_type> rows;
+
+      /// \brief Whether the Jacobian of each constraint is precomputed.
+      std::vector<bool> precomputed;
+
+      /// \brief Precomputed Jacobians (empty for the other constraints).
+      std::vector<jacobian_t> jacobians;
+    };
+
+    /// \brief Description of the problem.
+    ///
+    /// Copies of a problem share this data until one of them is modified
+    /// (copy-on-write), so that copying a problem (e.g. when creating a
+    /// solver) does not copy the constraints, bounds and scaling vectors.
+    struct Data
+    {
+      Data ()
+	: boundsPacked (false)
+      {
+      }
+
+      /// \brief Starting point.
+      startingPoint_t startingPoint;
+
+      /// \brief Vector of constraints.
+      constraints_t constraints;
+
+      /// \brief Constraints intervals vector.
+      intervalsVect_t boundsVect;
+
+      /// \brief Arguments intervals.
+      intervals_t argumentBounds;
+
+      /// \brief Constraints scaling vector.
+      scalingVect_t scalingVect;
+
+      /// \brief Objective scaling.
+      scaling_t objectiveScaling;
+
+      /// \brief Arguments scaling.
+      scaling_t argumentScaling;
+
+      /// \brief Arguments names.
+      names_t argumentNames;
+
+      /// \brief Whether the packed bounds are up to date. Shared data is
+      /// always packed, so that const methods never modify it.
+      bool boundsPacked;
+
+      /// \brief Packed lower bounds of the arguments.
+      vector_t argumentLower;
+
+      /// \brief Packed upper bounds of the arguments.
+      vector_t argumentUpper;
+
+      /// \brief Packed lower bounds of the constraints.
+      vector_t constraintsLower;
+
+      /// \brief Packed upper bounds of the constraints.
+      vector_t constraintsUpper;
+
+      /// \brief Differentiable constraints built by finalize, or null if
+      /// the problem is not finalized. The record is never modified, so
+      /// that copies share the precomputed Jacobians.
+      boost::shared_ptr<const DifferentiableConstraints> finalized;
+    };
+
     /// \brief Initialize attributes and do some checking.
     void initialize ();
 
+    /// \brief Copy the shared data if needed before a modification.
+    void detach ();
+
+    /// \brief Pack the bounds into contiguous vectors if needed.
+    void updatePackedBounds () const;
+
+    /// \brief Update the list of differentiable constraints and their
+    /// first row in the Jacobian matrix, and the Jacobian buffers.
+    ///
+    /// \return the differentiable constraints built by finalize if the
+    /// problem is finalized, and the updated list otherwise.
+    const DifferentiableConstraints& updateDifferentiableConstraints () const;
+
   private:
     /// \brief Objective function.
     /// Note: do not give access to this shared_ptr, since for now the legacy
@@ -402,29 +643,33 @@ namespace roboptim
     /// management.
     const boost::shared_ptr<const function_t> function_;
 
-    /// \brief Starting point.
-    startingPoint_t startingPoint_;
+    /// \brief Description of the problem, shared between copies.
+    boost::shared_ptr<Data> data_;
 
-    /// \brief Vector of constraints.
-    constraints_t constraints_;
+    /// \brief Jacobian buffers of the differentiable constraints, used by
+    /// the in-place sparse Jacobian assembly. They are owned by each copy
+    /// of the problem: the sparse precomputed Jacobians are copied there on
+    /// the first evaluation.
+    mutable std::vector<jacobian_t> jacobianBlocks_;
 
-    /// \brief Constraints intervals vector.
-    intervalsVect_t boundsVect_;
+    /// \brief Structure of the problem Jacobian.
+    mutable JacobianStructure jacobianStructure_;
 
-    /// \brief Arguments intervals.
-    intervals_t argumentBounds_;
+    /// \brief Whether the constraints can be evaluated concurrently.
+    mutable bool independentConstraints_;
 
-    /// \brief Constraints scaling vector.
-    scalingVect_t scalingVect_;
+    /// \brief Whether independentConstraints_ is up to date.
+    mutable bool independenceChecked_;
 
-    /// \brief Objective scaling.
-    scaling_t objectiveScaling_;
+    /// \brief Maximum number of threads used for the evaluation.
+    int evaluationThreads_;
 
-    /// \brief Arguments scaling.
-    scaling_t argumentScaling_;
+    /// \brief First row of each constraint in the constraints vector.
+    mutable std::vector<size_type> constraintRows_;
 
-    /// \brief Arguments names.
-    names_t argumentNames_;
+    /// \brief Differentiable constraints of a problem that is not
+    /// finalized.
+    mutable DifferentiableConstraints differentiable_;
   };
 
   /// Example shows problem class use.
@@ -22,9 +22,11 @@
 # include <stdexcept>
 
 # include <boost/format.hpp>
+# include <boost/make_shared.hpp>
 # include <boost/variant.hpp>
 # include <boost/variant/get.hpp>
 # include <boost/static_assert.hpp>
+# include <boost/type_traits/is_same.hpp>
 
 # define EIGEN_YES_I_KNOW_SPARE_MODULE_IS_NOT_STABLE_YET
 # include <Eigen/Core>
@@ -35,6 +37,8 @@
 # include <roboptim/core/terminal-color.hh>
 # include <roboptim/core/util.hh>
 # include <roboptim/core/detail/utility.hh>
+# include <roboptim/core/detail/parallel.hh>
+# include <roboptim/core/detail/parallel-jacobian.hh>
 # include <roboptim/core/portability.hh>
 
 namespace roboptim
@@ -43,78 +47,187 @@ namespace roboptim
   namespace detail
   {
     /// \internal
-    /// \brief Scale a row of an input jacobian.
-    /// \param j input jacobian.
-    /// \param ri row index.
-    /// \param s scaling value.
-    template <typename T>
-    inline void scale_jacobian_row(typename roboptim::Problem<T>::jacobian_t & j,
-                                   typename roboptim::Problem<T>::size_type ri,
-                                   const typename roboptim::Problem<T>::value_type & s)
+    /// \brief Scale the rows and columns of a dense Jacobian.
+    ///
+    /// This computes diag (rows) * j * diag (cols) in place.
+    ///
+    /// \param j input Jacobian.
+    /// \param rows row scaling.
+    /// \param cols column scaling.
+    inline void
+    scale_jacobian
+    (GenericFunctionTraits<EigenMatrixDense>::jacobian_ref j,
+     GenericFunctionTraits<EigenMatrixDense>::const_vector_ref rows,
+     GenericFunctionTraits<EigenMatrixDense>::const_vector_ref cols)
     {
-      j.middleRows(ri, 1) *= s;
+      j.array ().colwise () *= rows.array ();
+      j.array ().rowwise () *= cols.transpose ().array ();
     }
 
-#if EIGEN_VERSION_AT_LEAST(3, 2, 90) && (! EIGEN_VERSION_AT_LEAST(3, 3, 2))
-    /// Specialization for sparse type in Eigen >= 3.2.90 and < 3.3.2
-    /// See #115
-    template<>
-    inline void scale_jacobian_row<roboptim::EigenMatrixSparse>(
-                  roboptim::Problem<roboptim::EigenMatrixSparse>::jacobian_t & j,
-                  roboptim::Problem<roboptim::EigenMatrixSparse>::size_type ri,
-                  const roboptim::Problem<roboptim::EigenMatrixSparse>::value_type & s)
+    /// \internal
+    /// \brief Scale the rows and columns of a sparse Jacobian.
+    ///
+    /// This computes diag (rows) * j * diag (cols) in place, in a single
+    /// pass over the nonzeros.
+    ///
+    /// \param j input Jacobian.
+    /// \param rows row scaling.
+    /// \param cols column scaling.
+    inline void
+    scale_jacobian
+    (GenericFunctionTraits<EigenMatrixSparse>::jacobian_ref j,
+     GenericFunctionTraits<EigenMatrixDense>::const_vector_ref rows,
+     GenericFunctionTraits<EigenMatrixDense>::const_vector_ref cols)
     {
-      typedef roboptim::Problem<roboptim::EigenMatrixSparse>::size_type size_type;
-      typedef roboptim::Problem<roboptim::EigenMatrixSparse>::jacobian_t jacobian_t;
-      for (size_type k = 0; k < j.outerSize (); ++k)
-      {
-        for (jacobian_t::InnerIterator it(j, k); it; ++it)
-        {
-          if (it.row() == ri)
-          {
-            it.valueRef () *= s;
-          }
-        }
-      }
+      typedef GenericFunctionTraits<EigenMatrixSparse>::jacobian_t
+	jacobian_t;
+
+      for (jacobian_t::Index k = 0; k < j.outerSize (); ++k)
+	for (jacobian_t::InnerIterator it (j, k); it; ++it)
+	  it.valueRef () *= rows[it.row ()] * cols[it.col ()];
     }
-#endif
 
     /// \internal
-    /// \brief Scale a column of an input jacobian.
-    /// \param j input jacobian.
-    /// \param ci column index.
-    /// \param s scaling value.
-    template <typename T>
-    inline void scale_jacobian_col(typename roboptim::Problem<T>::jacobian_t & j,
-                                   typename roboptim::Problem<T>::size_type ci,
-                                   const typename roboptim::Problem<T>::value_type & s)
+    /// \brief Compute the violation of bounds.
+    ///
+    /// The violation is negative below the lower bound, positive above the
+    /// upper bound and null otherwise. Infinite bounds yield a null
+    /// violation without any branching, so that Eigen can vectorize this.
+    ///
+    /// \param v values.
+    /// \param lower lower bounds.
+    /// \param upper upper bounds.
+    /// \param violation output violation vector.
+    inline void bounds_violation
+    (GenericFunctionTraits<EigenMatrixDense>::const_vector_ref v,
+     GenericFunctionTraits<EigenMatrixDense>::const_vector_ref lower,
+     GenericFunctionTraits<EigenMatrixDense>::const_vector_ref upper,
+     GenericFunctionTraits<EigenMatrixDense>::vector_ref violation)
     {
-      j.middleCols(ci, 1) *= s;
+      violation = (v - lower).cwiseMin (0.) + (v - upper).cwiseMax (0.);
     }
 
-#if EIGEN_VERSION_AT_LEAST(3, 2, 90) && (! EIGEN_VERSION_AT_LEAST(3, 3, 2))
-    /// Specialization for sparse type in Eigen >= 3.2.90 and < 3.3.2
-    /// See #115
-    template<>
-    inline void scale_jacobian_col<roboptim::EigenMatrixSparse>(
-                  roboptim::Problem<roboptim::EigenMatrixSparse>::jacobian_t & j,
-                  roboptim::Problem<roboptim::EigenMatrixSparse>::size_type ci,
-                  const roboptim::Problem<roboptim::EigenMatrixSparse>::value_type & s)
+    /// \internal
+    /// \brief Project values on bounds.
+    ///
+    /// \param v values (modified in place).
+    /// \param lower lower bounds.
+    /// \param upper upper bounds.
+    inline void bounds_projection
+    (GenericFunctionTraits<EigenMatrixDense>::vector_ref v,
+     GenericFunctionTraits<EigenMatrixDense>::const_vector_ref lower,
+     GenericFunctionTraits<EigenMatrixDense>::const_vector_ref upper)
+    {
+      v = v.cwiseMax (lower).cwiseMin (upper);
+    }
+
+    /// \internal
+    /// \brief Compress a Jacobian matrix (no-op for dense matrices).
+    template <typename M>
+    inline void compress (M&)
     {
-      typedef roboptim::Problem<roboptim::EigenMatrixSparse>::size_type size_type;
-      typedef roboptim::Problem<roboptim::EigenMatrixSparse>::jacobian_t jacobian_t;
-      for (size_type k = 0; k < j.outerSize (); ++k)
+    }
+
+    /// \internal
+    /// \brief Compress a sparse Jacobian matrix.
+    inline void
+    compress (GenericFunctionTraits<EigenMatrixSparse>::jacobian_t& m)
+    {
+      m.makeCompressed ();
+    }
+
+    /// \internal
+    /// \brief Evaluate a constraint into its row block.
+    template <typename T>
+    struct EvaluateConstraint
+    {
+      typedef Problem<T> problem_t;
+
+      EvaluateConstraint
+      (const typename problem_t::constraints_t& constraints,
+       const std::vector<typename problem_t::size_type>& rows,
+       typename problem_t::result_ref res,
+       typename problem_t::const_argument_ref x)
+	: constraints_ (constraints),
+	  rows_ (rows),
+	  res_ (res),
+	  x_ (x)
+      {}
+
+      void operator () (std::size_t i)
       {
-        for (jacobian_t::InnerIterator it(j, k); it; ++it)
-        {
-          if (it.col() == ci)
-          {
-            it.valueRef () *= s;
-          }
-        }
+	const typename problem_t::constraint_t& c = constraints_[i];
+	(*c) (res_.segment (rows_[i], c->outputSize ()), x_);
       }
-    }
-#endif
+
+      const typename problem_t::constraints_t& constraints_;
+      const std::vector<typename problem_t::size_type>& rows_;
+      typename problem_t::result_ref res_;
+      typename problem_t::const_argument_ref x_;
+    };
+
+    /// \internal
+    /// \brief Evaluate the Jacobian of a differentiable constraint into
+    /// its row block (dense matrices) or into its own buffer (sparse
+    /// matrices).
+    template <typename T>
+    struct EvaluateJacobian
+    {
+      typedef Problem<T> problem_t;
+      typedef GenericDifferentiableFunction<T> differentiableFunction_t;
+      typedef typename problem_t::jacobian_t jacobian_t;
+
+      EvaluateJacobian
+      (const std::vector<const differentiableFunction_t*>& constraints,
+       const std::vector<typename problem_t::size_type>& rows,
+       const std::vector<bool>& precomputed,
+       const std::vector<jacobian_t>& jacobians,
+       std::vector<jacobian_t>& blocks,
+       JacobianStructure& structure,
+       typename problem_t::jacobian_ref jac,
+       typename problem_t::const_argument_ref x)
+	: constraints_ (constraints),
+	  rows_ (rows),
+	  precomputed_ (precomputed),
+	  jacobians_ (jacobians),
+	  blocks_ (blocks),
+	  structure_ (structure),
+	  jac_ (jac),
+	  x_ (x)
+      {}
+
+      void operator () (std::size_t i)
+      {
+	const differentiableFunction_t* df = constraints_[i];
+
+	// Precomputed Jacobian (already in its buffer for sparse matrices).
+	if (precomputed_[i])
+	  {
+	    copy_block (jac_, rows_[i], jacobians_[i]);
+	    return;
+	  }
+
+	evaluate_block (*df, jacobian_block (jac_, blocks_, i, rows_[i], 0,
+					     df->outputSize (),
+					     df->inputSize ()),
+			x_);
+      }
+
+      void assemble ()
+      {
+	// Sparse Jacobians are resized by the assembly.
+	assemble_rows (jac_, blocks_, structure_, x_.size ());
+      }
+
+      const std::vector<const differentiableFunction_t*>& constraints_;
+      const std::vector<typename problem_t::size_type>& rows_;
+      const std::vector<bool>& precomputed_;
+      const std::vector<jacobian_t>& jacobians_;
+      std::vector<jacobian_t>& blocks_;
+      JacobianStructure& structure_;
+      typename problem_t::jacobian_ref jac_;
+      typename problem_t::const_argument_ref x_;
+    };
   }
 
   //
@@ -126,14 +239,14 @@ namespace roboptim
     // the function passed, which is just as bad. This prepares the transition
     // to the safer shared_ptr version.
     : function_ (&f, detail::NoopDeleter<function_t> ()),
-      startingPoint_ (),
-      constraints_ (),
-      boundsVect_ (),
-      argumentBounds_ (),
-      scalingVect_ (),
-      objectiveScaling_ (),
-      argumentScaling_ (),
-      argumentNames_ ()
+      data_ (boost::make_shared<Data> ()),
+      jacobianBlocks_ (),
+      jacobianStructure_ (),
+      independentConstraints_ (true),
+      independenceChecked_ (true),
+      evaluationThreads_ (1),
+      constraintRows_ (),
+      differentiable_ ()
   {
     // Initialize attributes.
     initialize ();
@@ -142,14 +255,14 @@ namespace roboptim
   template <typename T>
   Problem<T>::Problem (const boost::shared_ptr<const function_t>& f)
     : function_ (f),
-      startingPoint_ (),
-      constraints_ (),
-      boundsVect_ (),
-      argumentBounds_ (),
-      scalingVect_ (),
-      objectiveScaling_ (),
-      argumentScaling_ (),
-      argumentNames_ ()
+      data_ (boost::make_shared<Data> ()),
+      jacobianBlocks_ (),
+      jacobianStructure_ (),
+      independentConstraints_ (true),
+      independenceChecked_ (true),
+      evaluationThreads_ (1),
+      constraintRows_ (),
+      differentiable_ ()
   {
     // Initialize attributes.
     initialize ();
@@ -162,14 +275,22 @@ namespace roboptim
     ROBOPTIM_ASSERT_MSG (function_.get () != 0, "cost function is unset");
 
     // Initialize bound.
-    argumentBounds_.resize (static_cast<std::size_t> (function_->inputSize ()),
-                            function_t::makeInfiniteInterval ());
+    data_->argumentBounds.resize
+      (static_cast<std::size_t> (function_->inputSize ()),
+       function_t::makeInfiniteInterval ());
 
     // Initialize scaling.
-    objectiveScaling_.resize (static_cast<std::size_t> (function_->outputSize ()),
-                              1.);
-    argumentScaling_.resize (static_cast<std::size_t> (function_->inputSize ()),
-                             1.);
+    data_->objectiveScaling.resize
+      (static_cast<std::size_t> (function_->outputSize ()), 1.);
+    data_->argumentScaling.resize
+      (static_cast<std::size_t> (function_->inputSize ()), 1.);
+  }
+
+  template <typename T>
+  void Problem<T>::detach ()
+  {
+    if (!data_.unique ())
+      data_ = boost::make_shared<Data> (*data_);
   }
 
   template <typename T>
@@ -181,15 +302,21 @@ namespace roboptim
   template <typename T>
   Problem<T>::Problem (const Problem<T>& pb)
     : function_ (pb.function_),
-      startingPoint_ (pb.startingPoint_),
-      constraints_ (pb.constraints_),
-      boundsVect_ (pb.boundsVect_),
-      argumentBounds_ (pb.argumentBounds_),
-      scalingVect_ (pb.scalingVect_),
-      objectiveScaling_ (pb.objectiveScaling_),
-      argumentScaling_ (pb.argumentScaling_),
-      argumentNames_ (pb.argumentNames_)
+      data_ (pb.data_),
+      jacobianBlocks_ (),
+      jacobianStructure_ (),
+      independentConstraints_ (pb.independentConstraints_),
+      independenceChecked_ (pb.independenceChecked_),
+      evaluationThreads_ (pb.evaluationThreads_),
+      constraintRows_ (),
+      differentiable_ ()
   {
+    // The finalization (typed pointers and precomputed Jacobians) is part
+    // of the shared data, e.g. for the copy stored by a solver. Only the
+    // Jacobian buffers are owned by each copy.
+    // Shared data is kept packed, so that const methods of the copies do
+    // not write to it.
+    updatePackedBounds ();
   }
 
   template <typename T>
@@ -203,7 +330,7 @@ namespace roboptim
   const typename Problem<T>::constraints_t&
   Problem<T>::constraints () const
   {
-    return constraints_;
+    return data_->constraints;
   }
 
   template <typename T>
@@ -221,13 +348,17 @@ namespace roboptim
     // Check that the pointer is not null.
     assert (!!x.get ());
     assert (b.first <= b.second);
-    constraints_.push_back (x);
+    detach ();
+    data_->constraints.push_back (x);
+    independenceChecked_ = false;
+    data_->finalized.reset ();
+    data_->boundsPacked = false;
     intervals_t bounds;
     bounds.push_back (b);
-    boundsVect_.push_back (bounds);
+    data_->boundsVect.push_back (bounds);
     scaling_t scaling;
     scaling.push_back (s);
-    scalingVect_.push_back (scaling);
+    data_->scalingVect.push_back (scaling);
   }
 
   template <typename T>
@@ -280,7 +411,11 @@ namespace roboptim
 
     // Check that the pointer is not null.
     assert (!!x.get ());
-    constraints_.push_back (x);
+    detach ();
+    data_->constraints.push_back (x);
+    independenceChecked_ = false;
+    data_->finalized.reset ();
+    data_->boundsPacked = false;
 
     // Check that the bounds are correctly defined.
     for (std::size_t i = 0; i < static_cast<std::size_t> (x->outputSize ());
@@ -290,8 +425,8 @@ namespace roboptim
 	assert (interval.first <= interval.second);
       }
 
-    boundsVect_.push_back (b);
-    scalingVect_.push_back (s);
+    data_->boundsVect.push_back (b);
+    data_->scalingVect.push_back (s);
   }
 
   template <typename T>
@@ -299,7 +434,7 @@ namespace roboptim
   {
     size_type m = 0;
     for (typename constraints_t::const_iterator
-	   c = constraints_.begin (); c != constraints_.end (); ++c)
+	   c = data_->constraints.begin (); c != data_->constraints.end (); ++c)
       {
 	m += (*c)->outputSize ();
       }
@@ -312,7 +447,7 @@ namespace roboptim
   {
     size_type m = 0;
     for (typename constraints_t::const_iterator
-	   c = constraints_.begin (); c != constraints_.end (); ++c)
+	   c = data_->constraints.begin (); c != data_->constraints.end (); ++c)
       {
 	if ((*c)->template asType<GenericDifferentiableFunction<T> > ())
 	  m += (*c)->outputSize ();
@@ -324,64 +459,243 @@ namespace roboptim
   template <typename T>
   void Problem<T>::clearConstraints ()
   {
-    constraints_.clear ();
-    boundsVect_.clear ();
-    scalingVect_.clear ();
+    detach ();
+    data_->constraints.clear ();
+    data_->boundsVect.clear ();
+    data_->scalingVect.clear ();
+    independentConstraints_ = true;
+    independenceChecked_ = true;
+    data_->finalized.reset ();
+    data_->boundsPacked = false;
+  }
+
+  template <typename T>
+  void Problem<T>::finalize ()
+  {
+    typedef GenericDifferentiableFunction<T> differentiableFunction_t;
+
+    detach ();
+    data_->finalized.reset ();
+    jacobianBlocks_.clear ();
+    jacobianStructure_.clear ();
+
+    boost::shared_ptr<DifferentiableConstraints>
+      finalized = boost::make_shared<DifferentiableConstraints> ();
+
+    // Dummy argument: the Jacobian of a linear function does not depend on
+    // the evaluation point.
+    argument_t x (function_->inputSize ());
+    x.setZero ();
+
+    size_type global_row = 0;
+    for (typename constraints_t::const_iterator
+	   c = data_->constraints.begin (); c != data_->constraints.end (); ++c)
+      {
+	const typename function_t::flag_t flags = (*c)->getFlags ();
+	if ((flags & differentiableFunction_t::flags)
+	    != differentiableFunction_t::flags)
+	  continue;
+
+	const differentiableFunction_t*
+	  df = (*c)->template castInto<differentiableFunction_t> (false);
+	// Matrix-free functions only build their Jacobian on request.
+	const bool linear = (flags & ROBOPTIM_IS_LINEAR) != 0
+	  && (flags & ROBOPTIM_IS_MATRIX_FREE) == 0;
+
+	finalized->constraints.push_back (df);
+	finalized->rows.push_back (global_row);
+	finalized->precomputed.push_back (linear);
+	finalized->jacobians.push_back (jacobian_t ());
+
+	if (linear)
+	  {
+	    jacobian_t& block = finalized->jacobians.back ();
+	    block.resize (df->outputSize (), df->inputSize ());
+	    block.setZero ();
+	    df->jacobian (block, x);
+	    detail::compress (block);
+	  }
+
+	global_row += df->outputSize ();
+      }
+
+    data_->finalized = finalized;
+  }
+
+  template <typename T>
+  bool Problem<T>::isFinalized () const
+  {
+    return !!data_->finalized;
+  }
+
+  template <typename T>
+  int& Problem<T>::evaluationThreads ()
+  {
+    return evaluationThreads_;
+  }
+
+  template <typename T>
+  int Problem<T>::evaluationThreads () const
+  {
+    return evaluationThreads_;
+  }
+
+  template <typename T>
+  int Problem<T>::parallelThreads () const
+  {
+    // Nothing to check for a sequential evaluation.
+    if (detail::parallel_threads (evaluationThreads_, true) == 1)
+      return 1;
+
+    // Functions rely on internal buffers: constraints modifying a common
+    // object (e.g. a constraint added twice, or views of the same
+    // function) cannot be evaluated concurrently.
+    if (!independenceChecked_)
+      {
+	std::vector<const void*> objects;
+	for (size_t i = 0; i < data_->constraints.size (); ++i)
+	  detail::append_evaluation_state (objects, *data_->constraints[i]);
+	independentConstraints_ = detail::distinct_objects (objects);
+	independenceChecked_ = true;
+      }
+
+    return detail::parallel_threads (evaluationThreads_,
+				     independentConstraints_);
   }
 
   template <typename T>
   typename Problem<T>::startingPoint_t&
   Problem<T>::startingPoint ()
   {
-    if (startingPoint_ && startingPoint_->size ()
+    detach ();
+    if (data_->startingPoint && data_->startingPoint->size ()
 	!= this->function ().inputSize ())
       throw std::runtime_error ("invalid starting point (wrong size)");
-    return startingPoint_;
+    return data_->startingPoint;
   }
 
   template <typename T>
   const typename Problem<T>::startingPoint_t&
   Problem<T>::startingPoint () const
   {
-    if (startingPoint_ && startingPoint_->size ()
+    if (data_->startingPoint && data_->startingPoint->size ()
 	!= this->function ().inputSize ())
       throw std::runtime_error ("invalid starting point (wrong size)");
-    return startingPoint_;
+    return data_->startingPoint;
   }
 
   template <typename T>
   typename Problem<T>::intervalsVect_t&
   Problem<T>::boundsVector ()
   {
-    return boundsVect_;
+    detach ();
+    data_->boundsPacked = false;
+    return data_->boundsVect;
   }
 
   template <typename T>
   const typename Problem<T>::intervalsVect_t&
   Problem<T>::boundsVector () const
   {
-    return boundsVect_;
+    return data_->boundsVect;
   }
 
   template <typename T>
   typename Problem<T>::intervals_t&
   Problem<T>::argumentBounds ()
   {
-    return argumentBounds_;
+    detach ();
+    data_->boundsPacked = false;
+    return data_->argumentBounds;
   }
 
   template <typename T>
   const typename Problem<T>::intervals_t&
   Problem<T>::argumentBounds () const
   {
-    return argumentBounds_;
+    return data_->argumentBounds;
+  }
+
+  template <typename T>
+  void
+  Problem<T>::updatePackedBounds () const
+  {
+    if (data_->boundsPacked)
+      return;
+
+    const size_type n = function_->inputSize ();
+    data_->argumentLower.resize (n);
+    data_->argumentUpper.resize (n);
+    for (size_type i = 0; i < n; ++i)
+      {
+	const interval_t& b = data_->argumentBounds[static_cast<size_t> (i)];
+	data_->argumentLower[i] = b.first;
+	data_->argumentUpper[i] = b.second;
+      }
+
+    const size_type m = constraintsOutputSize ();
+    data_->constraintsLower.resize (m);
+    data_->constraintsUpper.resize (m);
+    size_type row = 0;
+    for (typename intervalsVect_t::const_iterator
+	   c = data_->boundsVect.begin (); c != data_->boundsVect.end (); ++c)
+      for (typename intervals_t::const_iterator
+	     b = c->begin (); b != c->end (); ++b, ++row)
+	{
+	  data_->constraintsLower[row] = b->first;
+	  data_->constraintsUpper[row] = b->second;
+	}
+
+    data_->boundsPacked = true;
+  }
+
+  template <typename T>
+  const typename Problem<T>::vector_t&
+  Problem<T>::argumentLowerBounds () const
+  {
+    updatePackedBounds ();
+    return data_->argumentLower;
+  }
+
+  template <typename T>
+  const typename Problem<T>::vector_t&
+  Problem<T>::argumentUpperBounds () const
+  {
+    updatePackedBounds ();
+    return data_->argumentUpper;
+  }
+
+  template <typename T>
+  const typename Problem<T>::vector_t&
+  Problem<T>::constraintsLowerBounds () const
+  {
+    updatePackedBounds ();
+    return data_->constraintsLower;
+  }
+
+  template <typename T>
+  const typename Problem<T>::vector_t&
+  Problem<T>::constraintsUpperBounds () const
+  {
+    updatePackedBounds ();
+    return data_->constraintsUpper;
+  }
+
+  template <typename T>
+  void
+  Problem<T>::projectOnArgumentBounds (argument_ref x) const
+  {
+    assert (x.size () == function_->inputSize ());
+
+    updatePackedBounds ();
+    detail::bounds_projection (x, data_->argumentLower, data_->argumentUpper);
   }
 
   template <typename T>
   const typename Problem<T>::scalingVect_t&
   Problem<T>::scalingVector () const
   {
-    return scalingVect_;
+    return data_->scalingVect;
   }
 
   template <typename T>
@@ -395,28 +709,30 @@ namespace roboptim
   typename Problem<T>::scaling_t&
   Problem<T>::objectiveScaling ()
   {
-    return objectiveScaling_;
+    detach ();
+    return data_->objectiveScaling;
   }
 
   template <typename T>
   const typename Problem<T>::scaling_t&
   Problem<T>::objectiveScaling () const
   {
-    return objectiveScaling_;
+    return data_->objectiveScaling;
   }
 
   template <typename T>
   typename Problem<T>::scaling_t&
   Problem<T>::argumentScaling ()
   {
-    return argumentScaling_;
+    detach ();
+    return data_->argumentScaling;
   }
 
   template <typename T>
   const typename Problem<T>::scaling_t&
   Problem<T>::argumentScaling () const
   {
-    return argumentScaling_;
+    return data_->argumentScaling;
   }
 
   template <typename T>
@@ -437,136 +753,166 @@ namespace roboptim
   typename Problem<T>::names_t&
   Problem<T>::argumentNames ()
   {
-    return argumentNames_;
+    detach ();
+    return data_->argumentNames;
   }
 
   template <typename T>
   const typename Problem<T>::names_t&
   Problem<T>::argumentNames () const
   {
-    return argumentNames_;
+    return data_->argumentNames;
   }
 
   template <typename T>
   typename Problem<T>::jacobian_t
   Problem<T>::jacobian (const_argument_ref x) const
   {
-    typedef GenericDifferentiableFunction<T> differentiableFunction_t;
-
     size_type n = function_->inputSize ();
     size_type m = differentiableConstraintsOutputSize ();
 
     jacobian_t jac (m, n);
     jac.setZero ();
-
-    // For each constraint of the problem
-    size_type global_row = 0;
-    for (typename constraints_t::const_iterator
-	   c = constraints_.begin (); c != constraints_.end (); ++c)
-      {
-	// If the constraint is differentiable
-        if ((*c)->template asType<differentiableFunction_t> ())
-	  {
-	    const differentiableFunction_t*
-	      df = (*c)->template castInto<differentiableFunction_t> ();
-	    df->jacobian (jac.block (global_row, 0, df->outputSize (), n), x);
-	    global_row += df->outputSize ();
-	  }
-      }
+    jacobian (jac, x);
 
     return jac;
   }
 
   template <typename T>
-  typename Problem<T>::jacobian_t
-  Problem<T>::scaledJacobian (const_argument_ref x) const
+  void
+  Problem<T>::jacobian (jacobian_ref jac, const_argument_ref x) const
+  {
+    const bool dense = boost::is_same<T, EigenMatrixDense>::value;
+
+    assert (!dense || jac.rows () == differentiableConstraintsOutputSize ());
+    assert (!dense || jac.cols () == function_->inputSize ());
+
+    // Each differentiable constraint writes to its own row block (dense
+    // matrices), or to its own persistent buffer (sparse matrices). Sparse
+    // buffers are then stacked, in place if the structure did not change.
+    const DifferentiableConstraints& d = updateDifferentiableConstraints ();
+    detail::EvaluateJacobian<T> f (d.constraints, d.rows, d.precomputed,
+				   d.jacobians, jacobianBlocks_,
+				   jacobianStructure_, jac, x);
+    detail::parallel_jacobian (d.constraints.size (),
+			       parallelThreads (), f, !dense);
+  }
+
+  template <typename T>
+  const typename Problem<T>::DifferentiableConstraints&
+  Problem<T>::updateDifferentiableConstraints () const
   {
     typedef GenericDifferentiableFunction<T> differentiableFunction_t;
 
-    // Compute the unscaled Jacobian matrix
-    jacobian_t jac = jacobian (x);
+    // Typed pointers, offsets and Jacobians are cached by finalize. Sparse
+    // precomputed Jacobians are copied to the buffers of this problem (once
+    // per copy), since the in-place assembly reads all the blocks there.
+    if (data_->finalized)
+      {
+	const DifferentiableConstraints& d = *data_->finalized;
+	if (jacobianBlocks_.size () != d.constraints.size ())
+	  {
+	    if (boost::is_same<T, EigenMatrixSparse>::value)
+	      jacobianBlocks_ = d.jacobians;
+	    else
+	      jacobianBlocks_.resize (d.constraints.size ());
+	  }
+	return d;
+      }
+
+    differentiable_.constraints.clear ();
+    differentiable_.rows.clear ();
 
-    // Apply constraint scaling parameters
     size_type global_row = 0;
-    size_t c_idx = 0;
     for (typename constraints_t::const_iterator
-	   c = constraints_.begin (); c != constraints_.end (); ++c)
+	   c = data_->constraints.begin (); c != data_->constraints.end (); ++c)
       {
 	// If the constraint is differentiable
-        if ((*c)->template asType<differentiableFunction_t> ())
+	if ((*c)->template asType<differentiableFunction_t> ())
 	  {
 	    const differentiableFunction_t*
 	      df = (*c)->template castInto<differentiableFunction_t> ();
-            for (size_type i = 0; i < df->outputSize (); ++i)
-	      {
-                detail::scale_jacobian_row<T> (jac, global_row + i,
-                                             scalingVect_[c_idx][static_cast<size_t> (i)]);
-              }
+	    differentiable_.constraints.push_back (df);
+	    differentiable_.rows.push_back (global_row);
 	    global_row += df->outputSize ();
 	  }
-        c_idx++;
       }
 
-    // Apply argument scaling parameters
-    for (size_t i = 0; i < argumentScaling_.size (); ++i)
+    const std::size_t n = differentiable_.constraints.size ();
+    differentiable_.precomputed.assign (n, false);
+    differentiable_.jacobians.resize (n);
+    jacobianBlocks_.resize (n);
+    return differentiable_;
+  }
+
+  template <typename T>
+  void
+  Problem<T>::evaluateConstraints (result_ref res, const_argument_ref x) const
+  {
+    assert (res.size () == constraintsOutputSize ());
+
+    constraintRows_.resize (data_->constraints.size ());
+    size_type global_row = 0;
+    for (size_t i = 0; i < data_->constraints.size (); ++i)
       {
-        detail::scale_jacobian_col<T> (jac, static_cast<size_type> (i),
-                                       argumentScaling_[i]);
+	constraintRows_[i] = global_row;
+	global_row += data_->constraints[i]->outputSize ();
       }
 
-    return jac;
+    // Each constraint writes to its own row block.
+    detail::EvaluateConstraint<T> f (data_->constraints, constraintRows_, res, x);
+    detail::parallel_for (data_->constraints.size (), parallelThreads (), f);
   }
 
-  template <>
-  inline Problem<EigenMatrixSparse>::jacobian_t
-  Problem<EigenMatrixSparse>::jacobian (const_argument_ref x) const
+  template <typename T>
+  typename Problem<T>::jacobian_t
+  Problem<T>::scaledJacobian (const_argument_ref x) const
   {
-    typedef GenericDifferentiableFunction<EigenMatrixSparse>
-      differentiableFunction_t;
-    typedef Eigen::Triplet<double> triplet_t;
-
     size_type n = function_->inputSize ();
     size_type m = differentiableConstraintsOutputSize ();
 
     jacobian_t jac (m, n);
     jac.setZero ();
+    scaledJacobian (jac, x);
+
+    return jac;
+  }
+
+  template <typename T>
+  void
+  Problem<T>::scaledJacobian (jacobian_ref jac, const_argument_ref x) const
+  {
+    // Compute the unscaled Jacobian matrix
+    jacobian (jac, x);
 
-    jacobian_t tmp;
-    std::vector<triplet_t> coeffs;
+    typedef GenericDifferentiableFunction<T> differentiableFunction_t;
 
-    // For each constraint of the problem
+    // Gather the scaling of the differentiable constraints' rows
+    vector_t rows (jac.rows ());
     size_type global_row = 0;
-    for (constraints_t::const_iterator
-	   c = constraints_.begin (); c != constraints_.end (); ++c)
+    for (size_t c = 0; c < data_->constraints.size (); ++c)
       {
-	// If the constraint is differentiable
-        if ((*c)->asType<differentiableFunction_t> ())
-	  {
-	    const differentiableFunction_t*
-	      df = (*c)->castInto<differentiableFunction_t> ();
-
-            tmp.resize (df->outputSize (), n);
-            tmp.setZero ();
-	    df->jacobian (tmp, x);
-            tmp.makeCompressed ();
-
-	    for (int k = 0; k < tmp.outerSize (); ++k)
-	      for (differentiableFunction_t::jacobian_t::InnerIterator
-		     it (tmp, k); it; ++it)
-		{
-		  const int row = static_cast<int> (global_row + it.row ());
-		  const int col = static_cast<int> (it.col ());
-		  coeffs.push_back (triplet_t (row, col, it.value ()));
-		}
+	if (!data_->constraints[c]->template asType<differentiableFunction_t> ())
+	  continue;
 
-	    global_row += df->outputSize ();
-	  }
+	const scaling_t& scaling = data_->scalingVect[c];
+	for (size_t i = 0; i < scaling.size (); ++i)
+	  rows[global_row++] = scaling[i];
       }
+    assert (global_row == jac.rows ());
 
-    jac.setFromTriplets (coeffs.begin (), coeffs.end ());
-    jac.makeCompressed ();
+    // Apply constraint and argument scaling parameters in a single pass
+    detail::scale_jacobian
+      (jac, rows, Eigen::Map<const vector_t>
+       (data_->argumentScaling.empty () ? 0 : &data_->argumentScaling[0],
+	static_cast<size_type> (data_->argumentScaling.size ())));
+  }
 
-    return jac;
+  template <typename T>
+  const JacobianStructure&
+  Problem<T>::jacobianStructure () const
+  {
+    return jacobianStructure_;
   }
 
   template <typename T>
@@ -577,49 +923,16 @@ namespace roboptim
     size_type m = constraintsOutputSize ();
 
     vector_t violations (n + m);
-    violations.setZero ();
-    size_type i = 0;
-    result_t res;
-
-    for (size_type j = 0; j < n; ++j, ++i)
-      {
-	value_type inf_viol = 0.;
-	value_type sup_viol = 0.;
+    result_t res (m);
 
-	const interval_t& bounds = argumentBounds_[static_cast<size_t> (j)];
+    // Evaluate all the constraints at once.
+    evaluateConstraints (res, x);
 
-	if (bounds.first != -Function::infinity ())
-	  inf_viol = std::min (x[j] - bounds.first, 0.);
-	if (bounds.second != Function::infinity ())
-	  sup_viol = std::max (x[j] - bounds.second, 0.);
-
-        if (inf_viol < 0.) violations[i] = inf_viol;
-        else violations[i] = sup_viol;
-      }
-
-    size_t c_idx = 0;
-    for (typename constraints_t::const_iterator
-	   c = constraints_.begin (); c != constraints_.end (); ++c, ++c_idx)
-      {
-	const intervals_t& bounds = boundsVect_[c_idx];
-	res.resize ((*c)->outputSize ());
-	(*(*c)) (res, x);
-
-	for (size_type j = 0; j < (*c)->outputSize (); ++j, ++i)
-	  {
-	    size_t jj = static_cast<size_t> (j);
-	    value_type inf_viol = 0.;
-	    value_type sup_viol = 0.;
-
-	    if (bounds[jj].first != -Function::infinity ())
-	      inf_viol = std::min (res[j] - bounds[jj].first, 0.);
-	    if (bounds[jj].second != Function::infinity ())
-	      sup_viol = std::max (res[j] - bounds[jj].second, 0.);
-
-	    if (inf_viol < 0.) violations[i] = inf_viol;
-	    else violations[i] = sup_viol;
-	  }
-      }
+    updatePackedBounds ();
+    detail::bounds_violation (x, data_->argumentLower, data_->argumentUpper,
+			      violations.head (n));
+    detail::bounds_violation (res, data_->constraintsLower, data_->constraintsUpper,
+			      violations.tail (m));
 
     return violations;
   }
@@ -766,26 +1079,26 @@ namespace roboptim
       }
 
     // Starting point.
-    if (startingPoint_)
+    if (data_->startingPoint)
       {
 	o << iendl << "Starting point: "
-	  << "[" << startingPoint_->size () << "](";
+	  << "[" << data_->startingPoint->size () << "](";
 	for (typename function_t::vector_t::Index i = 0;
-	     i < startingPoint_->size (); ++i)
+	     i < data_->startingPoint->size (); ++i)
 	  {
 	    if (i > 0)
 	      o << ",";
 	    std::size_t i_ = static_cast<std::size_t> (i);
 	    if (function_t::getLowerBound
-		(this->argumentBounds ()[i_]) <= (*startingPoint_)[i] &&
-		(*startingPoint_)[i] <= function_t::getUpperBound
+		(this->argumentBounds ()[i_]) <= (*data_->startingPoint)[i] &&
+		(*data_->startingPoint)[i] <= function_t::getUpperBound
 		(this->argumentBounds ()[i_]))
-	      o << fg::ok << (*startingPoint_)[i];
+	      o << fg::ok << (*data_->startingPoint)[i];
 	    else
-	      o << fg::fail << (*startingPoint_)[i];
+	      o << fg::fail << (*data_->startingPoint)[i];
 	    o << fg::reset;
 	  }
-	typename function_t::argument_t x0 = *startingPoint_;
+	typename function_t::argument_t x0 = *data_->startingPoint;
 	o << ")" << iendl << "Starting value: "
 	  << this->function () (x0);
       }
@@ -0,0 +1,201 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_SCALED_PROBLEM_HH
+# define ROBOPTIM_CORE_SCALED_PROBLEM_HH
+
+# include <ostream>
+
+# include <roboptim/core/differentiable-function.hh>
+# include <roboptim/core/problem.hh>
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_problem
+  /// @{
+
+  /// \brief Scaled view of a problem.
+  ///
+  /// The scaling parameters of a problem (objective, argument and
+  /// constraints scaling) define diagonal matrices \f$D_f\f$, \f$D_x\f$
+  /// and \f$D_c\f$. This view exposes the problem in the scaled variables
+  /// \f$y\f$ such that \f$x = D_x y\f$:
+  ///   - cost: \f$D_f f (D_x y)\f$,
+  ///   - constraints: \f$D_c g (D_x y)\f$,
+  ///   - Jacobian: \f$D_c J_g (D_x y) D_x\f$.
+  ///
+  /// The scaling is applied during the evaluation, in a single pass over
+  /// the (possibly sparse) derivatives, so that no scaled copy of the
+  /// functions is built.
+  ///
+  /// The scaling parameters and the scaled bounds are computed on
+  /// construction, and the view keeps a reference to the problem: the
+  /// problem must outlive the view. All the scaling parameters are
+  /// expected to be positive.
+  ///
+  /// \tparam T matrix type (dense or sparse).
+  template <typename T>
+  class ScaledProblem
+  {
+  public:
+    typedef Problem<T> problem_t;
+    typedef typename problem_t::function_t function_t;
+    typedef typename problem_t::value_type value_type;
+    typedef typename problem_t::size_type size_type;
+    typedef typename problem_t::vector_t vector_t;
+    typedef typename problem_t::argument_t argument_t;
+    typedef typename problem_t::argument_ref argument_ref;
+    typedef typename problem_t::const_argument_ref const_argument_ref;
+    typedef typename problem_t::result_ref result_ref;
+    typedef typename problem_t::jacobian_t jacobian_t;
+    typedef typename problem_t::jacobian_ref jacobian_ref;
+    typedef GenericDifferentiableFunction<T> differentiableFunction_t;
+    typedef typename differentiableFunction_t::gradient_ref gradient_ref;
+
+    /// \brief Create a scaled view of a problem.
+    ///
+    /// \param pb input problem.
+    /// \throw std::runtime_error if a scaling parameter is not positive.
+    explicit ScaledProblem (const problem_t& pb);
+
+    virtual ~ScaledProblem ();
+
+    /// \brief Input problem.
+    const problem_t& problem () const
+    {
+      return pb_;
+    }
+
+    /// \brief Argument scaling \f$D_x\f$.
+    const vector_t& argumentScaling () const
+    {
+      return argumentScaling_;
+    }
+
+    /// \brief Constraints scaling \f$D_c\f$ (one value per constraint row,
+    /// same order as Problem::evaluateConstraints).
+    const vector_t& constraintsScaling () const
+    {
+      return constraintsScaling_;
+    }
+
+    /// \brief Objective scaling \f$D_f\f$.
+    const vector_t& objectiveScaling () const
+    {
+      return objectiveScaling_;
+    }
+
+    /// \brief Scaled argument lower bounds.
+    const vector_t& argumentLowerBounds () const
+    {
+      return argumentLower_;
+    }
+
+    /// \brief Scaled argument upper bounds.
+    const vector_t& argumentUpperBounds () const
+    {
+      return argumentUpper_;
+    }
+
+    /// \brief Scaled constraints lower bounds.
+    const vector_t& constraintsLowerBounds () const
+    {
+      return constraintsLower_;
+    }
+
+    /// \brief Scaled constraints upper bounds.
+    const vector_t& constraintsUpperBounds () const
+    {
+      return constraintsUpper_;
+    }
+
+    /// \brief Map an argument of the problem to the scaled variables.
+    /// \param y scaled argument \f$D_x^{-1} x\f$.
+    /// \param x argument of the problem.
+    void scaleArgument (argument_ref y, const_argument_ref x) const;
+
+    /// \brief Map scaled variables to an argument of the problem.
+    /// \param x argument of the problem \f$D_x y\f$.
+    /// \param y scaled argument.
+    void unscaleArgument (argument_ref x, const_argument_ref y) const;
+
+    /// \brief Evaluate the scaled cost.
+    /// \param res result.
+    /// \param y scaled argument.
+    void cost (result_ref res, const_argument_ref y) const;
+
+    /// \brief Evaluate the gradient of the scaled cost.
+    /// \param gradient gradient.
+    /// \param y scaled argument.
+    /// \param functionId output index of the cost.
+    /// \throw std::runtime_error if the cost is not differentiable.
+    void costGradient (gradient_ref gradient, const_argument_ref y,
+		       size_type functionId = 0) const;
+
+    /// \brief Evaluate the scaled constraints.
+    /// \param res result (Problem::constraintsOutputSize rows).
+    /// \param y scaled argument.
+    void evaluateConstraints (result_ref res, const_argument_ref y) const;
+
+    /// \brief Evaluate the scaled Jacobian of the differentiable
+    /// constraints.
+    /// \param jac Jacobian (see Problem::jacobian).
+    /// \param y scaled argument.
+    void jacobian (jacobian_ref jac, const_argument_ref y) const;
+
+    /// \brief Print method.
+    /// \param o output stream.
+    /// \return modified output stream.
+    virtual std::ostream& print (std::ostream& o) const;
+
+  private:
+    /// \brief Input problem.
+    const problem_t& pb_;
+
+    /// \brief Argument scaling.
+    vector_t argumentScaling_;
+
+    /// \brief Constraints scaling.
+    vector_t constraintsScaling_;
+
+    /// \brief Objective scaling.
+    vector_t objectiveScaling_;
+
+    /// \brief Scaled argument lower bounds.
+    vector_t argumentLower_;
+
+    /// \brief Scaled argument upper bounds.
+    vector_t argumentUpper_;
+
+    /// \brief Scaled constraints lower bounds.
+    vector_t constraintsLower_;
+
+    /// \brief Scaled constraints upper bounds.
+    vector_t constraintsUpper_;
+
+    /// \brief Unscaled argument buffer.
+    mutable argument_t x_;
+  };
+
+  template <typename T>
+  std::ostream& operator<< (std::ostream& o, const ScaledProblem<T>& p);
+
+  /// @}
+} // end of namespace roboptim
+
+# include <roboptim/core/scaled-problem.hxx>
+#endif //! ROBOPTIM_CORE_SCALED_PROBLEM_HH
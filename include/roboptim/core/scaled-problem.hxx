@@ -0,0 +1,203 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_SCALED_PROBLEM_HXX
+# define ROBOPTIM_CORE_SCALED_PROBLEM_HXX
+
+# include <stdexcept>
+# include <string>
+
+# include <roboptim/core/indent.hh>
+# include <roboptim/core/util.hh>
+
+namespace roboptim
+{
+  namespace detail
+  {
+    /// \internal
+    /// \brief Scale the entries of a dense gradient.
+    ///
+    /// \param g gradient (modified in place).
+    /// \param s global scaling factor.
+    /// \param d scaling of each entry.
+    inline void
+    scale_gradient
+    (GenericDifferentiableFunction<EigenMatrixDense>::gradient_ref g,
+     double s,
+     GenericFunctionTraits<EigenMatrixDense>::const_vector_ref d)
+    {
+      g.array () *= s * d.transpose ().array ();
+    }
+
+    /// \internal
+    /// \brief Scale the nonzeros of a sparse gradient.
+    ///
+    /// \param g gradient (modified in place).
+    /// \param s global scaling factor.
+    /// \param d scaling of each entry.
+    inline void
+    scale_gradient
+    (GenericDifferentiableFunction<EigenMatrixSparse>::gradient_ref g,
+     double s,
+     GenericFunctionTraits<EigenMatrixDense>::const_vector_ref d)
+    {
+      typedef GenericDifferentiableFunction<EigenMatrixSparse>::gradient_t
+	gradient_t;
+
+      for (gradient_t::InnerIterator it (g); it; ++it)
+	it.valueRef () *= s * d[it.index ()];
+    }
+
+    /// \internal
+    /// \brief Copy a scaling vector, checking that it is positive.
+    template <typename V, typename S>
+    void copy_scaling (V& dst, const S& src, const std::string& what)
+    {
+      dst.resize (static_cast<typename V::Index> (src.size ()));
+      for (std::size_t i = 0; i < src.size (); ++i)
+	{
+	  if (!(src[i] > 0.))
+	    throw std::runtime_error ("non-positive " + what + " scaling");
+	  dst[static_cast<typename V::Index> (i)] = src[i];
+	}
+    }
+  } // end of namespace detail
+
+  template <typename T>
+  ScaledProblem<T>::ScaledProblem (const problem_t& pb)
+    : pb_ (pb),
+      argumentScaling_ (),
+      constraintsScaling_ (pb.constraintsOutputSize ()),
+      objectiveScaling_ (),
+      argumentLower_ (),
+      argumentUpper_ (),
+      constraintsLower_ (),
+      constraintsUpper_ (),
+      x_ (pb.function ().inputSize ())
+  {
+    detail::copy_scaling (argumentScaling_, pb_.argumentScaling (),
+			  "argument");
+    detail::copy_scaling (objectiveScaling_, pb_.objectiveScaling (),
+			  "objective");
+
+    size_type row = 0;
+    for (std::size_t i = 0; i < pb_.scalingVector ().size (); ++i)
+      {
+	vector_t scaling;
+	detail::copy_scaling (scaling, pb_.scalingVector ()[i], "constraint");
+	constraintsScaling_.segment (row, scaling.size ()) = scaling;
+	row += scaling.size ();
+      }
+
+    // Infinite bounds remain infinite since all scaling factors are
+    // positive.
+    argumentLower_ = pb_.argumentLowerBounds ().cwiseQuotient
+      (argumentScaling_);
+    argumentUpper_ = pb_.argumentUpperBounds ().cwiseQuotient
+      (argumentScaling_);
+    constraintsLower_ = pb_.constraintsLowerBounds ().cwiseProduct
+      (constraintsScaling_);
+    constraintsUpper_ = pb_.constraintsUpperBounds ().cwiseProduct
+      (constraintsScaling_);
+  }
+
+  template <typename T>
+  ScaledProblem<T>::~ScaledProblem ()
+  {
+  }
+
+  template <typename T>
+  void
+  ScaledProblem<T>::scaleArgument (argument_ref y, const_argument_ref x) const
+  {
+    assert (x.size () == argumentScaling_.size ());
+    y = x.cwiseQuotient (argumentScaling_);
+  }
+
+  template <typename T>
+  void
+  ScaledProblem<T>::unscaleArgument (argument_ref x,
+				     const_argument_ref y) const
+  {
+    assert (y.size () == argumentScaling_.size ());
+    x = y.cwiseProduct (argumentScaling_);
+  }
+
+  template <typename T>
+  void
+  ScaledProblem<T>::cost (result_ref res, const_argument_ref y) const
+  {
+    unscaleArgument (x_, y);
+    pb_.function () (res, x_);
+    res.array () *= objectiveScaling_.array ();
+  }
+
+  template <typename T>
+  void
+  ScaledProblem<T>::costGradient (gradient_ref gradient, const_argument_ref y,
+				  size_type functionId) const
+  {
+    if (!pb_.function ().template asType<differentiableFunction_t> ())
+      throw std::runtime_error ("the cost function is not differentiable");
+
+    const differentiableFunction_t* df =
+      pb_.function ().template castInto<differentiableFunction_t> ();
+
+    unscaleArgument (x_, y);
+    df->gradient (gradient, x_, functionId);
+    detail::scale_gradient (gradient, objectiveScaling_[functionId],
+			    argumentScaling_);
+  }
+
+  template <typename T>
+  void
+  ScaledProblem<T>::evaluateConstraints (result_ref res,
+					 const_argument_ref y) const
+  {
+    unscaleArgument (x_, y);
+    pb_.evaluateConstraints (res, x_);
+    res.array () *= constraintsScaling_.array ();
+  }
+
+  template <typename T>
+  void
+  ScaledProblem<T>::jacobian (jacobian_ref jac, const_argument_ref y) const
+  {
+    unscaleArgument (x_, y);
+    pb_.scaledJacobian (jac, x_);
+  }
+
+  template <typename T>
+  std::ostream& ScaledProblem<T>::print (std::ostream& o) const
+  {
+    o << "Scaled problem:" << incindent
+      << iendl << "Argument scaling: " << argumentScaling_.transpose ()
+      << iendl << "Objective scaling: " << objectiveScaling_.transpose ()
+      << iendl << "Constraints scaling: " << constraintsScaling_.transpose ()
+      << iendl << "Problem:" << incindent << iendl << pb_
+      << decindent << decindent;
+    return o;
+  }
+
+  template <typename T>
+  std::ostream& operator<< (std::ostream& o, const ScaledProblem<T>& p)
+  {
+    return p.print (o);
+  }
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_SCALED_PROBLEM_HXX
@@ -57,21 +57,31 @@ namespace roboptim
 
     /// \brief Get a possible scaling vector based on the gradient's infinity
     /// norm.
+    ///
+    /// The Jacobians of distinct constraints are evaluated in parallel if
+    /// the problem allows it (see Problem::evaluationThreads).
+    ///
     /// \param x vector of arguments to consider.
     /// \return scaling vector.
     void computeScaling (const std::vector<argument_t>& x);
 
+    /// \brief Suggested scaling parameters of each constraint.
+    /// \return vector of pairs of function/scaling parameters.
+    const std::vector<scalingFunc_t>& scaling () const
+    {
+      return scalingFunc_;
+    }
+
     /// \brief Print method.
     /// \param o output stream.
     /// \return modified output stream.
     virtual std::ostream& print (std::ostream& o) const;
 
   private:
-    /// \brief Get the infinite norm of a row of the Jacobian.
-    /// \param jac Jacobian matrix.
-    /// \param i row index.
-    /// \return infinity norm.
-    value_type maxRow (const jacobian_t& jac, size_type i) const;
+    /// \brief Update a scaling parameter given a gradient amplitude.
+    /// \param curScaling current scaling parameter.
+    /// \param maxGrad infinity norm of the gradient.
+    void updateScaling (value_type& curScaling, value_type maxGrad) const;
 
   private:
     /// \brief Copy of the input problem.
@@ -18,11 +18,15 @@
 #ifndef ROBOPTIM_CORE_SCALING_HELPER_HXX
 # define ROBOPTIM_CORE_SCALING_HELPER_HXX
 
+# include <algorithm>
+# include <cmath>
+# include <limits>
 # include <vector>
 # include <stdexcept>
 
 # include <roboptim/core/util.hh>
 # include <roboptim/core/differentiable-function.hh>
+# include <roboptim/core/detail/parallel.hh>
 
 namespace roboptim
 {
@@ -52,62 +56,153 @@ namespace roboptim
   {
   }
 
+  namespace detail
+  {
+    /// \internal
+    /// \brief Compute the maximum absolute value of each row of a dense
+    /// Jacobian.
+    ///
+    /// \param jac Jacobian matrix.
+    /// \param res maximum absolute value of each row.
+    inline void
+    row_max_abs
+    (GenericFunctionTraits<EigenMatrixDense>::const_matrix_ref jac,
+     GenericFunctionTraits<EigenMatrixDense>::vector_ref res)
+    {
+      if (jac.cols () == 0)
+	res.setZero ();
+      else
+	res = jac.cwiseAbs ().rowwise ().maxCoeff ();
+    }
+
+    /// \internal
+    /// \brief Compute the maximum absolute value of each row of a sparse
+    /// Jacobian, in a single pass over the nonzeros.
+    ///
+    /// \param jac Jacobian matrix.
+    /// \param res maximum absolute value of each row.
+    inline void
+    row_max_abs
+    (const GenericFunctionTraits<EigenMatrixSparse>::matrix_t& jac,
+     GenericFunctionTraits<EigenMatrixDense>::vector_ref res)
+    {
+      typedef GenericFunctionTraits<EigenMatrixSparse>::matrix_t matrix_t;
+
+      res.setZero ();
+      for (matrix_t::Index k = 0; k < jac.outerSize (); ++k)
+	for (matrix_t::InnerIterator it (jac, k); it; ++it)
+	  res[it.row ()] = std::max (res[it.row ()], std::abs (it.value ()));
+    }
+
+    /// \internal
+    /// \brief Compute the extreme gradient amplitudes of a constraint
+    /// over a set of points.
+    template <typename T>
+    struct GradientRange
+    {
+      typedef GenericDifferentiableFunction<T> differentiableFunction_t;
+      typedef typename differentiableFunction_t::argument_t argument_t;
+      typedef typename differentiableFunction_t::vector_t vector_t;
+      typedef typename differentiableFunction_t::jacobian_t jacobian_t;
+      typedef typename Problem<T>::constraints_t constraints_t;
+
+      GradientRange (const constraints_t& constraints,
+		     const std::vector<argument_t>& x,
+		     std::vector<vector_t>& maxGrad,
+		     std::vector<vector_t>& minGrad)
+	: constraints_ (constraints),
+	  x_ (x),
+	  maxGrad_ (maxGrad),
+	  minGrad_ (minGrad)
+      {}
+
+      void operator () (std::size_t i)
+      {
+	if (!constraints_[i]->template asType<differentiableFunction_t> ())
+	  return;
+
+	const differentiableFunction_t* df =
+	  constraints_[i]->template castInto<differentiableFunction_t> ();
+
+	// Buffers are local to the constraint, hence to the thread.
+	jacobian_t jac (df->outputSize (), df->inputSize ());
+	vector_t rowMax (df->outputSize ());
+	maxGrad_[i].setConstant (df->outputSize (), 0.);
+	minGrad_[i].setConstant (df->outputSize (),
+				 std::numeric_limits<double>::infinity ());
+
+	for (typename std::vector<argument_t>::const_iterator
+	       xi = x_.begin (); xi != x_.end (); ++xi)
+	  {
+	    jac.setZero ();
+	    df->jacobian (jac, *xi);
+	    row_max_abs (jac, rowMax);
+	    maxGrad_[i] = maxGrad_[i].cwiseMax (rowMax);
+	    minGrad_[i] = minGrad_[i].cwiseMin (rowMax);
+	  }
+      }
+
+      const constraints_t& constraints_;
+      const std::vector<argument_t>& x_;
+      std::vector<vector_t>& maxGrad_;
+      std::vector<vector_t>& minGrad_;
+    };
+  } // end of namespace detail
+
   template <typename T>
   void ScalingHelper<T>::computeScaling (const std::vector<argument_t>& x)
   {
-    typedef GenericDifferentiableFunction<T> differentiableFunction_t;
-    typedef typename differentiableFunction_t::jacobian_t jacobian_t;
-
-    std::vector<interval_t> bounds;
-    jacobian_t jac;
-    size_t c_idx = 0;
+    typedef typename problem_t::vector_t vector_t;
+
+    if (x.empty ())
+      return;
+
+    const constraints_t& constraints = pb_.constraints ();
+
+    // Extreme gradient amplitudes of each output dimension. Distinct
+    // constraints are processed in parallel: a function relies on internal
+    // buffers, so a given constraint is evaluated by a single thread.
+    std::vector<vector_t> maxGrad (constraints.size ());
+    std::vector<vector_t> minGrad (constraints.size ());
+    detail::GradientRange<T> range (constraints, x, maxGrad, minGrad);
+    detail::parallel_for (constraints.size (), pb_.parallelThreads (),
+			  range);
+
+    // The update rule only depends on the extreme amplitudes: a gradient
+    // too high always takes precedence, otherwise the smallest gradient
+    // sets the scaling.
+    for (size_t c_idx = 0; c_idx < constraints.size (); ++c_idx)
+    {
+      for (size_type i = 0; i < maxGrad[c_idx].size (); ++i)
+      {
+        value_type& curScaling
+          = scalingFunc_[c_idx].second[static_cast<size_t> (i)];
+        updateScaling (curScaling, maxGrad[c_idx][i]);
+        updateScaling (curScaling, minGrad[c_idx][i]);
+      }
+    }
+  }
 
-    // For each constraint
-    for (typename constraints_t::const_iterator
-         c  = pb_.constraints ().begin ();
-         c != pb_.constraints ().end (); ++c, ++c_idx)
+  template <typename T>
+  void ScalingHelper<T>::updateScaling (value_type& curScaling,
+                                        value_type maxGrad) const
+  {
+    // Gradient values too high
+    if (maxGrad > gradRange_.second)
+    {
+      value_type scaling = gradRange_.second / maxGrad;
+      if (scaling < curScaling)
+      {
+        curScaling = scaling;
+      }
+    }
+    // Gradient values too low
+    else if (maxGrad < gradRange_.first && curScaling >= 1.)
     {
-      // If the constraints is differentiable
-      if ((*c)->template asType<differentiableFunction_t> ())
+      value_type scaling = gradRange_.first / maxGrad;
+      if (scaling > curScaling)
       {
-        const differentiableFunction_t*
-          df = (*c)->template castInto<differentiableFunction_t> ();
-        jac.resize (df->outputSize (), df->inputSize ());
-
-        for (typename std::vector<argument_t>::const_iterator
-             xi = x.begin (); xi != x.end (); ++xi)
-        {
-          jac.setZero ();
-          df->jacobian (jac, *xi);
-
-          // For each output dimension
-          for (size_type i = 0; i < df->outputSize (); ++i)
-          {
-            // Get the maximum amplitude of the gradient
-            value_type maxGrad = maxRow (jac, i);
-            value_type& curScaling
-              = scalingFunc_[c_idx].second[static_cast<size_t> (i)];
-
-            // Gradient values too high
-            if (maxGrad > gradRange_.second)
-            {
-               value_type scaling = gradRange_.second / maxGrad;
-               if (scaling < curScaling)
-               {
-                 curScaling = scaling;
-               }
-            }
-            // Gradient values too low
-            else if (maxGrad < gradRange_.first && curScaling >= 1.)
-            {
-               value_type scaling = gradRange_.first / maxGrad;
-               if (scaling > curScaling)
-               {
-                 curScaling = scaling;
-               }
-            }
-          }
-        }
+        curScaling = scaling;
       }
     }
   }
@@ -135,25 +230,6 @@ namespace roboptim
     return o;
   }
 
-  template <>
-  inline ScalingHelper<EigenMatrixSparse>::value_type
-  ScalingHelper<EigenMatrixSparse>::maxRow
-  (const jacobian_t& jac, size_type i) const
-  {
-    typedef DifferentiableFunction::vector_t denseVector_t;
-
-    // Note: lpNorm is not available for sparse Eigen::Block
-    denseVector_t grad (jac.row (i));
-    return grad.lpNorm<Eigen::Infinity> ();
-  }
-
-  template <typename T>
-  typename ScalingHelper<T>::value_type
-  ScalingHelper<T>::maxRow (const jacobian_t& jac, size_type i) const
-  {
-    return jac.row (i).template lpNorm<Eigen::Infinity> ();
-  }
-
   template <typename T>
   std::ostream&
   operator<< (std::ostream& o, const ScalingHelper<T>& sh)
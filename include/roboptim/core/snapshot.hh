@@ -0,0 +1,210 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_SNAPSHOT_HH
+# define ROBOPTIM_CORE_SNAPSHOT_HH
+
+# include <cstddef>
+# include <fstream>
+# include <string>
+
+# include <boost/cstdint.hpp>
+# include <boost/shared_ptr.hpp>
+# include <boost/scoped_ptr.hpp>
+
+# include <roboptim/core/fwd.hh>
+# include <roboptim/core/portability.hh>
+# include <roboptim/core/function.hh>
+# include <roboptim/core/problem.hh>
+
+namespace roboptim
+{
+  /// \addtogroup roboptim_problem
+  /// @{
+
+  /// \brief Save a problem into a binary snapshot.
+  ///
+  /// The snapshot is a binary file that can be loaded back with
+  /// loadSnapshot, without any parsing: all arrays are stored with their
+  /// in-memory layout, aligned on 8 bytes, and are read through Eigen::Map
+  /// views on a memory-mapped file.
+  ///
+  /// The cost function and the constraints have to be numeric linear,
+  /// numeric quadratic or constant functions. The snapshot stores them
+  /// along with the bounds, the scaling, the argument names and the
+  /// starting point. As numeric quadratic functions only read the upper
+  /// triangle of their symmetric matrix, only that triangle is saved.
+  ///
+  /// The file format depends on the platform (byte order, index size) and
+  /// on the storage order of matrices: a snapshot can only be loaded by a
+  /// compatible build.
+  ///
+  /// \param pb problem to save.
+  /// \param filename path of the snapshot.
+  /// \throw std::runtime_error if a function cannot be saved or if the
+  /// file cannot be written.
+  template <typename T>
+  void saveSnapshot (const Problem<T>& pb, const std::string& filename);
+
+  /// \brief Load a problem from a binary snapshot.
+  ///
+  /// The file is memory-mapped, and matrices are read through Eigen::Map
+  /// views. Since RobOptim numeric functions own their data, each matrix
+  /// is copied once (in bulk) into its function; the mapping is released
+  /// once the problem is built.
+  ///
+  /// \param filename path of the snapshot.
+  /// \return loaded problem.
+  /// \throw std::runtime_error if the file is invalid or incompatible.
+  template <typename T>
+  boost::shared_ptr<Problem<T> > loadSnapshot (const std::string& filename);
+
+  /// @}
+
+  namespace detail
+  {
+    /// \internal
+    /// \brief Kind of function stored in a snapshot.
+    enum SnapshotFunctionKind
+      {
+	SNAPSHOT_NUMERIC_LINEAR = 0,
+	SNAPSHOT_NUMERIC_QUADRATIC = 1,
+	SNAPSHOT_CONSTANT = 2
+      };
+
+    /// \internal
+    /// \brief Write a binary snapshot. Each record is padded to 8 bytes.
+    class ROBOPTIM_CORE_DLLAPI SnapshotWriter
+    {
+    public:
+      /// \brief Open a snapshot file and write its header.
+      ///
+      /// \param filename path of the snapshot.
+      /// \param sparse whether matrices are sparse.
+      /// \throw std::runtime_error
+      SnapshotWriter (const std::string& filename, bool sparse);
+
+      /// \brief Write raw data.
+      void write (const void* data, std::size_t size);
+
+      /// \brief Write a 64-bit unsigned integer.
+      void writeInteger (boost::uint64_t v);
+
+      /// \brief Write a string.
+      void writeString (const std::string& s);
+
+      /// \brief Write a vector.
+      void writeVector
+      (GenericFunctionTraits<EigenMatrixDense>::const_vector_ref v);
+
+      /// \brief Write a dense matrix.
+      void writeMatrix
+      (GenericFunctionTraits<EigenMatrixDense>::const_matrix_ref m);
+
+      /// \brief Write a sparse matrix.
+      void writeMatrix
+      (GenericFunctionTraits<EigenMatrixSparse>::const_matrix_ref m);
+
+      /// \brief Flush and close the file.
+      /// \throw std::runtime_error
+      void close ();
+
+    private:
+      /// \brief Output file.
+      std::ofstream file_;
+
+      /// \brief Path of the file.
+      std::string filename_;
+    };
+
+    /// \internal
+    /// \brief Read a memory-mapped binary snapshot.
+    class ROBOPTIM_CORE_DLLAPI SnapshotReader
+    {
+    public:
+      /// \brief Dense matrix type.
+      typedef GenericFunctionTraits<EigenMatrixDense>::matrix_t
+      denseMatrix_t;
+
+      /// \brief Sparse matrix type.
+      typedef GenericFunctionTraits<EigenMatrixSparse>::matrix_t
+      sparseMatrix_t;
+
+      /// \brief Vector type.
+      typedef GenericFunctionTraits<EigenMatrixDense>::vector_t vector_t;
+
+      /// \brief Read-only view of a vector.
+      typedef Eigen::Map<const vector_t> vectorView_t;
+
+      /// \brief Read-only view of a dense matrix.
+      typedef Eigen::Map<const denseMatrix_t> denseMatrixView_t;
+
+      /// \brief Map a snapshot file and check its header.
+      ///
+      /// \param filename path of the snapshot.
+      /// \param sparse whether matrices are expected to be sparse.
+      /// \throw std::runtime_error
+      SnapshotReader (const std::string& filename, bool sparse);
+
+      ~SnapshotReader ();
+
+      /// \brief Read raw data.
+      /// \return pointer to the data in the mapped file.
+      /// \throw std::runtime_error if the file is too short.
+      const void* read (std::size_t size);
+
+      /// \brief Read a 64-bit unsigned integer.
+      boost::uint64_t readInteger ();
+
+      /// \brief Read a size and check that it fits in the file.
+      std::size_t readSize (std::size_t elementSize);
+
+      /// \brief Read a string.
+      std::string readString ();
+
+      /// \brief Read a vector.
+      vectorView_t readVector ();
+
+      /// \brief Read a dense matrix.
+      denseMatrixView_t readDenseMatrix ();
+
+      /// \brief Read a sparse matrix.
+      sparseMatrix_t readSparseMatrix ();
+
+      /// \brief Whether the whole file has been read.
+      bool eof () const;
+
+    private:
+      struct Mapping;
+
+      /// \brief Memory mapping of the file.
+      boost::scoped_ptr<Mapping> mapping_;
+
+      /// \brief Beginning of the mapped data.
+      const char* data_;
+
+      /// \brief Size of the mapped data.
+      std::size_t size_;
+
+      /// \brief Current offset.
+      std::size_t offset_;
+    };
+  } // end of namespace detail
+} // end of namespace roboptim
+
+# include <roboptim/core/snapshot.hxx>
+#endif //! ROBOPTIM_CORE_SNAPSHOT_HH
@@ -0,0 +1,350 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROBOPTIM_CORE_SNAPSHOT_HXX
+# define ROBOPTIM_CORE_SNAPSHOT_HXX
+
+# include <stdexcept>
+
+# include <boost/format.hpp>
+# include <boost/make_shared.hpp>
+# include <boost/type_traits/is_same.hpp>
+
+# include <roboptim/core/numeric-linear-function.hh>
+# include <roboptim/core/numeric-quadratic-function.hh>
+# include <roboptim/core/function/constant.hh>
+
+namespace roboptim
+{
+  namespace detail
+  {
+    /// \internal
+    /// \brief Read a matrix from a snapshot: dense matrices are read
+    /// through a view on the mapped file, sparse matrices are rebuilt
+    /// from their compressed arrays.
+    template <typename T>
+    struct SnapshotMatrix;
+
+    template <>
+    struct SnapshotMatrix<EigenMatrixDense>
+    {
+      typedef SnapshotReader::denseMatrixView_t type;
+
+      static type read (SnapshotReader& r)
+      {
+	return r.readDenseMatrix ();
+      }
+    };
+
+    template <>
+    struct SnapshotMatrix<EigenMatrixSparse>
+    {
+      typedef SnapshotReader::sparseMatrix_t type;
+
+      static type read (SnapshotReader& r)
+      {
+	return r.readSparseMatrix ();
+      }
+    };
+
+    /// \internal
+    /// \brief Write a scaling vector.
+    inline void
+    writeSnapshotScaling (SnapshotWriter& w, const std::vector<double>& s)
+    {
+      w.writeVector (Eigen::Map<const SnapshotReader::vector_t>
+		     (s.empty () ? 0 : &s[0],
+		      static_cast<Function::size_type> (s.size ())));
+    }
+
+    /// \internal
+    /// \brief Read a scaling vector.
+    inline std::vector<double>
+    readSnapshotScaling (SnapshotReader& r)
+    {
+      SnapshotReader::vectorView_t v = r.readVector ();
+      return std::vector<double> (v.data (), v.data () + v.size ());
+    }
+
+    /// \internal
+    /// \brief Write a function into a snapshot.
+    template <typename T>
+    void writeSnapshotFunction (SnapshotWriter& w,
+				const GenericFunction<T>& f)
+    {
+      typedef GenericNumericLinearFunction<T> numericLinear_t;
+      typedef GenericNumericQuadraticFunction<T> numericQuadratic_t;
+      typedef GenericConstantFunction<T> constant_t;
+
+      if (f.template asType<numericQuadratic_t> ())
+	{
+	  const numericQuadratic_t*
+	    q = f.template castInto<numericQuadratic_t> ();
+	  w.writeInteger (SNAPSHOT_NUMERIC_QUADRATIC);
+	  w.writeInteger (static_cast<boost::uint64_t> (f.inputSize ()));
+	  w.writeInteger (static_cast<boost::uint64_t> (f.outputSize ()));
+	  w.writeString (f.getName ());
+	  // Only the upper triangle of A is used by the function.
+	  const typename numericQuadratic_t::matrix_t
+	    a = q->A ().template triangularView<Eigen::Upper> ();
+	  w.writeMatrix (a);
+	  w.writeVector (q->b ());
+	  w.writeVector (q->c ());
+	}
+      else if (f.template asType<numericLinear_t> ())
+	{
+	  const numericLinear_t*
+	    l = f.template castInto<numericLinear_t> ();
+	  w.writeInteger (SNAPSHOT_NUMERIC_LINEAR);
+	  w.writeInteger (static_cast<boost::uint64_t> (f.inputSize ()));
+	  w.writeInteger (static_cast<boost::uint64_t> (f.outputSize ()));
+	  w.writeString (f.getName ());
+	  w.writeMatrix (l->A ());
+	  w.writeVector (l->b ());
+	}
+      else if (f.template asType<constant_t> ())
+	{
+	  // The offset is the value of the function anywhere.
+	  typename GenericFunction<T>::argument_t x (f.inputSize ());
+	  x.setZero ();
+	  w.writeInteger (SNAPSHOT_CONSTANT);
+	  w.writeInteger (static_cast<boost::uint64_t> (f.inputSize ()));
+	  w.writeInteger (static_cast<boost::uint64_t> (f.outputSize ()));
+	  w.writeString (f.getName ());
+	  w.writeVector (f (x));
+	}
+      else
+	{
+	  boost::format fmt
+	    ("cannot save function '%s' into a snapshot: only numeric linear, "
+	     "numeric quadratic and constant functions are supported");
+	  fmt % f.getName ();
+	  throw std::runtime_error (fmt.str ());
+	}
+    }
+
+    /// \internal
+    /// \brief Read a function from a snapshot.
+    ///
+    /// The sizes are checked before any allocation.
+    ///
+    /// \param r snapshot reader.
+    /// \param inputSize expected input size, or -1 for the cost function
+    /// (whose input size is then checked against the argument bounds that
+    /// follow it in the file).
+    /// \throw std::runtime_error
+    template <typename T>
+    boost::shared_ptr<GenericFunction<T> >
+    readSnapshotFunction (SnapshotReader& r,
+			  typename GenericFunction<T>::size_type inputSize = -1)
+    {
+      typedef GenericFunction<T> function_t;
+      typedef typename function_t::size_type size_type;
+      typedef GenericNumericLinearFunction<T> numericLinear_t;
+      typedef GenericNumericQuadraticFunction<T> numericQuadratic_t;
+      typedef GenericConstantFunction<T> constant_t;
+      typedef typename SnapshotMatrix<T>::type matrix_t;
+
+      typedef SnapshotReader::vector_t::Scalar scalar_t;
+
+      const boost::uint64_t kind = r.readInteger ();
+
+      // The lower and upper argument bounds follow the cost function.
+      size_type n = inputSize;
+      if (inputSize < 0)
+	n = static_cast<size_type> (r.readSize (2 * sizeof (scalar_t)));
+      else if (r.readInteger () != static_cast<boost::uint64_t> (inputSize))
+	throw std::runtime_error ("invalid snapshot: inconsistent input size");
+
+      // A vector of size m follows for every kind of function.
+      const size_type m =
+	static_cast<size_type> (r.readSize (sizeof (scalar_t)));
+      const std::string name = r.readString ();
+
+      boost::shared_ptr<function_t> f;
+      switch (kind)
+	{
+	case SNAPSHOT_NUMERIC_QUADRATIC:
+	  {
+	    const matrix_t a = SnapshotMatrix<T>::read (r);
+	    const SnapshotReader::vectorView_t b = r.readVector ();
+	    const SnapshotReader::vectorView_t c = r.readVector ();
+	    if (a.rows () != n || a.cols () != n || b.size () != n
+		|| c.size () != m)
+	      throw std::runtime_error
+		("invalid snapshot: inconsistent quadratic function");
+	    f = boost::make_shared<numericQuadratic_t> (a, b, c, name);
+	    break;
+	  }
+
+	case SNAPSHOT_NUMERIC_LINEAR:
+	  {
+	    const matrix_t a = SnapshotMatrix<T>::read (r);
+	    const SnapshotReader::vectorView_t b = r.readVector ();
+	    if (a.rows () != m || a.cols () != n || b.size () != m)
+	      throw std::runtime_error
+		("invalid snapshot: inconsistent linear function");
+	    f = boost::make_shared<numericLinear_t> (a, b, name);
+	    break;
+	  }
+
+	case SNAPSHOT_CONSTANT:
+	  {
+	    const SnapshotReader::vectorView_t offset = r.readVector ();
+	    if (offset.size () != m)
+	      throw std::runtime_error
+		("invalid snapshot: inconsistent constant function");
+	    f = boost::make_shared<constant_t> (n, offset);
+	    break;
+	  }
+
+	default:
+	  throw std::runtime_error ("invalid snapshot: unknown function kind");
+	}
+
+      return f;
+    }
+  } // end of namespace detail
+
+  template <typename T>
+  void saveSnapshot (const Problem<T>& pb, const std::string& filename)
+  {
+    typedef Problem<T> problem_t;
+    typedef typename problem_t::constraints_t constraints_t;
+    typedef typename problem_t::intervals_t intervals_t;
+    typedef typename problem_t::vector_t vector_t;
+
+    detail::SnapshotWriter w (filename,
+			      boost::is_same<T, EigenMatrixSparse>::value);
+
+    // Cost function.
+    detail::writeSnapshotFunction (w, pb.function ());
+    detail::writeSnapshotScaling (w, pb.objectiveScaling ());
+
+    // Arguments.
+    w.writeVector (pb.argumentLowerBounds ());
+    w.writeVector (pb.argumentUpperBounds ());
+    detail::writeSnapshotScaling (w, pb.argumentScaling ());
+
+    w.writeInteger
+      (static_cast<boost::uint64_t> (pb.argumentNames ().size ()));
+    for (std::size_t i = 0; i < pb.argumentNames ().size (); ++i)
+      w.writeString (pb.argumentNames ()[i]);
+
+    w.writeInteger (pb.startingPoint () ? 1 : 0);
+    if (pb.startingPoint ())
+      w.writeVector (*pb.startingPoint ());
+
+    // Constraints.
+    w.writeInteger (static_cast<boost::uint64_t> (pb.constraints ().size ()));
+    std::size_t i = 0;
+    for (typename constraints_t::const_iterator
+	   c = pb.constraints ().begin (); c != pb.constraints ().end ();
+	 ++c, ++i)
+      {
+	detail::writeSnapshotFunction (w, **c);
+
+	const intervals_t& bounds = pb.boundsVector ()[i];
+	vector_t lower (bounds.size ());
+	vector_t upper (bounds.size ());
+	for (std::size_t j = 0; j < bounds.size (); ++j)
+	  {
+	    lower[static_cast<typename vector_t::Index> (j)] = bounds[j].first;
+	    upper[static_cast<typename vector_t::Index> (j)] = bounds[j].second;
+	  }
+	w.writeVector (lower);
+	w.writeVector (upper);
+	detail::writeSnapshotScaling (w, pb.scalingVector ()[i]);
+      }
+
+    w.close ();
+  }
+
+  template <typename T>
+  boost::shared_ptr<Problem<T> > loadSnapshot (const std::string& filename)
+  {
+    typedef Problem<T> problem_t;
+    typedef typename problem_t::function_t function_t;
+    typedef typename problem_t::intervals_t intervals_t;
+    typedef typename problem_t::size_type size_type;
+    typedef detail::SnapshotReader::vectorView_t vectorView_t;
+
+    detail::SnapshotReader r (filename,
+			      boost::is_same<T, EigenMatrixSparse>::value);
+
+    // Cost function.
+    boost::shared_ptr<const function_t>
+      cost = detail::readSnapshotFunction<T> (r);
+    boost::shared_ptr<problem_t> pb = boost::make_shared<problem_t> (cost);
+    const size_type n = cost->inputSize ();
+
+    pb->objectiveScaling () = detail::readSnapshotScaling (r);
+    if (pb->objectiveScaling ().size ()
+	!= static_cast<std::size_t> (cost->outputSize ()))
+      throw std::runtime_error ("invalid snapshot: inconsistent scaling");
+
+    // Arguments.
+    const vectorView_t lower = r.readVector ();
+    const vectorView_t upper = r.readVector ();
+    if (lower.size () != n || upper.size () != n)
+      throw std::runtime_error ("invalid snapshot: inconsistent bounds");
+    intervals_t& argumentBounds = pb->argumentBounds ();
+    for (size_type j = 0; j < n; ++j)
+      argumentBounds[static_cast<std::size_t> (j)] =
+	function_t::makeInterval (lower[j], upper[j]);
+
+    pb->argumentScaling () = detail::readSnapshotScaling (r);
+    if (pb->argumentScaling ().size () != static_cast<std::size_t> (n))
+      throw std::runtime_error ("invalid snapshot: inconsistent scaling");
+
+    const std::size_t nNames = r.readSize (sizeof (boost::uint64_t));
+    pb->argumentNames ().resize (nNames);
+    for (std::size_t j = 0; j < nNames; ++j)
+      pb->argumentNames ()[j] = r.readString ();
+
+    if (r.readInteger ())
+      pb->startingPoint () = typename problem_t::argument_t (r.readVector ());
+
+    // Constraints.
+    const std::size_t nConstraints = r.readSize (sizeof (boost::uint64_t));
+    for (std::size_t i = 0; i < nConstraints; ++i)
+      {
+	boost::shared_ptr<function_t> c =
+	  detail::readSnapshotFunction<T> (r, n);
+
+	const vectorView_t cLower = r.readVector ();
+	const vectorView_t cUpper = r.readVector ();
+	if (cLower.size () != c->outputSize ()
+	    || cUpper.size () != c->outputSize ())
+	  throw std::runtime_error ("invalid snapshot: inconsistent bounds");
+
+	intervals_t bounds (static_cast<std::size_t> (c->outputSize ()));
+	for (size_type j = 0; j < c->outputSize (); ++j)
+	  bounds[static_cast<std::size_t> (j)] =
+	    function_t::makeInterval (cLower[j], cUpper[j]);
+
+	pb->addConstraint (c, bounds, detail::readSnapshotScaling (r));
+      }
+
+    if (!r.eof ())
+      throw std::runtime_error ("invalid snapshot: trailing data");
+
+    return pb;
+  }
+} // end of namespace roboptim
+
+#endif //! ROBOPTIM_CORE_SNAPSHOT_HXX
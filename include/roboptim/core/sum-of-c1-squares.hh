@@ -26,6 +26,7 @@
 # include <roboptim/core/portability.hh>
 # include <roboptim/core/differentiable-function.hh>
 # include <roboptim/core/function.hh>
+# include <roboptim/core/jacobian-structure.hh>
 
 namespace roboptim {
   /// \addtogroup roboptim_meta_function
@@ -60,10 +61,53 @@ namespace roboptim {
 
     virtual ~GenericSumOfC1Squares ();
 
+    virtual void evaluationState (std::vector<const void*>& objects)
+      const;
+
     /// \brief Get base function
     /// Base function is the vector valued function given at construction
     /// of this class.
     const boost::shared_ptr<const parent_t>& baseFunction () const;
+
+    /// \brief Whether the Jacobian of the base function is reused
+    /// between evaluations at the same point (gradient, Gauss-Newton
+    /// Hessian and product).
+    ///
+    /// This must only be enabled if the Jacobian of the base function only
+    /// depends on its argument. Changing this flag discards the last
+    /// Jacobian.
+    ///
+    /// \param cache caching flag (default: false).
+    void cacheJacobian (bool cache);
+
+    /// \brief Whether the Jacobian of the base function is reused between
+    /// evaluations at the same point.
+    /// \return caching flag.
+    bool cacheJacobian () const
+    {
+      return cacheJacobian_;
+    }
+
+    /// \brief Gauss-Newton approximation of the Hessian.
+    ///
+    /// The Hessian of the sum of squares is approximated by
+    /// \f$2 J^T J\f$, where J is the Jacobian of the base function.
+    /// With sparse matrices, the pattern of the result is only computed
+    /// when the pattern of J changes: as long as the same matrix is
+    /// passed, later calls update its values in place.
+    /// \param hessian approximated Hessian (size: inputSize () x
+    /// inputSize ())
+    /// \param x point at which the Hessian is approximated
+    void gaussNewtonHessian (matrix_ref hessian, const_argument_ref x) const;
+
+    /// \brief Product of the Gauss-Newton Hessian with a vector.
+    ///
+    /// Compute \f$2 J^T (J v)\f$ without forming \f$J^T J\f$.
+    /// \param result product (size: inputSize ())
+    /// \param x point at which the Hessian is approximated
+    /// \param v vector (size: inputSize ())
+    void gaussNewtonProduct (vector_ref result, const_argument_ref x,
+                             const_vector_ref v) const;
   protected:
     /// \brief Compute value of function
     /// Value is sum of squares of coordinates of vector valued base function
@@ -76,14 +120,30 @@ namespace roboptim {
   private:
     /// Compute base function and store result in value_.
     void computeFunction (const_argument_ref x) const;
+    /// Compute Jacobian of base function and store it in jacobian_.
+    void computeJacobian (const_argument_ref x) const;
     /// \brief Vector valued function given at construction
     boost::shared_ptr<const parent_t> baseFunction_;
     /// \brief Store last argument for which the function has been computed
     mutable argument_t x_;
     /// \brief temporary variable to store vector value of input function
     mutable result_t value_;
-    /// \brief temporary variable to store gradients
-    mutable gradient_t gradient_;
+    /// \brief Whether the Jacobian of the base function is reused.
+    bool cacheJacobian_;
+    /// \brief Store last argument for which the Jacobian has been computed
+    mutable argument_t jacobianX_;
+    /// \brief Whether jacobian_ has been computed
+    mutable bool hasJacobian_;
+    /// \brief Jacobian of the base function
+    mutable jacobian_t jacobian_;
+    /// \brief temporary variable to store J v
+    mutable result_t product_;
+    /// \brief Pattern of jacobian_ used for the Gauss-Newton Hessian
+    /// (sparse matrices only)
+    mutable JacobianStructure jacobianStructure_;
+    /// \brief Pattern of the last Gauss-Newton Hessian (sparse matrices
+    /// only)
+    mutable JacobianStructure hessianStructure_;
   }; // class GenericSumOfC1Squares
 
   /// \brief Sum of the squares of dense differentiable functions.
@@ -21,6 +21,12 @@
 #ifndef ROBOPTIM_CORE_SUM_OF_C1_SQUARES_HXX
 # define ROBOPTIM_CORE_SUM_OF_C1_SQUARES_HXX
 
+# include <algorithm>
+
+# include <boost/type_traits/is_same.hpp>
+
+# include <roboptim/core/alloc.hh>
+
 namespace roboptim {
 
   template <typename T>
@@ -28,10 +34,14 @@ namespace roboptim {
                                                    function,
                                                    const std::string& name) :
     parent_t (function->inputSize(), 1, name),
-    baseFunction_ (function)
+    baseFunction_ (function),
+    cacheJacobian_ (false),
+    jacobianX_ (function->inputSize ()),
+    hasJacobian_ (false),
+    jacobian_ (function->outputSize (), function->inputSize ()),
+    product_ (function->outputSize ())
   {
     value_.resize (function->outputSize());
-    gradient_.resize (function->inputSize());
     x_.resize (function->inputSize());
     x_.setZero ();
     (*baseFunction_) (value_, x_);
@@ -42,7 +52,13 @@ namespace roboptim {
     parent_t (src.inputSize(), 1, src.getName()),
     baseFunction_ (src.baseFunction_), x_ (src.x_),
     value_ (src.value_),
-    gradient_ (src.gradient_)
+    cacheJacobian_ (src.cacheJacobian_),
+    jacobianX_ (src.jacobianX_),
+    hasJacobian_ (src.hasJacobian_),
+    jacobian_ (src.jacobian_),
+    product_ (src.product_),
+    jacobianStructure_ (),
+    hessianStructure_ ()
   {
   }
 
@@ -51,6 +67,15 @@ namespace roboptim {
   {
   }
 
+  template <typename T>
+  void
+  GenericSumOfC1Squares<T>::evaluationState (std::vector<const void*>& objects)
+    const
+  {
+    objects.push_back (this);
+    baseFunction_->evaluationState (objects);
+  }
+
   template <typename T>
   const boost::shared_ptr<const typename GenericSumOfC1Squares<T>::parent_t>&
   GenericSumOfC1Squares<T>::baseFunction () const
@@ -58,6 +83,14 @@ namespace roboptim {
     return baseFunction_;
   }
 
+  template <typename T>
+  void
+  GenericSumOfC1Squares<T>::cacheJacobian (bool cache)
+  {
+    cacheJacobian_ = cache;
+    hasJacobian_ = false;
+  }
+
   template <typename T>
   void GenericSumOfC1Squares<T>::
   impl_compute(result_ref result, const_argument_ref x) const
@@ -71,6 +104,29 @@ namespace roboptim {
     result[0] = sumSquares;
   }
 
+  // 2 J^T y - sparse specialization
+  template <>
+  inline void GenericSumOfC1Squares<EigenMatrixSparse>::
+  impl_gradient(gradient_ref gradient, const_argument_ref x,
+                size_type ROBOPTIM_DEBUG_ONLY (row)) const
+  {
+    assert (row == 0);
+    computeFunction (x);
+    computeJacobian (x);
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    bool cur_malloc_allowed = is_malloc_allowed ();
+    set_is_malloc_allowed (true);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+    gradient = (2. * value_.transpose () * jacobian_).sparseView ();
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    set_is_malloc_allowed (cur_malloc_allowed);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+  }
+
+  // 2 J^T y
   template <typename T>
   void GenericSumOfC1Squares<T>::
   impl_gradient(gradient_ref gradient, const_argument_ref x,
@@ -78,13 +134,98 @@ namespace roboptim {
   {
     assert (row == 0);
     computeFunction (x);
-    gradient.setZero ();
-    for (typename result_t::Index i = 0; i < value_.size (); i++) {
-      value_type y = value_[i];
-      gradient_.setZero ();
-      baseFunction_->gradient (gradient_, x, static_cast<size_type> (i));
-      gradient += 2*y*gradient_;
-    }
+    computeJacobian (x);
+    gradient.noalias () = 2. * value_.transpose () * jacobian_;
+  }
+
+  // 2 J^T J - sparse specialization
+  template <>
+  inline void GenericSumOfC1Squares<EigenMatrixSparse>::
+  gaussNewtonHessian (matrix_ref hessian, const_argument_ref x) const
+  {
+    assert (hessian.rows () == inputSize ());
+    assert (hessian.cols () == inputSize ());
+
+    computeJacobian (x);
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    bool cur_malloc_allowed = is_malloc_allowed ();
+    set_is_malloc_allowed (true);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+    jacobian_.makeCompressed ();
+
+    // Symbolic step: only done when the pattern of J changes, or when
+    // another matrix is given.
+    const bool symbolic = !jacobianStructure_.matches (jacobian_)
+      || !hessianStructure_.matches (hessian);
+    if (symbolic)
+      {
+        hessian = 2. * jacobian_.transpose () * jacobian_;
+        hessian.makeCompressed ();
+        jacobianStructure_.update (jacobian_);
+        hessianStructure_.update (hessian);
+      }
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    set_is_malloc_allowed (cur_malloc_allowed);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+    if (symbolic)
+      return;
+
+    // Numeric step: update the values in place.
+    std::fill (hessian.valuePtr (),
+               hessian.valuePtr () + hessian.nonZeros (), 0.);
+    if (matrix_t::IsRowMajor)
+      {
+        // Sum of the outer products of the rows of J.
+        for (size_type k = 0; k < jacobian_.outerSize (); ++k)
+          for (matrix_t::InnerIterator it (jacobian_, k); it; ++it)
+            for (matrix_t::InnerIterator jt (jacobian_, k); jt; ++jt)
+              hessian.coeffRef (it.col (), jt.col ()) +=
+                2. * it.value () * jt.value ();
+      }
+    else
+      {
+        // Dot products of the columns of J.
+        for (size_type j = 0; j < hessian.outerSize (); ++j)
+          for (matrix_t::InnerIterator it (hessian, j); it; ++it)
+            it.valueRef () =
+              2. * jacobian_.col (it.row ()).dot (jacobian_.col (j));
+      }
+  }
+
+  // 2 J^T J
+  template <typename T>
+  void GenericSumOfC1Squares<T>::
+  gaussNewtonHessian (matrix_ref hessian, const_argument_ref x) const
+  {
+    assert (hessian.rows () == this->inputSize ());
+    assert (hessian.cols () == this->inputSize ());
+
+    computeJacobian (x);
+
+    // Only compute the lower triangular part.
+    hessian.setZero ();
+    hessian.template selfadjointView<Eigen::Lower> ()
+      .rankUpdate (jacobian_.transpose (), 2.);
+    hessian.template triangularView<Eigen::StrictlyUpper> () =
+      hessian.transpose ();
+  }
+
+  // 2 J^T (J v)
+  template <typename T>
+  void GenericSumOfC1Squares<T>::
+  gaussNewtonProduct (vector_ref result, const_argument_ref x,
+                      const_vector_ref v) const
+  {
+    assert (result.size () == this->inputSize ());
+    assert (v.size () == this->inputSize ());
+
+    computeJacobian (x);
+    product_.noalias () = jacobian_ * v;
+    result.noalias () = 2. * (jacobian_.transpose () * product_);
   }
 
   template <typename T>
@@ -96,6 +237,30 @@ namespace roboptim {
     }
   }
 
+  template <typename T>
+  void GenericSumOfC1Squares<T>::computeJacobian (const_argument_ref x) const
+  {
+    if (cacheJacobian_ && hasJacobian_ && x == jacobianX_)
+      return;
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    // Sparse Jacobians may be reallocated by the base function.
+    bool cur_malloc_allowed = is_malloc_allowed ();
+    if (!boost::is_same<T, EigenMatrixDense>::value)
+      set_is_malloc_allowed (true);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+    jacobian_.setZero ();
+    baseFunction_->jacobian (jacobian_, x);
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    set_is_malloc_allowed (cur_malloc_allowed);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+    jacobianX_ = x;
+    hasJacobian_ = true;
+  }
+
 // Explicit template instantiations for dense and sparse matrices.
 # ifdef ROBOPTIM_PRECOMPILED_DENSE_SPARSE
   extern template class ROBOPTIM_CORE_DLLAPI GenericSumOfC1Squares<EigenMatrixDense>;
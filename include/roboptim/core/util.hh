@@ -194,6 +194,23 @@ namespace roboptim
   (M& m, const B& b,
    Function::size_type startRow, Function::size_type startCol);
 
+  /// \brief Compute the product of two sparse matrices, in place.
+  ///
+  /// If m is compressed and its pattern contains the pattern of a * b
+  /// (e.g. m was computed by this function with the same operand
+  /// patterns), the values are computed directly in m, without any
+  /// allocation. Otherwise, m is rebuilt from the product.
+  ///
+  /// \param m result matrix.
+  /// \param a left operand.
+  /// \param b right operand.
+  /// \param work index buffer, resized to the inner size of m if needed.
+  /// \tparam M sparse matrix type.
+  /// \return true if the product was computed in place.
+  template <typename M>
+  bool sparseProductInPlace
+  (M& m, const M& a, const M& b, std::vector<typename M::Index>& work);
+
   /// \brief Apply normalize to a scalar.
   inline double normalize (double x, double eps = 1e-8);
 
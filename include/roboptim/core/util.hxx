@@ -220,6 +220,81 @@ namespace roboptim
       }
   }
 
+  template <typename M>
+  bool sparseProductInPlace
+  (M& m, const M& a, const M& b, std::vector<typename M::Index>& work)
+  {
+    typedef typename M::Index index_t;
+#if EIGEN_VERSION_AT_LEAST(3, 2, 90)
+    typedef typename M::StorageIndex storageIndex_t;
+#else
+    typedef typename M::Index storageIndex_t;
+#endif
+
+    ROBOPTIM_ASSERT (a.cols () == b.rows ());
+
+    // The outer vectors of m are those of the operand that shares its
+    // storage order, the other one is scanned along the inner dimension.
+    const M& outer = (M::IsRowMajor)? a : b;
+    const M& inner = (M::IsRowMajor)? b : a;
+
+    bool inPlace = m.isCompressed ()
+      && m.rows () == a.rows () && m.cols () == b.cols ()
+      && static_cast<index_t> (work.size ()) == m.innerSize ();
+
+    if (inPlace)
+      {
+	const storageIndex_t* outerIdx = m.outerIndexPtr ();
+	const storageIndex_t* innerIdx = m.innerIndexPtr ();
+	typename M::Scalar* values = m.valuePtr ();
+
+	for (index_t k = 0; k < m.outerSize () && inPlace; ++k)
+	  {
+	    // Map the inner indices of the current outer vector to their
+	    // position in the values array.
+	    for (index_t p = outerIdx[k]; p < outerIdx[k + 1]; ++p)
+	      {
+		work[static_cast<std::size_t> (innerIdx[p])] = p;
+		values[p] = 0.;
+	      }
+
+	    for (typename M::InnerIterator it (outer, k); it && inPlace; ++it)
+	      for (typename M::InnerIterator jt (inner, it.index ()); jt; ++jt)
+		{
+		  const index_t p =
+		    work[static_cast<std::size_t> (jt.index ())];
+		  if (p < 0)
+		    {
+		      inPlace = false;
+		      break;
+		    }
+		  values[p] += it.value () * jt.value ();
+		}
+
+	    for (index_t p = outerIdx[k]; p < outerIdx[k + 1]; ++p)
+	      work[static_cast<std::size_t> (innerIdx[p])] = -1;
+	  }
+
+	if (inPlace)
+	  return true;
+      }
+
+    // Pattern mismatch: rebuild the result.
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    bool cur_malloc_allowed = is_malloc_allowed ();
+    set_is_malloc_allowed (true);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+
+    m = a * b;
+    m.makeCompressed ();
+    work.assign (static_cast<std::size_t> (m.innerSize ()), -1);
+
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    set_is_malloc_allowed (cur_malloc_allowed);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+    return false;
+  }
+
   inline double normalize (double x, double eps)
   {
       return (std::fabs (x) < eps)? 0:x;
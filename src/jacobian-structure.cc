@@ -0,0 +1,321 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "debug.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include <roboptim/core/indent.hh>
+#include <roboptim/core/jacobian-structure.hh>
+#include <roboptim/core/util.hh>
+
+namespace roboptim
+{
+  JacobianStructure::JacobianStructure ()
+    : rows_ (0),
+      cols_ (0),
+      outer_ (),
+      cooRows_ (),
+      cooCols_ (),
+      csrRowPointers_ (),
+      csrCols_ (),
+      csrPermutation_ (),
+      slots_ ()
+  {
+  }
+
+  void JacobianStructure::update (const matrix_t& m)
+  {
+    assert (m.isCompressed ());
+
+    rows_ = static_cast<index_t> (m.rows ());
+    cols_ = static_cast<index_t> (m.cols ());
+
+    const index_t outerSize = static_cast<index_t> (m.outerSize ());
+    const index_t nnz = static_cast<index_t> (m.nonZeros ());
+    const index_t* outer = m.outerIndexPtr ();
+    const index_t* inner = m.innerIndexPtr ();
+
+    outer_.assign (outer, outer + outerSize + 1);
+
+    // COO layout: follow the storage order of the values.
+    cooRows_.resize (static_cast<std::size_t> (nnz));
+    cooCols_.resize (static_cast<std::size_t> (nnz));
+    for (index_t k = 0; k < outerSize; ++k)
+      for (index_t p = outer[k]; p < outer[k + 1]; ++p)
+	{
+	  std::size_t p_ = static_cast<std::size_t> (p);
+	  cooRows_[p_] = (matrix_t::IsRowMajor)? k : inner[p];
+	  cooCols_[p_] = (matrix_t::IsRowMajor)? inner[p] : k;
+	}
+
+    // CSR layout: bucket the nonzeros by row. Since the nonzeros are
+    // visited in storage order, columns are sorted within each row.
+    csrRowPointers_.assign (static_cast<std::size_t> (rows_) + 1, 0);
+    for (indices_t::const_iterator
+	   r = cooRows_.begin (); r != cooRows_.end (); ++r)
+      csrRowPointers_[static_cast<std::size_t> (*r) + 1]++;
+    for (std::size_t i = 0; i < static_cast<std::size_t> (rows_); ++i)
+      csrRowPointers_[i + 1] += csrRowPointers_[i];
+
+    indices_t next (csrRowPointers_.begin (), csrRowPointers_.end () - 1);
+    csrCols_.resize (static_cast<std::size_t> (nnz));
+    csrPermutation_.resize (static_cast<std::size_t> (nnz));
+    for (index_t p = 0; p < nnz; ++p)
+      {
+	std::size_t p_ = static_cast<std::size_t> (p);
+	std::size_t pos = static_cast<std::size_t>
+	  (next[static_cast<std::size_t> (cooRows_[p_])]++);
+	csrCols_[pos] = cooCols_[p_];
+	csrPermutation_[pos] = p;
+      }
+  }
+
+  bool JacobianStructure::matches (const matrix_t& m) const
+  {
+    if (empty () || !m.isCompressed ()
+	|| m.rows () != rows_ || m.cols () != cols_
+	|| m.nonZeros () != nonZeros ())
+      return false;
+
+    const index_t* outer = m.outerIndexPtr ();
+    const index_t* inner = m.innerIndexPtr ();
+    const indices_t& innerRef = (matrix_t::IsRowMajor)? cooCols_ : cooRows_;
+
+    return std::equal (outer_.begin (), outer_.end (), outer)
+      && std::equal (innerRef.begin (), innerRef.end (), inner);
+  }
+
+  void JacobianStructure::assemble (matrix_t& m,
+				    const std::vector<matrix_t>& blocks,
+				    index_t cols)
+  {
+    assembleBlocks (m, blocks, cols, false);
+  }
+
+  void JacobianStructure::assembleBlockDiagonal
+  (matrix_t& m, const std::vector<matrix_t>& blocks)
+  {
+    index_t cols = 0;
+    for (std::size_t i = 0; i < blocks.size (); ++i)
+      cols += static_cast<index_t> (blocks[i].cols ());
+    assembleBlocks (m, blocks, cols, true);
+  }
+
+  void JacobianStructure::assembleBlocks (matrix_t& m,
+					  const std::vector<matrix_t>& blocks,
+					  index_t cols, bool diagonal)
+  {
+    typedef Eigen::Triplet<value_type> triplet_t;
+
+    const std::size_t n_blocks = blocks.size ();
+
+    // Fast path: if the structure did not change, copy the values directly
+    // into their slots.
+    if (slots_.size () == n_blocks && matches (m) && cols == cols_)
+      {
+	value_type* values = m.valuePtr ();
+	bool samePattern = true;
+	index_t global_row = 0;
+	index_t global_col = 0;
+
+	for (std::size_t i = 0; i < n_blocks && samePattern; ++i)
+	  {
+	    const matrix_t& block = blocks[i];
+	    const indices_t& slots = slots_[i];
+
+	    if (static_cast<std::size_t> (block.nonZeros ()) != slots.size ())
+	      {
+		samePattern = false;
+		break;
+	      }
+
+	    std::size_t p = 0;
+	    for (index_t k = 0; k < block.outerSize () && samePattern; ++k)
+	      for (matrix_t::InnerIterator it (block, k); it; ++it, ++p)
+		{
+		  const std::size_t slot = static_cast<std::size_t> (slots[p]);
+		  if (cooRows_[slot] != global_row + it.row ()
+		      || cooCols_[slot] != global_col + it.col ())
+		    {
+		      samePattern = false;
+		      break;
+		    }
+		  values[slot] = it.value ();
+		}
+
+	    global_row += static_cast<index_t> (block.rows ());
+	    if (diagonal)
+	      global_col += static_cast<index_t> (block.cols ());
+	  }
+
+	if (samePattern)
+	  return;
+      }
+
+    // Slow path: build the union structure and record the slots.
+    index_t rows = 0;
+    std::size_t nnz = 0;
+    for (std::size_t i = 0; i < n_blocks; ++i)
+      {
+	rows += static_cast<index_t> (blocks[i].rows ());
+	nnz += static_cast<std::size_t> (blocks[i].nonZeros ());
+      }
+
+    std::vector<triplet_t> coeffs;
+    coeffs.reserve (nnz);
+
+    index_t global_row = 0;
+    index_t global_col = 0;
+    for (std::size_t i = 0; i < n_blocks; ++i)
+      {
+	const matrix_t& block = blocks[i];
+	for (index_t k = 0; k < block.outerSize (); ++k)
+	  for (matrix_t::InnerIterator it (block, k); it; ++it)
+	    coeffs.push_back
+	      (triplet_t (static_cast<index_t> (global_row + it.row ()),
+			  static_cast<index_t> (global_col + it.col ()),
+			  it.value ()));
+	global_row += static_cast<index_t> (block.rows ());
+	if (diagonal)
+	  global_col += static_cast<index_t> (block.cols ());
+      }
+
+    m.resize (rows, cols);
+    m.setFromTriplets (coeffs.begin (), coeffs.end ());
+    m.makeCompressed ();
+
+    update (m);
+
+    const index_t* outer = m.outerIndexPtr ();
+    const index_t* inner = m.innerIndexPtr ();
+    slots_.resize (n_blocks);
+    global_row = 0;
+    global_col = 0;
+    for (std::size_t i = 0; i < n_blocks; ++i)
+      {
+	const matrix_t& block = blocks[i];
+	indices_t& slots = slots_[i];
+	slots.resize (static_cast<std::size_t> (block.nonZeros ()));
+
+	std::size_t p = 0;
+	for (index_t k = 0; k < block.outerSize (); ++k)
+	  for (matrix_t::InnerIterator it (block, k); it; ++it, ++p)
+	    {
+	      const index_t row = global_row + static_cast<index_t> (it.row ());
+	      const index_t col = global_col + static_cast<index_t> (it.col ());
+	      const index_t o = (matrix_t::IsRowMajor)? row : col;
+	      const index_t in = (matrix_t::IsRowMajor)? col : row;
+	      slots[p] = static_cast<index_t>
+		(std::lower_bound (inner + outer[o], inner + outer[o + 1], in)
+		 - inner);
+	    }
+	global_row += static_cast<index_t> (block.rows ());
+	if (diagonal)
+	  global_col += static_cast<index_t> (block.cols ());
+      }
+  }
+
+  void JacobianStructure::clear ()
+  {
+    rows_ = 0;
+    cols_ = 0;
+    outer_.clear ();
+    cooRows_.clear ();
+    cooCols_.clear ();
+    csrRowPointers_.clear ();
+    csrCols_.clear ();
+    csrPermutation_.clear ();
+    slots_.clear ();
+  }
+
+  bool JacobianStructure::empty () const
+  {
+    return outer_.empty ();
+  }
+
+  JacobianStructure::index_t JacobianStructure::rows () const
+  {
+    return rows_;
+  }
+
+  JacobianStructure::index_t JacobianStructure::cols () const
+  {
+    return cols_;
+  }
+
+  JacobianStructure::index_t JacobianStructure::nonZeros () const
+  {
+    return static_cast<index_t> (cooRows_.size ());
+  }
+
+  const JacobianStructure::indices_t& JacobianStructure::cooRows () const
+  {
+    return cooRows_;
+  }
+
+  const JacobianStructure::indices_t& JacobianStructure::cooCols () const
+  {
+    return cooCols_;
+  }
+
+  const JacobianStructure::indices_t&
+  JacobianStructure::csrRowPointers () const
+  {
+    return csrRowPointers_;
+  }
+
+  const JacobianStructure::indices_t& JacobianStructure::csrCols () const
+  {
+    return csrCols_;
+  }
+
+  const JacobianStructure::indices_t&
+  JacobianStructure::csrPermutation () const
+  {
+    return csrPermutation_;
+  }
+
+  void JacobianStructure::csrValues (const matrix_t& m,
+				     value_type* values) const
+  {
+    assert (matches (m));
+
+    const value_type* src = m.valuePtr ();
+    for (std::size_t k = 0; k < csrPermutation_.size (); ++k)
+      values[k] = src[csrPermutation_[k]];
+  }
+
+  std::ostream& JacobianStructure::print (std::ostream& o) const
+  {
+    o << "Jacobian structure:" << incindent
+      << iendl << "Size: " << rows_ << " x " << cols_
+      << iendl << "Nonzeros: " << nonZeros ()
+      << iendl << "COO rows: " << cooRows_
+      << iendl << "COO columns: " << cooCols_
+      << iendl << "CSR row pointers: " << csrRowPointers_
+      << iendl << "CSR columns: " << csrCols_
+      << iendl << "CSR permutation: " << csrPermutation_;
+    return o << decindent;
+  }
+
+  std::ostream& operator<< (std::ostream& o, const JacobianStructure& s)
+  {
+    return s.print (o);
+  }
+} // end of namespace roboptim
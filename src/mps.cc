@@ -0,0 +1,685 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "debug.hh"
+
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <istream>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/format.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
+
+#include <roboptim/core/mps.hh>
+#include <roboptim/core/numeric-linear-function.hh>
+#include <roboptim/core/numeric-quadratic-function.hh>
+
+namespace roboptim
+{
+  namespace
+  {
+    typedef mpsProblem_t::value_type value_type;
+    typedef mpsProblem_t::size_type size_type;
+    typedef mpsProblem_t::vector_t vector_t;
+    typedef mpsProblem_t::intervals_t intervals_t;
+    typedef GenericFunctionTraits<EigenMatrixSparse>::matrix_t matrix_t;
+#if EIGEN_VERSION_AT_LEAST(3, 2, 90)
+    typedef matrix_t::StorageIndex storageIndex_t;
+#else
+    typedef matrix_t::Index storageIndex_t;
+#endif
+    typedef Eigen::Triplet<value_type> triplet_t;
+    typedef std::vector<triplet_t> triplets_t;
+    typedef boost::unordered_map<std::string, size_type> indices_t;
+
+    /// \brief Values beyond this threshold are considered infinite.
+    const value_type mpsInfinity = 1e30;
+
+    bool isSpace (char c)
+    {
+      return std::isspace (static_cast<unsigned char> (c)) != 0;
+    }
+
+    /// \brief MPS sections.
+    enum MpsSection
+      {
+	MPS_NONE,
+	MPS_NAME,
+	MPS_OBJSENSE,
+	MPS_ROWS,
+	MPS_COLUMNS,
+	MPS_RHS,
+	MPS_RANGES,
+	MPS_BOUNDS,
+	MPS_QUADOBJ,
+	MPS_QMATRIX,
+	MPS_ENDATA
+      };
+
+    /// \brief Streaming MPS/QPS parser.
+    class MpsParser
+    {
+    public:
+      explicit MpsParser (std::istream& in)
+	: in_ (in),
+	  line_ (),
+	  lineNumber_ (0),
+	  tokens_ (),
+	  section_ (MPS_NONE),
+	  name_ (),
+	  maximize_ (false),
+	  objective_ (),
+	  objectiveConstant_ (0.),
+	  rows_ (),
+	  freeRows_ (),
+	  rowTypes_ (),
+	  rhs_ (),
+	  ranges_ (),
+	  hasRange_ (),
+	  columns_ (),
+	  columnNames_ (),
+	  cost_ (),
+	  lower_ (),
+	  upper_ (),
+	  a_ (),
+	  q_ ()
+      {
+      }
+
+      boost::shared_ptr<mpsProblem_t> parse (const std::string& name);
+
+    private:
+      bool nextLine ();
+      void tokenize ();
+      void readHeader ();
+      void readRow ();
+      void readColumn ();
+      void readRhs ();
+      void readRange ();
+      void readBound ();
+      void readQuadratic (bool lowerTriangle);
+
+      size_type row (const std::string& name) const;
+      size_type column (const std::string& name) const;
+      value_type number (const std::string& s) const;
+      void error (const std::string& message) const;
+
+      boost::shared_ptr<mpsProblem_t> build ();
+
+      /// \brief Input stream.
+      std::istream& in_;
+
+      /// \brief Current line.
+      std::string line_;
+
+      /// \brief Current line number.
+      std::size_t lineNumber_;
+
+      /// \brief Tokens of the current line.
+      std::vector<std::string> tokens_;
+
+      /// \brief Current section.
+      MpsSection section_;
+
+      /// \brief Name of the problem.
+      std::string name_;
+
+      /// \brief Whether the objective is maximized.
+      bool maximize_;
+
+      /// \brief Name of the objective row.
+      std::string objective_;
+
+      /// \brief Constant term of the objective.
+      value_type objectiveConstant_;
+
+      /// \brief Indices of constraint rows.
+      indices_t rows_;
+
+      /// \brief Ignored free rows.
+      boost::unordered_set<std::string> freeRows_;
+
+      /// \brief Types of constraint rows (E, L or G).
+      std::vector<char> rowTypes_;
+
+      /// \brief Right-hand sides of constraint rows.
+      std::vector<value_type> rhs_;
+
+      /// \brief Ranges of constraint rows.
+      std::vector<value_type> ranges_;
+
+      /// \brief Whether constraint rows have a range.
+      std::vector<bool> hasRange_;
+
+      /// \brief Indices of columns.
+      indices_t columns_;
+
+      /// \brief Names of columns.
+      std::vector<std::string> columnNames_;
+
+      /// \brief Linear cost coefficients.
+      std::vector<value_type> cost_;
+
+      /// \brief Lower bounds of columns.
+      std::vector<value_type> lower_;
+
+      /// \brief Upper bounds of columns.
+      std::vector<value_type> upper_;
+
+      /// \brief Constraint matrix triplets.
+      triplets_t a_;
+
+      /// \brief Hessian triplets.
+      triplets_t q_;
+    };
+
+    bool MpsParser::nextLine ()
+    {
+      while (std::getline (in_, line_))
+	{
+	  ++lineNumber_;
+
+	  // Remove carriage returns of DOS files.
+	  if (!line_.empty () && line_[line_.size () - 1] == '\r')
+	    line_.erase (line_.size () - 1);
+
+	  if (line_.empty () || line_[0] == '*')
+	    continue;
+
+	  tokenize ();
+	  if (!tokens_.empty ())
+	    return true;
+	}
+      return false;
+    }
+
+    void MpsParser::tokenize ()
+    {
+      std::size_t n = 0;
+      std::size_t i = 0;
+      const std::size_t size = line_.size ();
+
+      while (i < size)
+	{
+	  while (i < size && isSpace (line_[i]))
+	    ++i;
+	  if (i == size)
+	    break;
+
+	  std::size_t j = i;
+	  while (j < size && !isSpace (line_[j]))
+	    ++j;
+
+	  if (n == tokens_.size ())
+	    tokens_.push_back (std::string ());
+	  tokens_[n++].assign (line_, i, j - i);
+	  i = j;
+	}
+      tokens_.resize (n);
+    }
+
+    void MpsParser::error (const std::string& message) const
+    {
+      boost::format fmt ("MPS line %d: %s");
+      fmt % lineNumber_ % message;
+      throw std::runtime_error (fmt.str ());
+    }
+
+    value_type MpsParser::number (const std::string& s) const
+    {
+      const char* begin = s.c_str ();
+      char* end = 0;
+      errno = 0;
+      value_type v = std::strtod (begin, &end);
+      if (end == begin || *end != '\0')
+	error ((boost::format ("invalid number '%s'") % s).str ());
+      if (errno == ERANGE && std::fabs (v) > 1.)
+	v = (v > 0.) ? Function::infinity () : -Function::infinity ();
+      if (v >= mpsInfinity)
+	return Function::infinity ();
+      if (v <= -mpsInfinity)
+	return -Function::infinity ();
+      return v;
+    }
+
+    size_type MpsParser::row (const std::string& name) const
+    {
+      indices_t::const_iterator it = rows_.find (name);
+      if (it == rows_.end ())
+	error ((boost::format ("unknown row '%s'") % name).str ());
+      return it->second;
+    }
+
+    size_type MpsParser::column (const std::string& name) const
+    {
+      indices_t::const_iterator it = columns_.find (name);
+      if (it == columns_.end ())
+	error ((boost::format ("unknown column '%s'") % name).str ());
+      return it->second;
+    }
+
+    void MpsParser::readHeader ()
+    {
+      const std::string& s = tokens_[0];
+
+      if (s == "NAME")
+	{
+	  section_ = MPS_NAME;
+	  if (tokens_.size () > 1)
+	    name_ = tokens_[1];
+	}
+      else if (s == "OBJSENSE")
+	{
+	  section_ = MPS_OBJSENSE;
+	  // Free MPS: sense on the same line.
+	  if (tokens_.size () > 1)
+	    maximize_ = (tokens_[1] == "MAX" || tokens_[1] == "MAXIMIZE");
+	}
+      else if (s == "ROWS")
+	section_ = MPS_ROWS;
+      else if (s == "COLUMNS")
+	section_ = MPS_COLUMNS;
+      else if (s == "RHS")
+	section_ = MPS_RHS;
+      else if (s == "RANGES")
+	section_ = MPS_RANGES;
+      else if (s == "BOUNDS")
+	section_ = MPS_BOUNDS;
+      else if (s == "QUADOBJ" || s == "QSECTION")
+	section_ = MPS_QUADOBJ;
+      else if (s == "QMATRIX")
+	section_ = MPS_QMATRIX;
+      else if (s == "ENDATA")
+	section_ = MPS_ENDATA;
+      else
+	error ((boost::format ("unsupported section '%s'") % s).str ());
+    }
+
+    void MpsParser::readRow ()
+    {
+      if (tokens_.size () < 2)
+	error ("invalid row");
+
+      const char type = tokens_[0].size () == 1 ? tokens_[0][0] : '\0';
+      const std::string& name = tokens_[1];
+
+      if (type == 'N')
+	{
+	  // Only the first free row is the objective, the others are
+	  // ignored.
+	  if (objective_.empty ())
+	    objective_ = name;
+	  else
+	    freeRows_.insert (name);
+	  return;
+	}
+
+      if (type != 'E' && type != 'L' && type != 'G')
+	error ((boost::format ("invalid row type '%s'") % tokens_[0]).str ());
+
+      if (!rows_.insert (std::make_pair (name, rowTypes_.size ())).second)
+	error ((boost::format ("duplicate row '%s'") % name).str ());
+
+      rowTypes_.push_back (type);
+      rhs_.push_back (0.);
+      ranges_.push_back (0.);
+      hasRange_.push_back (false);
+    }
+
+    void MpsParser::readColumn ()
+    {
+      // Integrality markers.
+      if (tokens_.size () >= 2 && tokens_[1] == "'MARKER'")
+	return;
+
+      if (tokens_.size () != 3 && tokens_.size () != 5)
+	error ("invalid column entry");
+
+      const std::string& name = tokens_[0];
+      size_type j = static_cast<size_type> (columnNames_.size ());
+
+      // Entries of a column are usually consecutive.
+      if (columnNames_.empty () || columnNames_.back () != name)
+	{
+	  std::pair<indices_t::iterator, bool> it =
+	    columns_.insert (std::make_pair (name, j));
+	  if (it.second)
+	    {
+	      columnNames_.push_back (name);
+	      cost_.push_back (0.);
+	      lower_.push_back (0.);
+	      upper_.push_back (Function::infinity ());
+	    }
+	  else
+	    j = it.first->second;
+	}
+      else
+	--j;
+
+      for (std::size_t k = 1; k + 1 < tokens_.size (); k += 2)
+	{
+	  const value_type v = number (tokens_[k + 1]);
+
+	  if (tokens_[k] == objective_)
+	    cost_[static_cast<std::size_t> (j)] += v;
+	  else if (freeRows_.find (tokens_[k]) == freeRows_.end ()
+		   && v != 0.)
+	    a_.push_back
+	      (triplet_t (static_cast<storageIndex_t> (row (tokens_[k])),
+			  static_cast<storageIndex_t> (j), v));
+	}
+    }
+
+    void MpsParser::readRhs ()
+    {
+      // The RHS set name is optional.
+      const std::size_t first = tokens_.size () % 2;
+      if (tokens_.size () < 2 || tokens_.size () > 5)
+	error ("invalid RHS entry");
+
+      for (std::size_t k = first; k + 1 < tokens_.size (); k += 2)
+	{
+	  const value_type v = number (tokens_[k + 1]);
+
+	  // A RHS on the objective is the opposite of its constant term.
+	  if (tokens_[k] == objective_)
+	    objectiveConstant_ = -v;
+	  else if (freeRows_.find (tokens_[k]) == freeRows_.end ())
+	    rhs_[static_cast<std::size_t> (row (tokens_[k]))] = v;
+	}
+    }
+
+    void MpsParser::readRange ()
+    {
+      // The RANGES set name is optional.
+      const std::size_t first = tokens_.size () % 2;
+      if (tokens_.size () < 2 || tokens_.size () > 5)
+	error ("invalid RANGES entry");
+
+      for (std::size_t k = first; k + 1 < tokens_.size (); k += 2)
+	{
+	  const std::size_t i = static_cast<std::size_t> (row (tokens_[k]));
+	  ranges_[i] = number (tokens_[k + 1]);
+	  hasRange_[i] = true;
+	}
+    }
+
+    void MpsParser::readBound ()
+    {
+      if (tokens_.size () < 2)
+	error ("invalid bound");
+
+      const std::string& type = tokens_[0];
+      const bool hasValue = !(type == "FR" || type == "MI"
+			      || type == "PL" || type == "BV");
+
+      // The bound set name is optional.
+      std::string name;
+      value_type v = 0.;
+      if (hasValue)
+	{
+	  if (tokens_.size () != 3 && tokens_.size () != 4)
+	    error ("invalid bound");
+	  name = tokens_[tokens_.size () - 2];
+	  v = number (tokens_.back ());
+	}
+      else
+	{
+	  // BV bounds may have a (useless) value.
+	  if (tokens_.size () >= 3
+	      && columns_.find (tokens_[2]) != columns_.end ())
+	    name = tokens_[2];
+	  else
+	    name = tokens_[1];
+	}
+
+      const std::size_t j = static_cast<std::size_t> (column (name));
+
+      if (type == "UP" || type == "UI")
+	{
+	  upper_[j] = v;
+	  // Historical convention: a negative upper bound on a variable with
+	  // the default lower bound makes it unbounded below.
+	  if (v < 0. && lower_[j] == 0.)
+	    lower_[j] = -Function::infinity ();
+	}
+      else if (type == "LO" || type == "LI")
+	lower_[j] = v;
+      else if (type == "FX")
+	lower_[j] = upper_[j] = v;
+      else if (type == "FR")
+	{
+	  lower_[j] = -Function::infinity ();
+	  upper_[j] = Function::infinity ();
+	}
+      else if (type == "MI")
+	lower_[j] = -Function::infinity ();
+      else if (type == "PL")
+	upper_[j] = Function::infinity ();
+      else if (type == "BV")
+	{
+	  lower_[j] = 0.;
+	  upper_[j] = 1.;
+	}
+      else
+	error ((boost::format ("unsupported bound type '%s'") % type).str ());
+    }
+
+    void MpsParser::readQuadratic (bool lowerTriangle)
+    {
+      if (tokens_.size () != 3)
+	error ("invalid quadratic entry");
+
+      const storageIndex_t i =
+	static_cast<storageIndex_t> (column (tokens_[0]));
+      const storageIndex_t j =
+	static_cast<storageIndex_t> (column (tokens_[1]));
+      const value_type v = number (tokens_[2]);
+
+      if (v == 0.)
+	return;
+
+      // The cost is 1/2 x^T Q x, and quadratic functions compute x^T A x.
+      q_.push_back (triplet_t (i, j, .5 * v));
+      if (lowerTriangle && i != j)
+	q_.push_back (triplet_t (j, i, .5 * v));
+    }
+
+    boost::shared_ptr<mpsProblem_t> MpsParser::parse (const std::string& name)
+    {
+      name_ = name;
+
+      while (nextLine ())
+	{
+	  // Section headers start on the first column.
+	  if (!isSpace (line_[0]))
+	    {
+	      readHeader ();
+	      if (section_ == MPS_ENDATA)
+		break;
+	      continue;
+	    }
+
+	  switch (section_)
+	    {
+	    case MPS_OBJSENSE:
+	      maximize_ = (tokens_[0] == "MAX" || tokens_[0] == "MAXIMIZE");
+	      break;
+	    case MPS_ROWS:
+	      readRow ();
+	      break;
+	    case MPS_COLUMNS:
+	      readColumn ();
+	      break;
+	    case MPS_RHS:
+	      readRhs ();
+	      break;
+	    case MPS_RANGES:
+	      readRange ();
+	      break;
+	    case MPS_BOUNDS:
+	      readBound ();
+	      break;
+	    case MPS_QUADOBJ:
+	      readQuadratic (true);
+	      break;
+	    case MPS_QMATRIX:
+	      readQuadratic (false);
+	      break;
+	    case MPS_NONE:
+	    case MPS_NAME:
+	    case MPS_ENDATA:
+	      error ("unexpected data");
+	      break;
+	    }
+	}
+
+      if (section_ != MPS_ENDATA)
+	error ("missing ENDATA");
+
+      if (columnNames_.empty ())
+	error ("no column");
+
+      return build ();
+    }
+
+    boost::shared_ptr<mpsProblem_t> MpsParser::build ()
+    {
+      typedef GenericNumericLinearFunction<EigenMatrixSparse> linear_t;
+      typedef GenericNumericQuadraticFunction<EigenMatrixSparse> quadratic_t;
+
+      const size_type n = static_cast<size_type> (columnNames_.size ());
+      const size_type m = static_cast<size_type> (rowTypes_.size ());
+      const value_type sign = maximize_ ? -1. : 1.;
+
+      // Cost function.
+      vector_t c = sign * Eigen::Map<const vector_t> (&cost_[0], n);
+      vector_t c0 (1);
+      c0[0] = sign * objectiveConstant_;
+
+      boost::shared_ptr<mpsProblem_t::function_t> cost;
+      if (q_.empty ())
+	{
+	  matrix_t a (1, n);
+	  a.reserve (static_cast<matrix_t::Index>
+		     ((c.array () != 0.).count ()));
+	  for (size_type j = 0; j < n; ++j)
+	    if (c[j] != 0.)
+	      a.insert (0, j) = c[j];
+	  a.makeCompressed ();
+	  cost = boost::make_shared<linear_t> (a, c0, name_);
+	}
+      else
+	{
+	  matrix_t q (n, n);
+	  q.setFromTriplets (q_.begin (), q_.end ());
+	  triplets_t ().swap (q_);
+	  if (maximize_)
+	    q *= -1.;
+	  cost = boost::make_shared<quadratic_t> (q, c, c0, name_);
+	}
+
+      boost::shared_ptr<mpsProblem_t> pb =
+	boost::make_shared<mpsProblem_t> (cost);
+
+      // Argument bounds and names.
+      for (std::size_t j = 0; j < columnNames_.size (); ++j)
+	{
+	  if (lower_[j] > upper_[j])
+	    {
+	      boost::format fmt ("inconsistent bounds for column '%s'");
+	      fmt % columnNames_[j];
+	      throw std::runtime_error (fmt.str ());
+	    }
+	  pb->argumentBounds ()[j] = Function::makeInterval (lower_[j],
+							    upper_[j]);
+	}
+      pb->argumentNames ().swap (columnNames_);
+
+      if (m == 0)
+	return pb;
+
+      // Constraints.
+      matrix_t a (m, n);
+      a.setFromTriplets (a_.begin (), a_.end ());
+      triplets_t ().swap (a_);
+
+      intervals_t bounds (static_cast<std::size_t> (m));
+      for (std::size_t i = 0; i < bounds.size (); ++i)
+	{
+	  const value_type b = rhs_[i];
+	  const value_type r = ranges_[i];
+	  value_type l = b;
+	  value_type u = b;
+
+	  switch (rowTypes_[i])
+	    {
+	    case 'E':
+	      if (hasRange_[i])
+		{
+		  if (r >= 0.)
+		    u = b + r;
+		  else
+		    l = b + r;
+		}
+	      break;
+	    case 'L':
+	      l = hasRange_[i] ? b - std::fabs (r) : -Function::infinity ();
+	      break;
+	    case 'G':
+	      u = hasRange_[i] ? b + std::fabs (r) : Function::infinity ();
+	      break;
+	    }
+
+	  bounds[i] = Function::makeInterval (l, u);
+	}
+
+      pb->addConstraint
+	(boost::make_shared<linear_t> (a, vector_t::Zero (m), "constraints"),
+	 bounds, mpsProblem_t::scaling_t (bounds.size (), 1.));
+
+      return pb;
+    }
+  } // end of anonymous namespace
+
+  boost::shared_ptr<mpsProblem_t>
+  readMps (std::istream& in, const std::string& name)
+  {
+    MpsParser parser (in);
+    return parser.parse (name);
+  }
+
+  boost::shared_ptr<mpsProblem_t>
+  readMps (const std::string& filename)
+  {
+    std::ifstream file (filename.c_str ());
+    if (!file)
+      {
+	boost::format fmt ("failed to open MPS file '%s'");
+	fmt % filename;
+	throw std::runtime_error (fmt.str ());
+      }
+    return readMps (file);
+  }
+} // end of namespace roboptim
@@ -18,7 +18,9 @@
 #include <roboptim/core/portability.hh>
 #include <roboptim/core/function.hh>
 #include <roboptim/core/numeric-quadratic-function.hh>
+#include <roboptim/core/low-rank-quadratic-function.hh>
 #include <roboptim/core/numeric-linear-function.hh>
+#include <roboptim/core/matrix-free-linear-function.hh>
 #include <roboptim/core/sum-of-c1-squares.hh>
 #include <roboptim/core/problem.hh>
 #include <roboptim/core/solver.hh>
@@ -34,6 +36,7 @@
 #include <roboptim/core/function/identity.hh>
 #include <roboptim/core/function/polynomial.hh>
 #include <roboptim/core/function/sin.hh>
+#include <roboptim/core/function/spline.hh>
 
 namespace roboptim
 {
@@ -58,9 +61,15 @@ namespace roboptim
   template class GenericNumericQuadraticFunction<EigenMatrixDense>;
   template class GenericNumericQuadraticFunction<EigenMatrixSparse>;
 
+  template class GenericLowRankQuadraticFunction<EigenMatrixDense>;
+  template class GenericLowRankQuadraticFunction<EigenMatrixSparse>;
+
   template class GenericNumericLinearFunction<EigenMatrixDense>;
   template class GenericNumericLinearFunction<EigenMatrixSparse>;
 
+  template class GenericMatrixFreeLinearFunction<EigenMatrixDense>;
+  template class GenericMatrixFreeLinearFunction<EigenMatrixSparse>;
+
   template class GenericSumOfC1Squares<EigenMatrixDense>;
   template class GenericSumOfC1Squares<EigenMatrixSparse>;
 
@@ -103,6 +112,9 @@ namespace roboptim
   template class Sin<EigenMatrixDense>;
   template class Sin<EigenMatrixSparse>;
 
+  template class Spline<EigenMatrixDense>;
+  template class Spline<EigenMatrixSparse>;
+
   namespace callback
   {
     template class Multiplexer<Solver<EigenMatrixDense> >;
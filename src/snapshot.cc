@@ -0,0 +1,367 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "debug.hh"
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/format.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <roboptim/core/snapshot.hh>
+
+namespace roboptim
+{
+  namespace detail
+  {
+    namespace
+    {
+      /// \brief Magic number of snapshot files.
+      const char snapshotMagic[8] = {'R', 'O', 'B', 'O', 'S', 'N', 'A', 'P'};
+
+      /// \brief Version of the snapshot format.
+      const boost::uint32_t snapshotVersion = 1;
+
+      /// \brief Byte order marker.
+      const boost::uint32_t snapshotByteOrder = 0x01020304;
+
+      /// \brief Alignment of all records.
+      const std::size_t snapshotAlignment = 8;
+
+      /// \brief Sparse matrix index type.
+      typedef SnapshotReader::sparseMatrix_t::Index sparseIndex_t;
+#if EIGEN_VERSION_AT_LEAST(3, 2, 90)
+      typedef SnapshotReader::sparseMatrix_t::StorageIndex storageIndex_t;
+#else
+      typedef SnapshotReader::sparseMatrix_t::Index storageIndex_t;
+#endif
+
+      /// \brief Snapshot header.
+      struct SnapshotHeader
+      {
+	char magic[8];
+	boost::uint32_t byteOrder;
+	boost::uint32_t version;
+	boost::uint32_t sparse;
+	boost::uint32_t storageOrder;
+	boost::uint32_t indexSize;
+	boost::uint32_t scalarSize;
+      };
+
+      SnapshotHeader makeHeader (bool sparse)
+      {
+	SnapshotHeader h;
+	std::memcpy (h.magic, snapshotMagic, sizeof (h.magic));
+	h.byteOrder = snapshotByteOrder;
+	h.version = snapshotVersion;
+	h.sparse = sparse ? 1 : 0;
+	h.storageOrder = (StorageOrder == Eigen::RowMajor) ? 1 : 0;
+	h.indexSize = static_cast<boost::uint32_t> (sizeof (storageIndex_t));
+	h.scalarSize = static_cast<boost::uint32_t>
+	  (sizeof (Function::value_type));
+	return h;
+      }
+
+      std::size_t padding (std::size_t size)
+      {
+	return (snapshotAlignment - size % snapshotAlignment)
+	  % snapshotAlignment;
+      }
+    } // end of anonymous namespace
+
+    SnapshotWriter::SnapshotWriter (const std::string& filename, bool sparse)
+      : file_ (filename.c_str (), std::ios::out | std::ios::binary
+	       | std::ios::trunc),
+	filename_ (filename)
+    {
+      if (!file_)
+	{
+	  boost::format fmt ("failed to open snapshot file '%s'");
+	  fmt % filename_;
+	  throw std::runtime_error (fmt.str ());
+	}
+
+      SnapshotHeader h = makeHeader (sparse);
+      write (&h, sizeof (h));
+    }
+
+    void SnapshotWriter::write (const void* data, std::size_t size)
+    {
+      static const char zeros[snapshotAlignment] = {0};
+
+      if (size > 0)
+	file_.write (static_cast<const char*> (data),
+		     static_cast<std::streamsize> (size));
+      file_.write (zeros, static_cast<std::streamsize> (padding (size)));
+    }
+
+    void SnapshotWriter::writeInteger (boost::uint64_t v)
+    {
+      write (&v, sizeof (v));
+    }
+
+    void SnapshotWriter::writeString (const std::string& s)
+    {
+      writeInteger (s.size ());
+      write (s.data (), s.size ());
+    }
+
+    void SnapshotWriter::writeVector
+    (GenericFunctionTraits<EigenMatrixDense>::const_vector_ref v)
+    {
+      writeInteger (static_cast<boost::uint64_t> (v.size ()));
+      write (v.data (),
+	     static_cast<std::size_t> (v.size ())
+	     * sizeof (Function::value_type));
+    }
+
+    void SnapshotWriter::writeMatrix
+    (GenericFunctionTraits<EigenMatrixDense>::const_matrix_ref m)
+    {
+      typedef SnapshotReader::denseMatrix_t matrix_t;
+
+      writeInteger (static_cast<boost::uint64_t> (m.rows ()));
+      writeInteger (static_cast<boost::uint64_t> (m.cols ()));
+
+      // Write the matrix with its storage order. Matrices with an outer
+      // stride (e.g. blocks) are first copied.
+      if (m.outerStride () != m.innerSize ())
+	{
+	  const matrix_t contiguous (m);
+	  write (contiguous.data (), static_cast<std::size_t>
+		 (contiguous.size ()) * sizeof (matrix_t::Scalar));
+	}
+      else
+	write (m.data (), static_cast<std::size_t> (m.size ())
+	       * sizeof (matrix_t::Scalar));
+    }
+
+    void SnapshotWriter::writeMatrix
+    (GenericFunctionTraits<EigenMatrixSparse>::const_matrix_ref m)
+    {
+      typedef SnapshotReader::sparseMatrix_t matrix_t;
+
+      // Uncompressed matrices are compressed in a temporary copy.
+      if (!m.isCompressed ())
+	{
+	  matrix_t compressed (m);
+	  compressed.makeCompressed ();
+	  writeMatrix (compressed);
+	  return;
+	}
+
+      const std::size_t nnz = static_cast<std::size_t> (m.nonZeros ());
+      writeInteger (static_cast<boost::uint64_t> (m.rows ()));
+      writeInteger (static_cast<boost::uint64_t> (m.cols ()));
+      writeInteger (static_cast<boost::uint64_t> (nnz));
+      write (m.outerIndexPtr (),
+	     (static_cast<std::size_t> (m.outerSize ()) + 1)
+	     * sizeof (storageIndex_t));
+      write (m.innerIndexPtr (), nnz * sizeof (storageIndex_t));
+      write (m.valuePtr (), nnz * sizeof (matrix_t::Scalar));
+    }
+
+    void SnapshotWriter::close ()
+    {
+      file_.close ();
+      if (!file_)
+	{
+	  boost::format fmt ("failed to write snapshot file '%s'");
+	  fmt % filename_;
+	  throw std::runtime_error (fmt.str ());
+	}
+    }
+
+    struct SnapshotReader::Mapping
+    {
+      Mapping (const std::string& filename)
+	: file (filename.c_str (), boost::interprocess::read_only),
+	  region (file, boost::interprocess::read_only)
+      {}
+
+      boost::interprocess::file_mapping file;
+      boost::interprocess::mapped_region region;
+    };
+
+    SnapshotReader::SnapshotReader (const std::string& filename, bool sparse)
+      : mapping_ (),
+	data_ (0),
+	size_ (0),
+	offset_ (0)
+    {
+      try
+	{
+	  mapping_.reset (new Mapping (filename));
+	}
+      catch (const boost::interprocess::interprocess_exception& e)
+	{
+	  boost::format fmt ("failed to map snapshot file '%s': %s");
+	  fmt % filename % e.what ();
+	  throw std::runtime_error (fmt.str ());
+	}
+
+      data_ = static_cast<const char*> (mapping_->region.get_address ());
+      size_ = mapping_->region.get_size ();
+
+      const SnapshotHeader& h =
+	*static_cast<const SnapshotHeader*> (read (sizeof (SnapshotHeader)));
+      const SnapshotHeader expected = makeHeader (sparse);
+
+      if (std::memcmp (h.magic, expected.magic, sizeof (h.magic)) != 0)
+	throw std::runtime_error ("invalid snapshot: wrong magic number");
+      if (h.byteOrder != expected.byteOrder)
+	throw std::runtime_error ("incompatible snapshot: wrong byte order");
+      if (h.version != expected.version)
+	throw std::runtime_error ("incompatible snapshot: unsupported version");
+      if (h.sparse != expected.sparse)
+	throw std::runtime_error
+	  ("incompatible snapshot: wrong matrix type (dense/sparse)");
+      if (h.storageOrder != expected.storageOrder)
+	throw std::runtime_error ("incompatible snapshot: wrong storage order");
+      if (h.indexSize != expected.indexSize
+	  || h.scalarSize != expected.scalarSize)
+	throw std::runtime_error ("incompatible snapshot: wrong type sizes");
+    }
+
+    SnapshotReader::~SnapshotReader ()
+    {
+    }
+
+    const void* SnapshotReader::read (std::size_t size)
+    {
+      const std::size_t padded = size + padding (size);
+      if (padded > size_ - offset_)
+	throw std::runtime_error ("invalid snapshot: unexpected end of file");
+
+      const void* data = data_ + offset_;
+      offset_ += padded;
+      return data;
+    }
+
+    boost::uint64_t SnapshotReader::readInteger ()
+    {
+      boost::uint64_t v;
+      std::memcpy (&v, read (sizeof (v)), sizeof (v));
+      return v;
+    }
+
+    std::size_t SnapshotReader::readSize (std::size_t elementSize)
+    {
+      const boost::uint64_t n = readInteger ();
+      if (elementSize > 0 && n > (size_ - offset_) / elementSize)
+	throw std::runtime_error ("invalid snapshot: size out of range");
+      return static_cast<std::size_t> (n);
+    }
+
+    std::string SnapshotReader::readString ()
+    {
+      const std::size_t n = readSize (1);
+      return std::string (static_cast<const char*> (read (n)), n);
+    }
+
+    SnapshotReader::vectorView_t SnapshotReader::readVector ()
+    {
+      const std::size_t n = readSize (sizeof (vector_t::Scalar));
+      const vector_t::Scalar* data = static_cast<const vector_t::Scalar*>
+	(read (n * sizeof (vector_t::Scalar)));
+      return vectorView_t (data, static_cast<vector_t::Index> (n));
+    }
+
+    SnapshotReader::denseMatrixView_t SnapshotReader::readDenseMatrix ()
+    {
+      const boost::uint64_t rows = readInteger ();
+      const boost::uint64_t cols = readInteger ();
+      const std::size_t elementSize = sizeof (denseMatrix_t::Scalar);
+
+      if (cols > 0 && rows > (size_ - offset_) / elementSize / cols)
+	throw std::runtime_error ("invalid snapshot: size out of range");
+
+      const std::size_t n = static_cast<std::size_t> (rows * cols);
+      const denseMatrix_t::Scalar* data =
+	static_cast<const denseMatrix_t::Scalar*> (read (n * elementSize));
+      return denseMatrixView_t (data,
+				static_cast<denseMatrix_t::Index> (rows),
+				static_cast<denseMatrix_t::Index> (cols));
+    }
+
+    SnapshotReader::sparseMatrix_t SnapshotReader::readSparseMatrix ()
+    {
+      // Sizes and offsets are stored in the index type of the matrix.
+      const boost::uint64_t maxIndex = static_cast<boost::uint64_t>
+	(std::numeric_limits<storageIndex_t>::max ());
+
+      const boost::uint64_t rows = readInteger ();
+      const boost::uint64_t cols = readInteger ();
+      if (rows > maxIndex || cols > maxIndex)
+	throw std::runtime_error ("invalid snapshot: size out of range");
+
+      const std::size_t nnz = readSize (sizeof (storageIndex_t)
+					+ sizeof (sparseMatrix_t::Scalar));
+      if (nnz > maxIndex)
+	throw std::runtime_error ("invalid snapshot: size out of range");
+
+      const std::size_t outerSize = static_cast<std::size_t>
+	(sparseMatrix_t::IsRowMajor ? rows : cols);
+      const std::size_t innerSize = static_cast<std::size_t>
+	(sparseMatrix_t::IsRowMajor ? cols : rows);
+
+      if (outerSize >= (size_ - offset_) / sizeof (storageIndex_t))
+	throw std::runtime_error ("invalid snapshot: size out of range");
+
+      // The index arrays are read (and their size checked) before any
+      // allocation.
+      const storageIndex_t* outer = static_cast<const storageIndex_t*>
+	(read ((outerSize + 1) * sizeof (storageIndex_t)));
+      const storageIndex_t* inner = static_cast<const storageIndex_t*>
+	(read (nnz * sizeof (storageIndex_t)));
+      const sparseMatrix_t::Scalar* values =
+	static_cast<const sparseMatrix_t::Scalar*>
+	(read (nnz * sizeof (sparseMatrix_t::Scalar)));
+
+      // Check the compressed structure before using it.
+      if (outer[0] != 0 || static_cast<std::size_t> (outer[outerSize]) != nnz)
+	throw std::runtime_error ("invalid snapshot: corrupted sparse matrix");
+      for (std::size_t k = 0; k < outerSize; ++k)
+	if (outer[k] > outer[k + 1])
+	  throw std::runtime_error
+	    ("invalid snapshot: corrupted sparse matrix");
+      for (std::size_t p = 0; p < nnz; ++p)
+	if (inner[p] < 0 || static_cast<std::size_t> (inner[p]) >= innerSize)
+	  throw std::runtime_error
+	    ("invalid snapshot: corrupted sparse matrix");
+
+      sparseMatrix_t m (static_cast<sparseIndex_t> (rows),
+			static_cast<sparseIndex_t> (cols));
+      m.resizeNonZeros (static_cast<sparseIndex_t> (nnz));
+      std::memcpy (m.outerIndexPtr (), outer,
+		   (outerSize + 1) * sizeof (storageIndex_t));
+      std::memcpy (m.innerIndexPtr (), inner, nnz * sizeof (storageIndex_t));
+      std::memcpy (m.valuePtr (), values,
+		   nnz * sizeof (sparseMatrix_t::Scalar));
+      return m;
+    }
+
+    bool SnapshotReader::eof () const
+    {
+      return offset_ == size_;
+    }
+  } // end of namespace detail
+} // end of namespace roboptim
@@ -240,4 +240,48 @@ BOOST_AUTO_TEST_CASE_TEMPLATE (finite_difference_jacobian, T, functionTypes_t)
   //BOOST_CHECK (output->match_pattern ());
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE (randomized_jacobian_check, T, functionTypes_t)
+{
+  typedef typename GenericDifferentiableFunction<T>::argument_t argument_t;
+
+  boost::shared_ptr<GenericDifferentiableFunction<T> >
+    fg = boost::make_shared<FGood<T> > ();
+  boost::shared_ptr<GenericDifferentiableFunction<T> >
+    fb = boost::make_shared<FBad<T> > ();
+
+  std::vector<argument_t> points;
+  argument_t x (2);
+  for (double i = -10.; i < 10.; i += 1.)
+    {
+      x[0] = i;
+      x[1] = 2. * i + 0.5;
+      points.push_back (x);
+    }
+
+  BOOST_CHECK (checkJacobianRandomized (*fg, points));
+  BOOST_CHECK (!checkJacobianRandomized (*fb, points));
+  BOOST_CHECK_NO_THROW (checkJacobianRandomizedAndThrow (*fg, points, 5));
+  BOOST_CHECK_THROW (checkJacobianRandomizedAndThrow (*fb, points, 5),
+		     BadDirectionalDerivative<T>);
+
+  // Only the second column of FBad's Jacobian is wrong.
+  argument_t e0 = argument_t::Zero (2);
+  argument_t e1 = argument_t::Zero (2);
+  e0[0] = 1.;
+  e1[1] = 1.;
+  BOOST_CHECK (checkDirectionalDerivative (*fb, x, e0));
+  BOOST_CHECK (!checkDirectionalDerivative (*fb, x, e1));
+
+  try
+    {
+      checkJacobianRandomizedAndThrow (*fb, points);
+    }
+  catch (const BadDirectionalDerivative<T>& e)
+    {
+      BOOST_CHECK_EQUAL (e.maxDeltaRow_, 0);
+      BOOST_CHECK (e.maxDelta_ > e.threshold_);
+      std::cout << e << std::endl;
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
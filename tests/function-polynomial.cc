@@ -116,6 +116,36 @@ BOOST_AUTO_TEST_CASE_TEMPLATE (polynomial_test, T, functionTypes_t)
 	    << "Hessian:" << std::endl
 	    << fct->hessian (x) << std::endl;
 
+  // Batched evaluation: values and derivatives of all orders
+  typename Polynomial<T>::vector_t times (4);
+  times << -1.5, 0., .5, 3.;
+  typename Polynomial<T>::vector_t values (times.size ());
+  fct->derivatives (values, times);
+  for (typename Polynomial<T>::size_type i = 0; i < times.size (); ++i)
+    {
+      x[0] = times[i];
+      BOOST_CHECK_CLOSE (values[i], (*fct) (x)[0], 1e-8);
+    }
+
+  fct->derivatives (values, times, 1);
+  for (typename Polynomial<T>::size_type i = 0; i < times.size (); ++i)
+    {
+      x[0] = times[i];
+      BOOST_CHECK_CLOSE (values[i], fct->gradient (x, 0).coeff (0), 1e-8);
+    }
+
+  fct->derivatives (values, times, 2);
+  for (typename Polynomial<T>::size_type i = 0; i < times.size (); ++i)
+    {
+      x[0] = times[i];
+      BOOST_CHECK_CLOSE (values[i], fct->hessian (x).coeff (0, 0), 1e-8);
+    }
+
+  fct->derivatives (values, times, 3);
+  BOOST_CHECK ((values.array () == 48.).all ());
+  fct->derivatives (values, times, 4);
+  BOOST_CHECK (values.isZero ());
+
   // Test exceptions
   coefficients.resize (0);
   BOOST_CHECK_THROW (fct = boost::make_shared<Polynomial<T> > (coefficients),
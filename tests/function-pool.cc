@@ -187,6 +187,32 @@ private:
   engine_ptr engine_;
 };
 
+template <typename T>
+class CombinedEngineWrapper : public EngineWrapper<T>,
+			      public FunctionPoolEngine
+{
+public:
+  ROBOPTIM_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_
+  (GenericDifferentiableFunction<T>);
+
+  typedef typename EngineWrapper<T>::engine_ptr engine_ptr;
+
+  CombinedEngineWrapper (engine_ptr engine)
+    : EngineWrapper<T> (engine),
+      engine_ (engine)
+  {
+  }
+
+  void computeWithJacobian (Function::const_argument_ref x) const
+  {
+    engine_->compute (x);
+    engine_->jacobian (x);
+  }
+
+private:
+  engine_ptr engine_;
+};
+
 template <typename T>
 class Position : public GenericDifferentiableFunction<T>
 {
@@ -249,6 +275,18 @@ to_dense (GenericFunctionTraits<EigenMatrixSparse>::const_matrix_ref m)
   return sparse_to_dense (m);
 }
 
+inline const double*
+valuePtr (const GenericFunctionTraits<EigenMatrixDense>::matrix_t& m)
+{
+  return m.data ();
+}
+
+inline const double*
+valuePtr (const GenericFunctionTraits<EigenMatrixSparse>::matrix_t& m)
+{
+  return m.valuePtr ();
+}
+
 struct PositionConstraintVisitor : public boost::static_visitor<>
 {
   typedef Function::const_argument_ref const_argument_ref;
@@ -383,4 +421,158 @@ BOOST_AUTO_TEST_CASE_TEMPLATE (function_pool, T, functionTypes_t)
   BOOST_CHECK (output->match_pattern ());
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE (function_pool_parallel, T, functionTypes_t)
+{
+  output = boost::make_shared<boost::test_tools::output_test_stream> ();
+
+  size_t n_joints = 10;
+  boost::shared_ptr<Engine> engine = boost::make_shared<Engine> (n_joints);
+  boost::shared_ptr<EngineWrapper<T> >
+    engine_wrapper = boost::make_shared<EngineWrapper<T> > (engine);
+
+  typedef boost::mpl::list<GenericDifferentiableFunction<T> > poolTypes_t;
+  typedef GenericDifferentiableFunction<T> poolFunction_t;
+  typedef FunctionPool<poolFunction_t, poolTypes_t> pool_t;
+  typedef typename poolFunction_t::argument_t argument_t;
+  typedef typename poolFunction_t::result_t result_t;
+  typedef typename poolFunction_t::jacobian_t jacobian_t;
+
+  typename pool_t::functionList_t position_vector;
+  for (size_t i = 0; i < n_joints; ++i)
+  {
+    std::string name = (boost::format ("Position of joint %1%") % i).str ();
+    position_vector.push_back
+      (boost::make_shared<Position<T> > (engine, i, name));
+  }
+
+  pool_t pool (engine_wrapper, position_vector, "sequential pool");
+  pool_t parallel_pool (engine_wrapper, position_vector, "parallel pool");
+  BOOST_CHECK_EQUAL (parallel_pool.evaluationThreads (), 1);
+  parallel_pool.evaluationThreads () = 4;
+
+  argument_t x (static_cast<typename pool_t::size_type> (n_joints));
+  for (typename argument_t::Index i = 0; i < x.size (); ++i)
+    x[i] = 0.1 * static_cast<double> (i + 1);
+
+  // Same results as the sequential evaluation.
+  result_t res = pool (x);
+  result_t parallel_res = parallel_pool (x);
+  BOOST_CHECK (allclose (res, parallel_res));
+
+  jacobian_t jac = pool.jacobian (x);
+  jacobian_t parallel_jac = parallel_pool.jacobian (x);
+  BOOST_CHECK (allclose (to_dense (jac), to_dense (parallel_jac)));
+
+  // Later evaluations write into the same matrix.
+  const double* values = valuePtr (parallel_jac);
+  x *= 2.;
+  res = pool (x);
+  jac = pool.jacobian (x);
+  parallel_pool.jacobian (parallel_jac, x);
+  BOOST_CHECK_EQUAL (values, valuePtr (parallel_jac));
+  BOOST_CHECK (allclose (to_dense (jac), to_dense (parallel_jac)));
+
+  // A function added twice is supported (sequential evaluation).
+  position_vector.push_back (position_vector[0]);
+  pool_t duplicate_pool (engine_wrapper, position_vector, "duplicate pool");
+  duplicate_pool.evaluationThreads () = 4;
+  result_t duplicate_res = duplicate_pool (x);
+  BOOST_CHECK (allclose (duplicate_res.head (res.size ()), res));
+  BOOST_CHECK (allclose (duplicate_res.tail (2), res.head (2)));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (function_pool_engine_cache, T, functionTypes_t)
+{
+  output = boost::make_shared<boost::test_tools::output_test_stream> ();
+
+  size_t n_joints = 3;
+  boost::shared_ptr<Engine> engine = boost::make_shared<Engine> (n_joints);
+
+  typedef boost::mpl::list<GenericDifferentiableFunction<T> > poolTypes_t;
+  typedef GenericDifferentiableFunction<T> poolFunction_t;
+  typedef FunctionPool<poolFunction_t, poolTypes_t> pool_t;
+  typedef typename poolFunction_t::argument_t argument_t;
+  typedef typename poolFunction_t::result_t result_t;
+  typedef typename poolFunction_t::jacobian_t jacobian_t;
+
+  typename pool_t::functionList_t position_vector;
+  for (size_t i = 0; i < n_joints; ++i)
+    position_vector.push_back
+      (boost::make_shared<Position<T> > (engine, i, "position"));
+
+  argument_t x (static_cast<typename pool_t::size_type> (n_joints));
+  x << M_PI/4., -M_PI/4., M_PI/2.;
+  argument_t y = 2. * x;
+
+  // Separate value and Jacobian passes.
+  {
+    pool_t pool (boost::make_shared<EngineWrapper<T> > (engine),
+		 position_vector);
+    BOOST_CHECK (!pool.cacheEngine ());
+    pool.cacheEngine (true);
+    engine->reset ();
+
+    result_t res = pool (x);
+    result_t res2 = pool (x);
+    BOOST_CHECK (allclose (res, res2));
+    BOOST_CHECK_EQUAL (engine->computeCounter (), 1);
+    BOOST_CHECK_EQUAL (engine->jacobianCounter (), 0);
+
+    jacobian_t jac = pool.jacobian (x);
+    pool.jacobian (jac, x);
+    pool (res2, x);
+    BOOST_CHECK_EQUAL (engine->computeCounter (), 1);
+    BOOST_CHECK_EQUAL (engine->jacobianCounter (), 1);
+
+    // New point.
+    pool (res2, y);
+    BOOST_CHECK_EQUAL (engine->computeCounter (), 2);
+    pool.jacobian (jac, y);
+    BOOST_CHECK_EQUAL (engine->jacobianCounter (), 2);
+
+    // External modification of the engine.
+    pool.resetEngineCache ();
+    pool (res2, y);
+    BOOST_CHECK_EQUAL (engine->computeCounter (), 3);
+
+    // Without caching, the engine is always run, and what it computes is
+    // not kept when caching is enabled again.
+    pool.cacheEngine (false);
+    BOOST_CHECK (!pool.cacheEngine ());
+    pool (res2, y);
+    pool (res2, x);
+    pool (res2, y);
+    BOOST_CHECK_EQUAL (engine->computeCounter (), 6);
+    pool.cacheEngine (true);
+    pool (res2, y);
+    pool (res2, y);
+    BOOST_CHECK_EQUAL (engine->computeCounter (), 7);
+    BOOST_CHECK (allclose (res2, pool (y)));
+  }
+
+  // Single pass.
+  {
+    pool_t pool (boost::make_shared<CombinedEngineWrapper<T> > (engine),
+		 position_vector);
+    pool.cacheEngine (true);
+    engine->reset ();
+
+    result_t res = pool (x);
+    jacobian_t jac = pool.jacobian (x);
+    BOOST_CHECK_EQUAL (engine->computeCounter (), 1);
+    BOOST_CHECK_EQUAL (engine->jacobianCounter (), 1);
+
+    pool.jacobian (jac, y);
+    pool (res, y);
+    BOOST_CHECK_EQUAL (engine->computeCounter (), 2);
+    BOOST_CHECK_EQUAL (engine->jacobianCounter (), 2);
+
+    // Same results as without caching.
+    pool_t reference (boost::make_shared<EngineWrapper<T> > (engine),
+		      position_vector);
+    BOOST_CHECK (allclose (res, reference (y)));
+    BOOST_CHECK (allclose (to_dense (jac), to_dense (reference.jacobian (y))));
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,172 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "shared-tests/fixture.hh"
+
+#include <iostream>
+#include <stdexcept>
+
+#include <boost/make_shared.hpp>
+
+#include <roboptim/core/io.hh>
+#include <roboptim/core/problem.hh>
+#include <roboptim/core/function/constant.hh>
+#include <roboptim/core/function/spline.hh>
+
+using namespace roboptim;
+
+typedef boost::mpl::list< ::roboptim::EigenMatrixDense,
+			  ::roboptim::EigenMatrixSparse> functionTypes_t;
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (spline_test, T, functionTypes_t)
+{
+  typedef Spline<T> spline_t;
+  typedef typename spline_t::vector_t vector_t;
+  typedef typename spline_t::size_type size_type;
+  typedef typename spline_t::jacobian_t jacobian_t;
+
+  // Clamped cubic spline on [0, 3] with 6 coefficients.
+  const size_type degree = 3;
+  vector_t knots (10);
+  knots << 0., 0., 0., 0., 1., 2., 3., 3., 3., 3.;
+  vector_t times (7);
+  times << 0., .3, 1., 1.5, 2., 2.7, 3.;
+
+  spline_t spline (knots, degree, times);
+  std::cout << spline << std::endl;
+
+  BOOST_CHECK_EQUAL (spline.inputSize (), 6);
+  BOOST_CHECK_EQUAL (spline.outputSize (), 7);
+
+  // Binary search of the segments.
+  BOOST_CHECK_EQUAL (spline.segment (0.), 3);
+  BOOST_CHECK_EQUAL (spline.segment (.5), 3);
+  BOOST_CHECK_EQUAL (spline.segment (1.), 4);
+  BOOST_CHECK_EQUAL (spline.segment (2.5), 5);
+  BOOST_CHECK_EQUAL (spline.segment (3.), 5);
+
+  // Partition of unity.
+  vector_t ones = vector_t::Ones (6);
+  BOOST_CHECK (allclose (spline (ones), vector_t::Ones (7)));
+
+  // Linear precision: with the Greville abscissae as coefficients, the
+  // spline is s(t) = t.
+  vector_t greville (6);
+  for (size_type j = 0; j < 6; ++j)
+    greville[j] = knots.segment (j + 1, degree).sum () / 3.;
+  BOOST_CHECK (allclose (spline (greville), times));
+
+  spline_t velocity (knots, degree, times, 1);
+  spline_t acceleration (knots, degree, times, 2);
+  BOOST_CHECK (allclose (velocity (greville), vector_t::Ones (7)));
+  BOOST_CHECK (allclose (acceleration (greville), vector_t::Zero (7)));
+  BOOST_CHECK (allclose (velocity (ones), vector_t::Zero (7)));
+
+  // Derivatives of a generic spline against finite differences.
+  vector_t c (6);
+  c << 1., -2., .5, 3., 0., 1.;
+  vector_t result (times.size ());
+  vector_t resultEps (times.size ());
+  const double eps = 1e-6;
+  for (size_type order = 1; order <= 3; ++order)
+    {
+      spline.derivatives (result, times.array () + eps, c, order - 1);
+      spline.derivatives (resultEps, times.array () - eps, c, order - 1);
+      vector_t fd = (result - resultEps) / (2. * eps);
+      spline.derivatives (result, times, c, order);
+
+      // Skip the knots, where the highest derivative is discontinuous.
+      for (size_type i = 0; i < times.size (); ++i)
+	if (times[i] != 1. && times[i] != 2.)
+	  BOOST_CHECK_SMALL (result[i] - fd[i], 1e-4);
+    }
+
+  // Batched evaluation matches the sampled functions.
+  spline.derivatives (result, times, c);
+  BOOST_CHECK (allclose (result, spline (c)));
+  spline.derivatives (result, times, c, 1);
+  BOOST_CHECK (allclose (result, velocity (c)));
+  spline.derivatives (result, times, c, 4);
+  BOOST_CHECK (result.isZero ());
+
+  // Local support of the Jacobian.
+  jacobian_t jac = spline.jacobian (c);
+  BOOST_CHECK (allclose (toDense (jac) * c, spline (c)));
+  for (size_type i = 0; i < times.size (); ++i)
+    {
+      const size_type first = spline.segment (times[i]) - degree;
+      for (size_type j = 0; j < spline.inputSize (); ++j)
+	if (j < first || j > first + degree)
+	  BOOST_CHECK_EQUAL (toDense (jac) (i, j), 0.);
+      BOOST_CHECK (allclose (toDense (spline.gradient (c, i)),
+			     toDense (jac).row (i)));
+    }
+  BOOST_CHECK (toDense (spline.hessian (c, 0)).isZero ());
+
+  // Row-selective evaluation.
+  typename spline_t::indices_t rows;
+  rows.push_back (5);
+  rows.push_back (1);
+  vector_t rowsResult (2);
+  BOOST_CHECK (spline.computeRows (rowsResult, c, rows));
+  BOOST_CHECK_CLOSE (rowsResult[0], spline (c)[5], 1e-8);
+  BOOST_CHECK_CLOSE (rowsResult[1], spline (c)[1], 1e-8);
+
+  jacobian_t rowsJacobian (2, spline.inputSize ());
+  rowsJacobian.setZero ();
+  BOOST_CHECK (spline.jacobianRows (rowsJacobian, c, rows));
+  BOOST_CHECK (allclose (toDense (rowsJacobian).row (0),
+			 toDense (jac).row (5)));
+  BOOST_CHECK (allclose (toDense (rowsJacobian).row (1),
+			 toDense (jac).row (1)));
+
+  // Invalid splines.
+  BOOST_CHECK_THROW (spline_t (knots.head (7), degree, times),
+		     std::runtime_error);
+  knots[5] = .5;
+  BOOST_CHECK_THROW (spline_t (knots, degree, times), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (spline_problem_test, T, functionTypes_t)
+{
+  typedef Problem<T> problem_t;
+  typedef Spline<T> spline_t;
+  typedef typename spline_t::vector_t vector_t;
+
+  // Linear spline: the samples are the coefficients.
+  vector_t knots (6);
+  knots << 0., 0., 1., 2., 3., 3.;
+  vector_t times (4);
+  times << 0., 1., 2., 3.;
+
+  vector_t v (4);
+  v.setZero ();
+  problem_t pb (boost::make_shared<GenericConstantFunction<T> > (v));
+  pb.addConstraint (boost::make_shared<spline_t> (knots, 1, times),
+		    typename problem_t::intervals_t
+		    (4, Function::makeInterval (-1., 1.)),
+		    typename problem_t::scaling_t (4, 1.));
+
+  vector_t x (4);
+  x << 1., 2., 3., 4.;
+  BOOST_CHECK (allclose (toDense (pb.jacobian (x)),
+			 Eigen::MatrixXd::Identity (4, 4)));
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
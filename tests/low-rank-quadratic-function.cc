@@ -0,0 +1,133 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "shared-tests/fixture.hh"
+
+#include <iostream>
+
+#include <roboptim/core/io.hh>
+#include <roboptim/core/low-rank-quadratic-function.hh>
+#include <roboptim/core/numeric-quadratic-function.hh>
+
+using namespace roboptim;
+
+typedef boost::mpl::list< ::roboptim::EigenMatrixDense,
+			  ::roboptim::EigenMatrixSparse> functionTypes_t;
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (low_rank_quadratic_test, T, functionTypes_t)
+{
+  typedef GenericLowRankQuadraticFunction<T> lowRank_t;
+  typedef GenericNumericQuadraticFunction<T> quadratic_t;
+  typedef typename lowRank_t::vector_t vector_t;
+
+  vector_t d (5);
+  d << 1., 2., .5, 3., 1.;
+  typename lowRank_t::lowRank_t u (5, 2);
+  u <<
+    1., 0.,
+    -1., 2.,
+    0., 1.,
+    .5, -.5,
+    2., 0.;
+  vector_t b (5);
+  b << 1., 0., -1., 2., .5;
+  vector_t c (1);
+  c << -2.;
+
+  lowRank_t f (d, u, b, c);
+  std::cout << f << std::endl;
+
+  BOOST_CHECK (f.getFlags () & ROBOPTIM_IS_QUADRATIC);
+  BOOST_CHECK (!(f.getFlags () & ROBOPTIM_IS_NUMERIC_QUADRATIC));
+  BOOST_CHECK_EQUAL (f.inputSize (), 5);
+  BOOST_CHECK_EQUAL (f.outputSize (), 1);
+  BOOST_CHECK_EQUAL (f.rank (), 2);
+
+  // Reference function with an explicit matrix.
+  Eigen::MatrixXd dense = u * u.transpose ();
+  dense.diagonal () += d;
+  typename quadratic_t::matrix_t a;
+  a = dense.sparseView ();
+  quadratic_t g (a, b, c);
+
+  vector_t x (5);
+  x << 1., -2., .5, 0., 3.;
+
+  BOOST_CHECK_CLOSE (f (x)[0], g (x)[0], 1e-8);
+  BOOST_CHECK (allclose (toDense (f.gradient (x, 0)),
+			 toDense (g.gradient (x, 0))));
+  BOOST_CHECK (allclose (toDense (f.jacobian (x)),
+			 toDense (g.jacobian (x))));
+  BOOST_CHECK (allclose (toDense (f.hessian (x, 0)),
+			 toDense (g.hessian (x, 0))));
+
+  // Value and gradient at once.
+  typename lowRank_t::result_t result (1);
+  typename lowRank_t::gradient_t gradient (5);
+  gradient.setZero ();
+  f.computeWithGradient (result, gradient, x);
+  BOOST_CHECK_CLOSE (result[0], g (x)[0], 1e-8);
+  BOOST_CHECK (allclose (toDense (gradient), toDense (g.gradient (x, 0))));
+
+  // Hessian-vector product.
+  vector_t v (5);
+  v << .5, 1., -1., 2., 0.;
+  vector_t hv (5);
+  f.hessianProduct (hv, v);
+  BOOST_CHECK (allclose (hv, 2. * dense * v));
+
+  // Without constant term.
+  lowRank_t h (d, u, b);
+  BOOST_CHECK_CLOSE (h (x)[0], g (x)[0] - c[0], 1e-8);
+}
+
+BOOST_AUTO_TEST_CASE (low_rank_quadratic_sparse_hessian)
+{
+  typedef GenericLowRankQuadraticFunction<EigenMatrixSparse> lowRank_t;
+  typedef lowRank_t::vector_t vector_t;
+
+  // Only a few rows of U are nonzero: the sparse Hessian only stores the
+  // coefficients they couple, and the diagonal of D.
+  const int n = 1000;
+  vector_t d (n);
+  d.setZero ();
+  d[10] = 1.;
+  lowRank_t::lowRank_t u (n, 2);
+  u.setZero ();
+  u.row (3) << 1., -1.;
+  u.row (500) << 2., .5;
+  u.row (999) << 0., 3.;
+  vector_t b (n);
+  b.setZero ();
+
+  lowRank_t f (d, u, b);
+  vector_t x (n);
+  x.setZero ();
+
+  lowRank_t::hessian_t h = f.hessian (x, 0);
+  BOOST_CHECK_EQUAL (h.rows (), n);
+  BOOST_CHECK_EQUAL (h.cols (), n);
+  BOOST_CHECK_EQUAL (h.nonZeros (), 10);
+
+  Eigen::MatrixXd expected = 2. * u * u.transpose ();
+  expected.diagonal () += 2. * d;
+  BOOST_CHECK (allclose (toDense (h), expected));
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,228 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "shared-tests/fixture.hh"
+
+#include <iostream>
+#include <stdexcept>
+
+#include <roboptim/core/io.hh>
+#include <roboptim/core/matrix-free-linear-function.hh>
+#include <roboptim/core/numeric-linear-function.hh>
+#include <roboptim/core/problem.hh>
+#include <roboptim/core/function/constant.hh>
+
+using namespace roboptim;
+
+typedef boost::mpl::list< ::roboptim::EigenMatrixDense,
+			  ::roboptim::EigenMatrixSparse> functionTypes_t;
+
+typedef Eigen::Ref<Eigen::VectorXd> vector_ref;
+typedef const Eigen::Ref<const Eigen::VectorXd>& const_vector_ref;
+
+// Forward difference operator: (D x)_i = x_{i+1} - x_i.
+struct Difference
+{
+  Difference (int& count)
+    : count_ (count)
+  {}
+
+  void operator () (vector_ref result, const_vector_ref x) const
+  {
+    ++count_;
+    result = x.tail (x.size () - 1) - x.head (x.size () - 1);
+  }
+
+  int& count_;
+};
+
+// Transposed operator: (D^T w)_j = w_{j-1} - w_j.
+struct DifferenceTranspose
+{
+  DifferenceTranspose (int& count)
+    : count_ (count)
+  {}
+
+  void operator () (vector_ref result, const_vector_ref w) const
+  {
+    ++count_;
+    result.setZero ();
+    result.head (w.size ()) -= w;
+    result.tail (w.size ()) += w;
+  }
+
+  int& count_;
+};
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (matrix_free_linear_test, T, functionTypes_t)
+{
+  typedef GenericMatrixFreeLinearFunction<T> matrixFree_t;
+  typedef GenericNumericLinearFunction<T> linear_t;
+  typedef typename matrixFree_t::vector_t vector_t;
+  typedef typename matrixFree_t::jacobian_t jacobian_t;
+
+  const int n = 6;
+  Eigen::MatrixXd dense (n - 1, n);
+  dense.setZero ();
+  for (int i = 0; i < n - 1; ++i)
+    {
+      dense (i, i) = -1.;
+      dense (i, i + 1) = 1.;
+    }
+  typename linear_t::matrix_t a;
+  a = dense.sparseView ();
+  typename linear_t::matrix_t at;
+  at = dense.transpose ().sparseView ();
+
+  vector_t b (n - 1);
+  b << 1., 0., -1., 2., .5;
+  vector_t bt (n);
+  bt.setZero ();
+
+  int count = 0;
+  int countTranspose = 0;
+  Difference apply (count);
+  DifferenceTranspose applyTranspose (countTranspose);
+
+  // Wide operator (fewer outputs than inputs) and its transpose.
+  matrixFree_t f (n, apply, applyTranspose, b);
+  matrixFree_t ft (n - 1, applyTranspose, apply, bt, "transpose");
+  linear_t g (a, b);
+  linear_t gt (at, bt);
+  std::cout << f << std::endl;
+
+  BOOST_CHECK (f.getFlags () & ROBOPTIM_IS_LINEAR);
+  BOOST_CHECK (!(f.getFlags () & ROBOPTIM_IS_NUMERIC_LINEAR));
+  BOOST_CHECK_EQUAL (f.inputSize (), n);
+  BOOST_CHECK_EQUAL (f.outputSize (), n - 1);
+
+  vector_t x (n);
+  x << 1., -2., .5, 0., 3., 1.;
+  vector_t y (n - 1);
+  y << .5, 1., -1., 2., 0.;
+
+  BOOST_CHECK (allclose (f (x), g (x)));
+  BOOST_CHECK (allclose (ft (y), gt (y)));
+
+  // Jacobian-vector and vector-Jacobian products.
+  vector_t jv (n - 1);
+  f.jacobianProduct (jv, x);
+  BOOST_CHECK (allclose (jv, dense * x));
+  vector_t vj (n);
+  f.jacobianTransposeProduct (vj, y);
+  BOOST_CHECK (allclose (vj, dense.transpose () * y));
+
+  // The Jacobian is built row by row for the wide operator, and column
+  // by column for its transpose.
+  count = countTranspose = 0;
+  BOOST_CHECK (allclose (toDense (f.jacobian (x)), dense));
+  BOOST_CHECK_EQUAL (count, 0);
+  BOOST_CHECK_EQUAL (countTranspose, n - 1);
+  BOOST_CHECK (allclose (toDense (ft.jacobian (y)),
+			 Eigen::MatrixXd (dense.transpose ())));
+  BOOST_CHECK_EQUAL (count, 0);
+  BOOST_CHECK_EQUAL (countTranspose, 2 * (n - 1));
+
+  for (int i = 0; i < n - 1; ++i)
+    BOOST_CHECK (allclose (toDense (f.gradient (x, i)),
+			   toDense (g.gradient (x, i))));
+
+  // Cached Jacobian.
+  f.cacheJacobian () = true;
+  count = countTranspose = 0;
+  jacobian_t jac = f.jacobian (x);
+  jac = f.jacobian (x);
+  BOOST_CHECK (allclose (toDense (jac), dense));
+  BOOST_CHECK_EQUAL (countTranspose, n - 1);
+  f.resetJacobian ();
+  jac = f.jacobian (x);
+  BOOST_CHECK_EQUAL (countTranspose, 2 * (n - 1));
+  std::cout << f << std::endl;
+
+  // Rows and columns of the Jacobian.
+  typename matrixFree_t::indices_t indices;
+  indices.push_back (3);
+  indices.push_back (0);
+
+  jacobian_t rows (2, n);
+  rows.setZero ();
+  BOOST_CHECK (f.jacobianRows (rows, x, indices));
+  BOOST_CHECK (allclose (toDense (rows).row (0), dense.row (3)));
+  BOOST_CHECK (allclose (toDense (rows).row (1), dense.row (0)));
+
+  jacobian_t columns (n - 1, 2);
+  columns.setZero ();
+  BOOST_CHECK (f.jacobianColumns (columns, x, indices));
+  BOOST_CHECK (allclose (toDense (columns).col (0), dense.col (3)));
+  BOOST_CHECK (allclose (toDense (columns).col (1), dense.col (0)));
+
+  // Invalid functions.
+  BOOST_CHECK_THROW (matrixFree_t (n, apply,
+				   typename matrixFree_t::product_t (), b),
+		     std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (matrix_free_linear_finalize, T, functionTypes_t)
+{
+  typedef GenericMatrixFreeLinearFunction<T> matrixFree_t;
+  typedef typename matrixFree_t::vector_t vector_t;
+  typedef Problem<T> problem_t;
+  typedef typename problem_t::intervals_t intervals_t;
+  typedef typename problem_t::scaling_t scaling_t;
+
+  const int n = 6;
+  Eigen::MatrixXd dense (n - 1, n);
+  dense.setZero ();
+  for (int i = 0; i < n - 1; ++i)
+    {
+      dense (i, i) = -1.;
+      dense (i, i + 1) = 1.;
+    }
+
+  vector_t b (n - 1);
+  b.setZero ();
+
+  int count = 0;
+  int countTranspose = 0;
+  Difference apply (count);
+  DifferenceTranspose applyTranspose (countTranspose);
+  boost::shared_ptr<matrixFree_t> f =
+    boost::make_shared<matrixFree_t> (n, apply, applyTranspose, b);
+  BOOST_CHECK (f->getFlags () & ROBOPTIM_IS_MATRIX_FREE);
+
+  vector_t v (n);
+  v.setZero ();
+  problem_t pb (boost::make_shared<GenericConstantFunction<T> > (v));
+  pb.addConstraint (f, intervals_t (n - 1, Function::makeInfiniteInterval ()),
+		    scaling_t (n - 1, 1.));
+
+  // The Jacobian of a matrix-free constraint is not precomputed.
+  pb.finalize ();
+  BOOST_CHECK (pb.isFinalized ());
+  BOOST_CHECK_EQUAL (count, 0);
+  BOOST_CHECK_EQUAL (countTranspose, 0);
+
+  // It is built on request.
+  vector_t x (n);
+  x << 1., -2., .5, 0., 3., 1.;
+  BOOST_CHECK (allclose (toDense (pb.jacobian (x)), dense));
+  BOOST_CHECK_EQUAL (countTranspose, n - 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
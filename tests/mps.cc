@@ -0,0 +1,194 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "shared-tests/fixture.hh"
+
+#include <sstream>
+
+#include <roboptim/core/mps.hh>
+#include <roboptim/core/numeric-linear-function.hh>
+#include <roboptim/core/numeric-quadratic-function.hh>
+
+using namespace roboptim;
+
+typedef mpsProblem_t problem_t;
+typedef problem_t::argument_t argument_t;
+typedef problem_t::result_t result_t;
+typedef GenericNumericLinearFunction<EigenMatrixSparse> linear_t;
+typedef GenericNumericQuadraticFunction<EigenMatrixSparse> quadratic_t;
+
+// Fixed MPS linear program.
+static const char* lp =
+  "* Linear test problem\n"
+  "NAME          TESTPROB\n"
+  "ROWS\n"
+  " N  COST\n"
+  " L  LIM1\n"
+  " G  LIM2\n"
+  " E  MYEQN\n"
+  "COLUMNS\n"
+  "    XONE      COST         1   LIM1         1\n"
+  "    XONE      LIM2         1\n"
+  "    YTWO      COST         2   LIM1         1\n"
+  "    YTWO      MYEQN       -1\n"
+  "    ZTHREE    COST         3   LIM2         1\n"
+  "    ZTHREE    MYEQN        1\n"
+  "RHS\n"
+  "    RHS1      LIM1         4   LIM2         1\n"
+  "    RHS1      MYEQN        7\n"
+  "BOUNDS\n"
+  " UP BND1      XONE         4\n"
+  " LO BND1      YTWO        -1\n"
+  " UP BND1      YTWO         1\n"
+  "ENDATA\n";
+
+// Free MPS quadratic program.
+static const char* qp =
+  "NAME QPTEST\n"
+  "OBJSENSE\n"
+  "    MAX\n"
+  "ROWS\n"
+  " N obj\n"
+  " N other\n"
+  " E c1\n"
+  " L c2\n"
+  "COLUMNS\n"
+  " MARKER 'MARKER' 'INTORG'\n"
+  " x obj 1 c1 2\n"
+  " x other 5\n"
+  " MARKER 'MARKER' 'INTEND'\n"
+  " y obj -1 c2 1\n"
+  " y c1 1\n"
+  "RHS\n"
+  " rhs obj 10 c1 3\n"
+  " c2 2\n"
+  "RANGES\n"
+  " rng c1 -1\n"
+  " c2 4\n"
+  "BOUNDS\n"
+  " FR bnd x\n"
+  " MI y\n"
+  " UP y 5\n"
+  "QUADOBJ\n"
+  " x x 2\n"
+  " x y 1\n"
+  " y y 4\n"
+  "ENDATA\n";
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE (mps_linear)
+{
+  std::istringstream in (lp);
+  boost::shared_ptr<problem_t> pb = readMps (in);
+
+  BOOST_CHECK_EQUAL (pb->function ().getName (), "TESTPROB");
+  BOOST_CHECK_EQUAL (pb->function ().inputSize (), 3);
+  BOOST_CHECK (pb->function ().asType<linear_t> ());
+  BOOST_REQUIRE_EQUAL (pb->constraints ().size (), 1);
+  BOOST_CHECK_EQUAL (pb->constraintsOutputSize (), 3);
+
+  BOOST_REQUIRE_EQUAL (pb->argumentNames ().size (), 3);
+  BOOST_CHECK_EQUAL (pb->argumentNames ()[0], "XONE");
+  BOOST_CHECK_EQUAL (pb->argumentNames ()[2], "ZTHREE");
+
+  argument_t lower (3);
+  argument_t upper (3);
+  lower << 0., -1., 0.;
+  upper << 4., 1., Function::infinity ();
+  BOOST_CHECK (pb->argumentLowerBounds () == lower);
+  BOOST_CHECK (pb->argumentUpperBounds () == upper);
+
+  lower << -Function::infinity (), 1., 7.;
+  upper << 4., Function::infinity (), 7.;
+  BOOST_CHECK (pb->constraintsLowerBounds () == lower);
+  BOOST_CHECK (pb->constraintsUpperBounds () == upper);
+
+  argument_t x (3);
+  x << 1., 2., 3.;
+  result_t f (1);
+  f << 14.;
+  BOOST_CHECK (allclose (pb->function () (x), f));
+
+  result_t g (3);
+  pb->evaluateConstraints (g, x);
+  result_t expected (3);
+  expected << 3., 4., 1.;
+  BOOST_CHECK (allclose (g, expected));
+}
+
+BOOST_AUTO_TEST_CASE (mps_quadratic)
+{
+  std::istringstream in (qp);
+  boost::shared_ptr<problem_t> pb = readMps (in);
+
+  BOOST_CHECK_EQUAL (pb->function ().getName (), "QPTEST");
+  BOOST_REQUIRE (pb->function ().asType<quadratic_t> ());
+  BOOST_REQUIRE_EQUAL (pb->constraints ().size (), 1);
+
+  // Maximization: the cost is negated.
+  // f (x, y) = -(x^2 + x y + 2 y^2 + x - y - 10)
+  argument_t x (2);
+  x << 2., 1.;
+  result_t f (1);
+  f << 1.;
+  BOOST_CHECK (allclose (pb->function () (x), f));
+
+  argument_t lower (2);
+  argument_t upper (2);
+  lower << -Function::infinity (), -Function::infinity ();
+  upper << Function::infinity (), 5.;
+  BOOST_CHECK (pb->argumentLowerBounds () == lower);
+  BOOST_CHECK (pb->argumentUpperBounds () == upper);
+
+  // Ranges on an equality row (negative range) and on an inequality row.
+  lower << 2., -2.;
+  upper << 3., 2.;
+  BOOST_CHECK (pb->constraintsLowerBounds () == lower);
+  BOOST_CHECK (pb->constraintsUpperBounds () == upper);
+
+  // Entries of the second free row are ignored.
+  result_t g (2);
+  pb->evaluateConstraints (g, x);
+  result_t expected (2);
+  expected << 5., 1.;
+  BOOST_CHECK (allclose (g, expected));
+}
+
+BOOST_AUTO_TEST_CASE (mps_errors)
+{
+  {
+    std::istringstream in ("ROWS\n N obj\nCOLUMNS\n x c 1\nENDATA\n");
+    BOOST_CHECK_THROW (readMps (in), std::runtime_error);
+  }
+  {
+    std::istringstream in ("ROWS\n N obj\nCOLUMNS\n x obj one\nENDATA\n");
+    BOOST_CHECK_THROW (readMps (in), std::runtime_error);
+  }
+  {
+    std::istringstream in ("ROWS\n N obj\nCOLUMNS\n x obj 1\n");
+    BOOST_CHECK_THROW (readMps (in), std::runtime_error);
+  }
+  {
+    std::istringstream in ("ROWS\n N obj\nCOLUMNS\n x obj 1\n"
+			   "BOUNDS\n UP b y 1\nENDATA\n");
+    BOOST_CHECK_THROW (readMps (in), std::runtime_error);
+  }
+  BOOST_CHECK_THROW (readMps ("/nonexistent/file.mps"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -17,6 +17,8 @@
 
 #include "shared-tests/fixture.hh"
 
+#include <cmath>
+
 #include <roboptim/core/io.hh>
 #include <roboptim/core/debug.hh>
 #include <roboptim/core/n-times-derivable-function.hh>
@@ -67,6 +69,40 @@ struct F10 : public NTimesDerivableFunction<10>
   }
 };
 
+// Define a 2-times derivable function: [sin(t), t^2].
+struct G2 : public NTimesDerivableFunction<2>
+{
+  using NTimesDerivableFunction<2>::impl_compute;
+
+  G2 () : NTimesDerivableFunction<2> (2, "[sin(t), t^2]")
+  {}
+
+  virtual void impl_compute (result_ref result, double t) const
+  {
+    result[0] = std::sin (t);
+    result[1] = t * t;
+  }
+
+  virtual void impl_derivative (derivative_ref derivative,
+				double t,
+				size_type order = 1) const
+  {
+    switch (order)
+      {
+      case 0:
+	impl_compute (derivative, t);
+	break;
+      case 1:
+	derivative[0] = std::cos (t);
+	derivative[1] = 2. * t;
+	break;
+      default:
+	derivative[0] = -std::sin (t);
+	derivative[1] = 2.;
+      }
+  }
+};
+
 #define PRINT_FUNC(func)                          \
   (*output) << (*func) << std::endl               \
             << "Evaluate:" << std::endl           \
@@ -102,4 +138,31 @@ BOOST_AUTO_TEST_CASE (n_times_derivable_function)
   BOOST_CHECK (output->match_pattern ());
 }
 
+BOOST_AUTO_TEST_CASE (n_times_derivable_function_derivatives)
+{
+  G2 g;
+
+  G2::vector_t times (5);
+  times << -1., 0., .25, 1., 3.;
+  G2::matrix_t values (g.derivativeSize (), times.size ());
+  G2::derivative_t derivative (g.derivativeSize ());
+
+  // Batched evaluation matches the evaluation at each point.
+  for (G2::size_type order = 0; order <= 2; ++order)
+    {
+      g.derivatives (values, times, order);
+      for (G2::size_type i = 0; i < times.size (); ++i)
+	{
+	  g.derivative (derivative, times[i], order);
+	  BOOST_CHECK (allclose (values.col (i), derivative));
+	}
+    }
+
+  // Gradient and Hessian rely on the derivatives.
+  G2::argument_t x (1);
+  x[0] = .25;
+  BOOST_CHECK_CLOSE (g.gradient (x, 1)[0], .5, 1e-8);
+  BOOST_CHECK_CLOSE (g.hessian (x, 0) (0, 0), -std::sin (.25), 1e-8);
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
@@ -80,4 +80,45 @@ BOOST_AUTO_TEST_CASE_TEMPLATE (numeric_linear_function, T, functionTypes_t)
   BOOST_CHECK (output->match_pattern ());
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE (numeric_linear_function_subsets, T,
+			       functionTypes_t)
+{
+  typedef GenericNumericLinearFunction<T> linear_t;
+  typedef typename linear_t::jacobian_t jacobian_t;
+  typedef typename linear_t::indices_t indices_t;
+
+  Eigen::MatrixXd dense (4, 5);
+  dense <<
+    1., 0., 2., 0., 0.,
+    0., 3., 0., 0., 7.,
+    4., 0., 5., 0., 0.,
+    0., 0., 6., 8., 0.;
+  typename linear_t::matrix_t a;
+  a = dense.sparseView ();
+  typename linear_t::vector_t b = linear_t::vector_t::Zero (4);
+  linear_t f (a, b);
+  typename linear_t::argument_t x = linear_t::argument_t::Zero (5);
+
+  // Unsorted and repeated indices.
+  indices_t indices;
+  indices.push_back (3);
+  indices.push_back (0);
+  indices.push_back (3);
+  indices.push_back (1);
+
+  jacobian_t rows (4, 5);
+  rows.setZero ();
+  BOOST_CHECK (f.jacobianRows (rows, x, indices));
+  for (std::size_t k = 0; k < indices.size (); ++k)
+    BOOST_CHECK (allclose (toDense (rows).row (static_cast<int> (k)),
+			   dense.row (indices[k])));
+
+  jacobian_t columns (4, 4);
+  columns.setZero ();
+  BOOST_CHECK (f.jacobianColumns (columns, x, indices));
+  for (std::size_t k = 0; k < indices.size (); ++k)
+    BOOST_CHECK (allclose (toDense (columns).col (static_cast<int> (k)),
+			   dense.col (indices[k])));
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
@@ -134,5 +134,63 @@ BOOST_AUTO_TEST_CASE_TEMPLATE (random_gradient_check, T, sparseOnly_t)
     }
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE (symmetric_kernels, T, functionTypes_t)
+{
+  typedef GenericNumericQuadraticFunction<T> quadratic_t;
+
+  Eigen::MatrixXd dense (4, 4);
+  dense <<
+    2., -1., 0., .5,
+    -1., 3., 1., 0.,
+    0., 1., 1., 0.,
+    .5, 0., 0., 4.;
+  typename quadratic_t::matrix_t a;
+  a = dense.sparseView ();
+  typename quadratic_t::vector_t b (4);
+  b << 1., -2., 0., .5;
+  typename quadratic_t::vector_t c (1);
+  c << 3.;
+  quadratic_t f (a, b, c);
+
+  typename quadratic_t::vector_t x (4);
+  x << 1., 2., -1., .5;
+
+  // Reference values with the full matrix.
+  const double value = x.dot (dense * x) + b.dot (x) + c[0];
+  Eigen::VectorXd gradient = 2. * dense * x + b;
+
+  BOOST_CHECK_CLOSE (f (x)[0], value, 1e-8);
+  BOOST_CHECK (allclose (toDense (f.gradient (x, 0)),
+			 Eigen::MatrixXd (gradient.transpose ())));
+  BOOST_CHECK (allclose (toDense (f.jacobian (x)),
+			 Eigen::MatrixXd (gradient.transpose ())));
+  BOOST_CHECK (allclose (toDense (f.hessian (x, 0)),
+			 Eigen::MatrixXd (2. * dense)));
+
+  // Value and gradient at once.
+  typename quadratic_t::result_t result (1);
+  typename quadratic_t::gradient_t grad (4);
+  grad.setZero ();
+  f.computeWithGradient (result, grad, x);
+  BOOST_CHECK_CLOSE (result[0], value, 1e-8);
+  BOOST_CHECK (allclose (toDense (grad),
+			 Eigen::MatrixXd (gradient.transpose ())));
+
+  // Only the upper triangle is read, even if the sparse matrix is not
+  // compressed.
+  Eigen::MatrixXd upper = dense.triangularView<Eigen::Upper> ();
+  a = upper.sparseView ();
+  quadratic_t g (a, b, c);
+  g.A ().coeffRef (1, 3) = 2.;
+  g.A ().coeffRef (3, 0) = 7.;
+  dense (1, 3) = dense (3, 1) = 2.;
+  gradient = 2. * dense * x + b;
+
+  BOOST_CHECK_CLOSE (g (x)[0], x.dot (dense * x) + b.dot (x) + c[0], 1e-8);
+  BOOST_CHECK (allclose (toDense (g.gradient (x, 0)),
+			 Eigen::MatrixXd (gradient.transpose ())));
+  BOOST_CHECK (allclose (toDense (g.hessian (x, 0)),
+			 Eigen::MatrixXd (2. * dense)));
+}
 
 BOOST_AUTO_TEST_SUITE_END ()
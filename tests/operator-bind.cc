@@ -27,11 +27,34 @@
 #include <roboptim/core/operator/bind.hh>
 
 #include <roboptim/core/differentiable-function.hh>
+#include <roboptim/core/numeric-linear-function.hh>
+#include <roboptim/core/decorator/finite-difference-gradient.hh>
 #include <roboptim/core/function/constant.hh>
 #include <roboptim/core/function/identity.hh>
 
 using namespace roboptim;
 
+// g(x) = [x_0 * x_1 + x_2, x_3²], counting its evaluations.
+template <typename T>
+struct G : public GenericFunction<T>
+{
+public:
+  ROBOPTIM_FUNCTION_FWD_TYPEDEFS_ (GenericFunction<T>);
+
+  G () : GenericFunction<T> (4, 2, "g"),
+	 computeCount (0)
+  {}
+
+  void impl_compute (result_ref res, const_argument_ref x) const
+  {
+    ++computeCount;
+    res[0] = x[0] * x[1] + x[2];
+    res[1] = x[3] * x[3];
+  }
+
+  mutable int computeCount;
+};
+
 template <typename T>
 struct F : public GenericDifferentiableFunction<T>
 {
@@ -167,4 +190,73 @@ BOOST_AUTO_TEST_CASE_TEMPLATE (chain_test, T, functionTypes_t)
   BOOST_CHECK (output->match_pattern ());
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE (bind_columns_test, T, functionTypes_t)
+{
+  typedef GenericDifferentiableFunction<T> differentiableFunction_t;
+  typedef Bind<differentiableFunction_t> bind_t;
+  typedef typename differentiableFunction_t::value_type value_type;
+  typedef typename differentiableFunction_t::argument_t argument_t;
+
+  typename bind_t::boundValues_t boundValues (4);
+  boundValues[0] = 2.;
+  boundValues[1] = 3.;
+  boundValues[3] = -1.;
+
+  argument_t x (1);
+  x << 0.5;
+  argument_t fullX (4);
+  fullX << 2., 3., 0.5, -1.;
+
+  // Only the free variable is perturbed by finite differences.
+  boost::shared_ptr<G<T> > g = boost::make_shared<G<T> > ();
+  boost::shared_ptr<differentiableFunction_t> fd =
+    boost::make_shared<GenericFiniteDifferenceGradient
+		       <T, finiteDifferenceGradientPolicies::Simple<T> > > (g);
+  boost::shared_ptr<bind_t> fct = boost::make_shared<bind_t>
+    (fd, boundValues);
+
+  Eigen::MatrixXd expected (2, 1);
+  expected << 1., 0.;
+  BOOST_CHECK (allclose (toDense (fct->jacobian (x)), expected, 1e-6));
+  BOOST_CHECK_EQUAL (g->computeCount, 2);
+
+  // The Jacobian of a numeric linear function is sliced directly.
+  Eigen::MatrixXd dense (2, 4);
+  dense <<
+    1., 0., 2., 0.,
+    0., 3., 0., 4.;
+  typename GenericNumericLinearFunction<T>::matrix_t a;
+  a = dense.sparseView ();
+  typename GenericNumericLinearFunction<T>::vector_t b (2);
+  b << 1., -1.;
+  boost::shared_ptr<differentiableFunction_t> linear =
+    boost::make_shared<GenericNumericLinearFunction<T> > (a, b);
+
+  boundValues.assign (4, boost::optional<value_type> ());
+  boundValues[1] = 3.;
+  boost::shared_ptr<bind_t> linear_fct = boost::make_shared<bind_t>
+    (linear, boundValues);
+
+  Eigen::MatrixXd expectedLinear (2, 3);
+  expectedLinear << dense.col (0), dense.col (2), dense.col (3);
+  argument_t y (3);
+  y << 2., 0.5, -1.;
+  BOOST_CHECK (allclose (toDense (linear_fct->jacobian (y)),
+			 expectedLinear));
+  BOOST_CHECK (allclose ((*linear_fct) (y), (*linear) (fullX)));
+
+  // Nested binds forward the free columns to the input function.
+  typename bind_t::boundValues_t nestedValues (3);
+  nestedValues[1] = 0.5;
+  boost::shared_ptr<differentiableFunction_t> inner = linear_fct;
+  boost::shared_ptr<bind_t> nested = boost::make_shared<bind_t>
+    (inner, nestedValues);
+
+  Eigen::MatrixXd expectedNested (2, 2);
+  expectedNested << dense.col (0), dense.col (3);
+  argument_t z (2);
+  z << 2., -1.;
+  BOOST_CHECK (allclose (toDense (nested->jacobian (z)), expectedNested));
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
@@ -42,6 +42,72 @@ using namespace roboptim;
 // ::roboptim::EigenMatrixSparse
 typedef boost::mpl::list< ::roboptim::EigenMatrixDense> functionTypes_t;
 
+typedef boost::mpl::list< ::roboptim::EigenMatrixDense,
+			  ::roboptim::EigenMatrixSparse> allFunctionTypes_t;
+
+// r (x, y) = (x^2, x y, y), counting its evaluations.
+template <typename T>
+struct CountingFunction : public GenericDifferentiableFunction<T>
+{
+  ROBOPTIM_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_
+  (GenericDifferentiableFunction<T>);
+
+  CountingFunction ()
+    : GenericDifferentiableFunction<T> (2, 3, "r"),
+      computeCount (0),
+      jacobianCount (0)
+  {}
+
+  void impl_compute (result_ref res, const_argument_ref x) const
+  {
+    ++computeCount;
+    res[0] = x[0] * x[0];
+    res[1] = x[0] * x[1];
+    res[2] = x[1];
+  }
+
+  void impl_gradient (gradient_ref grad, const_argument_ref x,
+		      size_type functionId) const
+  {
+    switch (functionId)
+      {
+      case 0:
+	grad.coeffRef (0) = 2. * x[0];
+	break;
+      case 1:
+	grad.coeffRef (0) = x[1];
+	grad.coeffRef (1) = x[0];
+	break;
+      default:
+	grad.coeffRef (1) = 1.;
+      }
+  }
+
+  void impl_jacobian (jacobian_ref jac, const_argument_ref x) const
+  {
+    ++jacobianCount;
+    jac.coeffRef (0, 0) = 2. * x[0];
+    jac.coeffRef (1, 0) = x[1];
+    jac.coeffRef (1, 1) = x[0];
+    jac.coeffRef (2, 1) = 1.;
+  }
+
+  mutable int computeCount;
+  mutable int jacobianCount;
+};
+
+inline const double*
+valuePtr (const GenericFunctionTraits<EigenMatrixDense>::matrix_t& m)
+{
+  return m.data ();
+}
+
+inline const double*
+valuePtr (const GenericFunctionTraits<EigenMatrixSparse>::matrix_t& m)
+{
+  return m.valuePtr ();
+}
+
 BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
 
 BOOST_AUTO_TEST_CASE_TEMPLATE (chain_test, T, functionTypes_t)
@@ -210,4 +276,90 @@ BOOST_AUTO_TEST_CASE_TEMPLATE (chain_jacobian_test, T, functionTypes_t)
     }
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE (chain_cache_test, T, allFunctionTypes_t)
+{
+  typedef GenericDifferentiableFunction<T> differentiableFunction_t;
+  typedef GenericNumericLinearFunction<T> linear_t;
+  typedef CountingFunction<T> counting_t;
+  typedef Chain<differentiableFunction_t, differentiableFunction_t> chain_t;
+  typedef typename differentiableFunction_t::argument_t argument_t;
+  typedef typename differentiableFunction_t::jacobian_t jacobian_t;
+
+  Eigen::MatrixXd dense (2, 3);
+  dense <<
+    1., 0., 2.,
+    0., 3., 0.;
+  typename linear_t::matrix_t a;
+  a = dense.sparseView ();
+  typename linear_t::vector_t b (2);
+  b.setZero ();
+
+  boost::shared_ptr<linear_t> f = boost::make_shared<linear_t> (a, b);
+  boost::shared_ptr<counting_t> r = boost::make_shared<counting_t> ();
+  boost::shared_ptr<chain_t> h =
+    chain<differentiableFunction_t, differentiableFunction_t> (f, r);
+
+  argument_t x (2);
+  x << 1., 2.;
+
+  // Without caching, the right function is evaluated every time.
+  BOOST_CHECK (!h->cacheRight ());
+  (*h) (x);
+  h->jacobian (x);
+  BOOST_CHECK_EQUAL (r->computeCount, 2);
+  BOOST_CHECK_EQUAL (r->jacobianCount, 1);
+
+  // With caching, the right function is evaluated once per point.
+  h->cacheRight (true);
+  r->computeCount = 0;
+  r->jacobianCount = 0;
+  typename differentiableFunction_t::result_t res = (*h) (x);
+  jacobian_t jac = h->jacobian (x);
+  for (typename differentiableFunction_t::size_type i = 0;
+       i < h->outputSize (); ++i)
+    BOOST_CHECK (allclose (toDense (h->gradient (x, i)),
+			   toDense (jac).row (i)));
+  BOOST_CHECK_EQUAL (r->computeCount, 1);
+  BOOST_CHECK_EQUAL (r->jacobianCount, 1);
+
+  typename differentiableFunction_t::result_t expected (2);
+  expected << 5., 6.;
+  BOOST_CHECK (allclose (res, expected));
+
+  Eigen::MatrixXd expectedJac (2, 2);
+  expectedJac <<
+    2., 2.,
+    6., 3.;
+  BOOST_CHECK (allclose (toDense (jac), expectedJac));
+
+  // A new point triggers a new evaluation, and the Jacobian is computed in
+  // the same matrix.
+  const double* values = valuePtr (jac);
+  x << 2., 1.;
+  h->jacobian (jac, x);
+  BOOST_CHECK_EQUAL (values, valuePtr (jac));
+  BOOST_CHECK_EQUAL (r->computeCount, 2);
+  BOOST_CHECK_EQUAL (r->jacobianCount, 2);
+  expectedJac <<
+    4., 2.,
+    3., 6.;
+  BOOST_CHECK (allclose (toDense (jac), expectedJac));
+
+  // Explicit invalidation.
+  h->resetCache ();
+  (*h) (x);
+  BOOST_CHECK_EQUAL (r->computeCount, 3);
+
+  // Results computed without caching are not reused once it is enabled
+  // again.
+  h->cacheRight (false);
+  x << 1., 2.;
+  (*h) (x);
+  h->cacheRight (true);
+  (*h) (x);
+  (*h) (x);
+  BOOST_CHECK_EQUAL (r->computeCount, 5);
+  BOOST_CHECK (allclose ((*h) (x), expected));
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
@@ -21,11 +21,14 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <cmath>
 #include <iostream>
 
 #include <roboptim/core/io.hh>
 #include <roboptim/core/operator/derivative.hh>
 
+#include <roboptim/core/n-times-derivable-function.hh>
+#include <roboptim/core/numeric-linear-function.hh>
 #include <roboptim/core/function/cos.hh>
 #include <roboptim/core/function/identity.hh>
 
@@ -141,4 +144,92 @@ BOOST_AUTO_TEST_CASE_TEMPLATE (nondifferentiable_derivative_test, T, functionTyp
     << (*df) (x) << std::endl;
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE (linear_derivative_test, T, functionTypes_t)
+{
+  typedef GenericNumericLinearFunction<T> linear_t;
+
+  Eigen::MatrixXd dense (2, 3);
+  dense <<
+    1., 0., 2.,
+    0., 3., -1.;
+  typename linear_t::matrix_t a;
+  a = dense.sparseView ();
+  typename linear_t::vector_t b (2);
+  b << 1., -1.;
+  boost::shared_ptr<linear_t> f = boost::make_shared<linear_t> (a, b);
+
+  typename linear_t::argument_t x (3);
+  x << 1., 2., 3.;
+
+  // The column of the Jacobian is computed directly.
+  for (typename linear_t::size_type j = 0; j < 3; ++j)
+    {
+      boost::shared_ptr<GenericFunction<T> > df = derivative (f, j);
+      BOOST_CHECK (allclose ((*df) (x),
+			     typename linear_t::vector_t (dense.col (j))));
+    }
+}
+
+// Define a 2-times derivable function: [t^3, exp(t)].
+struct H : public NTimesDerivableFunction<2>
+{
+  using NTimesDerivableFunction<2>::impl_compute;
+
+  H () : NTimesDerivableFunction<2> (2, "[t^3, exp(t)]")
+  {}
+
+  virtual void impl_compute (result_ref result, double t) const
+  {
+    result[0] = t * t * t;
+    result[1] = std::exp (t);
+  }
+
+  virtual void impl_derivative (derivative_ref derivative,
+				double t,
+				size_type order = 1) const
+  {
+    switch (order)
+      {
+      case 0:
+	impl_compute (derivative, t);
+	break;
+      case 1:
+	derivative[0] = 3. * t * t;
+	derivative[1] = std::exp (t);
+	break;
+      default:
+	derivative[0] = 6. * t;
+	derivative[1] = std::exp (t);
+      }
+  }
+};
+
+BOOST_AUTO_TEST_CASE (n_times_derivable_derivative_test)
+{
+  boost::shared_ptr<H> h = boost::make_shared<H> ();
+  boost::shared_ptr<Derivative<H> > dh = derivative (h, 0);
+
+  H::vector_t times (4);
+  times << -1., 0., .5, 2.;
+  H::matrix_t values (2, times.size ());
+  H::matrix_t expected (2, times.size ());
+
+  // Derivatives of order k of dh are derivatives of order k + 1 of h.
+  for (H::size_type order = 0; order <= 1; ++order)
+    {
+      dh->derivatives (values, times, order);
+      h->derivatives (expected, times, order + 1);
+      BOOST_CHECK (allclose (values, expected));
+    }
+
+  // Pointwise evaluation is consistent with the batch.
+  dh->derivatives (values, times);
+  H::argument_t x (1);
+  for (H::size_type i = 0; i < times.size (); ++i)
+    {
+      x[0] = times[i];
+      BOOST_CHECK (allclose ((*dh) (x), H::vector_t (values.col (i))));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
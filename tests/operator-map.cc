@@ -21,7 +21,10 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <thread>
 
 #include <roboptim/core/io.hh>
 #include <roboptim/core/operator/map.hh>
@@ -34,6 +37,124 @@ using namespace roboptim;
 typedef boost::mpl::list< ::roboptim::EigenMatrixDense,
 			  ::roboptim::EigenMatrixSparse> functionTypes_t;
 
+// f (x, y, z) = (x y, x + 2 z)
+template <typename T>
+struct F : public GenericDifferentiableFunction<T>
+{
+  ROBOPTIM_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_
+  (GenericDifferentiableFunction<T>);
+
+  F () : GenericDifferentiableFunction<T> (3, 2, "f")
+  {}
+
+  // Reentrant: the evaluation does not modify anything.
+  void evaluationState (std::vector<const void*>&) const
+  {}
+
+  void impl_compute (result_ref res, const_argument_ref x) const
+  {
+    res[0] = x[0] * x[1];
+    res[1] = x[0] + 2. * x[2];
+  }
+
+  void impl_gradient (gradient_ref grad, const_argument_ref x,
+		      size_type functionId) const
+  {
+    if (functionId == 0)
+      {
+	grad.coeffRef (0) = x[1];
+	grad.coeffRef (1) = x[0];
+      }
+    else
+      {
+	grad.coeffRef (0) = 1.;
+	grad.coeffRef (2) = 2.;
+      }
+  }
+
+  void impl_jacobian (jacobian_ref jac, const_argument_ref x) const
+  {
+    jac.coeffRef (0, 0) = x[1];
+    jac.coeffRef (0, 1) = x[0];
+    jac.coeffRef (1, 0) = 1.;
+    jac.coeffRef (1, 2) = 2.;
+  }
+};
+
+// Function writing to an internal counter during its evaluation, which
+// records the maximum number of concurrent evaluations.
+template <typename T>
+struct Stateful : public GenericDifferentiableFunction<T>
+{
+  ROBOPTIM_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_
+  (GenericDifferentiableFunction<T>);
+
+  Stateful ()
+    : GenericDifferentiableFunction<T> (1, 1, "stateful"),
+      active (0),
+      maxActive (0)
+  {}
+
+  void enter () const
+  {
+    ++active;
+    maxActive = std::max (maxActive, active);
+
+    // Leave some time to the other threads.
+    std::this_thread::sleep_for (std::chrono::milliseconds (1));
+
+    --active;
+  }
+
+  void impl_compute (result_ref res, const_argument_ref x) const
+  {
+    enter ();
+    res[0] = 2. * x[0];
+  }
+
+  void impl_gradient (gradient_ref grad, const_argument_ref,
+		      size_type) const
+  {
+    enter ();
+    grad.coeffRef (0) = 2.;
+  }
+
+  void impl_jacobian (jacobian_ref jac, const_argument_ref) const
+  {
+    enter ();
+    jac.coeffRef (0, 0) = 2.;
+  }
+
+  mutable int active;
+  mutable int maxActive;
+};
+
+inline const double*
+valuePtr (const GenericFunctionTraits<EigenMatrixDense>::matrix_t& m)
+{
+  return m.data ();
+}
+
+inline const double*
+valuePtr (const GenericFunctionTraits<EigenMatrixSparse>::matrix_t& m)
+{
+  return m.valuePtr ();
+}
+
+template <typename M>
+Function::matrix_t
+referenceJacobian (const GenericDifferentiableFunction<M>& f,
+		   Function::const_argument_ref x,
+		   Function::size_type repeat)
+{
+  Function::matrix_t jac (2 * repeat, 3 * repeat);
+  jac.setZero ();
+  for (Function::size_type i = 0; i < repeat; ++i)
+    jac.block (2 * i, 3 * i, 2, 3) =
+      toDense (f.jacobian (x.segment (3 * i, 3)));
+  return jac;
+}
+
 BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
 
 BOOST_AUTO_TEST_CASE_TEMPLATE (map_test, T, functionTypes_t)
@@ -55,4 +176,82 @@ BOOST_AUTO_TEST_CASE_TEMPLATE (map_test, T, functionTypes_t)
     << fct->jacobian (x) << std::endl;
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE (map_block_diagonal, T, functionTypes_t)
+{
+  typedef GenericDifferentiableFunction<T> f_t;
+  typedef Map<f_t> map_t;
+  typedef typename map_t::argument_t argument_t;
+  typedef typename map_t::result_t result_t;
+  typedef typename map_t::gradient_t gradient_t;
+  typedef typename map_t::jacobian_t jacobian_t;
+
+  const typename map_t::size_type repeat = 20;
+  boost::shared_ptr<f_t> f = boost::make_shared<F<T> > ();
+  boost::shared_ptr<map_t> fct = map (f, repeat);
+
+  BOOST_CHECK_EQUAL (fct->inputSize (), 3 * repeat);
+  BOOST_CHECK_EQUAL (fct->outputSize (), 2 * repeat);
+
+  argument_t x = argument_t::Random (fct->inputSize ());
+
+  // Each repeat is evaluated on its own segment.
+  result_t res = (*fct) (x);
+  for (typename map_t::size_type i = 0; i < repeat; ++i)
+    BOOST_CHECK (allclose (res.segment (2 * i, 2),
+			   (*f) (x.segment (3 * i, 3))));
+
+  // Block-diagonal Jacobian.
+  jacobian_t jac = fct->jacobian (x);
+  BOOST_CHECK (allclose (toDense (jac), referenceJacobian (*f, x, repeat)));
+
+  // Gradients only depend on the segment of the repeat.
+  for (typename map_t::size_type i = 0; i < fct->outputSize (); ++i)
+    {
+      gradient_t grad = fct->gradient (x, i);
+      BOOST_CHECK (allclose (toDense (grad), toDense (jac).row (i)));
+    }
+
+  // Later evaluations write into the same matrix.
+  const double* values = valuePtr (jac);
+  x *= 2.;
+  fct->jacobian (jac, x);
+  BOOST_CHECK_EQUAL (values, valuePtr (jac));
+  BOOST_CHECK (allclose (toDense (jac), referenceJacobian (*f, x, repeat)));
+
+  // Parallel evaluation (f can be evaluated concurrently).
+  boost::shared_ptr<map_t> parallel_fct = map (f, repeat);
+  parallel_fct->evaluationThreads () = 4;
+  BOOST_CHECK (allclose ((*parallel_fct) (x), (*fct) (x)));
+
+  jacobian_t parallel_jac = parallel_fct->jacobian (x);
+  BOOST_CHECK (allclose (toDense (parallel_jac), toDense (jac)));
+  values = valuePtr (parallel_jac);
+  x *= 2.;
+  fct->jacobian (jac, x);
+  parallel_fct->jacobian (parallel_jac, x);
+  BOOST_CHECK_EQUAL (values, valuePtr (parallel_jac));
+  BOOST_CHECK (allclose (toDense (parallel_jac), toDense (jac)));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (map_stateful_origin, T, functionTypes_t)
+{
+  typedef GenericDifferentiableFunction<T> f_t;
+  typedef Map<f_t> map_t;
+  typedef typename map_t::argument_t argument_t;
+  typedef typename map_t::jacobian_t jacobian_t;
+
+  const typename map_t::size_type repeat = 64;
+  boost::shared_ptr<Stateful<T> > f = boost::make_shared<Stateful<T> > ();
+  boost::shared_ptr<map_t> fct = map (boost::shared_ptr<f_t> (f), repeat);
+  fct->evaluationThreads () = 4;
+
+  // The origin modifies itself: the repeats are evaluated sequentially.
+  argument_t x = argument_t::Random (repeat);
+  BOOST_CHECK (allclose ((*fct) (x), 2. * x));
+  jacobian_t jac = fct->jacobian (x);
+  BOOST_CHECK (allclose (toDense (jac),
+			 2. * Function::matrix_t::Identity (repeat, repeat)));
+  BOOST_CHECK_EQUAL (f->maxActive, 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
@@ -36,6 +36,66 @@ using namespace roboptim;
 typedef boost::mpl::list< ::roboptim::EigenMatrixDense,
 			  ::roboptim::EigenMatrixSparse> functionTypes_t;
 
+inline const double*
+valuePtr (const GenericFunctionTraits<EigenMatrixDense>::matrix_t& m)
+{
+  return m.data ();
+}
+
+inline const double*
+valuePtr (const GenericFunctionTraits<EigenMatrixSparse>::matrix_t& m)
+{
+  return m.valuePtr ();
+}
+
+// f(x) = [a x_0² + x_1, x_0 x_1 + a]
+template <typename T>
+struct F : public GenericTwiceDifferentiableFunction<T>
+{
+  ROBOPTIM_TWICE_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_
+  (GenericTwiceDifferentiableFunction<T>);
+
+  explicit F (value_type a)
+    : GenericTwiceDifferentiableFunction<T> (2, 2, "f"),
+      a_ (a)
+  {}
+
+  void impl_compute (result_ref result, const_argument_ref x) const
+  {
+    result[0] = a_ * x[0] * x[0] + x[1];
+    result[1] = x[0] * x[1] + a_;
+  }
+
+  void impl_gradient (gradient_ref gradient, const_argument_ref x,
+		      size_type functionId) const
+  {
+    if (functionId == 0)
+      {
+	gradient.coeffRef (0) = 2. * a_ * x[0];
+	gradient.coeffRef (1) = 1.;
+      }
+    else
+      {
+	gradient.coeffRef (0) = x[1];
+	gradient.coeffRef (1) = x[0];
+      }
+  }
+
+  void impl_hessian (hessian_ref hessian, const_argument_ref,
+		     size_type functionId) const
+  {
+    if (functionId == 0)
+      hessian.coeffRef (0, 0) = 2. * a_;
+    else
+      {
+	hessian.coeffRef (0, 1) = 1.;
+	hessian.coeffRef (1, 0) = 1.;
+      }
+  }
+
+  value_type a_;
+};
+
 BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
 
 BOOST_AUTO_TEST_CASE_TEMPLATE (product_test, T, functionTypes_t)
@@ -111,4 +171,56 @@ BOOST_AUTO_TEST_CASE_TEMPLATE (product_test, T, functionTypes_t)
   BOOST_CHECK (output->match_pattern ());
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE (product_hessian_test, T, functionTypes_t)
+{
+  typedef GenericTwiceDifferentiableFunction<T> function_t;
+  typedef Product<function_t, function_t> product_t;
+  typedef typename product_t::argument_t argument_t;
+  typedef typename product_t::gradient_t gradient_t;
+  typedef typename product_t::jacobian_t jacobian_t;
+  typedef typename product_t::size_type size_type;
+
+  typename GenericFunction<T>::value_type eps = 1e-6;
+
+  boost::shared_ptr<function_t> u = boost::make_shared<F<T> > (2.);
+  boost::shared_ptr<function_t> v = boost::make_shared<F<T> > (-1.);
+  boost::shared_ptr<product_t> fct = boost::make_shared<product_t> (u, v);
+  GenericFiniteDifferenceGradient<T> fd_fct (fct);
+
+  argument_t x (2);
+  x << 0.5, -1.5;
+
+  // Jacobian and gradients.
+  jacobian_t jac = fct->jacobian (x);
+  BOOST_CHECK (allclose (toDense (jac), toDense (fd_fct.jacobian (x)),
+			 eps, eps));
+  for (size_type i = 0; i < fct->outputSize (); ++i)
+    BOOST_CHECK (allclose (toDense (fct->gradient (x, i)),
+			   toDense (jac).row (i)));
+
+  // Later evaluations write into the same matrix.
+  const double* values = valuePtr (jac);
+  x << 1., 2.;
+  fct->jacobian (jac, x);
+  BOOST_CHECK_EQUAL (values, valuePtr (jac));
+  BOOST_CHECK (allclose (toDense (jac), toDense (fd_fct.jacobian (x)),
+			 eps, eps));
+
+  // Hessians, compared to finite differences of the gradients.
+  for (size_type i = 0; i < fct->outputSize (); ++i)
+    {
+      Eigen::MatrixXd expected (2, 2);
+      gradient_t g = fct->gradient (x, i);
+      for (size_type j = 0; j < x.size (); ++j)
+	{
+	  argument_t xEps = x;
+	  xEps[j] += eps;
+	  expected.col (j) = (toDense (fct->gradient (xEps, i))
+			      - toDense (g)).transpose () / eps;
+	}
+      BOOST_CHECK (allclose (toDense (fct->hessian (x, i)), expected,
+			     1e-4, 1e-4));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
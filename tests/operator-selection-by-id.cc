@@ -28,6 +28,7 @@
 
 #include <roboptim/core/function/constant.hh>
 #include <roboptim/core/function/identity.hh>
+#include <roboptim/core/numeric-linear-function.hh>
 
 using namespace roboptim;
 
@@ -67,4 +68,40 @@ BOOST_AUTO_TEST_CASE_TEMPLATE (chain_test, T, functionTypes_t)
                      std::runtime_error);
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE (selection_rows_test, T, functionTypes_t)
+{
+  typedef GenericDifferentiableFunction<T> function_t;
+  typedef SelectionById<function_t> selection_t;
+
+  Eigen::MatrixXd dense (4, 3);
+  dense <<
+    1., 0., 2.,
+    0., 3., 0.,
+    4., 0., 5.,
+    0., 0., 6.;
+  typename GenericNumericLinearFunction<T>::matrix_t a;
+  a = dense.sparseView ();
+  typename GenericNumericLinearFunction<T>::vector_t b (4);
+  b << 1., 2., 3., 4.;
+  boost::shared_ptr<function_t> linear =
+    boost::make_shared<GenericNumericLinearFunction<T> > (a, b);
+
+  std::vector<bool> selector (4, false);
+  selector[1] = selector[3] = true;
+  boost::shared_ptr<selection_t> fct = selectionById (linear, selector);
+
+  typename function_t::argument_t x (3);
+  x << 1., -1., 2.;
+  typename function_t::result_t expected (2);
+  expected << (*linear) (x)[1], (*linear) (x)[3];
+
+  // The selected rows are evaluated directly by the linear function.
+  BOOST_CHECK (allclose ((*fct) (x), expected));
+  Eigen::MatrixXd expectedJacobian (2, 3);
+  expectedJacobian << dense.row (1), dense.row (3);
+  BOOST_CHECK (allclose (toDense (fct->jacobian (x)), expectedJacobian));
+  BOOST_CHECK (allclose (toDense (fct->gradient (x, 1)),
+			 toDense (linear->gradient (x, 3))));
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
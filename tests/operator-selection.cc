@@ -28,6 +28,7 @@
 
 #include <roboptim/core/function/constant.hh>
 #include <roboptim/core/function/identity.hh>
+#include <roboptim/core/numeric-linear-function.hh>
 
 using namespace roboptim;
 
@@ -35,6 +36,79 @@ using namespace roboptim;
 typedef boost::mpl::list< ::roboptim::EigenMatrixDense,
 			  ::roboptim::EigenMatrixSparse> functionTypes_t;
 
+// f_i (x) = (i + 1) * x_0 + i * x_1^2, that can evaluate a subset of its
+// outputs.
+template <typename T>
+struct RowFunction : public GenericDifferentiableFunction<T>
+{
+  ROBOPTIM_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_
+  (GenericDifferentiableFunction<T>);
+
+  RowFunction ()
+    : GenericDifferentiableFunction<T> (2, 6, "row function"),
+      computeCount (0),
+      jacobianCount (0),
+      rowsCount (0)
+  {}
+
+  value_type value (const_argument_ref x, size_type i) const
+  {
+    return static_cast<value_type> (i + 1) * x[0]
+      + static_cast<value_type> (i) * x[1] * x[1];
+  }
+
+  void impl_compute (result_ref result, const_argument_ref x) const
+  {
+    ++computeCount;
+    for (size_type i = 0; i < this->outputSize (); ++i)
+      result[i] = value (x, i);
+  }
+
+  void impl_gradient (gradient_ref gradient, const_argument_ref x,
+		      size_type functionId) const
+  {
+    gradient.coeffRef (0) = static_cast<value_type> (functionId + 1);
+    gradient.coeffRef (1) = 2. * static_cast<value_type> (functionId) * x[1];
+  }
+
+  void impl_jacobian (jacobian_ref jacobian, const_argument_ref x) const
+  {
+    ++jacobianCount;
+    for (size_type i = 0; i < this->outputSize (); ++i)
+      {
+	jacobian.coeffRef (i, 0) = static_cast<value_type> (i + 1);
+	jacobian.coeffRef (i, 1) = 2. * static_cast<value_type> (i) * x[1];
+      }
+  }
+
+  bool impl_compute_rows (result_ref result, const_argument_ref x,
+			  const indices_t& rows) const
+  {
+    ++rowsCount;
+    for (std::size_t k = 0; k < rows.size (); ++k)
+      result[static_cast<size_type> (k)] = value (x, rows[k]);
+    return true;
+  }
+
+  bool impl_jacobian_rows (jacobian_ref jacobian, const_argument_ref x,
+			   const indices_t& rows) const
+  {
+    ++rowsCount;
+    for (std::size_t k = 0; k < rows.size (); ++k)
+      {
+	const size_type i = static_cast<size_type> (k);
+	jacobian.coeffRef (i, 0) = static_cast<value_type> (rows[k] + 1);
+	jacobian.coeffRef (i, 1) =
+	  2. * static_cast<value_type> (rows[k]) * x[1];
+      }
+    return true;
+  }
+
+  mutable int computeCount;
+  mutable int jacobianCount;
+  mutable int rowsCount;
+};
+
 BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
 
 BOOST_AUTO_TEST_CASE_TEMPLATE (chain_test, T, functionTypes_t)
@@ -60,4 +134,62 @@ BOOST_AUTO_TEST_CASE_TEMPLATE (chain_test, T, functionTypes_t)
   BOOST_CHECK_THROW (fct = selection (identity, 0, 10), std::runtime_error);
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE (selection_rows_test, T, functionTypes_t)
+{
+  typedef GenericDifferentiableFunction<T> function_t;
+  typedef Selection<function_t> selection_t;
+  typedef typename function_t::argument_t argument_t;
+
+  boost::shared_ptr<RowFunction<T> > f =
+    boost::make_shared<RowFunction<T> > ();
+  boost::shared_ptr<function_t> origin = f;
+  boost::shared_ptr<selection_t> fct = selection (origin, 2, 3);
+
+  argument_t x (2);
+  x << 1., 2.;
+
+  // Only the selected rows are evaluated.
+  BOOST_CHECK (allclose ((*fct) (x), (*f) (x).segment (2, 3)));
+  BOOST_CHECK (allclose (toDense (fct->jacobian (x)),
+			 toDense (f->jacobian (x)).middleRows (2, 3)));
+  BOOST_CHECK_EQUAL (f->rowsCount, 2);
+  BOOST_CHECK_EQUAL (f->computeCount, 1);
+  BOOST_CHECK_EQUAL (f->jacobianCount, 1);
+
+  for (typename function_t::size_type i = 0; i < fct->outputSize (); ++i)
+    BOOST_CHECK (allclose (toDense (fct->gradient (x, i)),
+			   toDense (f->gradient (x, 2 + i))));
+
+  // Nested selections forward the rows to the origin.
+  boost::shared_ptr<function_t> inner = fct;
+  boost::shared_ptr<selection_t> nested = selection (inner, 1, 2);
+  BOOST_CHECK (allclose ((*nested) (x), (*f) (x).segment (3, 2)));
+  BOOST_CHECK (allclose (toDense (nested->jacobian (x)),
+			 toDense (f->jacobian (x)).middleRows (3, 2)));
+  BOOST_CHECK_EQUAL (f->rowsCount, 4);
+  BOOST_CHECK_EQUAL (f->computeCount, 2);
+  BOOST_CHECK_EQUAL (f->jacobianCount, 2);
+
+  // Numeric linear functions evaluate their rows.
+  Eigen::MatrixXd dense (4, 3);
+  dense <<
+    1., 0., 2.,
+    0., 3., 0.,
+    4., 0., 5.,
+    0., 0., 6.;
+  typename GenericNumericLinearFunction<T>::matrix_t a;
+  a = dense.sparseView ();
+  typename GenericNumericLinearFunction<T>::vector_t b (4);
+  b << 1., 2., 3., 4.;
+  boost::shared_ptr<function_t> linear =
+    boost::make_shared<GenericNumericLinearFunction<T> > (a, b);
+  boost::shared_ptr<selection_t> linear_fct = selection (linear, 1, 2);
+
+  argument_t y (3);
+  y << 1., -1., 2.;
+  BOOST_CHECK (allclose ((*linear_fct) (y), (*linear) (y).segment (1, 2)));
+  BOOST_CHECK (allclose (toDense (linear_fct->jacobian (y)),
+			 dense.middleRows (1, 2)));
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
@@ -19,10 +19,14 @@
 
 #include "shared-tests/fixture.hh"
 
+#include <algorithm>
 #include <iostream>
 
 #include <roboptim/core/io.hh>
 #include <roboptim/core/differentiable-function.hh>
+#include <roboptim/core/numeric-linear-function.hh>
+#include <roboptim/core/problem.hh>
+#include <roboptim/core/function/constant.hh>
 #include <roboptim/core/util.hh>
 #include <roboptim/core/operator/split.hh>
 
@@ -48,6 +52,52 @@ struct F : public DifferentiableFunction
   }
 };
 
+// Count the evaluations of f_n (x) = s * (n + 1) * x_0 * x_1, where the
+// value of s can be changed between evaluations.
+struct G : public TwiceDifferentiableFunction
+{
+  G () : TwiceDifferentiableFunction (2, 6, "f_n (x) = (n + 1) * x_0 * x_1"),
+	 computeCount (0),
+	 jacobianCount (0),
+	 hessianCount (0),
+	 scale (1.)
+  {}
+
+  void impl_compute (result_ref res, const_argument_ref x) const
+  {
+    ++computeCount;
+    for (size_type i = 0; i < outputSize (); ++i)
+      res[i] = scale * static_cast<value_type> (i + 1) * x[0] * x[1];
+  }
+
+  void impl_gradient (gradient_ref grad, const_argument_ref x,
+		      size_type functionId) const
+  {
+    grad[0] = static_cast<value_type> (functionId + 1) * x[1];
+    grad[1] = static_cast<value_type> (functionId + 1) * x[0];
+  }
+
+  void impl_jacobian (jacobian_ref jac, const_argument_ref x) const
+  {
+    ++jacobianCount;
+    for (size_type i = 0; i < outputSize (); ++i)
+      impl_gradient (jac.row (i), x, i);
+  }
+
+  void impl_hessian (hessian_ref h, const_argument_ref,
+		     size_type functionId) const
+  {
+    ++hessianCount;
+    h.setZero ();
+    h (0, 1) = h (1, 0) = static_cast<value_type> (functionId + 1);
+  }
+
+  mutable int computeCount;
+  mutable int jacobianCount;
+  mutable int hessianCount;
+  value_type scale;
+};
+
 BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
 
 BOOST_AUTO_TEST_CASE (split)
@@ -79,4 +129,175 @@ BOOST_AUTO_TEST_CASE (split)
   BOOST_CHECK (output->match_pattern ());
 }
 
+BOOST_AUTO_TEST_CASE (split_rows)
+{
+  // Numeric linear functions only evaluate the split output.
+  NumericLinearFunction::matrix_t a (3, 2);
+  a <<
+    1., 2.,
+    3., 4.,
+    5., 6.;
+  NumericLinearFunction::vector_t b (3);
+  b << 1., 0., -1.;
+  boost::shared_ptr<NumericLinearFunction> linear
+    (new NumericLinearFunction (a, b));
+
+  Function::vector_t x (2);
+  x << 1., -2.;
+  for (Function::size_type id = 0; id < 3; ++id)
+    {
+      Split<DifferentiableFunction> splitF (linear, id);
+      BOOST_CHECK_CLOSE (splitF (x)[0], (*linear) (x)[id], 1e-8);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (split_shared_evaluation)
+{
+  boost::shared_ptr<G> g (new G ());
+  std::vector<boost::shared_ptr<Split<TwiceDifferentiableFunction> > >
+    splits = roboptim::split<TwiceDifferentiableFunction> (g, true);
+  BOOST_CHECK_EQUAL (splits.size (), 6);
+
+  Function::vector_t x (2);
+  x << 2., -3.;
+  Function::vector_t res (1);
+  TwiceDifferentiableFunction::gradient_t grad (2);
+  TwiceDifferentiableFunction::hessian_t h (2, 2);
+
+  // The function is evaluated once for all the outputs.
+  for (std::size_t i = 0; i < splits.size (); ++i)
+    {
+      const Function::value_type n = static_cast<Function::value_type> (i + 1);
+
+      (*splits[i]) (res, x);
+      BOOST_CHECK_CLOSE (res[0], n * x[0] * x[1], 1e-8);
+
+      grad.setZero ();
+      splits[i]->gradient (grad, x, 0);
+      BOOST_CHECK_CLOSE (grad[0], n * x[1], 1e-8);
+      BOOST_CHECK_CLOSE (grad[1], n * x[0], 1e-8);
+
+      h.setZero ();
+      splits[i]->hessian (h, x, 0);
+      BOOST_CHECK_CLOSE (h (0, 1), n, 1e-8);
+    }
+  BOOST_CHECK_EQUAL (g->computeCount, 1);
+  BOOST_CHECK_EQUAL (g->jacobianCount, 1);
+  BOOST_CHECK_EQUAL (g->hessianCount, 6);
+
+  // Same point: nothing is evaluated.
+  (*splits[3]) (res, x);
+  splits[3]->hessian (h, x, 0);
+  BOOST_CHECK_EQUAL (g->computeCount, 1);
+  BOOST_CHECK_EQUAL (g->hessianCount, 6);
+
+  // New point.
+  x[1] = 1.;
+  (*splits[0]) (res, x);
+  (*splits[5]) (res, x);
+  BOOST_CHECK_CLOSE (res[0], 12., 1e-8);
+  BOOST_CHECK_EQUAL (g->computeCount, 2);
+
+  // Forget the evaluations.
+  splits[0]->evaluation ()->reset ();
+  (*splits[1]) (res, x);
+  BOOST_CHECK_EQUAL (g->computeCount, 3);
+
+  // Scalar constraints of a problem share the evaluations.
+  Function::vector_t v (2);
+  v.setZero ();
+  Problem<EigenMatrixDense> pb (boost::make_shared<ConstantFunction> (v));
+  addNonScalarConstraint
+    (pb, boost::static_pointer_cast<TwiceDifferentiableFunction> (g),
+     std::vector<Function::interval_t>
+     (6, Function::makeInfiniteInterval ()),
+     std::vector<Function::value_type> (), true);
+  BOOST_CHECK_EQUAL (pb.constraints ().size (), 6);
+
+  Function::vector_t constraints (6);
+  pb.evaluateConstraints (constraints, x);
+  BOOST_CHECK_CLOSE (constraints[4], 10., 1e-8);
+  BOOST_CHECK_EQUAL (g->computeCount, 4);
+
+  // The shared record is part of the evaluation state of the operators.
+  std::vector<const void*> objects;
+  splits[0]->evaluationState (objects);
+  BOOST_CHECK (std::find (objects.begin (), objects.end (),
+			  splits[0]->evaluation ().get ()) != objects.end ());
+
+  // The scalar constraints are evaluated sequentially.
+  pb.evaluationThreads () = 4;
+  BOOST_CHECK_EQUAL (pb.parallelThreads (), 1);
+
+  x << -1., 2.;
+  pb.evaluateConstraints (constraints, x);
+  Problem<EigenMatrixDense>::jacobian_t jac = pb.jacobian (x);
+  for (int i = 0; i < 6; ++i)
+    {
+      const Function::value_type n = static_cast<Function::value_type> (i + 1);
+
+      BOOST_CHECK_CLOSE (constraints[i], n * x[0] * x[1], 1e-8);
+      BOOST_CHECK_CLOSE (jac (i, 0), n * x[1], 1e-8);
+      BOOST_CHECK_CLOSE (jac (i, 1), n * x[0], 1e-8);
+    }
+  BOOST_CHECK_EQUAL (g->computeCount, 5);
+  BOOST_CHECK_EQUAL (g->jacobianCount, 2);
+}
+
+BOOST_AUTO_TEST_CASE (split_shared_evaluation_toggle)
+{
+  typedef Split<TwiceDifferentiableFunction> split_t;
+
+  boost::shared_ptr<G> g (new G ());
+  Function::vector_t x (2);
+  x << 2., -3.;
+  Function::vector_t res (1);
+
+  // By default, each Split operator evaluates the function.
+  std::vector<boost::shared_ptr<split_t> >
+    splits = roboptim::split<TwiceDifferentiableFunction> (g);
+  for (std::size_t i = 0; i < splits.size (); ++i)
+    {
+      BOOST_CHECK (!splits[i]->evaluation ());
+      (*splits[i]) (res, x);
+    }
+  BOOST_CHECK_EQUAL (g->computeCount, 6);
+
+  // A change of the function is seen at the same point.
+  g->scale = 2.;
+  (*splits[0]) (res, x);
+  BOOST_CHECK_CLOSE (res[0], -12., 1e-8);
+
+  // Shared evaluations return the recorded result until they are reset.
+  std::vector<boost::shared_ptr<split_t> >
+    shared = roboptim::split<TwiceDifferentiableFunction> (g, true);
+  (*shared[0]) (res, x);
+  BOOST_CHECK_CLOSE (res[0], -12., 1e-8);
+  g->scale = 1.;
+  (*shared[0]) (res, x);
+  BOOST_CHECK_CLOSE (res[0], -12., 1e-8);
+  shared[0]->evaluation ()->reset ();
+  (*shared[0]) (res, x);
+  BOOST_CHECK_CLOSE (res[0], -6., 1e-8);
+
+  // Scalar constraints of a problem are independent by default.
+  Function::vector_t v (2);
+  v.setZero ();
+  Problem<EigenMatrixDense> pb (boost::make_shared<ConstantFunction> (v));
+  addNonScalarConstraint
+    (pb, boost::static_pointer_cast<TwiceDifferentiableFunction> (g),
+     std::vector<Function::interval_t>
+     (6, Function::makeInfiniteInterval ()));
+  BOOST_CHECK_EQUAL (pb.constraints ().size (), 6);
+  for (std::size_t i = 0; i < pb.constraints ().size (); ++i)
+    BOOST_CHECK (!boost::dynamic_pointer_cast<split_t>
+		 (pb.constraints ()[i])->evaluation ());
+
+  Function::vector_t constraints (6);
+  g->scale = 3.;
+  pb.evaluateConstraints (constraints, x);
+  for (int i = 0; i < 6; ++i)
+    BOOST_CHECK_CLOSE (constraints[i], -18. * (i + 1), 1e-8);
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,154 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "shared-tests/fixture.hh"
+
+#include <iostream>
+
+#include <boost/make_shared.hpp>
+
+#include <roboptim/core/io.hh>
+#include <roboptim/core/operator/stack.hh>
+#include <roboptim/core/numeric-linear-function.hh>
+#include <roboptim/core/numeric-quadratic-function.hh>
+
+using namespace roboptim;
+
+typedef boost::mpl::list< ::roboptim::EigenMatrixDense,
+			  ::roboptim::EigenMatrixSparse> functionTypes_t;
+
+inline const double*
+valuePtr (const GenericFunctionTraits<EigenMatrixDense>::matrix_t& m)
+{
+  return m.data ();
+}
+
+inline const double*
+valuePtr (const GenericFunctionTraits<EigenMatrixSparse>::matrix_t& m)
+{
+  return m.valuePtr ();
+}
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (stack_test, T, functionTypes_t)
+{
+  typedef GenericDifferentiableFunction<T> function_t;
+  typedef GenericNumericLinearFunction<T> linear_t;
+  typedef GenericNumericQuadraticFunction<T> quadratic_t;
+  typedef Stack<function_t> stack_t;
+  typedef typename stack_t::argument_t argument_t;
+  typedef typename stack_t::result_t result_t;
+  typedef typename stack_t::jacobian_t jacobian_t;
+  typedef typename stack_t::size_type size_type;
+
+  Eigen::MatrixXd dense (2, 3);
+  dense <<
+    1., 0., 2.,
+    0., 3., 0.;
+  typename linear_t::matrix_t a;
+  a = dense.sparseView ();
+  typename linear_t::vector_t b (2);
+  b << 1., -1.;
+
+  typename quadratic_t::matrix_t q (3, 3);
+  q.setIdentity ();
+  typename quadratic_t::vector_t c (3);
+  c << 0., 1., 0.;
+
+  dense.resize (3, 3);
+  dense <<
+    0., 0., 1.,
+    1., 1., 0.,
+    0., 0., 4.;
+  typename linear_t::matrix_t a2;
+  a2 = dense.sparseView ();
+  typename linear_t::vector_t b2 (3);
+  b2.setZero ();
+
+  typename stack_t::functions_t functions;
+  functions.push_back (boost::make_shared<linear_t> (a, b, "f0"));
+  functions.push_back (boost::make_shared<quadratic_t> (q, c, "f1"));
+  functions.push_back (boost::make_shared<linear_t> (a2, b2, "f2"));
+
+  boost::shared_ptr<stack_t> fct = stack (functions);
+  std::cout << *fct << std::endl;
+
+  BOOST_CHECK_EQUAL (fct->inputSize (), 3);
+  BOOST_CHECK_EQUAL (fct->outputSize (), 6);
+  BOOST_CHECK_EQUAL (fct->getName (), "stack(f0, f1, f2)");
+
+  argument_t x (3);
+  x << 1., 2., 3.;
+
+  // Each function is evaluated in its segment.
+  result_t res = (*fct) (x);
+  size_type row = 0;
+  for (std::size_t i = 0; i < functions.size (); ++i)
+    {
+      const function_t& f = *functions[i];
+      BOOST_CHECK (allclose (res.segment (row, f.outputSize ()), f (x)));
+      row += f.outputSize ();
+    }
+
+  // Jacobian and gradients.
+  jacobian_t jac = fct->jacobian (x);
+  row = 0;
+  for (std::size_t i = 0; i < functions.size (); ++i)
+    {
+      const function_t& f = *functions[i];
+      BOOST_CHECK (allclose (toDense (jac).middleRows (row, f.outputSize ()),
+			     toDense (f.jacobian (x))));
+      for (size_type j = 0; j < f.outputSize (); ++j)
+	BOOST_CHECK (allclose (toDense (fct->gradient (x, row + j)),
+			       toDense (f.gradient (x, j))));
+      row += f.outputSize ();
+    }
+
+  // Later evaluations write into the same matrix.
+  const double* values = valuePtr (jac);
+  x << -1., .5, 2.;
+  fct->jacobian (jac, x);
+  BOOST_CHECK_EQUAL (values, valuePtr (jac));
+  BOOST_CHECK (allclose (toDense (jac).middleRows (2, 1),
+			 toDense (functions[1]->jacobian (x))));
+
+  // Parallel evaluation.
+  boost::shared_ptr<stack_t> parallel_fct = stack (functions);
+  parallel_fct->evaluationThreads () = 4;
+  BOOST_CHECK (allclose ((*parallel_fct) (x), (*fct) (x)));
+  BOOST_CHECK (allclose (toDense (parallel_fct->jacobian (x)),
+			 toDense (jac)));
+
+  // A function stacked twice is supported (sequential evaluation).
+  functions.push_back (functions[0]);
+  boost::shared_ptr<stack_t> duplicate_fct = stack (functions);
+  duplicate_fct->evaluationThreads () = 4;
+  result_t duplicate_res = (*duplicate_fct) (x);
+  BOOST_CHECK (allclose (duplicate_res.head (6), (*fct) (x)));
+  BOOST_CHECK (allclose (duplicate_res.tail (2), (*functions[0]) (x)));
+
+  // Invalid stacks.
+  functions.push_back (boost::make_shared<linear_t>
+		       (typename linear_t::matrix_t (1, 2),
+			typename linear_t::vector_t (1)));
+  BOOST_CHECK_THROW (stack (functions), std::runtime_error);
+  BOOST_CHECK_THROW (stack (typename stack_t::functions_t ()),
+		     std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
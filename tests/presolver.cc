@@ -0,0 +1,242 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "shared-tests/fixture.hh"
+
+#include <boost/make_shared.hpp>
+
+#include <roboptim/core/io.hh>
+#include <roboptim/core/presolver.hh>
+#include <roboptim/core/function/identity.hh>
+#include <roboptim/core/numeric-linear-function.hh>
+#include <roboptim/core/numeric-quadratic-function.hh>
+
+using namespace roboptim;
+
+typedef boost::mpl::list< ::roboptim::EigenMatrixDense,
+			  ::roboptim::EigenMatrixSparse> functionTypes_t;
+
+template <typename T>
+boost::shared_ptr<Problem<T> > buildProblem ()
+{
+  typedef Problem<T> problem_t;
+  typedef typename problem_t::intervals_t intervals_t;
+  typedef typename problem_t::scaling_t scaling_t;
+  typedef GenericNumericQuadraticFunction<T> quadratic_t;
+  typedef GenericNumericLinearFunction<T> linear_t;
+  typedef GenericIdentityFunction<T> identity_t;
+
+  const Function::value_type inf = Function::infinity ();
+
+  // f (x) = x^T x + 1^T x
+  typename quadratic_t::matrix_t a (4, 4);
+  a.setIdentity ();
+  typename quadratic_t::vector_t b (4);
+  b.setOnes ();
+
+  boost::shared_ptr<problem_t> pb = boost::make_shared<problem_t>
+    (boost::make_shared<quadratic_t> (a, b, "cost"));
+
+  pb->argumentBounds ()[0] = Function::makeInterval (1., 1.);
+  pb->argumentBounds ()[1] = Function::makeInterval (-5., 5.);
+  pb->argumentBounds ()[2] = Function::makeInterval (-5., 5.);
+  pb->argumentBounds ()[3] = Function::makeInterval (-5., 3.);
+  pb->argumentNames ().push_back ("x0");
+  pb->argumentNames ().push_back ("x1");
+  pb->argumentNames ().push_back ("x2");
+  pb->argumentNames ().push_back ("x3");
+
+  typename problem_t::argument_t x0 (4);
+  x0 << 1., 0., 2., 0.;
+  pb->startingPoint () = x0;
+
+  // Row 0: implied by the bounds once rows 1 and 2 are applied.
+  // Row 1: singleton.
+  // Row 2: singleton once x0 is removed.
+  // Rows 3 and 4: duplicates.
+  Eigen::MatrixXd dense (5, 4);
+  dense <<
+    0., 1., 1., 1.,
+    0., 2., 0., 0.,
+    1., 0., 1., 0.,
+    0., 0., 2., 2.,
+    0., 0., 1., 1.;
+  typename linear_t::matrix_t l;
+  l = dense.sparseView ();
+  typename linear_t::vector_t lb (5);
+  lb.setZero ();
+
+  intervals_t bounds;
+  bounds.push_back (Function::makeInterval (-inf, 10.));
+  bounds.push_back (Function::makeInterval (0., 4.));
+  bounds.push_back (Function::makeInterval (2., 5.));
+  bounds.push_back (Function::makeInterval (-4., 6.));
+  bounds.push_back (Function::makeInterval (-1., 2.));
+  pb->addConstraint (boost::make_shared<linear_t> (l, lb, "linear"),
+		     bounds, scaling_t (5, 1.));
+
+  typename identity_t::vector_t offset (4);
+  offset.setZero ();
+  pb->addConstraint (boost::make_shared<identity_t> (offset),
+		     intervals_t (4, Function::makeInfiniteInterval ()),
+		     scaling_t (4, 1.));
+
+  return pb;
+}
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (presolver, T, functionTypes_t)
+{
+  typedef Problem<T> problem_t;
+  typedef typename problem_t::argument_t argument_t;
+  typedef typename problem_t::result_t result_t;
+
+  boost::shared_ptr<problem_t> pb = buildProblem<T> ();
+  Presolver<T> presolver (*pb);
+  const problem_t& reduced = *presolver.problem ();
+
+  std::cout << presolver << std::endl;
+
+  BOOST_CHECK_EQUAL (presolver.removedVariables (), 1);
+  BOOST_CHECK_EQUAL (presolver.removedRows (), 4);
+  BOOST_CHECK_EQUAL (reduced.function ().inputSize (), 3);
+  BOOST_REQUIRE_EQUAL (reduced.constraints ().size (), 2);
+  BOOST_CHECK_EQUAL (reduced.constraintsOutputSize (), 5);
+
+  // Tightened argument bounds.
+  argument_t lower (3);
+  argument_t upper (3);
+  lower << 0., 1., -5.;
+  upper << 2., 4., 3.;
+  BOOST_CHECK (allclose (reduced.argumentLowerBounds (), lower));
+  BOOST_CHECK (allclose (reduced.argumentUpperBounds (), upper));
+  BOOST_REQUIRE_EQUAL (reduced.argumentNames ().size (), 3);
+  BOOST_CHECK_EQUAL (reduced.argumentNames ()[0], "x1");
+  BOOST_REQUIRE (reduced.startingPoint ());
+  BOOST_CHECK_CLOSE ((*reduced.startingPoint ())[1], 2., 1e-8);
+
+  // Merged duplicate rows.
+  BOOST_CHECK_CLOSE (reduced.constraintsLowerBounds ()[0], -2., 1e-8);
+  BOOST_CHECK_CLOSE (reduced.constraintsUpperBounds ()[0], 4., 1e-8);
+
+  // The reduced functions match the input ones.
+  argument_t y (3);
+  y << 2., 1., .5;
+  argument_t x (4);
+  x << 1., 2., 1., .5;
+  BOOST_CHECK (allclose (reduced.function () (y), pb->function () (x)));
+
+  result_t g (5);
+  reduced.evaluateConstraints (g, y);
+  result_t expected (5);
+  expected << 3., 1., 2., 1., .5;
+  BOOST_CHECK (allclose (g, expected));
+
+  // Postsolve.
+  Result r (3, 1);
+  r.x = y;
+  r.value = reduced.function () (y);
+  r.lambda.resize (8);
+  r.lambda << .4, -.6, .3, .8, .1, .2, .3, .4;
+
+  Result res = presolver.postsolve (r);
+  BOOST_CHECK (allclose (res.x, x));
+  BOOST_CHECK (allclose (res.value, r.value));
+
+  result_t constraints (9);
+  constraints << 3.5, 4., 2., 3., 1.5, 1., 2., 1., .5;
+  BOOST_CHECK (allclose (res.constraints, constraints));
+
+  // Bound multipliers of x1 and x2 go to rows 1 and 2, the multiplier of
+  // the merged row goes to row 4 (active upper bound), and the multiplier
+  // of the fixed variable follows from the stationarity condition.
+  Function::vector_t lambda (13);
+  lambda << -2.5, 0., 0., .3, 0., .2, -.6, 0., 1.6, .1, .2, .3, .4;
+  BOOST_CHECK (allclose (res.lambda, lambda));
+
+  // Wrong result size.
+  Result wrong (4, 1);
+  BOOST_CHECK_THROW (presolver.postsolve (wrong), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (presolver_quadratic_upper, T, functionTypes_t)
+{
+  typedef Problem<T> problem_t;
+  typedef typename problem_t::argument_t argument_t;
+  typedef GenericNumericQuadraticFunction<T> quadratic_t;
+
+  // Upper triangle of a symmetric matrix, and a stray coefficient in the
+  // lower triangle that must be ignored.
+  Eigen::MatrixXd upper (3, 3);
+  upper <<
+    1., 1., .5,
+    0., 2., -1.,
+    7., 0., 3.;
+  typename quadratic_t::matrix_t a;
+  a = upper.sparseView ();
+  typename quadratic_t::vector_t b (3);
+  b << 1., -1., 2.;
+
+  problem_t pb (boost::make_shared<quadratic_t> (a, b, "cost"));
+  pb.argumentBounds ()[1] = Function::makeInterval (2., 2.);
+
+  Presolver<T> presolver (pb);
+  const problem_t& reduced = *presolver.problem ();
+  BOOST_CHECK_EQUAL (presolver.removedVariables (), 1);
+  BOOST_REQUIRE_EQUAL (reduced.function ().inputSize (), 2);
+
+  argument_t y (2);
+  y << .5, -1.;
+  argument_t x (3);
+  x << .5, 2., -1.;
+  Eigen::MatrixXd dense = upper.triangularView<Eigen::Upper> ();
+  dense.triangularView<Eigen::StrictlyLower> () =
+    dense.transpose ().triangularView<Eigen::StrictlyLower> ();
+  BOOST_CHECK_CLOSE (pb.function () (x)[0], x.dot (dense * x) + b.dot (x),
+		     1e-8);
+  BOOST_CHECK (allclose (reduced.function () (y), pb.function () (x)));
+
+  // The reduced matrix only stores an upper triangle.
+  const quadratic_t* q =
+    reduced.function ().template castInto<quadratic_t> ();
+  Eigen::MatrixXd ra = toDense (q->A ());
+  BOOST_CHECK_EQUAL (ra (1, 0), 0.);
+  BOOST_CHECK_CLOSE (ra (0, 1), .5, 1e-8);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (presolver_infeasible, T, functionTypes_t)
+{
+  typedef Problem<T> problem_t;
+  typedef GenericNumericLinearFunction<T> linear_t;
+
+  boost::shared_ptr<problem_t> pb = buildProblem<T> ();
+
+  // x0 is fixed to 1.
+  Eigen::MatrixXd dense (1, 4);
+  dense << 1., 0., 0., 0.;
+  typename linear_t::matrix_t l;
+  l = dense.sparseView ();
+  typename linear_t::vector_t lb (1);
+  lb.setZero ();
+  pb->addConstraint (boost::make_shared<linear_t> (l, lb),
+		     Function::makeInterval (2., 3.));
+
+  BOOST_CHECK_THROW (Presolver<T> presolver (*pb), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
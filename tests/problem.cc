@@ -23,8 +23,12 @@
 #include <roboptim/core/util.hh>
 #include <roboptim/core/portability.hh>
 #include <roboptim/core/problem.hh>
+#include <roboptim/core/solver.hh>
 #include <roboptim/core/function/constant.hh>
+#include <roboptim/core/linear-function.hh>
 #include <roboptim/core/numeric-linear-function.hh>
+#include <roboptim/core/operator/selection.hh>
+#include <roboptim/core/detail/parallel.hh>
 
 using namespace roboptim;
 
@@ -52,6 +56,145 @@ struct F : public GenericFunction<T>
 };
 
 
+// Non-differentiable function of size 3.
+template <typename T>
+struct G : public GenericFunction<T>
+{
+  ROBOPTIM_FUNCTION_FWD_TYPEDEFS_ (GenericFunction<T>);
+
+  G () : GenericFunction<T> (3, 2, "a * b, b + c")
+  {}
+
+  void impl_compute (result_ref res, const_argument_ref x) const
+  {
+    res (0) = x[0] * x[1];
+    res (1) = x[1] + x[2];
+  }
+};
+
+// Exception that does not derive from std::exception.
+struct Failure
+{};
+
+// Function throwing when evaluated.
+template <typename T>
+struct Throwing : public GenericFunction<T>
+{
+  ROBOPTIM_FUNCTION_FWD_TYPEDEFS_ (GenericFunction<T>);
+
+  Throwing () : GenericFunction<T> (3, 1, "throwing")
+  {}
+
+  void impl_compute (result_ref, const_argument_ref) const
+  {
+    throw Failure ();
+  }
+};
+
+// Linear function counting the evaluations of its Jacobian.
+template <typename T>
+struct CountingLinear : public GenericLinearFunction<T>
+{
+  ROBOPTIM_TWICE_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_
+  (GenericLinearFunction<T>);
+
+  CountingLinear () : GenericLinearFunction<T> (3, 1, "a + 2 c"), count (0)
+  {}
+
+  void impl_compute (result_ref res, const_argument_ref x) const
+  {
+    res[0] = x[0] + 2. * x[2];
+  }
+
+  void impl_gradient (gradient_ref grad, const_argument_ref,
+                      size_type) const
+  {
+    ++count;
+    grad.coeffRef (0) = 1.;
+    grad.coeffRef (2) = 2.;
+  }
+
+  mutable int count;
+};
+
+// Nonlinear differentiable function.
+template <typename T>
+struct Nonlinear : public GenericDifferentiableFunction<T>
+{
+  ROBOPTIM_DIFFERENTIABLE_FUNCTION_FWD_TYPEDEFS_
+  (GenericDifferentiableFunction<T>);
+
+  Nonlinear () : GenericDifferentiableFunction<T> (3, 1, "a * b")
+  {}
+
+  void impl_compute (result_ref res, const_argument_ref x) const
+  {
+    res[0] = x[0] * x[1];
+  }
+
+  void impl_gradient (gradient_ref grad, const_argument_ref x,
+                      size_type) const
+  {
+    grad.coeffRef (0) = x[1];
+    grad.coeffRef (1) = x[0];
+  }
+};
+
+// Solver doing nothing, used to check the problem it stores.
+template <typename T>
+struct NullSolver : public Solver<T>
+{
+  explicit NullSolver (const Problem<T>& pb) : Solver<T> (pb)
+  {}
+
+  void solve ()
+  {}
+};
+
+// Build a problem with two linear constraints and one
+// non-differentiable constraint.
+template <typename T>
+boost::shared_ptr<Problem<T> > makeJacobianProblem ()
+{
+  typedef Problem<T> problem_t;
+  typedef typename problem_t::intervals_t intervals_t;
+  typedef typename problem_t::scaling_t scaling_t;
+
+  typedef GenericConstantFunction<T>          constantFunction_t;
+  typedef GenericNumericLinearFunction<T>     numericLinearFunction_t;
+
+  typename constantFunction_t::vector_t v (3);
+  v.setZero ();
+  boost::shared_ptr<problem_t> pb = boost::make_shared<problem_t>
+    (boost::make_shared<constantFunction_t> (v));
+
+  typename numericLinearFunction_t::matrix_t a (2, 3);
+  typename numericLinearFunction_t::vector_t b (2);
+  a.setZero ();
+  a.coeffRef (0, 0) = 1.;
+  a.coeffRef (0, 2) = 2.;
+  a.coeffRef (1, 1) = 3.;
+  b << 1., 2.;
+  pb->addConstraint (boost::make_shared<numericLinearFunction_t> (a, b),
+                     intervals_t (2, Function::makeInfiniteInterval ()),
+                     scaling_t (2, 2.));
+
+  pb->addConstraint (boost::make_shared<G<T> > (),
+                     intervals_t (2, Function::makeInfiniteInterval ()),
+                     scaling_t (2, 1.));
+
+  a.setZero ();
+  a.coeffRef (0, 1) = -4.;
+  a.coeffRef (1, 0) = 5.;
+  a.coeffRef (1, 2) = 6.;
+  pb->addConstraint (boost::make_shared<numericLinearFunction_t> (a, b),
+                     intervals_t (2, Function::makeInfiniteInterval ()),
+                     scaling_t (2, 0.5));
+
+  pb->argumentScaling ()[1] = 10.;
+  return pb;
+}
+
 BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
 
 BOOST_AUTO_TEST_CASE_TEMPLATE (problem, T, functionTypes_t)
@@ -263,4 +406,402 @@ BOOST_AUTO_TEST_CASE_TEMPLATE (problem, T, functionTypes_t)
   BOOST_CHECK (output->match_pattern ());
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE (problem_jacobian_in_place, T, functionTypes_t)
+{
+  typedef Problem<T> problem_t;
+  typedef typename problem_t::jacobian_t jacobian_t;
+  typedef typename problem_t::argument_t argument_t;
+
+  boost::shared_ptr<problem_t> pb = makeJacobianProblem<T> ();
+
+  argument_t x (3);
+  x << 1., 2., 3.;
+
+  jacobian_t jac (4, 3);
+  jac.setZero ();
+
+  // First call computes the structure, second call reuses it.
+  for (int i = 0; i < 2; ++i)
+    {
+      pb->jacobian (jac, x);
+      BOOST_CHECK (allclose (jac, pb->jacobian (x)));
+      pb->scaledJacobian (jac, x);
+      BOOST_CHECK (allclose (jac, pb->scaledJacobian (x)));
+    }
+
+  // Evaluation at a different point.
+  x << -1., 0.5, 4.;
+  pb->scaledJacobian (jac, x);
+  BOOST_CHECK (allclose (jac, pb->scaledJacobian (x)));
+}
+
+BOOST_AUTO_TEST_CASE (problem_jacobian_structure)
+{
+  typedef Problem<EigenMatrixSparse> problem_t;
+  typedef problem_t::jacobian_t jacobian_t;
+  typedef problem_t::argument_t argument_t;
+  typedef JacobianStructure::indices_t indices_t;
+
+  boost::shared_ptr<problem_t> pb = makeJacobianProblem<EigenMatrixSparse> ();
+
+  argument_t x (3);
+  x << 1., 2., 3.;
+
+  jacobian_t jac;
+  pb->scaledJacobian (jac, x);
+  GenericFunctionTraits<EigenMatrixDense>::matrix_t
+    dense = toDense (pb->scaledJacobian (x));
+
+  const JacobianStructure& s = pb->jacobianStructure ();
+  BOOST_CHECK_EQUAL (s.rows (), 4);
+  BOOST_CHECK_EQUAL (s.cols (), 3);
+  BOOST_CHECK_EQUAL (s.nonZeros (), 6);
+  BOOST_CHECK (s.matches (jac));
+
+  // COO layout follows the values array.
+  const indices_t& rows = s.cooRows ();
+  const indices_t& cols = s.cooCols ();
+  for (std::size_t k = 0; k < rows.size (); ++k)
+    BOOST_CHECK_EQUAL (dense (rows[k], cols[k]), jac.valuePtr ()[k]);
+
+  // CSR layout.
+  std::vector<double> csr (static_cast<std::size_t> (s.nonZeros ()));
+  s.csrValues (jac, &csr[0]);
+  BOOST_CHECK_EQUAL (s.csrRowPointers ().size (), 5);
+  for (std::size_t r = 0; r < 4; ++r)
+    for (int k = s.csrRowPointers ()[r]; k < s.csrRowPointers ()[r + 1]; ++k)
+      {
+        std::size_t k_ = static_cast<std::size_t> (k);
+        BOOST_CHECK_EQUAL (dense (static_cast<int> (r), s.csrCols ()[k_]),
+                           csr[k_]);
+        if (k > s.csrRowPointers ()[r])
+          BOOST_CHECK (s.csrCols ()[k_ - 1] < s.csrCols ()[k_]);
+      }
+
+  // Index arrays and values array are stable between calls.
+  const int* rowsPtr = &rows[0];
+  const double* valuesPtr = jac.valuePtr ();
+  x << -1., 0.5, 4.;
+  pb->scaledJacobian (jac, x);
+  BOOST_CHECK_EQUAL (&pb->jacobianStructure ().cooRows ()[0], rowsPtr);
+  BOOST_CHECK_EQUAL (jac.valuePtr (), valuesPtr);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (problem_parallel_evaluation, T, functionTypes_t)
+{
+  typedef Problem<T> problem_t;
+  typedef typename problem_t::intervals_t intervals_t;
+  typedef typename problem_t::scaling_t scaling_t;
+  typedef typename problem_t::jacobian_t jacobian_t;
+  typedef typename problem_t::argument_t argument_t;
+  typedef typename problem_t::result_t result_t;
+
+  typedef GenericConstantFunction<T>          constantFunction_t;
+  typedef GenericNumericLinearFunction<T>     numericLinearFunction_t;
+
+  const typename problem_t::size_type n = 3;
+  typename constantFunction_t::vector_t v (n);
+  v.setZero ();
+  problem_t pb (boost::make_shared<constantFunction_t> (v));
+
+  // Many independent constraints, some of them non-differentiable.
+  for (int i = 0; i < 50; ++i)
+    {
+      typename numericLinearFunction_t::matrix_t a (3, n);
+      typename numericLinearFunction_t::vector_t b (3);
+      a.setZero ();
+      for (int k = 0; k < 3; ++k)
+        a.coeffRef (k, (i + k) % n) = 1. + i + k;
+      b << i, -i, 0.;
+
+      intervals_t bounds (3, Function::makeInterval (-1., 1.));
+      pb.addConstraint (boost::make_shared<numericLinearFunction_t> (a, b),
+                        bounds, scaling_t (3, 1.));
+      if (i % 10 == 0)
+        pb.addConstraint (boost::make_shared<G<T> > (),
+                          intervals_t (2, Function::makeInterval (0., 1.)),
+                          scaling_t (2, 1.));
+    }
+
+  BOOST_CHECK_EQUAL (pb.evaluationThreads (), 1);
+
+  argument_t x (n);
+  x << 0.1, -0.2, 0.3;
+
+  result_t values (pb.constraintsOutputSize ());
+  pb.evaluateConstraints (values, x);
+  jacobian_t jac = pb.jacobian (x);
+  result_t violations = pb.constraintsViolationVector (x);
+
+  // Check the stacked values.
+  typename problem_t::size_type row = 0;
+  for (typename problem_t::constraints_t::const_iterator
+         c = pb.constraints ().begin (); c != pb.constraints ().end (); ++c)
+    {
+      BOOST_CHECK (allclose (values.segment (row, (*c)->outputSize ()),
+                             (**c) (x)));
+      row += (*c)->outputSize ();
+    }
+
+  // The output does not depend on the number of threads.
+  pb.evaluationThreads () = 4;
+  BOOST_CHECK_EQUAL (pb.evaluationThreads (), 4);
+  for (int i = 0; i < 3; ++i)
+    {
+      result_t values_ (pb.constraintsOutputSize ());
+      pb.evaluateConstraints (values_, x);
+      BOOST_CHECK_EQUAL (values_, values);
+      BOOST_CHECK (allclose (pb.jacobian (x), jac, 0., 0.));
+      BOOST_CHECK_EQUAL (pb.constraintsViolationVector (x), violations);
+    }
+
+  BOOST_CHECK_EQUAL (pb.parallelThreads (),
+                     detail::has_parallel_support () ? 4 : 1);
+
+  // Copies keep the number of threads.
+  problem_t pb_copy (pb);
+  BOOST_CHECK_EQUAL (pb_copy.evaluationThreads (), 4);
+
+  // Views of the same function share its buffers, so they are evaluated
+  // sequentially.
+  problem_t pb_views (pb);
+  boost::shared_ptr<GenericDifferentiableFunction<T> >
+    g = boost::make_shared<Nonlinear<T> > ();
+  pb_views.addConstraint (selection (g, 0, 1),
+                          intervals_t (1, Function::makeInterval (0., 1.)),
+                          scaling_t (1, 1.));
+  pb_views.addConstraint (selection (g, 0, 1),
+                          intervals_t (1, Function::makeInterval (0., 1.)),
+                          scaling_t (1, 1.));
+  BOOST_CHECK_EQUAL (pb_views.parallelThreads (), 1);
+  result_t values_views (pb_views.constraintsOutputSize ());
+  pb_views.evaluateConstraints (values_views, x);
+  BOOST_CHECK_EQUAL (values_views.tail (2),
+                     result_t::Constant (2, (*g) (x)[0]));
+
+  // Any exception thrown by a constraint is propagated.
+  problem_t pb_throwing (pb);
+  pb_throwing.addConstraint (boost::make_shared<Throwing<T> > (),
+                             intervals_t (1, Function::makeInterval (0., 1.)),
+                             scaling_t (1, 1.));
+  bool failed = false;
+  try
+    {
+      result_t values_throwing (pb_throwing.constraintsOutputSize ());
+      pb_throwing.evaluateConstraints (values_throwing, x);
+    }
+  catch (...)
+    {
+      failed = true;
+    }
+  BOOST_CHECK (failed);
+
+  // A constraint added twice falls back to sequential evaluation.
+  pb.addConstraint (pb.constraints ()[0],
+                    intervals_t (3, Function::makeInterval (-1., 1.)),
+                    scaling_t (3, 1.));
+  BOOST_CHECK_EQUAL (pb.parallelThreads (), 1);
+  result_t values_ (pb.constraintsOutputSize ());
+  pb.evaluateConstraints (values_, x);
+  BOOST_CHECK_EQUAL (values_.tail (3), values.head (3));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (problem_finalize, T, functionTypes_t)
+{
+  typedef Problem<T> problem_t;
+  typedef typename problem_t::intervals_t intervals_t;
+  typedef typename problem_t::scaling_t scaling_t;
+  typedef typename problem_t::jacobian_t jacobian_t;
+  typedef typename problem_t::argument_t argument_t;
+
+  boost::shared_ptr<problem_t> pb = makeJacobianProblem<T> ();
+  boost::shared_ptr<CountingLinear<T> >
+    linear = boost::make_shared<CountingLinear<T> > ();
+  pb->addConstraint (linear,
+                     intervals_t (1, Function::makeInfiniteInterval ()),
+                     scaling_t (1, 1.));
+  pb->addConstraint (boost::make_shared<Nonlinear<T> > (),
+                     intervals_t (1, Function::makeInfiniteInterval ()),
+                     scaling_t (1, 3.));
+
+  argument_t x (3);
+  x << 1., 2., 3.;
+  jacobian_t jac = pb->jacobian (x);
+  jacobian_t scaledJac = pb->scaledJacobian (x);
+
+  BOOST_CHECK (!pb->isFinalized ());
+  pb->finalize ();
+  BOOST_CHECK (pb->isFinalized ());
+
+  // Linear Jacobians are not evaluated anymore.
+  int count = linear->count;
+  BOOST_CHECK (allclose (pb->jacobian (x), jac));
+  BOOST_CHECK (allclose (pb->scaledJacobian (x), scaledJac));
+  BOOST_CHECK_EQUAL (linear->count, count);
+
+  // Nonlinear Jacobians are still updated.
+  jacobian_t jac_ (jac.rows (), jac.cols ());
+  jac_.setZero ();
+  x << 4., 5., 6.;
+  pb->jacobian (jac_, x);
+  BOOST_CHECK_CLOSE (toDense (jac_) (5, 0), 5., 1e-8);
+  BOOST_CHECK_CLOSE (toDense (jac_) (5, 1), 4., 1e-8);
+  BOOST_CHECK (allclose (toDense (jac_).topRows (5),
+                         toDense (jac).topRows (5)));
+  BOOST_CHECK_EQUAL (linear->count, count);
+
+  // Parallel evaluation.
+  pb->evaluationThreads () = 2;
+  BOOST_CHECK (allclose (pb->jacobian (x), jac_));
+
+  // Copies, e.g. the problem stored by a solver, keep the finalization.
+  NullSolver<T> solver (*pb);
+  BOOST_CHECK (solver.problem ().isFinalized ());
+  BOOST_CHECK (allclose (solver.problem ().jacobian (x), jac_));
+  BOOST_CHECK_EQUAL (linear->count, count);
+
+  // Copies share the precomputed Jacobians: copying does not allocate
+  // matrices.
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+  bool cur_malloc_allowed = is_malloc_allowed ();
+  set_is_malloc_allowed (false);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+  problem_t copy (*pb);
+#ifndef ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+  set_is_malloc_allowed (cur_malloc_allowed);
+#endif //! ROBOPTIM_DO_NOT_CHECK_ALLOCATION
+  BOOST_CHECK (copy.isFinalized ());
+
+  // Adding a constraint resets the finalization, but not the one of the
+  // copies.
+  pb->addConstraint (boost::make_shared<Nonlinear<T> > (),
+                     intervals_t (1, Function::makeInfiniteInterval ()),
+                     scaling_t (1, 1.));
+  BOOST_CHECK (!pb->isFinalized ());
+  BOOST_CHECK_EQUAL (pb->jacobian (x).rows (), 7);
+  BOOST_CHECK (copy.isFinalized ());
+  BOOST_CHECK (allclose (copy.jacobian (x), jac_));
+
+  pb->finalize ();
+  BOOST_CHECK_EQUAL (pb->jacobian (x).rows (), 7);
+  BOOST_CHECK (allclose (toDense (pb->jacobian (x)).topRows (6),
+                         toDense (jac_)));
+  BOOST_CHECK (allclose (copy.jacobian (x), jac_));
+  BOOST_CHECK_EQUAL (copy.jacobian (x).rows (), 6);
+  // Once by the evaluation before finalize, once by finalize.
+  BOOST_CHECK_EQUAL (linear->count, count + 2);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (problem_packed_bounds, T, functionTypes_t)
+{
+  typedef Problem<T> problem_t;
+  typedef typename problem_t::intervals_t intervals_t;
+  typedef typename problem_t::scaling_t scaling_t;
+  typedef typename problem_t::argument_t argument_t;
+  typedef typename problem_t::vector_t vector_t;
+
+  typedef GenericConstantFunction<T> constantFunction_t;
+
+  typename constantFunction_t::vector_t v (3);
+  v.setZero ();
+  problem_t pb (boost::make_shared<constantFunction_t> (v));
+
+  pb.argumentBounds ()[0] = Function::makeInterval (-1., 1.);
+  pb.argumentBounds ()[2] = Function::makeLowerInterval (0.);
+
+  intervals_t bounds;
+  bounds.push_back (Function::makeInterval (0., 1.));
+  bounds.push_back (Function::makeUpperInterval (2.));
+  pb.addConstraint (boost::make_shared<G<T> > (), bounds, scaling_t (2, 1.));
+
+  const double inf = Function::infinity ();
+  vector_t lower (3), upper (3);
+  lower << -1., -inf, 0.;
+  upper << 1., inf, inf;
+  BOOST_CHECK_EQUAL (pb.argumentLowerBounds (), lower);
+  BOOST_CHECK_EQUAL (pb.argumentUpperBounds (), upper);
+
+  vector_t cLower (2), cUpper (2);
+  cLower << 0., -inf;
+  cUpper << 1., 2.;
+  BOOST_CHECK_EQUAL (pb.constraintsLowerBounds (), cLower);
+  BOOST_CHECK_EQUAL (pb.constraintsUpperBounds (), cUpper);
+
+  // Packed bounds follow modifications.
+  pb.argumentBounds ()[1] = Function::makeInterval (-2., 2.);
+  BOOST_CHECK_EQUAL (pb.argumentLowerBounds ()[1], -2.);
+  BOOST_CHECK_EQUAL (pb.argumentUpperBounds ()[1], 2.);
+  pb.boundsVector ()[0][1] = Function::makeInterval (-3., 3.);
+  BOOST_CHECK_EQUAL (pb.constraintsLowerBounds ()[1], -3.);
+
+  // Violation: x = (2, -3, -1), G (x) = (-6, -4).
+  argument_t x (3);
+  x << 2., -3., -1.;
+  vector_t violation (5);
+  violation << 1., -1., -1., -6., -1.;
+  BOOST_CHECK_EQUAL (pb.constraintsViolationVector (x), violation);
+
+  // Projection.
+  argument_t px = x;
+  pb.projectOnArgumentBounds (px);
+  argument_t expected (3);
+  expected << 1., -2., 0.;
+  BOOST_CHECK_EQUAL (px, expected);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (problem_copy_on_write, T, functionTypes_t)
+{
+  typedef Problem<T> problem_t;
+  typedef typename problem_t::intervals_t intervals_t;
+  typedef typename problem_t::scaling_t scaling_t;
+  typedef typename problem_t::argument_t argument_t;
+
+  typedef GenericConstantFunction<T> constantFunction_t;
+
+  typename constantFunction_t::vector_t v (3);
+  v.setZero ();
+  problem_t pb (boost::make_shared<constantFunction_t> (v));
+  pb.argumentBounds ()[0] = Function::makeInterval (-1., 1.);
+  pb.addConstraint (boost::make_shared<G<T> > (),
+		    intervals_t (2, Function::makeInterval (0., 1.)),
+		    scaling_t (2, 1.));
+
+  // Copies share the description of the problem.
+  // Non-const accessors would make the source unique again.
+  const problem_t& cpb = pb;
+  const problem_t copy (pb);
+  BOOST_CHECK (&copy.constraints () == &cpb.constraints ());
+  BOOST_CHECK (&copy.boundsVector () == &cpb.boundsVector ());
+  BOOST_CHECK (&copy.argumentLowerBounds () == &cpb.argumentLowerBounds ());
+
+  // Modifying the source does not affect the copy.
+  pb.argumentBounds ()[0] = Function::makeInterval (-2., 2.);
+  pb.argumentScaling ()[1] = 3.;
+  pb.argumentNames ().push_back ("x0");
+  pb.startingPoint () = argument_t::Zero (3);
+  pb.addConstraint (boost::make_shared<G<T> > (),
+		    intervals_t (2, Function::makeInterval (0., 1.)),
+		    scaling_t (2, 1.));
+
+  BOOST_CHECK (&copy.constraints () != &cpb.constraints ());
+  BOOST_CHECK_EQUAL (pb.constraints ().size (), 2);
+  BOOST_CHECK_EQUAL (copy.constraints ().size (), 1);
+  BOOST_CHECK_EQUAL (pb.argumentLowerBounds ()[0], -2.);
+  BOOST_CHECK_EQUAL (copy.argumentLowerBounds ()[0], -1.);
+  BOOST_CHECK_EQUAL (copy.argumentBounds ()[0].second, 1.);
+  BOOST_CHECK_EQUAL (copy.argumentScaling ()[1], 1.);
+  BOOST_CHECK (copy.argumentNames ().empty ());
+  BOOST_CHECK (!copy.startingPoint ());
+  BOOST_CHECK_EQUAL (copy.constraintsOutputSize (), 2);
+  BOOST_CHECK_EQUAL (pb.constraintsOutputSize (), 4);
+
+  // Modifying a copy does not affect the source either.
+  problem_t other (pb);
+  other.clearConstraints ();
+  BOOST_CHECK_EQUAL (pb.constraints ().size (), 2);
+  BOOST_CHECK_EQUAL (other.constraints ().size (), 0);
+  BOOST_CHECK_EQUAL (other.constraintsLowerBounds ().size (), 0);
+  BOOST_CHECK_EQUAL (pb.constraintsLowerBounds ().size (), 4);
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,197 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "shared-tests/fixture.hh"
+
+#include <boost/make_shared.hpp>
+
+#include <roboptim/core/io.hh>
+#include <roboptim/core/scaled-problem.hh>
+#include <roboptim/core/scaling-helper.hh>
+#include <roboptim/core/numeric-linear-function.hh>
+#include <roboptim/core/numeric-quadratic-function.hh>
+
+using namespace roboptim;
+
+typedef boost::mpl::list< ::roboptim::EigenMatrixDense,
+			  ::roboptim::EigenMatrixSparse> functionTypes_t;
+
+template <typename T>
+boost::shared_ptr<Problem<T> > buildProblem ()
+{
+  typedef Problem<T> problem_t;
+  typedef typename problem_t::intervals_t intervals_t;
+  typedef typename problem_t::scaling_t scaling_t;
+  typedef GenericNumericQuadraticFunction<T> quadratic_t;
+  typedef GenericNumericLinearFunction<T> linear_t;
+
+  Eigen::MatrixXd dense (3, 3);
+  dense <<
+    2., 0., 1.,
+    0., 1., 0.,
+    1., 0., 3.;
+  typename quadratic_t::matrix_t a;
+  a = dense.sparseView ();
+  typename quadratic_t::vector_t b (3);
+  b << 1., -2., .5;
+
+  boost::shared_ptr<problem_t> pb = boost::make_shared<problem_t>
+    (boost::make_shared<quadratic_t> (a, b, "cost"));
+
+  pb->argumentBounds ()[0] = Function::makeInterval (-1., 2.);
+  pb->argumentBounds ()[2] = Function::makeLowerInterval (4.);
+  pb->argumentScaling ()[0] = 2.;
+  pb->argumentScaling ()[1] = .5;
+  pb->argumentScaling ()[2] = 10.;
+  pb->objectiveScaling ()[0] = .1;
+
+  dense.resize (2, 3);
+  dense <<
+    300., 0., 1.,
+    0., 1e-3, 2.;
+  typename linear_t::matrix_t l;
+  l = dense.sparseView ();
+  typename linear_t::vector_t lb (2);
+  lb << 1., 2.;
+
+  intervals_t bounds;
+  bounds.push_back (Function::makeInterval (-1., 1.));
+  bounds.push_back (Function::makeUpperInterval (3.));
+  scaling_t scaling;
+  scaling.push_back (.01);
+  scaling.push_back (4.);
+  pb->addConstraint (boost::make_shared<linear_t> (l, lb, "linear"),
+		     bounds, scaling);
+
+  pb->addConstraint (boost::make_shared<quadratic_t> (a, b, "quadratic"),
+		     Function::makeInterval (0., 5.), 3.);
+
+  return pb;
+}
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (scaled_problem, T, functionTypes_t)
+{
+  typedef Problem<T> problem_t;
+  typedef typename problem_t::argument_t argument_t;
+  typedef typename problem_t::result_t result_t;
+  typedef typename problem_t::jacobian_t jacobian_t;
+  typedef typename GenericDifferentiableFunction<T>::gradient_t gradient_t;
+
+  boost::shared_ptr<problem_t> pb = buildProblem<T> ();
+  ScaledProblem<T> scaled (*pb);
+
+  std::cout << scaled << std::endl;
+
+  Eigen::VectorXd dx (3);
+  dx << 2., .5, 10.;
+  Eigen::VectorXd dc (3);
+  dc << .01, 4., 3.;
+  BOOST_CHECK (allclose (scaled.argumentScaling (), dx));
+  BOOST_CHECK (allclose (scaled.constraintsScaling (), dc));
+
+  argument_t y (3);
+  y << .3, -1., .2;
+  argument_t x (3);
+  scaled.unscaleArgument (x, y);
+  BOOST_CHECK (allclose (x, argument_t (dx.asDiagonal () * y)));
+
+  argument_t y2 (3);
+  scaled.scaleArgument (y2, x);
+  BOOST_CHECK (allclose (y2, y));
+
+  // Cost and gradient.
+  result_t f (1);
+  scaled.cost (f, y);
+  BOOST_CHECK_CLOSE (f[0], .1 * pb->function () (x)[0], 1e-8);
+
+  const GenericDifferentiableFunction<T>& df =
+    *pb->function ().template castInto<GenericDifferentiableFunction<T> > ();
+  gradient_t g (3);
+  scaled.costGradient (g, y);
+  Eigen::VectorXd expectedGrad =
+    .1 * dx.asDiagonal () * Eigen::VectorXd (df.gradient (x).transpose ());
+  BOOST_CHECK (allclose (Eigen::VectorXd (g.transpose ()), expectedGrad));
+
+  // Constraints and Jacobian.
+  result_t c (3);
+  scaled.evaluateConstraints (c, y);
+  result_t expected (3);
+  pb->evaluateConstraints (expected, x);
+  BOOST_CHECK (allclose (c, result_t (dc.asDiagonal () * expected)));
+
+  jacobian_t jac (3, 3);
+  scaled.jacobian (jac, y);
+  Eigen::MatrixXd expectedJac = dc.asDiagonal ()
+    * Eigen::MatrixXd (pb->jacobian (x)) * dx.asDiagonal ();
+  BOOST_CHECK (allclose (Eigen::MatrixXd (jac), expectedJac));
+  BOOST_CHECK (allclose (Eigen::MatrixXd (pb->scaledJacobian (x)),
+			 expectedJac));
+
+  // Scaled bounds.
+  const double inf = Function::infinity ();
+  argument_t lower (3);
+  argument_t upper (3);
+  lower << -.5, -inf, .4;
+  upper << 1., inf, inf;
+  BOOST_CHECK (scaled.argumentLowerBounds () == lower);
+  BOOST_CHECK (scaled.argumentUpperBounds () == upper);
+  lower << -.01, -inf, 0.;
+  upper << .01, 12., 15.;
+  BOOST_CHECK (scaled.constraintsLowerBounds () == lower);
+  BOOST_CHECK (scaled.constraintsUpperBounds () == upper);
+
+  // Non-positive scaling.
+  pb->argumentScaling ()[1] = 0.;
+  BOOST_CHECK_THROW (ScaledProblem<T> wrong (*pb), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE (scaled_problem_scaling_helper)
+{
+  typedef Problem<EigenMatrixDense> denseProblem_t;
+  typedef Problem<EigenMatrixSparse> sparseProblem_t;
+  typedef ScalingHelper<EigenMatrixDense> denseHelper_t;
+  typedef ScalingHelper<EigenMatrixSparse> sparseHelper_t;
+
+  boost::shared_ptr<denseProblem_t> dense = buildProblem<EigenMatrixDense> ();
+  boost::shared_ptr<sparseProblem_t> sparse =
+    buildProblem<EigenMatrixSparse> ();
+  sparse->evaluationThreads () = 4;
+
+  std::vector<denseProblem_t::argument_t>
+    x (3, denseProblem_t::argument_t::Zero (3));
+  x[0] << 1., 2., 3.;
+  x[1] << -100., 0., 20.;
+  x[2] << 1e-3, 1e-3, 1e-3;
+
+  denseHelper_t dh (*dense, Function::makeInterval (.1, 10.));
+  sparseHelper_t sh (*sparse, Function::makeInterval (.1, 10.));
+  dh.computeScaling (x);
+  sh.computeScaling (x);
+
+  // Same suggestions for dense and sparse Jacobians, sequential or not.
+  BOOST_REQUIRE_EQUAL (dh.scaling ().size (), sh.scaling ().size ());
+  for (std::size_t i = 0; i < dh.scaling ().size (); ++i)
+    BOOST_CHECK (dh.scaling ()[i].second == sh.scaling ()[i].second);
+
+  // Linear rows: max gradients 300 and 2.
+  BOOST_CHECK_CLOSE (dh.scaling ()[0].second[0], 10. / 300., 1e-8);
+  BOOST_CHECK_CLOSE (dh.scaling ()[0].second[1], 1., 1e-8);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
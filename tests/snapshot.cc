@@ -0,0 +1,356 @@
+// Copyright (C) 2026 by the RobOptim team.
+//
+// This file is part of the roboptim.
+//
+// roboptim is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// roboptim is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with roboptim.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "shared-tests/fixture.hh"
+
+#include <fstream>
+#include <limits>
+
+#include <boost/filesystem.hpp>
+#include <boost/make_shared.hpp>
+
+#include <roboptim/core/util.hh>
+#include <roboptim/core/problem.hh>
+#include <roboptim/core/snapshot.hh>
+#include <roboptim/core/function/constant.hh>
+#include <roboptim/core/function/identity.hh>
+#include <roboptim/core/numeric-linear-function.hh>
+#include <roboptim/core/numeric-quadratic-function.hh>
+
+using namespace roboptim;
+
+typedef boost::mpl::list< ::roboptim::EigenMatrixDense,
+			  ::roboptim::EigenMatrixSparse> functionTypes_t;
+
+template <typename T>
+boost::shared_ptr<Problem<T> > buildProblem ()
+{
+  typedef Problem<T> problem_t;
+  typedef typename problem_t::intervals_t intervals_t;
+  typedef typename problem_t::scaling_t scaling_t;
+  typedef GenericNumericQuadraticFunction<T> quadratic_t;
+  typedef GenericNumericLinearFunction<T> linear_t;
+  typedef GenericConstantFunction<T> constant_t;
+
+  typename quadratic_t::matrix_t a (3, 3);
+  a.setZero ();
+  a.coeffRef (0, 0) = 2.;
+  a.coeffRef (1, 1) = 1.;
+  a.coeffRef (2, 2) = 4.;
+  a.coeffRef (0, 2) = a.coeffRef (2, 0) = -1.;
+  typename quadratic_t::vector_t b (3);
+  b << 1., 2., 3.;
+  typename quadratic_t::vector_t c (1);
+  c << 5.;
+
+  boost::shared_ptr<problem_t> pb = boost::make_shared<problem_t>
+    (boost::make_shared<quadratic_t> (a, b, c, "cost"));
+
+  pb->argumentBounds ()[0] = Function::makeInterval (-1., 1.);
+  pb->argumentBounds ()[2] = Function::makeLowerInterval (0.);
+  pb->argumentScaling ()[1] = 2.;
+  pb->objectiveScaling ()[0] = 0.5;
+  pb->argumentNames ().push_back ("x");
+  pb->argumentNames ().push_back ("y");
+  pb->argumentNames ().push_back ("z");
+
+  typename problem_t::argument_t x0 (3);
+  x0 << 0.5, -0.5, 1.;
+  pb->startingPoint () = x0;
+
+  // Linear constraints with different sizes.
+  for (int i = 0; i < 10; ++i)
+    {
+      const int m = 1 + i % 3;
+      typename linear_t::matrix_t l (m, 3);
+      l.setZero ();
+      for (int k = 0; k < m; ++k)
+	l.coeffRef (k, (i + k) % 3) = 1. + i + 0.5 * k;
+      typename linear_t::vector_t lb (m);
+      lb.setConstant (static_cast<double> (-i));
+
+      intervals_t bounds (static_cast<std::size_t> (m),
+			  Function::makeInterval (-i, i + 1.));
+      bounds[0] = Function::makeUpperInterval (3.);
+      pb->addConstraint (boost::make_shared<linear_t> (l, lb, "linear"),
+			 bounds, scaling_t (static_cast<std::size_t> (m),
+					    1. + i));
+    }
+
+  typename constant_t::vector_t offset (2);
+  offset << 1., -1.;
+  pb->addConstraint (boost::make_shared<constant_t> (3, offset),
+		     intervals_t (2, Function::makeInterval (-2., 2.)),
+		     scaling_t (2, 1.));
+
+  return pb;
+}
+
+BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (snapshot, T, functionTypes_t)
+{
+  typedef Problem<T> problem_t;
+  typedef typename problem_t::argument_t argument_t;
+  typedef GenericDifferentiableFunction<T> differentiableFunction_t;
+
+  const boost::filesystem::path path = boost::filesystem::temp_directory_path ()
+    / boost::filesystem::unique_path ("roboptim-core-snapshot-%%%%-%%%%.bin");
+
+  boost::shared_ptr<problem_t> pb = buildProblem<T> ();
+  saveSnapshot (*pb, path.string ());
+
+  boost::shared_ptr<problem_t> loaded = loadSnapshot<T> (path.string ());
+
+  // Problem data.
+  BOOST_CHECK_EQUAL (loaded->function ().getName (), "cost");
+  BOOST_CHECK (loaded->objectiveScaling () == pb->objectiveScaling ());
+  BOOST_CHECK (loaded->argumentScaling () == pb->argumentScaling ());
+  BOOST_CHECK (loaded->argumentNames () == pb->argumentNames ());
+  BOOST_CHECK (loaded->argumentLowerBounds () == pb->argumentLowerBounds ());
+  BOOST_CHECK (loaded->argumentUpperBounds () == pb->argumentUpperBounds ());
+  BOOST_CHECK (loaded->constraintsLowerBounds ()
+	       == pb->constraintsLowerBounds ());
+  BOOST_CHECK (loaded->constraintsUpperBounds ()
+	       == pb->constraintsUpperBounds ());
+  BOOST_CHECK (loaded->scalingVector () == pb->scalingVector ());
+  BOOST_REQUIRE (loaded->startingPoint ());
+  BOOST_CHECK (*loaded->startingPoint () == *pb->startingPoint ());
+  BOOST_REQUIRE_EQUAL (loaded->constraints ().size (),
+		       pb->constraints ().size ());
+
+  // Functions.
+  argument_t x (3);
+  x << 0.3, -1.2, 2.5;
+  BOOST_CHECK (allclose (loaded->function () (x), pb->function () (x)));
+  BOOST_CHECK
+    (allclose
+     (loaded->function ().template castInto<differentiableFunction_t> ()
+      ->jacobian (x),
+      pb->function ().template castInto<differentiableFunction_t> ()
+      ->jacobian (x)));
+
+  // Only the upper triangle of the quadratic cost is saved.
+  typedef GenericNumericQuadraticFunction<T> quadratic_t;
+  const quadratic_t* q =
+    pb->function ().template castInto<quadratic_t> ();
+  const quadratic_t* loadedQ =
+    loaded->function ().template castInto<quadratic_t> ();
+  Eigen::MatrixXd upper = toDense (q->A ());
+  upper.triangularView<Eigen::StrictlyLower> ().setZero ();
+  BOOST_CHECK (allclose (toDense (loadedQ->A ()), upper));
+  BOOST_CHECK (allclose (toDense (loadedQ->hessian (x, 0)),
+			 toDense (q->hessian (x, 0))));
+
+  typename problem_t::result_t values (pb->constraintsOutputSize ());
+  typename problem_t::result_t loadedValues (pb->constraintsOutputSize ());
+  pb->evaluateConstraints (values, x);
+  loaded->evaluateConstraints (loadedValues, x);
+  BOOST_CHECK (allclose (loadedValues, values));
+  BOOST_CHECK (allclose (loaded->jacobian (x), pb->jacobian (x)));
+
+  // A dense snapshot cannot be loaded as a sparse one, and conversely.
+  if (boost::is_same<T, EigenMatrixDense>::value)
+    BOOST_CHECK_THROW (loadSnapshot<EigenMatrixSparse> (path.string ()),
+		       std::runtime_error);
+  else
+    BOOST_CHECK_THROW (loadSnapshot<EigenMatrixDense> (path.string ()),
+		       std::runtime_error);
+
+  // Truncated snapshot.
+  const boost::uintmax_t size = boost::filesystem::file_size (path);
+  boost::filesystem::resize_file (path, size - 8);
+  BOOST_CHECK_THROW (loadSnapshot<T> (path.string ()), std::runtime_error);
+
+  // Wrong magic number.
+  {
+    std::ofstream file (path.string ().c_str (),
+			std::ios::out | std::ios::binary | std::ios::trunc);
+    file << "not a snapshot, definitely not a snapshot";
+  }
+  BOOST_CHECK_THROW (loadSnapshot<T> (path.string ()), std::runtime_error);
+
+  boost::filesystem::remove (path);
+  BOOST_CHECK_THROW (loadSnapshot<T> (path.string ()), std::runtime_error);
+
+  // Only numeric functions can be saved.
+  typedef GenericIdentityFunction<T> identity_t;
+  typename identity_t::vector_t offset (3);
+  offset.setZero ();
+  pb->addConstraint (boost::make_shared<identity_t> (offset),
+		     typename problem_t::intervals_t
+		     (3, Function::makeInfiniteInterval ()),
+		     typename problem_t::scaling_t (3, 1.));
+  BOOST_CHECK_THROW (saveSnapshot (*pb, path.string ()), std::runtime_error);
+  boost::filesystem::remove (path);
+}
+
+BOOST_AUTO_TEST_CASE (snapshot_corrupted_sparse_matrix)
+{
+  typedef detail::SnapshotReader::sparseMatrix_t matrix_t;
+  typedef matrix_t::StorageIndex index_t;
+
+  const boost::filesystem::path path = boost::filesystem::temp_directory_path ()
+    / boost::filesystem::unique_path ("roboptim-core-snapshot-%%%%-%%%%.bin");
+
+  // Sizes that do not fit the index type of the matrix.
+  {
+    detail::SnapshotWriter writer (path.string (), true);
+    writer.writeInteger (std::numeric_limits<boost::uint64_t>::max ());
+    writer.writeInteger (2);
+    writer.writeInteger (0);
+    writer.close ();
+  }
+  {
+    detail::SnapshotReader reader (path.string (), true);
+    BOOST_CHECK_THROW (reader.readSparseMatrix (), std::runtime_error);
+  }
+
+  // Outer index array larger than the file.
+  {
+    detail::SnapshotWriter writer (path.string (), true);
+    writer.writeInteger (1 << 20);
+    writer.writeInteger (1 << 20);
+    writer.writeInteger (0);
+    writer.close ();
+  }
+  {
+    detail::SnapshotReader reader (path.string (), true);
+    BOOST_CHECK_THROW (reader.readSparseMatrix (), std::runtime_error);
+  }
+
+  // Inconsistent compressed structure.
+  const index_t outer[3] = {0, 1, 2};
+  const index_t inner[1] = {0};
+  const double values[1] = {1.};
+  {
+    detail::SnapshotWriter writer (path.string (), true);
+    writer.writeInteger (2);
+    writer.writeInteger (2);
+    writer.writeInteger (1);
+    writer.write (outer, sizeof (outer));
+    writer.write (inner, sizeof (inner));
+    writer.write (values, sizeof (values));
+    writer.close ();
+  }
+  {
+    detail::SnapshotReader reader (path.string (), true);
+    BOOST_CHECK_THROW (reader.readSparseMatrix (), std::runtime_error);
+  }
+
+  // Valid matrix.
+  matrix_t m (2, 3);
+  m.insert (1, 0) = 2.;
+  m.insert (0, 2) = -1.;
+  m.makeCompressed ();
+  {
+    detail::SnapshotWriter writer (path.string (), true);
+    writer.writeMatrix (m);
+    writer.close ();
+  }
+  {
+    detail::SnapshotReader reader (path.string (), true);
+    BOOST_CHECK (allclose (reader.readSparseMatrix (), m));
+    BOOST_CHECK (reader.eof ());
+  }
+
+  boost::filesystem::remove (path);
+}
+
+BOOST_AUTO_TEST_CASE (snapshot_corrupted_constant_function)
+{
+  typedef detail::SnapshotReader::vector_t vector_t;
+  typedef Problem<EigenMatrixDense> problem_t;
+
+  const boost::filesystem::path path = boost::filesystem::temp_directory_path ()
+    / boost::filesystem::unique_path ("roboptim-core-snapshot-%%%%-%%%%.bin");
+
+  const vector_t offset = vector_t::Ones (1);
+  const vector_t bounds = vector_t::Zero (2);
+
+  // Input size of the cost function larger than the file.
+  {
+    detail::SnapshotWriter writer (path.string (), false);
+    writer.writeInteger (detail::SNAPSHOT_CONSTANT);
+    writer.writeInteger (boost::uint64_t (1) << 40);
+    writer.writeInteger (1);
+    writer.writeString ("cost");
+    writer.writeVector (offset);
+    writer.writeVector (offset);
+    writer.close ();
+  }
+  BOOST_CHECK_THROW (loadSnapshot<EigenMatrixDense> (path.string ()),
+		     std::runtime_error);
+
+  // Output size larger than the file.
+  {
+    detail::SnapshotWriter writer (path.string (), false);
+    writer.writeInteger (detail::SNAPSHOT_CONSTANT);
+    writer.writeInteger (2);
+    writer.writeInteger (boost::uint64_t (1) << 40);
+    writer.writeString ("cost");
+    writer.writeVector (offset);
+    writer.close ();
+  }
+  BOOST_CHECK_THROW (loadSnapshot<EigenMatrixDense> (path.string ()),
+		     std::runtime_error);
+
+  // Input size of a constraint different from the one of the cost.
+  for (int i = 0; i < 2; ++i)
+    {
+      {
+	detail::SnapshotWriter writer (path.string (), false);
+	writer.writeInteger (detail::SNAPSHOT_CONSTANT);
+	writer.writeInteger (2);
+	writer.writeInteger (1);
+	writer.writeString ("cost");
+	writer.writeVector (offset);
+	writer.writeVector (offset);
+	writer.writeVector (bounds);
+	writer.writeVector (bounds);
+	writer.writeVector (vector_t::Ones (2));
+	writer.writeInteger (0);
+	writer.writeInteger (0);
+	writer.writeInteger (1);
+	writer.writeInteger (detail::SNAPSHOT_CONSTANT);
+	writer.writeInteger (i == 0 ? boost::uint64_t (1) << 40 : 2);
+	writer.writeInteger (1);
+	writer.writeString ("constraint");
+	writer.writeVector (offset);
+	writer.writeVector (offset);
+	writer.writeVector (offset);
+	writer.writeVector (offset);
+	writer.close ();
+      }
+
+      if (i == 0)
+	BOOST_CHECK_THROW (loadSnapshot<EigenMatrixDense> (path.string ()),
+			   std::runtime_error);
+      else
+	{
+	  // Same file with a consistent input size.
+	  boost::shared_ptr<problem_t> pb =
+	    loadSnapshot<EigenMatrixDense> (path.string ());
+	  BOOST_CHECK_EQUAL (pb->function ().inputSize (), 2);
+	  BOOST_CHECK_EQUAL (pb->constraints ().size (), 1);
+	}
+    }
+
+  boost::filesystem::remove (path);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
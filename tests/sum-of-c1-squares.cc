@@ -20,6 +20,7 @@
 #include <iostream>
 
 #include <roboptim/core/io.hh>
+#include <roboptim/core/numeric-linear-function.hh>
 #include <roboptim/core/sum-of-c1-squares.hh>
 
 using namespace roboptim;
@@ -66,6 +67,49 @@ struct F : public DifferentiableFunction
   }
 };
 
+// Scaled identity whose scale can change between calls at the same point.
+struct Scaled : public DifferentiableFunction
+{
+  Scaled () : DifferentiableFunction (2, 2, "s * x"),
+              scale (1.),
+              count (0)
+  {
+  }
+
+  void
+  impl_compute (result_ref result, const_argument_ref x) const
+  {
+    result = scale * x;
+  }
+
+  void
+  impl_gradient (gradient_ref grad, const_argument_ref,
+                 size_type functionId) const
+  {
+    ++count;
+    grad.setZero ();
+    grad[functionId] = scale;
+  }
+
+  value_type scale;
+  mutable int count;
+};
+
+typedef boost::mpl::list< ::roboptim::EigenMatrixDense,
+                          ::roboptim::EigenMatrixSparse> functionTypes_t;
+
+inline const double*
+valuePtr (const GenericFunctionTraits<EigenMatrixDense>::matrix_t& m)
+{
+  return m.data ();
+}
+
+inline const double*
+valuePtr (const GenericFunctionTraits<EigenMatrixSparse>::matrix_t& m)
+{
+  return m.valuePtr ();
+}
+
 BOOST_FIXTURE_TEST_SUITE (core, TestSuiteConfiguration)
 
 BOOST_AUTO_TEST_CASE (sum_of_c1_squares)
@@ -108,4 +152,134 @@ BOOST_AUTO_TEST_CASE (sum_of_c1_squares)
   BOOST_CHECK (output->match_pattern ());
 }
 
+BOOST_AUTO_TEST_CASE (sum_of_c1_squares_gauss_newton)
+{
+  boost::shared_ptr<F> fptr = boost::make_shared<F> ();
+  SumOfC1Squares fSum (fptr, "sum");
+
+  SumOfC1Squares::vector_t x (4);
+  x << 1., -2., .5, 3.;
+
+  // Gradient: 2 J^T f.
+  SumOfC1Squares::matrix_t jac = fptr->jacobian (x);
+  SumOfC1Squares::vector_t f = (*fptr) (x);
+  BOOST_CHECK (allclose (fSum.gradient (x),
+                         SumOfC1Squares::gradient_t
+                         (2. * f.transpose () * jac)));
+
+  // Gauss-Newton Hessian: 2 J^T J.
+  SumOfC1Squares::matrix_t h (4, 4);
+  fSum.gaussNewtonHessian (h, x);
+  SumOfC1Squares::matrix_t expected = 2. * jac.transpose () * jac;
+  BOOST_CHECK (allclose (h, expected));
+
+  // Product with a vector.
+  SumOfC1Squares::vector_t v (4);
+  v << 1., 0., -1., 2.;
+  SumOfC1Squares::vector_t hv (4);
+  fSum.gaussNewtonProduct (hv, x, v);
+  BOOST_CHECK (allclose (hv, SumOfC1Squares::vector_t (expected * v)));
+}
+
+BOOST_AUTO_TEST_CASE (sum_of_c1_squares_cache_jacobian)
+{
+  boost::shared_ptr<Scaled> fptr = boost::make_shared<Scaled> ();
+  SumOfC1Squares fSum (fptr, "scaled");
+  BOOST_CHECK (!fSum.cacheJacobian ());
+
+  SumOfC1Squares::vector_t x (2);
+  x << 1., -2.;
+  SumOfC1Squares::matrix_t h (2, 2);
+  SumOfC1Squares::matrix_t identity =
+    SumOfC1Squares::matrix_t::Identity (2, 2);
+
+  // By default, the Jacobian is recomputed at each call, and changes of
+  // the base function are seen.
+  fSum.gaussNewtonHessian (h, x);
+  BOOST_CHECK (allclose (h, 2. * identity));
+  fptr->scale = 2.;
+  fSum.gaussNewtonHessian (h, x);
+  BOOST_CHECK (allclose (h, 8. * identity));
+  BOOST_CHECK_EQUAL (fptr->count, 4);
+
+  // Once enabled, the Jacobian is reused at the same point.
+  fSum.cacheJacobian (true);
+  BOOST_CHECK (fSum.cacheJacobian ());
+  fSum.gaussNewtonHessian (h, x);
+  BOOST_CHECK_EQUAL (fptr->count, 6);
+  fptr->scale = 3.;
+  fSum.gaussNewtonHessian (h, x);
+  BOOST_CHECK (allclose (h, 8. * identity));
+  SumOfC1Squares::vector_t v (2);
+  v << 1., 1.;
+  SumOfC1Squares::vector_t hv (2);
+  fSum.gaussNewtonProduct (hv, x, v);
+  BOOST_CHECK (allclose (hv, SumOfC1Squares::vector_t (8. * v)));
+  BOOST_CHECK_EQUAL (fptr->count, 6);
+
+  // A different point triggers a new evaluation.
+  SumOfC1Squares::vector_t y (2);
+  y << 0., 1.;
+  fSum.gaussNewtonHessian (h, y);
+  BOOST_CHECK (allclose (h, 18. * identity));
+  BOOST_CHECK_EQUAL (fptr->count, 8);
+
+  // Changing the flag discards the cached Jacobian.
+  fptr->scale = 1.;
+  fSum.cacheJacobian (true);
+  fSum.gaussNewtonHessian (h, y);
+  BOOST_CHECK (allclose (h, 2. * identity));
+  BOOST_CHECK_EQUAL (fptr->count, 10);
+
+  fSum.cacheJacobian (false);
+  fptr->scale = 2.;
+  fSum.gaussNewtonHessian (h, y);
+  BOOST_CHECK (allclose (h, 8. * identity));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE (sum_of_c1_squares_linear, T, functionTypes_t)
+{
+  typedef GenericNumericLinearFunction<T> linear_t;
+  typedef GenericSumOfC1Squares<T> sum_t;
+
+  Eigen::MatrixXd a (3, 4);
+  a <<
+    1., 0., 2., 0.,
+    0., 3., 0., 0.,
+    0., 0., 1., -1.;
+  typename linear_t::matrix_t sparseA;
+  sparseA = a.sparseView ();
+  typename linear_t::vector_t b (3);
+  b << 1., -1., .5;
+  boost::shared_ptr<linear_t> fptr = boost::make_shared<linear_t>
+    (sparseA, b);
+  sum_t fSum (fptr, "linear");
+
+  typename sum_t::vector_t x (4);
+  x << 1., 2., 3., 4.;
+
+  Eigen::VectorXd y = a * x + b;
+  BOOST_CHECK (allclose (toDense (fSum.gradient (x)),
+                         Eigen::MatrixXd (2. * y.transpose () * a)));
+
+  typename sum_t::matrix_t h (4, 4);
+  h.setZero ();
+  fSum.gaussNewtonHessian (h, x);
+  Eigen::MatrixXd expected = 2. * a.transpose () * a;
+  BOOST_CHECK (allclose (toDense (h), expected));
+
+  // The pattern of J does not change: the values are updated in place.
+  const double* values = valuePtr (h);
+  x << -1., 0., 2., 1.;
+  fSum.gaussNewtonHessian (h, x);
+  BOOST_CHECK_EQUAL (values, valuePtr (h));
+  BOOST_CHECK (allclose (toDense (h), expected));
+
+  typename sum_t::vector_t v (4);
+  v << 1., 0., -1., 2.;
+  typename sum_t::vector_t hv (4);
+  fSum.gaussNewtonProduct (hv, x, v);
+  BOOST_CHECK (allclose (hv, Eigen::VectorXd (expected * v)));
+}
+
 BOOST_AUTO_TEST_SUITE_END ()